@@ -0,0 +1,53 @@
+/*
+ * bench/bench.h
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the MIT License
+ */
+
+#ifndef HALM_BENCH_BENCH_H_
+#define HALM_BENCH_BENCH_H_
+/*----------------------------------------------------------------------------*/
+#include <xcore/helpers.h>
+#include <stddef.h>
+#include <stdint.h>
+/*----------------------------------------------------------------------------*/
+struct BenchCase
+{
+  /** Mandatory: unique case name in the "subsystem.operation" form. */
+  const char *name;
+  /** Mandatory: function that runs the requested number of iterations. */
+  void (*run)(void *, size_t);
+  /** Optional: argument for the case function. */
+  void *argument;
+  /** Mandatory: number of iterations in each sample. */
+  size_t iterations;
+  /** Optional: number of bytes processed in each iteration. */
+  size_t bytes;
+};
+/*----------------------------------------------------------------------------*/
+BEGIN_DECLS
+
+void benchRun(const struct BenchCase *);
+uint64_t benchTime(void);
+
+void benchBlockPool(void);
+void benchClock(void);
+void benchCrc(void);
+void benchDma(void);
+void benchFlashScheduler(void);
+void benchGovernor(void);
+void benchIdle(void);
+void benchInstrumentedProxy(void);
+void benchMemoryRegion(void);
+void benchMmcsd(void);
+void benchMpu(void);
+void benchNor(void);
+void benchProxy(void);
+void benchSdioSpi(void);
+void benchTimer(void);
+void benchUsb(void);
+void benchWorkQueue(void);
+
+END_DECLS
+/*----------------------------------------------------------------------------*/
+#endif /* HALM_BENCH_BENCH_H_ */
@@ -0,0 +1,230 @@
+/*
+ * bench_block_pool.c
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the MIT License
+ */
+
+#include "bench.h"
+
+#ifdef CONFIG_GENERIC_BLOCK_POOL
+#include <halm/generic/block_pool.h>
+#include <stdalign.h>
+#include <stdlib.h>
+/*----------------------------------------------------------------------------*/
+#define ARENA_SIZE      1024
+#define BLOCK_ALIGNMENT 64
+#define SMALL_COUNT     2
+#define SMALL_SIZE      16
+#define LARGE_COUNT     2
+#define LARGE_SIZE      64
+/*----------------------------------------------------------------------------*/
+static void checkAlignment(void);
+static void checkArena(void);
+static void checkBorrowing(void);
+static void checkInfo(const void *, size_t, size_t, size_t, uint32_t,
+    uint32_t);
+static void runAlloc(void *, size_t);
+/*----------------------------------------------------------------------------*/
+static const struct BlockSlab slabs[] = {
+    {SMALL_SIZE, SMALL_COUNT},
+    {LARGE_SIZE, LARGE_COUNT}
+};
+/*----------------------------------------------------------------------------*/
+static void checkAlignment(void)
+{
+  void *blocks[SMALL_COUNT + LARGE_COUNT];
+  void * const pool = init(BlockPool, &(struct BlockPoolConfig){
+      .slabs = slabs,
+      .count = ARRAY_SIZE(slabs),
+      .alignment = BLOCK_ALIGNMENT
+  });
+
+  if (pool == NULL)
+    abort();
+
+  for (size_t index = 0; index < ARRAY_SIZE(blocks); ++index)
+  {
+    blocks[index] = blockPoolAlloc(pool, 1);
+
+    if (blocks[index] == NULL)
+      abort();
+    if ((uintptr_t)blocks[index] % BLOCK_ALIGNMENT)
+      abort();
+  }
+
+  /* Block sizes are rounded up to the alignment */
+  struct BlockPoolInfo info;
+
+  if (blockPoolGetInfo(pool, 0, &info) != E_OK)
+    abort();
+  if (info.size != BLOCK_ALIGNMENT || info.count != SMALL_COUNT)
+    abort();
+
+  for (size_t index = 0; index < ARRAY_SIZE(blocks); ++index)
+    blockPoolFree(pool, blocks[index]);
+
+  deinit(pool);
+}
+/*----------------------------------------------------------------------------*/
+static void checkArena(void)
+{
+  alignas(max_align_t) static uint8_t arena[ARENA_SIZE];
+  const size_t required = blockPoolGetRequiredSize(slabs, ARRAY_SIZE(slabs),
+      BLOCK_ALIGNMENT);
+
+  if (required + 1 > sizeof(arena))
+    abort();
+
+  /* Region without space for all aligned blocks is rejected */
+  const struct BlockPoolConfig small = {
+      .slabs = slabs,
+      .count = ARRAY_SIZE(slabs),
+      .arena = arena + 1,
+      .size = required - BLOCK_ALIGNMENT,
+      .alignment = BLOCK_ALIGNMENT
+  };
+
+  if (init(BlockPool, &small) != NULL)
+    abort();
+
+  /* Required size covers the alignment of an arbitrary address */
+  void * const pool = init(BlockPool, &(struct BlockPoolConfig){
+      .slabs = slabs,
+      .count = ARRAY_SIZE(slabs),
+      .arena = arena + 1,
+      .size = required,
+      .alignment = BLOCK_ALIGNMENT
+  });
+
+  if (pool == NULL)
+    abort();
+
+  uint8_t *blocks[SMALL_COUNT + LARGE_COUNT];
+
+  for (size_t index = 0; index < ARRAY_SIZE(blocks); ++index)
+  {
+    uint8_t * const block = blockPoolAlloc(pool, SMALL_SIZE);
+
+    if (block == NULL || (uintptr_t)block % BLOCK_ALIGNMENT)
+      abort();
+    if (block < arena + 1 || block + BLOCK_ALIGNMENT > arena + 1 + required)
+      abort();
+
+    blocks[index] = block;
+  }
+
+  if (blockPoolAlloc(pool, SMALL_SIZE) != NULL)
+    abort();
+
+  for (size_t index = 0; index < ARRAY_SIZE(blocks); ++index)
+    blockPoolFree(pool, blocks[index]);
+
+  checkInfo(pool, 0, 0, SMALL_COUNT, LARGE_COUNT, 1);
+  deinit(pool);
+}
+/*----------------------------------------------------------------------------*/
+static void checkBorrowing(void)
+{
+  void *blocks[SMALL_COUNT + LARGE_COUNT];
+  void * const pool = init(BlockPool, &(struct BlockPoolConfig){
+      .slabs = slabs,
+      .count = ARRAY_SIZE(slabs)
+  });
+
+  if (pool == NULL)
+    abort();
+
+  /* Small requests take blocks of the larger slab when needed */
+  for (size_t index = 0; index < ARRAY_SIZE(blocks); ++index)
+  {
+    if ((blocks[index] = blockPoolAlloc(pool, SMALL_SIZE)) == NULL)
+      abort();
+  }
+
+  checkInfo(pool, 0, SMALL_COUNT, SMALL_COUNT, LARGE_COUNT, 0);
+  checkInfo(pool, 1, LARGE_COUNT, LARGE_COUNT, 0, 0);
+
+  /* Failures are counted by the smallest suitable slab */
+  if (blockPoolAlloc(pool, SMALL_SIZE) != NULL)
+    abort();
+  if (blockPoolAlloc(pool, LARGE_SIZE) != NULL)
+    abort();
+  if (blockPoolAlloc(pool, LARGE_SIZE + 1) != NULL)
+    abort();
+
+  checkInfo(pool, 0, SMALL_COUNT, SMALL_COUNT, LARGE_COUNT, 1);
+  checkInfo(pool, 1, LARGE_COUNT, LARGE_COUNT, 0, 1);
+
+  struct BlockPoolInfo info;
+
+  if (blockPoolGetInfo(pool, ARRAY_SIZE(slabs), &info) != E_VALUE)
+    abort();
+
+  /* Blocks are returned to their own slabs, peak values are kept */
+  for (size_t index = 0; index < ARRAY_SIZE(blocks); ++index)
+    blockPoolFree(pool, blocks[index]);
+  blockPoolFree(pool, NULL);
+
+  checkInfo(pool, 0, 0, SMALL_COUNT, LARGE_COUNT, 1);
+  checkInfo(pool, 1, 0, LARGE_COUNT, 0, 1);
+
+  deinit(pool);
+}
+/*----------------------------------------------------------------------------*/
+static void checkInfo(const void *pool, size_t index, size_t used,
+    size_t peak, uint32_t borrowed, uint32_t failures)
+{
+  struct BlockPoolInfo info;
+
+  if (blockPoolGetInfo(pool, index, &info) != E_OK)
+    abort();
+
+  if (info.used != used || info.peak != peak)
+    abort();
+  if (info.borrowed != borrowed || info.failures != failures)
+    abort();
+}
+/*----------------------------------------------------------------------------*/
+static void runAlloc(void *argument, size_t iterations)
+{
+  void *blocks[SMALL_COUNT + LARGE_COUNT];
+
+  while (iterations--)
+  {
+    for (size_t index = 0; index < ARRAY_SIZE(blocks); ++index)
+    {
+      if ((blocks[index] = blockPoolAlloc(argument, SMALL_SIZE)) == NULL)
+        abort();
+    }
+
+    for (size_t index = 0; index < ARRAY_SIZE(blocks); ++index)
+      blockPoolFree(argument, blocks[index]);
+  }
+}
+#endif
+/*----------------------------------------------------------------------------*/
+void benchBlockPool(void)
+{
+#ifdef CONFIG_GENERIC_BLOCK_POOL
+  checkAlignment();
+  checkBorrowing();
+  checkArena();
+
+  void * const pool = init(BlockPool, &(struct BlockPoolConfig){
+      .slabs = slabs,
+      .count = ARRAY_SIZE(slabs)
+  });
+
+  if (pool == NULL)
+    abort();
+
+  benchRun(&(const struct BenchCase){
+      .name = "block_pool.alloc_free",
+      .run = runAlloc,
+      .argument = pool,
+      .iterations = 1000000
+  });
+
+  deinit(pool);
+#endif
+}
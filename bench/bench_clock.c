@@ -0,0 +1,324 @@
+/*
+ * bench_clock.c
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the MIT License
+ */
+
+#include "bench.h"
+
+#ifdef CONFIG_GENERIC_CLOCK_SOLVER
+#include <halm/generic/clock_solver.h>
+#include <xcore/bits.h>
+#include <stdlib.h>
+/*----------------------------------------------------------------------------*/
+struct SolverCase
+{
+  const struct ClockSolverPll *model;
+  struct ClockSolverConfig config;
+
+  /* Check of the solution against constraints of the clock driver */
+  bool (*check)(const struct ClockSolverConfig *,
+      const struct ClockSolution *);
+};
+/*----------------------------------------------------------------------------*/
+static uint32_t calcStm32F4Divisor(uint32_t);
+static bool checkLpcGen2(uint32_t, const struct ClockSolution *);
+static bool checkLpcGen2System(const struct ClockSolverConfig *,
+    const struct ClockSolution *);
+static bool checkLpcGen2Usb(const struct ClockSolverConfig *,
+    const struct ClockSolution *);
+static bool checkM48x(const struct ClockSolverConfig *,
+    const struct ClockSolution *);
+static bool checkOutputs(const struct ClockSolverConfig *,
+    const struct ClockSolution *, uint8_t, uint8_t);
+static bool checkStm32F4Audio(const struct ClockSolverConfig *,
+    const struct ClockSolution *);
+static bool checkStm32F4Main(const struct ClockSolverConfig *,
+    const struct ClockSolution *);
+static void runSolver(void *, size_t);
+static void solveCase(const struct SolverCase *);
+/*----------------------------------------------------------------------------*/
+static volatile uint32_t sink;
+/*----------------------------------------------------------------------------*/
+static uint32_t calcStm32F4Divisor(uint32_t input)
+{
+  /* Input divider is selected by the driver for a 2 MHz reference */
+  const uint32_t pllm = (input + 2000000 - 1) / 2000000;
+  return pllm >= 2 && pllm <= 63 ? pllm : 0;
+}
+/*----------------------------------------------------------------------------*/
+static bool checkLpcGen2(uint32_t input, const struct ClockSolution *solution)
+{
+  /* Same checks as in calcPllFrequency() and calcPllValues() */
+  const uint32_t cco = input * solution->multiplier;
+
+  if (cco < 156000000 || cco > 320000000)
+    return false;
+  if (solution->divisor < 2 || solution->divisor > 16
+      || (solution->divisor & (solution->divisor - 1)))
+  {
+    return false;
+  }
+
+  const unsigned int msel = solution->multiplier / solution->divisor;
+  return msel * solution->divisor == solution->multiplier
+      && msel >= 1 && msel <= 32;
+}
+/*----------------------------------------------------------------------------*/
+static bool checkLpcGen2System(const struct ClockSolverConfig *config,
+    const struct ClockSolution *solution)
+{
+  return checkLpcGen2(config->input, solution)
+      && checkOutputs(config, solution, 0, BIT(CLOCK_SOLVER_CORE));
+}
+/*----------------------------------------------------------------------------*/
+static bool checkLpcGen2Usb(const struct ClockSolverConfig *config,
+    const struct ClockSolution *solution)
+{
+  /* Clock driver accepts only 48 MHz at the PLL output */
+  return checkLpcGen2(config->input, solution)
+      && config->input * solution->multiplier / solution->divisor == 48000000
+      && solution->dividers[CLOCK_SOLVER_USB] == 1
+      && checkOutputs(config, solution, 0, BIT(CLOCK_SOLVER_USB));
+}
+/*----------------------------------------------------------------------------*/
+static bool checkM48x(const struct ClockSolverConfig *config,
+    const struct ClockSolution *solution)
+{
+  /* Same checks as in sysPllEnable() of the clock driver */
+  const uint32_t fco = config->input * solution->multiplier;
+  uint32_t indiv = 1;
+
+  if (fco < 200000000 || fco > 500000000)
+    return false;
+  if (solution->divisor != 1 && solution->divisor != 2
+      && solution->divisor != 4)
+  {
+    return false;
+  }
+
+  while (config->input / indiv >= 8000000)
+    ++indiv;
+  if (indiv > 33 || config->input / indiv < 4000000)
+    return false;
+
+  /* Feedback divider is truncated by the driver, it should be exact */
+  const uint32_t reference = 2 * config->input / indiv;
+  const uint32_t fbdiv = fco / reference;
+
+  if (fbdiv < 2 || fbdiv > 513 || fbdiv * reference != fco)
+    return false;
+
+  return checkOutputs(config, solution, 0, BIT(CLOCK_SOLVER_CORE)
+      | BIT(CLOCK_SOLVER_USB) | BIT(CLOCK_SOLVER_SDIO));
+}
+/*----------------------------------------------------------------------------*/
+static bool checkOutputs(const struct ClockSolverConfig *config,
+    const struct ClockSolution *solution, uint8_t vcoTargets,
+    uint8_t targets)
+{
+  const uint32_t output = solution->vco / solution->divisor;
+
+  if (solution->vco != config->input * solution->multiplier)
+    return false;
+
+  for (size_t target = 0; target < CLOCK_SOLVER_TARGET_COUNT; ++target)
+  {
+    if (!(targets & BIT(target)) || !config->frequencies[target])
+      continue;
+
+    const uint32_t source = (vcoTargets & BIT(target)) ?
+        solution->vco : output;
+    const uint16_t divider = solution->dividers[target];
+
+    if (!divider || solution->frequencies[target] != source / divider)
+      return false;
+
+    /* Core and SDIO clocks must not exceed requested frequencies */
+    if ((target == CLOCK_SOLVER_CORE || target == CLOCK_SOLVER_SDIO)
+        && solution->frequencies[target] > config->frequencies[target])
+    {
+      return false;
+    }
+
+    /* USB clock is requested without a tolerance */
+    if (target == CLOCK_SOLVER_USB
+        && solution->frequencies[target] != config->frequencies[target])
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+/*----------------------------------------------------------------------------*/
+static bool checkStm32F4Audio(const struct ClockSolverConfig *config,
+    const struct ClockSolution *solution)
+{
+  /* Same checks as in audioPllEnable() of the clock driver */
+  const uint32_t pllm = calcStm32F4Divisor(config->input);
+
+  if (!pllm)
+    return false;
+
+  const uint32_t reference = config->input / pllm;
+  const uint32_t plln = solution->vco / reference;
+
+  if (plln < 192 || plln > 432 || plln * reference != solution->vco)
+    return false;
+  if (solution->divisor < 2 || solution->divisor > 7)
+    return false;
+
+  return checkOutputs(config, solution, 0, BIT(CLOCK_SOLVER_AUDIO));
+}
+/*----------------------------------------------------------------------------*/
+static bool checkStm32F4Main(const struct ClockSolverConfig *config,
+    const struct ClockSolution *solution)
+{
+  /* Same checks as in mainPllEnable() of the clock driver */
+  const uint32_t pllm = calcStm32F4Divisor(config->input);
+  const uint32_t pllp = (solution->divisor - 2) >> 1;
+
+  if (!pllm || (pllp << 1) + 2 != solution->divisor || pllp > 3)
+    return false;
+
+  const uint32_t reference = config->input / pllm;
+  const uint32_t plln = solution->vco / reference;
+
+  if (plln < 64 || plln > 432 || plln * reference != solution->vco)
+    return false;
+
+  /* Driver selects PLLQ for the 48 MHz clock on its own */
+  const uint32_t pllq = solution->vco / 48000000;
+
+  if (pllq < 2 || pllq > 15)
+    return false;
+  if (config->frequencies[CLOCK_SOLVER_USB]
+      && solution->dividers[CLOCK_SOLVER_USB] != pllq)
+  {
+    return false;
+  }
+
+  return checkOutputs(config, solution,
+      BIT(CLOCK_SOLVER_USB) | BIT(CLOCK_SOLVER_SDIO),
+      BIT(CLOCK_SOLVER_CORE) | BIT(CLOCK_SOLVER_USB) | BIT(CLOCK_SOLVER_SDIO));
+}
+/*----------------------------------------------------------------------------*/
+static void runSolver(void *argument, size_t iterations)
+{
+  const struct SolverCase * const entry = argument;
+  struct ClockSolution solution;
+
+  while (iterations--)
+  {
+    if (clockSolverFind(entry->model, &entry->config, &solution) != E_OK)
+      abort();
+    sink = solution.error;
+  }
+}
+/*----------------------------------------------------------------------------*/
+static void solveCase(const struct SolverCase *entry)
+{
+  struct ClockSolution solution;
+
+  if (clockSolverFind(entry->model, &entry->config, &solution) != E_OK)
+    abort();
+  if (!entry->check(&entry->config, &solution))
+    abort();
+}
+/*----------------------------------------------------------------------------*/
+void benchClock(void)
+{
+  /* System clock of LPC11Uxx from a 12 MHz crystal */
+  struct SolverCase lpcGen2System = {
+      .model = LpcGen2SystemPllModel,
+      .config = {
+          .input = 12000000,
+          .frequencies = {50000000, 0, 0, 0}
+      },
+      .check = checkLpcGen2System
+  };
+  /* USB clock of LPC11Uxx from a 12 MHz crystal */
+  struct SolverCase lpcGen2Usb = {
+      .model = LpcGen2UsbPllModel,
+      .config = {
+          .input = 12000000,
+          .frequencies = {0, 48000000, 0, 0}
+      },
+      .check = checkLpcGen2Usb
+  };
+  /* Core, USB and SDIO clocks from a 12 MHz crystal */
+  struct SolverCase m48x = {
+      .model = M48xSystemPllModel,
+      .config = {
+          .input = 12000000,
+          .frequencies = {192000000, 48000000, 50000000, 0}
+      },
+      .check = checkM48x
+  };
+  /* Core, USB and SDIO clocks from an 8 MHz crystal */
+  struct SolverCase stm32F4 = {
+      .model = Stm32F4MainPllModel,
+      .config = {
+          .input = 8000000,
+          .frequencies = {168000000, 48000000, 48000000, 0}
+      },
+      .check = checkStm32F4Main
+  };
+  /* I2S clock for 48 kHz sample rate with 256 x Fs master clock */
+  struct SolverCase stm32F4Audio = {
+      .model = Stm32F4AudioPllModel,
+      .config = {
+          .input = 8000000,
+          .frequencies = {0, 0, 0, 49152000}
+      },
+      .check = checkStm32F4Audio
+  };
+
+  solveCase(&lpcGen2System);
+  solveCase(&lpcGen2Usb);
+  solveCase(&m48x);
+  solveCase(&stm32F4);
+  solveCase(&stm32F4Audio);
+
+  /* USB PLL of LPC11Uxx can not produce 48 MHz from a 10 MHz crystal */
+  struct ClockSolution solution;
+
+  lpcGen2Usb.config.input = 10000000;
+  if (clockSolverFind(LpcGen2UsbPllModel, &lpcGen2Usb.config, &solution)
+      != E_ERROR)
+  {
+    abort();
+  }
+
+  benchRun(&(const struct BenchCase){
+      .name = "clock_solver.lpc_gen2",
+      .run = runSolver,
+      .argument = &lpcGen2System,
+      .iterations = 2000
+  });
+  benchRun(&(const struct BenchCase){
+      .name = "clock_solver.m48x",
+      .run = runSolver,
+      .argument = &m48x,
+      .iterations = 2000
+  });
+  benchRun(&(const struct BenchCase){
+      .name = "clock_solver.stm32f4",
+      .run = runSolver,
+      .argument = &stm32F4,
+      .iterations = 2000
+  });
+  benchRun(&(const struct BenchCase){
+      .name = "clock_solver.stm32f4_audio",
+      .run = runSolver,
+      .argument = &stm32F4Audio,
+      .iterations = 2000
+  });
+}
+#else
+/*----------------------------------------------------------------------------*/
+void benchClock(void)
+{
+}
+#endif
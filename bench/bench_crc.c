@@ -0,0 +1,68 @@
+/*
+ * bench_crc.c
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the MIT License
+ */
+
+#include "bench.h"
+#include <xcore/crc/crc7_mmc.h>
+#include <xcore/crc/crc16_ccitt.h>
+/*----------------------------------------------------------------------------*/
+#define BLOCK_SIZE 512
+/*----------------------------------------------------------------------------*/
+static void fillBlock(void);
+static void runCrc7(void *, size_t);
+static void runCrc16(void *, size_t);
+/*----------------------------------------------------------------------------*/
+static uint8_t block[BLOCK_SIZE];
+static volatile uint32_t sink;
+/*----------------------------------------------------------------------------*/
+static void fillBlock(void)
+{
+  /* Deterministic pseudo-random payload */
+  uint32_t state = 0x12345678UL;
+
+  for (size_t index = 0; index < BLOCK_SIZE; ++index)
+  {
+    state = state * 1664525UL + 1013904223UL;
+    block[index] = (uint8_t)(state >> 24);
+  }
+}
+/*----------------------------------------------------------------------------*/
+static void runCrc7(void *, size_t iterations)
+{
+  uint8_t checksum = 0;
+
+  while (iterations--)
+    checksum = crc7MMCUpdate(checksum, block, BLOCK_SIZE);
+
+  sink = checksum;
+}
+/*----------------------------------------------------------------------------*/
+static void runCrc16(void *, size_t iterations)
+{
+  uint16_t checksum = 0;
+
+  while (iterations--)
+    checksum = crc16CCITTUpdate(checksum, block, BLOCK_SIZE);
+
+  sink = checksum;
+}
+/*----------------------------------------------------------------------------*/
+void benchCrc(void)
+{
+  fillBlock();
+
+  benchRun(&(const struct BenchCase){
+      .name = "crc.crc7_mmc",
+      .run = runCrc7,
+      .iterations = 2000,
+      .bytes = BLOCK_SIZE
+  });
+  benchRun(&(const struct BenchCase){
+      .name = "crc.crc16_ccitt",
+      .run = runCrc16,
+      .iterations = 2000,
+      .bytes = BLOCK_SIZE
+  });
+}
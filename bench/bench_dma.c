@@ -0,0 +1,252 @@
+/*
+ * bench_dma.c
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the MIT License
+ */
+
+#include "bench.h"
+
+#ifdef CONFIG_GENERIC_DMA_RING
+#include <halm/generic/dma_ring.h>
+#include <assert.h>
+#include <stdlib.h>
+/*----------------------------------------------------------------------------*/
+#define PERIOD_COUNT  8
+#define PERIOD_SIZE   256
+
+/* Model of a circular channel that completes periods on demand */
+struct ModelDma
+{
+  struct Dma base;
+
+  void (*callback)(void *);
+  void *callbackArgument;
+
+  /* Index of the active period */
+  size_t position;
+  /* Transfer is in progress */
+  bool busy;
+};
+
+struct RingContext
+{
+  struct ModelDma *dma;
+  struct DmaRing ring;
+
+  /* Expected index of the next completed period */
+  size_t expected;
+};
+/*----------------------------------------------------------------------------*/
+static void advance(struct ModelDma *, size_t);
+static void onPeriodCompleted(void *, size_t, enum Result);
+static void runCoalesced(void *, size_t);
+static void runPeriod(void *, size_t);
+static void runRestart(void *, size_t);
+/*----------------------------------------------------------------------------*/
+static enum Result modelInit(void *, const void *);
+static void modelDeinit(void *);
+static void modelConfigure(void *, const void *);
+static void modelSetCallback(void *, void (*)(void *), void *);
+static enum Result modelEnable(void *);
+static void modelDisable(void *);
+static enum Result modelResidue(const void *, size_t *);
+static enum Result modelStatus(const void *);
+static void modelAppend(void *, void *, const void *, size_t);
+static void modelClear(void *);
+static size_t modelQueued(const void *);
+/*----------------------------------------------------------------------------*/
+static const struct DmaClass * const ModelDma = &(const struct DmaClass){
+    .size = sizeof(struct ModelDma),
+    .init = modelInit,
+    .deinit = modelDeinit,
+
+    .configure = modelConfigure,
+    .setCallback = modelSetCallback,
+
+    .enable = modelEnable,
+    .disable = modelDisable,
+    .residue = modelResidue,
+    .status = modelStatus,
+
+    .append = modelAppend,
+    .appendVector = NULL,
+    .clear = modelClear,
+    .queued = modelQueued
+};
+/*----------------------------------------------------------------------------*/
+static void advance(struct ModelDma *dma, size_t count)
+{
+  /* Interrupt is raised once after several completed periods */
+  dma->position = (dma->position + count) % PERIOD_COUNT;
+  dma->callback(dma->callbackArgument);
+}
+/*----------------------------------------------------------------------------*/
+static void onPeriodCompleted(void *argument, size_t index,
+    [[maybe_unused]] enum Result res)
+{
+  struct RingContext * const context = argument;
+
+  assert(res == E_OK);
+  assert(index == context->expected);
+
+  context->expected = (index + 1) % PERIOD_COUNT;
+}
+/*----------------------------------------------------------------------------*/
+static void runCoalesced(void *argument, size_t iterations)
+{
+  struct RingContext * const context = argument;
+
+  while (iterations--)
+    advance(context->dma, 3);
+}
+/*----------------------------------------------------------------------------*/
+static void runPeriod(void *argument, size_t iterations)
+{
+  struct RingContext * const context = argument;
+
+  while (iterations--)
+    advance(context->dma, 1);
+}
+/*----------------------------------------------------------------------------*/
+static void runRestart(void *argument, size_t iterations)
+{
+  struct RingContext * const context = argument;
+
+  while (iterations--)
+  {
+    /* Prebuilt ring is re-armed without appending descriptors */
+    dmaRingStop(&context->ring);
+    context->expected = 0;
+
+    [[maybe_unused]] const enum Result res = dmaRingStart(&context->ring);
+    assert(res == E_OK);
+
+    advance(context->dma, 1);
+  }
+}
+/*----------------------------------------------------------------------------*/
+static enum Result modelInit(void *object, const void *)
+{
+  struct ModelDma * const dma = object;
+
+  dma->callback = NULL;
+  dma->callbackArgument = NULL;
+  dma->position = 0;
+  dma->busy = false;
+
+  return E_OK;
+}
+/*----------------------------------------------------------------------------*/
+static void modelDeinit(void *)
+{
+}
+/*----------------------------------------------------------------------------*/
+static void modelConfigure(void *, const void *)
+{
+}
+/*----------------------------------------------------------------------------*/
+static void modelSetCallback(void *object, void (*callback)(void *),
+    void *argument)
+{
+  struct ModelDma * const dma = object;
+
+  dma->callback = callback;
+  dma->callbackArgument = argument;
+}
+/*----------------------------------------------------------------------------*/
+static enum Result modelEnable(void *object)
+{
+  struct ModelDma * const dma = object;
+
+  dma->position = 0;
+  dma->busy = true;
+  return E_OK;
+}
+/*----------------------------------------------------------------------------*/
+static void modelDisable(void *object)
+{
+  ((struct ModelDma *)object)->busy = false;
+}
+/*----------------------------------------------------------------------------*/
+static enum Result modelResidue(const void *, size_t *count)
+{
+  *count = PERIOD_SIZE;
+  return E_OK;
+}
+/*----------------------------------------------------------------------------*/
+static enum Result modelStatus(const void *object)
+{
+  return ((const struct ModelDma *)object)->busy ? E_BUSY : E_OK;
+}
+/*----------------------------------------------------------------------------*/
+static void modelAppend(void *, void *, const void *, size_t)
+{
+}
+/*----------------------------------------------------------------------------*/
+static void modelClear(void *)
+{
+}
+/*----------------------------------------------------------------------------*/
+static size_t modelQueued(const void *object)
+{
+  const struct ModelDma * const dma = object;
+  return dma->busy ? PERIOD_COUNT - dma->position : 0;
+}
+/*----------------------------------------------------------------------------*/
+void benchDma(void)
+{
+  struct RingContext context = {
+      .dma = init(ModelDma, NULL),
+      .expected = 0
+  };
+
+  if (context.dma == NULL)
+    abort();
+
+  /* Ring with a period count that differs from the channel is rejected */
+  dmaRingInit(&context.ring, context.dma, PERIOD_COUNT / 2);
+
+  if (dmaRingStart(&context.ring) != E_VALUE)
+    abort();
+
+  dmaRingInit(&context.ring, context.dma, PERIOD_COUNT);
+  dmaRingSetCallback(&context.ring, onPeriodCompleted, &context);
+
+  if (dmaRingStart(&context.ring) != E_OK)
+    abort();
+
+  benchRun(&(const struct BenchCase){
+      .name = "dma_ring.period",
+      .run = runPeriod,
+      .argument = &context,
+      .iterations = 1000000,
+      .bytes = PERIOD_SIZE
+  });
+  benchRun(&(const struct BenchCase){
+      .name = "dma_ring.coalesced",
+      .run = runCoalesced,
+      .argument = &context,
+      .iterations = 1000000,
+      .bytes = PERIOD_SIZE * 3
+  });
+  benchRun(&(const struct BenchCase){
+      .name = "dma_ring.restart",
+      .run = runRestart,
+      .argument = &context,
+      .iterations = 1000000,
+      .bytes = PERIOD_SIZE
+  });
+
+  /* Periods are never lost in these cases */
+  if (context.ring.overruns)
+    abort();
+
+  dmaRingStop(&context.ring);
+  deinit(context.dma);
+}
+#else
+/*----------------------------------------------------------------------------*/
+void benchDma(void)
+{
+}
+#endif
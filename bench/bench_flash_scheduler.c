@@ -0,0 +1,593 @@
+/*
+ * bench_flash_scheduler.c
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the MIT License
+ */
+
+#include "bench.h"
+
+#if defined(CONFIG_GENERIC_FLASH_SCHEDULER) && defined(CONFIG_GENERIC_WQ) \
+    && !defined(CONFIG_GENERIC_WQ_NONSTOP)
+#include <halm/generic/flash_scheduler.h>
+#include <halm/generic/work_queue.h>
+#include <halm/timer.h>
+#include <halm/wq.h>
+#include <stdlib.h>
+#include <string.h>
+/*----------------------------------------------------------------------------*/
+#define MODEL_CAPACITY    65536
+#define MODEL_SECTOR_SIZE 4096
+
+/* Number of queued sector erases in each iteration */
+#define ERASE_COUNT       4
+/* Duration of a sector erase in ticks of the model */
+#define ERASE_TICKS       64
+/* Sector with data that is read while erases are in progress */
+#define DATA_SECTOR       8
+/* Period of the status poller in ticks of the model */
+#define POLL_TICKS        8
+/* Period of reads from the data sector in ticks of the model */
+#define READ_TICKS        16
+#define READ_SIZE         256
+/* Sector that is programmed by sequential writes */
+#define WRITE_SECTOR      12
+/* Number of chunks in sequential transfers */
+#define CHUNK_COUNT       8
+
+/*
+ * Flash memory model with a sector erase time measured in ticks. Time of
+ * the model advances on each pass of the work queue and on each status
+ * query, the memory array is not accessible while an erase is in progress.
+ */
+struct FlashModel
+{
+  struct Interface base;
+
+  uint8_t memory[MODEL_CAPACITY];
+
+  /* Current position */
+  uint32_t position;
+  /* Address of the active erase */
+  uint32_t address;
+  /* Remaining ticks of the active erase, zero when the memory is idle */
+  uint32_t left;
+
+  /* Number of status queries */
+  size_t queries;
+  /* Number of erase suspends */
+  size_t suspends;
+
+  /* Erase operations are started without waiting for completion */
+  bool async;
+  /* Active erase operation is suspended */
+  bool suspended;
+};
+
+/* Periodic timer with events generated by the clock of the model */
+struct PollTimer
+{
+  struct Timer base;
+
+  void (*callback)(void *);
+  void *callbackArgument;
+  bool enabled;
+};
+
+struct SchedulerContext
+{
+  struct FlashModel *flash;
+  struct PollTimer *poller;
+  void *scheduler;
+  void *wq;
+
+  /* Ticks of the model since the beginning of the iteration */
+  uint32_t time;
+  /* Number of poller events */
+  size_t events;
+  /* Number of reads from the data sector */
+  size_t reads;
+};
+/*----------------------------------------------------------------------------*/
+static void checkErased(const struct FlashModel *, uint32_t);
+static void clockTask(void *);
+static void fillSector(struct FlashModel *, uint32_t, uint8_t);
+static void modelTick(struct FlashModel *);
+static void readData(struct SchedulerContext *);
+static void runErase(void *, size_t);
+static void runEraseCase(const char *, bool);
+static void runSequential(void *, size_t);
+
+static enum Result modelInit(void *, const void *);
+static enum Result modelGetParam(void *, int, void *);
+static enum Result modelSetParam(void *, int, const void *);
+static size_t modelRead(void *, void *, size_t);
+static size_t modelWrite(void *, const void *, size_t);
+
+static enum Result pollerInit(void *, const void *);
+static void pollerEnable(void *);
+static void pollerDisable(void *);
+static void pollerSetCallback(void *, void (*)(void *), void *);
+/*----------------------------------------------------------------------------*/
+static const struct InterfaceClass * const FlashModel =
+    &(const struct InterfaceClass){
+    .size = sizeof(struct FlashModel),
+    .init = modelInit,
+    .deinit = NULL,
+
+    .setCallback = NULL,
+    .getParam = modelGetParam,
+    .setParam = modelSetParam,
+    .read = modelRead,
+    .write = modelWrite
+};
+
+static const struct TimerClass * const PollTimer =
+    &(const struct TimerClass){
+    .size = sizeof(struct PollTimer),
+    .init = pollerInit,
+    .deinit = NULL,
+
+    .enable = pollerEnable,
+    .disable = pollerDisable,
+    .setAutostop = NULL,
+    .setCallback = pollerSetCallback,
+    .getFrequency = NULL,
+    .setFrequency = NULL,
+    .getOverflow = NULL,
+    .setOverflow = NULL,
+    .getValue = NULL,
+    .setValue = NULL
+};
+/*----------------------------------------------------------------------------*/
+static void checkErased(const struct FlashModel *model, uint32_t address)
+{
+  for (size_t offset = 0; offset < MODEL_SECTOR_SIZE; ++offset)
+  {
+    if (model->memory[address + offset] != 0xFF)
+      abort();
+  }
+}
+/*----------------------------------------------------------------------------*/
+static void clockTask(void *argument)
+{
+  struct SchedulerContext * const context = argument;
+  size_t pending;
+
+  modelTick(context->flash);
+  ++context->time;
+
+  if (context->poller != NULL && context->poller->enabled
+      && !(context->time % POLL_TICKS))
+  {
+    ++context->events;
+    context->poller->callback(context->poller->callbackArgument);
+  }
+
+  /* Reads have priority over queued erases */
+  if (!(context->time % READ_TICKS))
+    readData(context);
+
+  if (ifGetParam(context->scheduler, IF_FLASH_SCHEDULER_PENDING, &pending)
+      != E_OK)
+  {
+    abort();
+  }
+
+  if (pending)
+  {
+    /* All erases should be finished in time with a reasonable margin */
+    if (context->time > ERASE_COUNT * ERASE_TICKS * 2)
+      abort();
+
+    if (wqAdd(context->wq, clockTask, context) != E_OK)
+      abort();
+  }
+  else
+    wqStop(context->wq);
+}
+/*----------------------------------------------------------------------------*/
+static void fillSector(struct FlashModel *model, uint32_t address,
+    uint8_t seed)
+{
+  for (size_t offset = 0; offset < MODEL_SECTOR_SIZE; ++offset)
+    model->memory[address + offset] = (uint8_t)(seed + offset);
+}
+/*----------------------------------------------------------------------------*/
+static void modelTick(struct FlashModel *model)
+{
+  if (model->left && !model->suspended && !--model->left)
+    memset(model->memory + model->address, 0xFF, MODEL_SECTOR_SIZE);
+}
+/*----------------------------------------------------------------------------*/
+static void readData(struct SchedulerContext *context)
+{
+  static const uint32_t position = DATA_SECTOR * MODEL_SECTOR_SIZE;
+  uint8_t buffer[READ_SIZE];
+
+  if (ifSetParam(context->scheduler, IF_POSITION, &position) != E_OK)
+    abort();
+  if (ifRead(context->scheduler, buffer, sizeof(buffer)) != sizeof(buffer))
+    abort();
+
+  for (size_t offset = 0; offset < sizeof(buffer); ++offset)
+  {
+    if (buffer[offset] != (uint8_t)(DATA_SECTOR + offset))
+      abort();
+  }
+
+  ++context->reads;
+}
+/*----------------------------------------------------------------------------*/
+static void runErase(void *argument, size_t iterations)
+{
+  struct SchedulerContext * const context = argument;
+  struct FlashModel * const model = context->flash;
+  const uint32_t origin = 0;
+  uint8_t buffer[READ_SIZE];
+
+  while (iterations--)
+  {
+    context->time = 0;
+    context->events = 0;
+    context->reads = 0;
+    model->queries = 0;
+    model->suspends = 0;
+
+    for (uint32_t index = 0; index < ERASE_COUNT; ++index)
+    {
+      const uint32_t address = index * MODEL_SECTOR_SIZE;
+
+      fillSector(model, address, (uint8_t)index);
+      if (ifSetParam(context->scheduler, IF_FLASH_ERASE_SECTOR, &address)
+          != E_OK)
+      {
+        abort();
+      }
+    }
+
+    /* Time of the model is advanced by a regular task of the same queue */
+    if (wqAdd(context->wq, clockTask, context) != E_OK)
+      abort();
+    wqStart(context->wq);
+
+    for (uint32_t index = 0; index < ERASE_COUNT; ++index)
+      checkErased(model, index * MODEL_SECTOR_SIZE);
+    if (ifGetParam(context->scheduler, IF_STATUS, NULL) != E_OK)
+      abort();
+
+    /*
+     * Status is queried once per service pass, each pass is caused
+     * by an event of the poller, by a read or by a completed request.
+     * Work queue should not be occupied by status polling.
+     */
+    if (model->queries > context->events + context->reads + ERASE_COUNT)
+      abort();
+
+    /* Background erases are suspended by reads from the data sector */
+    if (model->async != (context->poller != NULL))
+      abort();
+    if (model->async && !model->suspends)
+      abort();
+
+    /* Read of a region with a queued erase waits for that erase */
+    fillSector(model, origin, 0);
+    if (ifSetParam(context->scheduler, IF_FLASH_ERASE_SECTOR, &origin)
+        != E_OK)
+    {
+      abort();
+    }
+    if (ifSetParam(context->scheduler, IF_POSITION, &origin) != E_OK)
+      abort();
+    if (ifRead(context->scheduler, buffer, sizeof(buffer)) != sizeof(buffer))
+      abort();
+
+    for (size_t offset = 0; offset < sizeof(buffer); ++offset)
+    {
+      if (buffer[offset] != 0xFF)
+        abort();
+    }
+    if (ifGetParam(context->scheduler, IF_STATUS, NULL) != E_OK)
+      abort();
+  }
+}
+/*----------------------------------------------------------------------------*/
+static void runEraseCase(const char *name, bool polled)
+{
+  struct SchedulerContext context = {
+      .flash = init(FlashModel, NULL),
+      .poller = polled ? init(PollTimer, NULL) : NULL,
+      .wq = init(WorkQueue, &(struct WorkQueueConfig){.size = 4})
+  };
+
+  if (context.flash == NULL || context.wq == NULL)
+    abort();
+  if (polled && context.poller == NULL)
+    abort();
+
+  context.scheduler = init(FlashScheduler, &(struct FlashSchedulerConfig){
+      .flash = context.flash,
+      .wq = context.wq,
+      .requests = ERASE_COUNT,
+      .poller = context.poller
+  });
+  if (context.scheduler == NULL)
+    abort();
+
+  fillSector(context.flash, DATA_SECTOR * MODEL_SECTOR_SIZE, DATA_SECTOR);
+
+  benchRun(&(const struct BenchCase){
+      .name = name,
+      .run = runErase,
+      .argument = &context,
+      .iterations = 1000
+  });
+
+  /* Sequential transfers do not depend on the erase mode */
+  if (polled)
+  {
+    benchRun(&(const struct BenchCase){
+        .name = "flash_scheduler.sequential",
+        .run = runSequential,
+        .argument = &context,
+        .iterations = 1000,
+        .bytes = MODEL_SECTOR_SIZE * 2
+    });
+  }
+
+  deinit(context.scheduler);
+  deinit(context.wq);
+  if (context.poller != NULL)
+    deinit(context.poller);
+  deinit(context.flash);
+}
+/*----------------------------------------------------------------------------*/
+static void runSequential(void *argument, size_t iterations)
+{
+  static const uint32_t origin = WRITE_SECTOR * MODEL_SECTOR_SIZE;
+  static const size_t chunk = MODEL_SECTOR_SIZE / CHUNK_COUNT;
+
+  struct SchedulerContext * const context = argument;
+  struct FlashModel * const model = context->flash;
+  uint8_t buffer[MODEL_SECTOR_SIZE / CHUNK_COUNT];
+  uint32_t position;
+
+  while (iterations--)
+  {
+    memset(model->memory + origin, 0xFF, MODEL_SECTOR_SIZE);
+
+    /* Position is set once, each transfer should continue the previous one */
+    if (ifSetParam(context->scheduler, IF_POSITION, &origin) != E_OK)
+      abort();
+
+    for (size_t index = 0; index < CHUNK_COUNT; ++index)
+    {
+      memset(buffer, (int)(index + 1), chunk);
+      if (ifWrite(context->scheduler, buffer, chunk) != chunk)
+        abort();
+    }
+
+    if (ifGetParam(context->scheduler, IF_POSITION, &position) != E_OK)
+      abort();
+    if (position != origin + MODEL_SECTOR_SIZE)
+      abort();
+
+    if (ifSetParam(context->scheduler, IF_POSITION, &origin) != E_OK)
+      abort();
+
+    for (size_t index = 0; index < CHUNK_COUNT; ++index)
+    {
+      if (ifRead(context->scheduler, buffer, chunk) != chunk)
+        abort();
+
+      for (size_t offset = 0; offset < chunk; ++offset)
+      {
+        if (buffer[offset] != (uint8_t)(index + 1))
+          abort();
+      }
+    }
+  }
+}
+/*----------------------------------------------------------------------------*/
+static enum Result modelInit(void *object, const void *)
+{
+  struct FlashModel * const model = object;
+
+  memset(model->memory, 0xFF, sizeof(model->memory));
+  model->position = 0;
+  model->address = 0;
+  model->left = 0;
+  model->queries = 0;
+  model->suspends = 0;
+  model->async = false;
+  model->suspended = false;
+  return E_OK;
+}
+/*----------------------------------------------------------------------------*/
+static enum Result modelGetParam(void *object, int parameter, void *data)
+{
+  struct FlashModel * const model = object;
+
+  switch ((enum FlashParameter)parameter)
+  {
+    case IF_FLASH_SECTOR_SIZE:
+      *(uint32_t *)data = MODEL_SECTOR_SIZE;
+      return E_OK;
+
+    default:
+      break;
+  }
+
+  switch ((enum IfParameter)parameter)
+  {
+    case IF_POSITION:
+      *(uint32_t *)data = model->position;
+      return E_OK;
+
+    case IF_SIZE:
+      *(uint32_t *)data = MODEL_CAPACITY;
+      return E_OK;
+
+    case IF_STATUS:
+      /* Each query occupies the memory bus for one tick */
+      ++model->queries;
+      modelTick(model);
+      return model->left && !model->suspended ? E_BUSY : E_OK;
+
+    default:
+      return E_INVALID;
+  }
+}
+/*----------------------------------------------------------------------------*/
+static enum Result modelSetParam(void *object, int parameter,
+    const void *data)
+{
+  struct FlashModel * const model = object;
+
+  switch ((enum FlashParameter)parameter)
+  {
+    case IF_FLASH_ERASE_SECTOR:
+    {
+      const uint32_t address = *(const uint32_t *)data;
+
+      if (address >= MODEL_CAPACITY || address % MODEL_SECTOR_SIZE)
+        return E_ADDRESS;
+      if (model->left)
+        return E_BUSY;
+
+      if (model->async)
+      {
+        model->address = address;
+        model->left = ERASE_TICKS;
+      }
+      else
+        memset(model->memory + address, 0xFF, MODEL_SECTOR_SIZE);
+
+      return E_OK;
+    }
+
+    case IF_FLASH_ERASE_SUSPEND:
+      if (!model->left || model->suspended)
+        return E_ERROR;
+
+      model->suspended = true;
+      ++model->suspends;
+      return E_OK;
+
+    case IF_FLASH_ERASE_RESUME:
+      model->suspended = false;
+      return E_OK;
+
+    default:
+      break;
+  }
+
+  switch ((enum IfParameter)parameter)
+  {
+    case IF_POSITION:
+    {
+      const uint32_t position = *(const uint32_t *)data;
+
+      if (position >= MODEL_CAPACITY)
+        return E_ADDRESS;
+
+      model->position = position;
+      return E_OK;
+    }
+
+    case IF_BLOCKING:
+      model->async = false;
+      return E_OK;
+
+    case IF_ZEROCOPY:
+      model->async = true;
+      return E_OK;
+
+    default:
+      return E_INVALID;
+  }
+}
+/*----------------------------------------------------------------------------*/
+static size_t modelRead(void *object, void *buffer, size_t length)
+{
+  struct FlashModel * const model = object;
+
+  /* Memory array is accessible only when the erase is suspended */
+  if (model->left)
+  {
+    if (!model->suspended)
+      abort();
+    if (model->position < model->address + MODEL_SECTOR_SIZE
+        && model->address < model->position + length)
+    {
+      abort();
+    }
+  }
+
+  if (length > MODEL_CAPACITY - model->position)
+    length = MODEL_CAPACITY - model->position;
+
+  memcpy(buffer, model->memory + model->position, length);
+  model->position += length;
+  return length;
+}
+/*----------------------------------------------------------------------------*/
+static size_t modelWrite(void *object, const void *buffer, size_t length)
+{
+  struct FlashModel * const model = object;
+  const uint8_t * const input = buffer;
+
+  /* Memory array is not accessible while the erase is in progress */
+  if (model->left)
+    abort();
+
+  if (length > MODEL_CAPACITY - model->position)
+    length = MODEL_CAPACITY - model->position;
+
+  /* Programming clears bits of the erased memory */
+  for (size_t offset = 0; offset < length; ++offset)
+    model->memory[model->position + offset] &= input[offset];
+
+  model->position += length;
+  return length;
+}
+/*----------------------------------------------------------------------------*/
+static enum Result pollerInit(void *object, const void *)
+{
+  struct PollTimer * const timer = object;
+
+  timer->callback = NULL;
+  timer->callbackArgument = NULL;
+  timer->enabled = false;
+  return E_OK;
+}
+/*----------------------------------------------------------------------------*/
+static void pollerEnable(void *object)
+{
+  ((struct PollTimer *)object)->enabled = true;
+}
+/*----------------------------------------------------------------------------*/
+static void pollerDisable(void *object)
+{
+  ((struct PollTimer *)object)->enabled = false;
+}
+/*----------------------------------------------------------------------------*/
+static void pollerSetCallback(void *object, void (*callback)(void *),
+    void *argument)
+{
+  struct PollTimer * const timer = object;
+
+  timer->callbackArgument = argument;
+  timer->callback = callback;
+}
+#endif
+/*----------------------------------------------------------------------------*/
+void benchFlashScheduler(void)
+{
+#if defined(CONFIG_GENERIC_FLASH_SCHEDULER) && defined(CONFIG_GENERIC_WQ) \
+    && !defined(CONFIG_GENERIC_WQ_NONSTOP)
+  /* Erase status is polled by the timer, reads suspend background erases */
+  runEraseCase("flash_scheduler.erase_polled", true);
+  /* Erases are executed in blocking mode by the work queue */
+  runEraseCase("flash_scheduler.erase_blocking", false);
+#endif
+}
@@ -0,0 +1,330 @@
+/*
+ * bench_governor.c
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the MIT License
+ */
+
+#include "bench.h"
+
+#ifdef CONFIG_GENERIC_FREQUENCY_GOVERNOR
+#include <halm/generic/frequency_governor.h>
+#include <halm/timer.h>
+#include <stdlib.h>
+
+#if defined(CONFIG_GENERIC_WQ) && !defined(CONFIG_GENERIC_WQ_NONSTOP)
+#  include <halm/generic/work_queue.h>
+#endif
+/*----------------------------------------------------------------------------*/
+/* Idle loops during a sampling interval at the highest operating point */
+#define CALIBRATION 1000
+#define POINT_COUNT 4
+
+/* Work queue model that holds a single task and reports idle loops */
+struct SampleQueue
+{
+  struct WorkQueue base;
+
+  void (*callback)(void *);
+  void *argument;
+
+  /* Idle loops reported by the next statistics call */
+  WqCounter loops;
+  /* Queue rejects new tasks */
+  bool full;
+};
+
+/* Sampling timer with events generated by the benchmark */
+struct SampleTimer
+{
+  struct Timer base;
+
+  void (*callback)(void *);
+  void *callbackArgument;
+};
+
+struct GovernorContext
+{
+  struct SampleQueue *wq;
+  struct SampleTimer *timer;
+  void *governor;
+};
+/*----------------------------------------------------------------------------*/
+static enum Result applyPoint(void *, size_t);
+static void checkLoadSupport(struct SampleTimer *);
+static void runOnDemand(void *, size_t);
+static void sample(struct GovernorContext *, WqCounter, size_t);
+static void sampleOverload(struct GovernorContext *, size_t);
+
+static enum Result queueInit(void *, const void *);
+static enum Result queueAdd(void *, void (*)(void *), void *);
+static void queueStatistics(void *, struct WqInfo *);
+
+static enum Result timerInit(void *, const void *);
+static void timerEnableStub(void *);
+static void timerDisableStub(void *);
+static void timerSetCallbackStub(void *, void (*)(void *), void *);
+/*----------------------------------------------------------------------------*/
+static const struct WorkQueueClass * const SampleQueue =
+    &(const struct WorkQueueClass){
+    .size = sizeof(struct SampleQueue),
+    .init = queueInit,
+    .deinit = NULL,
+
+    .add = queueAdd,
+    .profile = NULL,
+    .statistics = queueStatistics,
+    .start = NULL,
+    .stop = NULL,
+
+    .schedule = NULL,
+    .cancel = NULL
+};
+
+static const struct TimerClass * const SampleTimer =
+    &(const struct TimerClass){
+    .size = sizeof(struct SampleTimer),
+    .init = timerInit,
+    .deinit = NULL,
+
+    .enable = timerEnableStub,
+    .disable = timerDisableStub,
+    .setAutostop = NULL,
+    .setCallback = timerSetCallbackStub,
+    .getFrequency = NULL,
+    .setFrequency = NULL,
+    .getOverflow = NULL,
+    .setOverflow = NULL,
+    .getValue = NULL,
+    .setValue = NULL
+};
+
+static const uint32_t points[POINT_COUNT] = {
+    12000000, 24000000, 48000000, 96000000
+};
+static size_t applied;
+/*----------------------------------------------------------------------------*/
+static enum Result applyPoint(void *, size_t index)
+{
+  if (index >= POINT_COUNT)
+    abort();
+
+  applied = index;
+  return E_OK;
+}
+/*----------------------------------------------------------------------------*/
+static void checkLoadSupport([[maybe_unused]] struct SampleTimer *timer)
+{
+#if defined(CONFIG_GENERIC_WQ) && !defined(CONFIG_GENERIC_WQ_NONSTOP)
+  struct WorkQueue * const wq = init(WorkQueue,
+      &(struct WorkQueueConfig){.size = 4});
+
+  if (wq == NULL)
+    abort();
+
+  void * const governor = init(FrequencyGovernor,
+      &(struct FrequencyGovernorConfig){
+          .wq = wq,
+          .timer = timer,
+          .points = points,
+          .count = POINT_COUNT,
+          .apply = applyPoint,
+          .calibration = CALIBRATION,
+          .policy = GOVERNOR_PERFORMANCE
+      });
+
+  if (governor == NULL)
+    abort();
+
+  /* Idle loops are counted only when load measurement is built in */
+#  ifdef CONFIG_GENERIC_WQ_LOAD
+  const enum Result expected = E_OK;
+#  else
+  const enum Result expected = E_INVALID;
+#  endif
+
+  if (frequencyGovernorSetPolicy(governor, GOVERNOR_ONDEMAND) != expected)
+    abort();
+
+  deinit(governor);
+  deinit(wq);
+#endif
+}
+/*----------------------------------------------------------------------------*/
+static void runOnDemand(void *argument, size_t iterations)
+{
+  struct GovernorContext * const context = argument;
+
+  while (iterations--)
+  {
+    /* Idle queue steps down one operating point per sample */
+    for (size_t index = POINT_COUNT - 1; index > 0; --index)
+      sample(context, CALIBRATION, index - 1);
+    sample(context, CALIBRATION, 0);
+
+    /* Load between thresholds keeps the current point */
+    sample(context, CALIBRATION / (points[POINT_COUNT - 1] / points[0]) / 2,
+        0);
+
+    /* Fully loaded queue selects the highest point immediately */
+    sample(context, 0, POINT_COUNT - 1);
+    sample(context, CALIBRATION / 2, POINT_COUNT - 1);
+
+    sample(context, CALIBRATION, POINT_COUNT - 2);
+
+    /* Sampling task that could not be posted means an overload */
+    sampleOverload(context, POINT_COUNT - 1);
+  }
+}
+/*----------------------------------------------------------------------------*/
+static void sample(struct GovernorContext *context, WqCounter loops,
+    size_t expected)
+{
+  struct SampleQueue * const wq = context->wq;
+
+  wq->loops = loops;
+  context->timer->callback(context->timer->callbackArgument);
+
+  if (wq->callback == NULL)
+    abort();
+
+  void (* const callback)(void *) = wq->callback;
+
+  wq->callback = NULL;
+  callback(wq->argument);
+
+  if (frequencyGovernorGetPoint(context->governor) != expected)
+    abort();
+  if (applied != expected)
+    abort();
+}
+/*----------------------------------------------------------------------------*/
+static void sampleOverload(struct GovernorContext *context, size_t expected)
+{
+  struct SampleQueue * const wq = context->wq;
+
+  wq->full = true;
+  context->timer->callback(context->timer->callbackArgument);
+  wq->full = false;
+
+  /* Next sample is idle but the overload flag has priority */
+  sample(context, CALIBRATION, expected);
+}
+/*----------------------------------------------------------------------------*/
+static enum Result queueInit(void *object, const void *)
+{
+  struct SampleQueue * const wq = object;
+
+  wq->callback = NULL;
+  wq->argument = NULL;
+  wq->loops = 0;
+  wq->full = false;
+  return E_OK;
+}
+/*----------------------------------------------------------------------------*/
+static enum Result queueAdd(void *object, void (*callback)(void *),
+    void *argument)
+{
+  struct SampleQueue * const wq = object;
+
+  if (wq->full || wq->callback != NULL)
+    return E_FULL;
+
+  wq->callback = callback;
+  wq->argument = argument;
+  return E_OK;
+}
+/*----------------------------------------------------------------------------*/
+static void queueStatistics(void *object, struct WqInfo *statistics)
+{
+  const struct SampleQueue * const wq = object;
+
+  statistics->watermark = 0;
+  statistics->loops = wq->loops;
+  statistics->uptime = 0;
+  statistics->latency.max = 0;
+  statistics->latency.min = 0;
+}
+/*----------------------------------------------------------------------------*/
+static enum Result timerInit(void *object, const void *)
+{
+  struct SampleTimer * const timer = object;
+
+  timer->callback = NULL;
+  timer->callbackArgument = NULL;
+  return E_OK;
+}
+/*----------------------------------------------------------------------------*/
+static void timerEnableStub(void *)
+{
+}
+/*----------------------------------------------------------------------------*/
+static void timerDisableStub(void *)
+{
+}
+/*----------------------------------------------------------------------------*/
+static void timerSetCallbackStub(void *object, void (*callback)(void *),
+    void *argument)
+{
+  struct SampleTimer * const timer = object;
+
+  timer->callbackArgument = argument;
+  timer->callback = callback;
+}
+#endif
+/*----------------------------------------------------------------------------*/
+void benchGovernor(void)
+{
+#ifdef CONFIG_GENERIC_FREQUENCY_GOVERNOR
+  struct GovernorContext context = {
+      .wq = init(SampleQueue, NULL),
+      .timer = init(SampleTimer, NULL)
+  };
+
+  if (context.wq == NULL || context.timer == NULL)
+    abort();
+
+  checkLoadSupport(context.timer);
+
+  context.governor = init(FrequencyGovernor,
+      &(struct FrequencyGovernorConfig){
+          .wq = context.wq,
+          .timer = context.timer,
+          .points = points,
+          .count = POINT_COUNT,
+          .apply = applyPoint,
+          .calibration = CALIBRATION,
+          .policy = GOVERNOR_ONDEMAND
+      });
+
+  if (context.governor == NULL)
+    abort();
+
+  /* Latency-bound policy requires the latency limit */
+  if (frequencyGovernorSetPolicy(context.governor, GOVERNOR_LATENCY)
+      != E_INVALID)
+  {
+    abort();
+  }
+
+  benchRun(&(const struct BenchCase){
+      .name = "governor.ondemand",
+      .run = runOnDemand,
+      .argument = &context,
+      .iterations = 100000
+  });
+
+  /* Performance policy switches to the highest point immediately */
+  sample(&context, CALIBRATION, POINT_COUNT - 2);
+  if (frequencyGovernorSetPolicy(context.governor, GOVERNOR_PERFORMANCE)
+      != E_OK)
+  {
+    abort();
+  }
+  if (applied != POINT_COUNT - 1)
+    abort();
+
+  deinit(context.governor);
+  deinit(context.timer);
+  deinit(context.wq);
+#endif
+}
@@ -0,0 +1,525 @@
+/*
+ * bench_idle.c
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the MIT License
+ */
+
+#include "bench.h"
+
+#if defined(CONFIG_GENERIC_IDLE_COORDINATOR) \
+    && defined(CONFIG_GENERIC_TIMER_FACTORY)
+#include <halm/generic/idle_coordinator.h>
+#include <halm/generic/timer_factory.h>
+#include <stdlib.h>
+
+#if defined(CONFIG_GENERIC_WQ_IDLE) && !defined(CONFIG_GENERIC_WQ_NONSTOP)
+#  include <halm/generic/work_queue.h>
+#  include <halm/wq.h>
+#  define BENCH_WQ_IDLE
+#endif
+/*----------------------------------------------------------------------------*/
+/* Base timers and the clock use one-microsecond ticks */
+#define BASE_FREQUENCY    1000000
+/* Period of the base timer of the periodic factory */
+#define PERIODIC_OVERFLOW 1000
+/* Counter range of the base timer of the tickless factory */
+#define TICKLESS_RANGE    65536
+/* Period of the software timer of the tickless factory */
+#define TIMER_PERIOD      1000
+
+/* Latency and residency of the deep state in microseconds */
+#define DEEP_LATENCY      50
+#define DEEP_RESIDENCY    200
+
+enum
+{
+  STATE_SLEEP,
+  STATE_DEEP
+};
+
+/* Compare-match timer with a counter controlled by the benchmark */
+struct CompareTimer
+{
+  struct Timer base;
+
+  void (*callback)(void *);
+  void *callbackArgument;
+
+  /* Match or overflow value */
+  uint32_t overflow;
+  /* Counter value */
+  uint32_t value;
+};
+
+/* Free-running clock that advances by a fixed step on each read */
+struct StepClock
+{
+  struct Timer base;
+
+  /* Function called on each read to emulate a wake-up interrupt */
+  void (*callback)(void *);
+  void *callbackArgument;
+
+  uint32_t step;
+  uint32_t value;
+};
+
+struct IdleContext
+{
+  struct CompareTimer *base;
+  struct StepClock *clock;
+  void *coordinator;
+  void *factory;
+  void *timer;
+};
+/*----------------------------------------------------------------------------*/
+static void checkInfo(const void *, size_t, uint32_t, uint32_t);
+static void checkPeriodic(void);
+static void checkTickless(struct IdleContext *);
+static void enterAt(struct IdleContext *, uint32_t, size_t);
+static void onTimerEvent(void *);
+static void runEnter(void *, size_t);
+
+#ifdef BENCH_WQ_IDLE
+static void checkWorkQueue(struct IdleContext *);
+static void stopTask(void *);
+static void wakeQueue(void *);
+#endif
+
+static enum Result compareInit(void *, const void *);
+static void compareEnable(void *);
+static void compareDisable(void *);
+static void compareSetCallback(void *, void (*)(void *), void *);
+static uint32_t compareGetFrequency(const void *);
+static uint32_t compareGetOverflow(const void *);
+static void compareSetOverflow(void *, uint32_t);
+static uint32_t compareGetValue(const void *);
+static void compareSetValue(void *, uint32_t);
+
+static enum Result clockInit(void *, const void *);
+static uint32_t clockGetFrequency(const void *);
+static uint32_t clockGetOverflow(const void *);
+static uint32_t clockGetValue(const void *);
+/*----------------------------------------------------------------------------*/
+static const struct TimerClass * const CompareTimer =
+    &(const struct TimerClass){
+    .size = sizeof(struct CompareTimer),
+    .init = compareInit,
+    .deinit = NULL,
+
+    .enable = compareEnable,
+    .disable = compareDisable,
+    .setAutostop = NULL,
+    .setCallback = compareSetCallback,
+    .getFrequency = compareGetFrequency,
+    .setFrequency = NULL,
+    .getOverflow = compareGetOverflow,
+    .setOverflow = compareSetOverflow,
+    .getValue = compareGetValue,
+    .setValue = compareSetValue
+};
+
+static const struct TimerClass * const StepClock =
+    &(const struct TimerClass){
+    .size = sizeof(struct StepClock),
+    .init = clockInit,
+    .deinit = NULL,
+
+    .enable = NULL,
+    .disable = NULL,
+    .setAutostop = NULL,
+    .setCallback = NULL,
+    .getFrequency = clockGetFrequency,
+    .setFrequency = NULL,
+    .getOverflow = clockGetOverflow,
+    .setOverflow = NULL,
+    .getValue = clockGetValue,
+    .setValue = NULL
+};
+
+static const struct IdleState states[] = {
+    [STATE_SLEEP] = {PM_SLEEP, 0, 10},
+    [STATE_DEEP] = {PM_SUSPEND, DEEP_LATENCY, DEEP_RESIDENCY}
+};
+/*----------------------------------------------------------------------------*/
+static void checkInfo(const void *coordinator, size_t index, uint32_t entries,
+    uint32_t misses)
+{
+  struct IdleInfo info;
+
+  if (idleCoordinatorGetInfo(coordinator, index, &info) != E_OK)
+    abort();
+  if (info.entries != entries || info.misses != misses)
+    abort();
+}
+/*----------------------------------------------------------------------------*/
+static void checkPeriodic(void)
+{
+  struct CompareTimer * const base = init(CompareTimer,
+      &(uint32_t){PERIODIC_OVERFLOW});
+
+  if (base == NULL)
+    abort();
+
+  void * const factory = init(TimerFactory,
+      &(struct TimerFactoryConfig){&base->base});
+
+  if (factory == NULL)
+    abort();
+  timerEnable(factory);
+
+  /* Deadline is the next tick of the base timer */
+  base->value = 400;
+  if (timerFactoryGetDeadline(factory) != PERIODIC_OVERFLOW - 400)
+    abort();
+
+  /* Period of the base timer could not be changed */
+  if (timerFactorySetWakeup(factory, 0) != E_OK)
+    abort();
+  if (timerFactorySetWakeup(factory, DEEP_LATENCY) != E_INVALID)
+    abort();
+
+  void * const coordinator = init(IdleCoordinator,
+      &(struct IdleCoordinatorConfig){
+          .states = states,
+          .count = ARRAY_SIZE(states),
+          .capacity = 1
+      });
+
+  if (coordinator == NULL)
+    abort();
+  if (idleCoordinatorRegister(coordinator, factory) != E_OK)
+    abort();
+  if (idleCoordinatorRegister(coordinator, factory) != E_FULL)
+    abort();
+
+  /* Deep state fits in time but requires an early wake-up */
+  idleCoordinatorEnter(coordinator);
+  checkInfo(coordinator, STATE_SLEEP, 1, 0);
+  checkInfo(coordinator, STATE_DEEP, 0, 0);
+
+  idleCoordinatorUnregister(coordinator, factory);
+  deinit(coordinator);
+  deinit(factory);
+  deinit(base);
+}
+/*----------------------------------------------------------------------------*/
+static void checkTickless(struct IdleContext *context)
+{
+  struct CompareTimer * const base = context->base;
+  void * const factory = context->factory;
+
+  /* Only the periodic refresh is scheduled when timers are disabled */
+  base->value = 0;
+  if (timerFactoryGetDeadline(factory) != base->overflow)
+    abort();
+
+  void * const timer = timerFactoryCreate(factory);
+
+  if (timer == NULL)
+    abort();
+  context->timer = timer;
+  timerSetCallback(timer, onTimerEvent, NULL);
+  timerSetOverflow(timer, TIMER_PERIOD);
+  timerEnable(timer);
+
+  /* Wake-up is scheduled on the next tick after the timer expiration */
+  if (timerFactoryGetDeadline(factory) != TIMER_PERIOD + 1)
+    abort();
+
+  if (timerFactorySetWakeup(factory, DEEP_LATENCY) != E_OK)
+    abort();
+  if (base->overflow != TIMER_PERIOD + 1 - DEEP_LATENCY)
+    abort();
+  if (timerFactorySetWakeup(factory, 0) != E_OK)
+    abort();
+  if (base->overflow != TIMER_PERIOD + 1)
+    abort();
+
+  /* Early wake-up time is too close to the current time */
+  base->value = TIMER_PERIOD - DEEP_LATENCY;
+  if (timerFactorySetWakeup(factory, DEEP_LATENCY) != E_VALUE)
+    abort();
+  if (base->overflow != TIMER_PERIOD + 1)
+    abort();
+
+  timerDisable(timer);
+
+  /* Wake-up time is wrapped around the range of the base timer */
+  base->value = TICKLESS_RANGE - TIMER_PERIOD / 2;
+  timerEnable(timer);
+
+  if (timerFactoryGetDeadline(factory) != TIMER_PERIOD + 1)
+    abort();
+  if (timerFactorySetWakeup(factory, TIMER_PERIOD / 2 + 2) != E_OK)
+    abort();
+  if (base->overflow != TICKLESS_RANGE - 1)
+    abort();
+  if (timerFactorySetWakeup(factory, 0) != E_OK)
+    abort();
+
+  timerDisable(timer);
+  base->value = 0;
+  timerEnable(timer);
+
+  /* Timer is left enabled for the following cases */
+  if (idleCoordinatorRegister(context->coordinator, factory) != E_OK)
+    abort();
+
+  /* The deepest state that fits into the time left is selected */
+  enterAt(context, 0, STATE_DEEP);
+  checkInfo(context->coordinator, STATE_DEEP, 1, 0);
+
+  /* Deep state does not fit, the shallow state has no latency */
+  enterAt(context, TIMER_PERIOD - DEEP_RESIDENCY, STATE_SLEEP);
+  checkInfo(context->coordinator, STATE_SLEEP, 1, 0);
+
+  /* No state fits in the time left */
+  enterAt(context, TIMER_PERIOD - 5, STATE_SLEEP);
+  if (idleCoordinatorGetSkips(context->coordinator) != 1)
+    abort();
+  checkInfo(context->coordinator, STATE_SLEEP, 1, 0);
+
+  /* Wake-up after the deadline is counted as a miss */
+  context->clock->step = TIMER_PERIOD * 2;
+  enterAt(context, 0, STATE_DEEP);
+  context->clock->step = 1;
+  checkInfo(context->coordinator, STATE_DEEP, 2, 1);
+
+  if (idleCoordinatorGetInfo(context->coordinator, ARRAY_SIZE(states), NULL)
+      != E_VALUE)
+  {
+    abort();
+  }
+}
+/*----------------------------------------------------------------------------*/
+static void enterAt(struct IdleContext *context, uint32_t counter,
+    size_t expected)
+{
+  struct CompareTimer * const base = context->base;
+
+  base->value = counter;
+  idleCoordinatorEnter(context->coordinator);
+
+  if (expected == STATE_DEEP)
+  {
+    /* Early interrupt expires no timers and restores the wake-up time */
+    if (base->overflow != TIMER_PERIOD + 1 - DEEP_LATENCY)
+      abort();
+
+    base->value = base->overflow;
+    base->callback(base->callbackArgument);
+  }
+
+  if (base->overflow != TIMER_PERIOD + 1)
+    abort();
+}
+/*----------------------------------------------------------------------------*/
+static void onTimerEvent(void *)
+{
+  /* Timers of the benchmark never expire */
+  abort();
+}
+/*----------------------------------------------------------------------------*/
+static void runEnter(void *argument, size_t iterations)
+{
+  struct IdleContext * const context = argument;
+
+  while (iterations--)
+    enterAt(context, (uint32_t)(iterations % 8), STATE_DEEP);
+}
+/*----------------------------------------------------------------------------*/
+#ifdef BENCH_WQ_IDLE
+static void checkWorkQueue(struct IdleContext *context)
+{
+  struct IdleInfo before;
+  struct IdleInfo after;
+
+  struct WorkQueue * const wq = init(WorkQueue, &(struct WorkQueueConfig){
+      .size = 2,
+      .idle = context->coordinator
+  });
+
+  if (wq == NULL)
+    abort();
+
+  /* Clock read after the state change emulates a wake-up interrupt */
+  context->base->value = 0;
+  context->clock->callback = wakeQueue;
+  context->clock->callbackArgument = wq;
+
+  idleCoordinatorGetInfo(context->coordinator, STATE_DEEP, &before);
+  wqStart(wq);
+  idleCoordinatorGetInfo(context->coordinator, STATE_DEEP, &after);
+
+  context->clock->callback = NULL;
+  context->clock->callbackArgument = NULL;
+
+  /* Empty queue enters the low-power state selected by the coordinator */
+  if (after.entries != before.entries + 1)
+    abort();
+
+  /* Restore the wake-up time after the early interrupt */
+  context->base->value = context->base->overflow;
+  context->base->callback(context->base->callbackArgument);
+
+  deinit(wq);
+}
+/*----------------------------------------------------------------------------*/
+static void stopTask(void *argument)
+{
+  wqStop(argument);
+}
+/*----------------------------------------------------------------------------*/
+static void wakeQueue(void *argument)
+{
+  static bool entered = false;
+
+  /* Clock is read before and after the state change */
+  if ((entered = !entered))
+    return;
+
+  if (wqAdd(argument, stopTask, argument) != E_OK)
+    abort();
+}
+#endif
+/*----------------------------------------------------------------------------*/
+static enum Result compareInit(void *object, const void *configBase)
+{
+  const uint32_t * const overflow = configBase;
+  struct CompareTimer * const timer = object;
+
+  timer->callback = NULL;
+  timer->callbackArgument = NULL;
+  timer->overflow = *overflow;
+  timer->value = 0;
+  return E_OK;
+}
+/*----------------------------------------------------------------------------*/
+static void compareEnable(void *)
+{
+}
+/*----------------------------------------------------------------------------*/
+static void compareDisable(void *)
+{
+}
+/*----------------------------------------------------------------------------*/
+static void compareSetCallback(void *object, void (*callback)(void *),
+    void *argument)
+{
+  struct CompareTimer * const timer = object;
+
+  timer->callbackArgument = argument;
+  timer->callback = callback;
+}
+/*----------------------------------------------------------------------------*/
+static uint32_t compareGetFrequency(const void *)
+{
+  return BASE_FREQUENCY;
+}
+/*----------------------------------------------------------------------------*/
+static uint32_t compareGetOverflow(const void *object)
+{
+  return ((const struct CompareTimer *)object)->overflow;
+}
+/*----------------------------------------------------------------------------*/
+static void compareSetOverflow(void *object, uint32_t overflow)
+{
+  ((struct CompareTimer *)object)->overflow = overflow;
+}
+/*----------------------------------------------------------------------------*/
+static uint32_t compareGetValue(const void *object)
+{
+  return ((const struct CompareTimer *)object)->value;
+}
+/*----------------------------------------------------------------------------*/
+static void compareSetValue(void *object, uint32_t value)
+{
+  ((struct CompareTimer *)object)->value = value;
+}
+/*----------------------------------------------------------------------------*/
+static enum Result clockInit(void *object, const void *)
+{
+  struct StepClock * const clock = object;
+
+  clock->callback = NULL;
+  clock->callbackArgument = NULL;
+  clock->step = 1;
+  clock->value = 0;
+  return E_OK;
+}
+/*----------------------------------------------------------------------------*/
+static uint32_t clockGetFrequency(const void *)
+{
+  return BASE_FREQUENCY;
+}
+/*----------------------------------------------------------------------------*/
+static uint32_t clockGetOverflow(const void *)
+{
+  return 0;
+}
+/*----------------------------------------------------------------------------*/
+static uint32_t clockGetValue(const void *object)
+{
+  /* Reads of the free-running counter are not expected to be pure */
+  struct StepClock * const clock = (struct StepClock *)object;
+
+  if (clock->callback != NULL)
+    clock->callback(clock->callbackArgument);
+
+  clock->value += clock->step;
+  return clock->value;
+}
+#endif
+/*----------------------------------------------------------------------------*/
+void benchIdle(void)
+{
+#if defined(CONFIG_GENERIC_IDLE_COORDINATOR) \
+    && defined(CONFIG_GENERIC_TIMER_FACTORY)
+  struct IdleContext context = {
+      .base = init(CompareTimer, &(uint32_t){TICKLESS_RANGE}),
+      .clock = init(StepClock, NULL)
+  };
+
+  if (context.base == NULL || context.clock == NULL)
+    abort();
+
+  checkPeriodic();
+
+  context.factory = init(TicklessFactory,
+      &(struct TimerFactoryConfig){&context.base->base});
+  if (context.factory == NULL)
+    abort();
+  timerEnable(context.factory);
+
+  context.coordinator = init(IdleCoordinator,
+      &(struct IdleCoordinatorConfig){
+          .states = states,
+          .count = ARRAY_SIZE(states),
+          .capacity = 1,
+          .clock = context.clock
+      });
+  if (context.coordinator == NULL)
+    abort();
+
+  checkTickless(&context);
+
+#ifdef BENCH_WQ_IDLE
+  checkWorkQueue(&context);
+#endif
+
+  benchRun(&(const struct BenchCase){
+      .name = "idle_coordinator.enter",
+      .run = runEnter,
+      .argument = &context,
+      .iterations = 200000
+  });
+
+  idleCoordinatorUnregister(context.coordinator, context.factory);
+  deinit(context.coordinator);
+  deinit(context.timer);
+  deinit(context.factory);
+  deinit(context.clock);
+  deinit(context.base);
+#endif
+}
@@ -0,0 +1,412 @@
+/*
+ * bench_instrumented_proxy.c
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the MIT License
+ */
+
+#include "bench.h"
+
+#ifdef CONFIG_GENERIC_INSTRUMENTED_PROXY
+#include <halm/generic/instrumented_proxy.h>
+#include <halm/timer.h>
+#include <stdlib.h>
+#include <string.h>
+/*----------------------------------------------------------------------------*/
+#define BUFFER_SIZE 64
+
+/*
+ * Interface that accepts requests immediately. In zero-copy mode it signals
+ * the completion from the transfer function before returning to the caller.
+ */
+struct LoopInterface
+{
+  struct Interface base;
+
+  void (*callback)(void *);
+  void *callbackArgument;
+
+  /* Maximum number of bytes accepted by a single call */
+  size_t limit;
+  /* Status of the last transfer */
+  enum Result status;
+  /* Zero-copy mode is enabled */
+  bool zerocopy;
+};
+
+/* Free-running timer that advances on each read of the counter */
+struct StepTimer
+{
+  struct Timer base;
+
+  uint32_t value;
+};
+
+struct InstrumentedContext
+{
+  struct LoopInterface *pipe;
+  struct StepTimer *clock;
+  void *proxy;
+
+  /* Number of callbacks delivered to the user */
+  size_t callbacks;
+};
+/*----------------------------------------------------------------------------*/
+static void checkBlocking(struct InstrumentedContext *);
+static void checkParameters(struct InstrumentedContext *);
+static void checkReset(struct InstrumentedContext *);
+static void checkZerocopy(struct InstrumentedContext *);
+static void getStatistics(struct InstrumentedContext *,
+    struct InstrumentedProxyStatistics *);
+static void onTransferCompleted(void *);
+static void runWrite(void *, size_t);
+
+static enum Result loopInit(void *, const void *);
+static void loopSetCallback(void *, void (*)(void *), void *);
+static enum Result loopGetParam(void *, int, void *);
+static enum Result loopSetParam(void *, int, const void *);
+static size_t loopRead(void *, void *, size_t);
+static size_t loopWrite(void *, const void *, size_t);
+
+static enum Result timerInit(void *, const void *);
+static uint32_t timerGetOverflowStub(const void *);
+static uint32_t timerGetValueStub(const void *);
+/*----------------------------------------------------------------------------*/
+static const struct InterfaceClass * const LoopInterface =
+    &(const struct InterfaceClass){
+    .size = sizeof(struct LoopInterface),
+    .init = loopInit,
+    .deinit = NULL,
+
+    .setCallback = loopSetCallback,
+    .getParam = loopGetParam,
+    .setParam = loopSetParam,
+    .read = loopRead,
+    .write = loopWrite
+};
+
+static const struct TimerClass * const StepTimer =
+    &(const struct TimerClass){
+    .size = sizeof(struct StepTimer),
+    .init = timerInit,
+    .deinit = NULL,
+
+    .enable = NULL,
+    .disable = NULL,
+    .setAutostop = NULL,
+    .setCallback = NULL,
+    .getFrequency = NULL,
+    .setFrequency = NULL,
+    .getOverflow = timerGetOverflowStub,
+    .setOverflow = NULL,
+    .getValue = timerGetValueStub,
+    .setValue = NULL
+};
+/*----------------------------------------------------------------------------*/
+static void checkBlocking(struct InstrumentedContext *context)
+{
+  struct InstrumentedProxyStatistics statistics;
+  uint8_t buffer[BUFFER_SIZE] = {0};
+
+  if (ifWrite(context->proxy, buffer, sizeof(buffer)) != sizeof(buffer))
+    abort();
+  if (ifRead(context->proxy, buffer, sizeof(buffer)) != sizeof(buffer))
+    abort();
+
+  /* Wrapped interface accepts only a part of the request */
+  context->pipe->limit = BUFFER_SIZE / 4;
+  if (ifWrite(context->proxy, buffer, sizeof(buffer)) != BUFFER_SIZE / 4)
+    abort();
+  context->pipe->limit = SIZE_MAX;
+
+  getStatistics(context, &statistics);
+
+  if (statistics.tx.calls != 2 || statistics.tx.partial != 1)
+    abort();
+  if (statistics.tx.bytes != BUFFER_SIZE + BUFFER_SIZE / 4)
+    abort();
+  if (statistics.rx.calls != 1 || statistics.rx.partial != 0)
+    abort();
+  if (statistics.rx.bytes != BUFFER_SIZE)
+    abort();
+
+  /* Each call reads the clock twice, the latency is one tick */
+  if (statistics.tx.latency.count != 2 || statistics.tx.latency.max != 1)
+    abort();
+  if (statistics.rx.latency.count != 1 || statistics.rx.latency.min != 1)
+    abort();
+
+  /* Blocking transfers do not produce completion samples */
+  if (statistics.completion.count != 0 || statistics.callbacks != 0)
+    abort();
+}
+/*----------------------------------------------------------------------------*/
+static void checkParameters(struct InstrumentedContext *context)
+{
+  struct InstrumentedProxyStatistics statistics;
+  const uint32_t rate = 115200;
+  size_t available;
+
+  /* Parameters are forwarded, results are counted by the proxy */
+  if (ifGetParam(context->proxy, IF_RX_AVAILABLE, &available) != E_OK)
+    abort();
+  if (ifSetParam(context->proxy, IF_RATE, &rate) != E_VALUE)
+    abort();
+  if (ifSetParam(context->proxy, IF_ADDRESS, &rate) != E_INVALID)
+    abort();
+
+  getStatistics(context, &statistics);
+
+  if (statistics.results[E_OK] != 1 || statistics.results[E_VALUE] != 1
+      || statistics.results[E_INVALID] != 1)
+  {
+    abort();
+  }
+}
+/*----------------------------------------------------------------------------*/
+static void checkReset(struct InstrumentedContext *context)
+{
+  struct InstrumentedProxyStatistics statistics;
+
+  if (ifSetParam(context->proxy, IF_PROXY_RESET, NULL) != E_OK)
+    abort();
+
+  getStatistics(context, &statistics);
+
+  if (statistics.rx.calls || statistics.rx.bytes || statistics.tx.calls
+      || statistics.tx.bytes || statistics.tx.partial)
+  {
+    abort();
+  }
+  if (statistics.callbacks || statistics.completion.count)
+    abort();
+  if (statistics.completion.min != UINT32_MAX
+      || statistics.tx.latency.min != UINT32_MAX)
+  {
+    abort();
+  }
+
+  for (size_t index = 0; index < E_RESULT_END; ++index)
+  {
+    if (statistics.results[index] || statistics.status[index])
+      abort();
+  }
+}
+/*----------------------------------------------------------------------------*/
+static void checkZerocopy(struct InstrumentedContext *context)
+{
+  struct InstrumentedProxyStatistics statistics;
+  uint8_t buffer[BUFFER_SIZE] = {0};
+
+  ifSetCallback(context->proxy, onTransferCompleted, context);
+  if (ifSetParam(context->proxy, IF_ZEROCOPY, NULL) != E_OK)
+    abort();
+
+  /* Completion is signaled before the wrapped interface returns */
+  context->pipe->status = E_OK;
+  if (ifWrite(context->proxy, buffer, sizeof(buffer)) != sizeof(buffer))
+    abort();
+
+  getStatistics(context, &statistics);
+
+  if (statistics.completion.count != 1 || statistics.status[E_OK] != 1)
+    abort();
+  if (statistics.callbacks != 1 || context->callbacks != 1)
+    abort();
+
+  context->pipe->status = E_ERROR;
+  if (ifRead(context->proxy, buffer, sizeof(buffer)) != sizeof(buffer))
+    abort();
+
+  /* Rejected transfer should not capture the next unrelated callback */
+  context->pipe->limit = 0;
+  if (ifWrite(context->proxy, buffer, sizeof(buffer)) != 0)
+    abort();
+  context->pipe->limit = SIZE_MAX;
+  context->pipe->callback(context->pipe->callbackArgument);
+
+  getStatistics(context, &statistics);
+
+  if (statistics.completion.count != 2 || statistics.status[E_ERROR] != 1)
+    abort();
+  if (statistics.tx.partial != 1)
+    abort();
+  if (statistics.callbacks != 3 || context->callbacks != 3)
+    abort();
+
+  if (ifSetParam(context->proxy, IF_BLOCKING, NULL) != E_OK)
+    abort();
+  ifSetCallback(context->proxy, NULL, NULL);
+}
+/*----------------------------------------------------------------------------*/
+static void getStatistics(struct InstrumentedContext *context,
+    struct InstrumentedProxyStatistics *statistics)
+{
+  if (ifGetParam(context->proxy, IF_PROXY_STATISTICS, statistics) != E_OK)
+    abort();
+}
+/*----------------------------------------------------------------------------*/
+static void onTransferCompleted(void *argument)
+{
+  struct InstrumentedContext * const context = argument;
+  ++context->callbacks;
+}
+/*----------------------------------------------------------------------------*/
+static void runWrite(void *argument, size_t iterations)
+{
+  uint8_t buffer[BUFFER_SIZE] = {0};
+
+  while (iterations--)
+  {
+    if (ifWrite(argument, buffer, sizeof(buffer)) != sizeof(buffer))
+      abort();
+  }
+}
+/*----------------------------------------------------------------------------*/
+static enum Result loopInit(void *object, const void *)
+{
+  struct LoopInterface * const interface = object;
+
+  interface->callback = NULL;
+  interface->callbackArgument = NULL;
+  interface->limit = SIZE_MAX;
+  interface->status = E_OK;
+  interface->zerocopy = false;
+  return E_OK;
+}
+/*----------------------------------------------------------------------------*/
+static void loopSetCallback(void *object, void (*callback)(void *),
+    void *argument)
+{
+  struct LoopInterface * const interface = object;
+
+  interface->callbackArgument = argument;
+  interface->callback = callback;
+}
+/*----------------------------------------------------------------------------*/
+static enum Result loopGetParam(void *object, int parameter, void *data)
+{
+  const struct LoopInterface * const interface = object;
+
+  switch ((enum IfParameter)parameter)
+  {
+    case IF_RX_AVAILABLE:
+      *(size_t *)data = 0;
+      return E_OK;
+
+    case IF_STATUS:
+      return interface->status;
+
+    default:
+      return E_INVALID;
+  }
+}
+/*----------------------------------------------------------------------------*/
+static enum Result loopSetParam(void *object, int parameter, const void *)
+{
+  struct LoopInterface * const interface = object;
+
+  switch ((enum IfParameter)parameter)
+  {
+    case IF_BLOCKING:
+      interface->zerocopy = false;
+      return E_OK;
+
+    case IF_RATE:
+      return E_VALUE;
+
+    case IF_ZEROCOPY:
+      interface->zerocopy = true;
+      return E_OK;
+
+    default:
+      return E_INVALID;
+  }
+}
+/*----------------------------------------------------------------------------*/
+static size_t loopRead(void *object, void *buffer, size_t length)
+{
+  struct LoopInterface * const interface = object;
+
+  if (length > interface->limit)
+    length = interface->limit;
+
+  memset(buffer, 0, length);
+
+  if (interface->zerocopy && length && interface->callback != NULL)
+    interface->callback(interface->callbackArgument);
+
+  return length;
+}
+/*----------------------------------------------------------------------------*/
+static size_t loopWrite(void *object, const void *, size_t length)
+{
+  struct LoopInterface * const interface = object;
+
+  if (length > interface->limit)
+    length = interface->limit;
+
+  if (interface->zerocopy && length && interface->callback != NULL)
+    interface->callback(interface->callbackArgument);
+
+  return length;
+}
+/*----------------------------------------------------------------------------*/
+static enum Result timerInit(void *object, const void *)
+{
+  struct StepTimer * const timer = object;
+
+  timer->value = 0;
+  return E_OK;
+}
+/*----------------------------------------------------------------------------*/
+static uint32_t timerGetOverflowStub(const void *)
+{
+  return 0;
+}
+/*----------------------------------------------------------------------------*/
+static uint32_t timerGetValueStub(const void *object)
+{
+  struct StepTimer * const timer = (struct StepTimer *)object;
+  return timer->value++;
+}
+#endif
+/*----------------------------------------------------------------------------*/
+void benchInstrumentedProxy(void)
+{
+#ifdef CONFIG_GENERIC_INSTRUMENTED_PROXY
+  struct InstrumentedContext context = {
+      .pipe = init(LoopInterface, NULL),
+      .clock = init(StepTimer, NULL),
+      .callbacks = 0
+  };
+
+  if (context.pipe == NULL || context.clock == NULL)
+    abort();
+
+  context.proxy = init(InstrumentedProxy, &(struct InstrumentedProxyConfig){
+      .pipe = context.pipe,
+      .clock = context.clock
+  });
+  if (context.proxy == NULL)
+    abort();
+
+  checkBlocking(&context);
+  checkReset(&context);
+  checkParameters(&context);
+  checkReset(&context);
+  checkZerocopy(&context);
+  checkReset(&context);
+
+  benchRun(&(const struct BenchCase){
+      .name = "instrumented_proxy.write",
+      .run = runWrite,
+      .argument = context.proxy,
+      .iterations = 1000000,
+      .bytes = BUFFER_SIZE
+  });
+
+  deinit(context.proxy);
+  deinit(context.clock);
+  deinit(context.pipe);
+#endif
+}
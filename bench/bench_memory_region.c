@@ -0,0 +1,193 @@
+/*
+ * bench_memory_region.c
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the MIT License
+ */
+
+#include "bench.h"
+
+/* Placement checks require a separate region for each hint */
+#if defined(CONFIG_GENERIC_MEMORY_REGION) \
+    && CONFIG_GENERIC_MEMORY_REGION_COUNT >= 4
+#include <halm/generic/memory_region.h>
+#include <stdalign.h>
+#include <stdlib.h>
+/*----------------------------------------------------------------------------*/
+#define BLOCK_SIZE    64
+#define REGION_SIZE   256
+#define SPARE_SIZE    32
+/*----------------------------------------------------------------------------*/
+static bool belongsTo(const void *, const uint8_t *);
+static void checkPlacement(void);
+static void checkRegistration(void);
+static void checkRelease(void);
+static void runAlloc(void *, size_t);
+/*----------------------------------------------------------------------------*/
+alignas(BLOCK_SIZE) static uint8_t bulkMemory[REGION_SIZE];
+alignas(BLOCK_SIZE) static uint8_t coherentMemory[REGION_SIZE];
+alignas(BLOCK_SIZE) static uint8_t dmaMemory[REGION_SIZE];
+alignas(BLOCK_SIZE) static uint8_t fastMemory[REGION_SIZE];
+static uint8_t spareMemory[CONFIG_GENERIC_MEMORY_REGION_COUNT * SPARE_SIZE];
+/*----------------------------------------------------------------------------*/
+static bool belongsTo(const void *block, const uint8_t *memory)
+{
+  const uint8_t * const address = block;
+  return address >= memory && address < memory + REGION_SIZE;
+}
+/*----------------------------------------------------------------------------*/
+static void checkPlacement(void)
+{
+  void *blocks[REGION_SIZE / BLOCK_SIZE];
+  void *block;
+
+  /* Coherent memory is preferred for DMA buffers */
+  for (size_t index = 0; index < ARRAY_SIZE(blocks); ++index)
+  {
+    blocks[index] = memoryRegionAlloc(MEMORY_HINT_DMA, BLOCK_SIZE,
+        BLOCK_SIZE);
+
+    if (!belongsTo(blocks[index], coherentMemory))
+      abort();
+    if ((uintptr_t)blocks[index] % BLOCK_SIZE)
+      abort();
+  }
+
+  /* Other DMA-accessible regions are used when coherent memory is full */
+  block = memoryRegionAlloc(MEMORY_HINT_DMA, REGION_SIZE, 1);
+  if (!belongsTo(block, dmaMemory))
+    abort();
+
+  /* Heap is used when no suitable region has enough space */
+  block = memoryRegionAlloc(MEMORY_HINT_DMA, BLOCK_SIZE, BLOCK_SIZE);
+  if (block == NULL || memoryRegionGetFlags(block, BLOCK_SIZE) != 0)
+    abort();
+  if ((uintptr_t)block % BLOCK_SIZE)
+    abort();
+  memoryRegionFree(block);
+
+  block = memoryRegionAlloc(MEMORY_HINT_DEFAULT, BLOCK_SIZE, 1);
+  if (block == NULL || memoryRegionGetFlags(block, BLOCK_SIZE) != 0)
+    abort();
+  memoryRegionFree(block);
+
+  block = memoryRegionAlloc(MEMORY_HINT_BULK, BLOCK_SIZE, 1);
+  if (!belongsTo(block, bulkMemory))
+    abort();
+
+  /* Regions are also selected by name */
+  block = memoryRegionAllocNamed("bulk", BLOCK_SIZE, 1);
+  if (!belongsTo(block, bulkMemory))
+    abort();
+  if (memoryRegionAllocNamed("unknown", BLOCK_SIZE, 1) != NULL)
+    abort();
+  if (memoryRegionAllocNamed("bulk", REGION_SIZE, 1) != NULL)
+    abort();
+
+  /* Flags are reported only for blocks inside a single region */
+  if (memoryRegionGetFlags(blocks[0], BLOCK_SIZE)
+      != (MEMORY_DMA | MEMORY_COHERENT))
+  {
+    abort();
+  }
+  if (memoryRegionGetFlags(fastMemory, REGION_SIZE) != MEMORY_FAST)
+    abort();
+  if (memoryRegionGetFlags(fastMemory + 1, REGION_SIZE) != 0)
+    abort();
+}
+/*----------------------------------------------------------------------------*/
+static void checkRegistration(void)
+{
+  const struct MemoryRegion descriptors[] = {
+      {"bulk", bulkMemory, sizeof(bulkMemory), MEMORY_BULK},
+      {"dma", dmaMemory, sizeof(dmaMemory), MEMORY_DMA},
+      {"coherent", coherentMemory, sizeof(coherentMemory),
+          MEMORY_DMA | MEMORY_COHERENT},
+      {"fast", fastMemory, sizeof(fastMemory), MEMORY_FAST}
+  };
+
+  const size_t last = ARRAY_SIZE(descriptors) - 1;
+
+  for (size_t index = 0; index < last; ++index)
+  {
+    if (memoryRegionRegister(&descriptors[index]) != E_OK)
+      abort();
+  }
+
+  /* Overlapping regions are rejected while the registry has free entries */
+  const struct MemoryRegion overlap = {
+      "overlap", bulkMemory + REGION_SIZE / 2, REGION_SIZE, 0
+  };
+
+  if (memoryRegionRegister(&overlap) != E_EXIST)
+    abort();
+  if (memoryRegionRegister(&descriptors[last]) != E_OK)
+    abort();
+}
+/*----------------------------------------------------------------------------*/
+static void checkRelease(void)
+{
+  uint8_t * const first = memoryRegionAlloc(MEMORY_HINT_FAST, BLOCK_SIZE, 1);
+  uint8_t * const second = memoryRegionAlloc(MEMORY_HINT_FAST, BLOCK_SIZE, 1);
+  uint8_t * const third = second + BLOCK_SIZE;
+
+  if (!belongsTo(first, fastMemory) || second != first + BLOCK_SIZE)
+    abort();
+
+  /* Only the last allocation of the region is reclaimed */
+  memoryRegionFree(first);
+  if (memoryRegionAlloc(MEMORY_HINT_FAST, BLOCK_SIZE, 1) != third)
+    abort();
+
+  memoryRegionFree(third);
+  if (memoryRegionAlloc(MEMORY_HINT_FAST, BLOCK_SIZE, 1) != third)
+    abort();
+
+  memoryRegionFree(third);
+  memoryRegionFree(NULL);
+}
+/*----------------------------------------------------------------------------*/
+static void runAlloc(void *, size_t iterations)
+{
+  while (iterations--)
+  {
+    void * const block = memoryRegionAlloc(MEMORY_HINT_FAST, BLOCK_SIZE,
+        BLOCK_SIZE);
+
+    if (!belongsTo(block, fastMemory))
+      abort();
+    memoryRegionFree(block);
+  }
+}
+#endif
+/*----------------------------------------------------------------------------*/
+void benchMemoryRegion(void)
+{
+#if defined(CONFIG_GENERIC_MEMORY_REGION) \
+    && CONFIG_GENERIC_MEMORY_REGION_COUNT >= 4
+  checkRegistration();
+  checkRelease();
+  checkPlacement();
+
+  benchRun(&(const struct BenchCase){
+      .name = "memory_region.alloc_free",
+      .run = runAlloc,
+      .iterations = 1000000
+  });
+
+  /* Registry rejects regions when all entries are used */
+  for (size_t index = 0; index < CONFIG_GENERIC_MEMORY_REGION_COUNT; ++index)
+  {
+    const struct MemoryRegion spare = {
+        "spare", spareMemory + index * SPARE_SIZE, SPARE_SIZE, 0
+    };
+    const enum Result res = memoryRegionRegister(&spare);
+
+    if (res == E_FULL)
+      return;
+    if (res != E_OK)
+      abort();
+  }
+
+  abort();
+#endif
+}
@@ -0,0 +1,358 @@
+/*
+ * bench_mmcsd.c
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the MIT License
+ */
+
+#include "bench.h"
+
+#if defined(CONFIG_GENERIC_MMCSD) \
+    && defined(CONFIG_PLATFORM_LINUX_SD_CARD_EMULATOR)
+#include <halm/generic/mmcsd.h>
+#include <halm/platform/generic/sd_card_emulator.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+/*----------------------------------------------------------------------------*/
+#define BLOCK_SIZE            512
+#define IMAGE_CAPACITY        (16ULL << 20)
+#define LARGE_TRANSFER_SIZE   65536
+#define QUEUE_REQUESTS        16
+#define TRANSFER_SIZE         4096
+
+struct CardContext
+{
+  void *sdio;
+  void *card;
+};
+
+struct QueueContext
+{
+  void *card;
+
+  /* Number of completed requests */
+  volatile size_t completed;
+  /* Number of requests completed in the same transfer as the previous one */
+  size_t merged;
+  /* Queue depth observed by the previous completion callback */
+  uint32_t depth;
+};
+/*----------------------------------------------------------------------------*/
+static void onRequestFinished(void *, enum Result);
+static void runErase(void *, size_t);
+static void runQueue(void *, size_t);
+static void runRead(void *, size_t);
+static void runWrite(void *, size_t);
+static void runWriteLarge(void *, size_t);
+static void setupCard(struct CardContext *, const char *,
+    const struct SdCardEmulatorProfile *, bool, size_t);
+static void transferQueue(struct QueueContext *, uint8_t *, uint64_t, bool);
+static void writeSequence(void *, size_t, size_t);
+/*----------------------------------------------------------------------------*/
+static uint8_t buffer[LARGE_TRANSFER_SIZE];
+/*----------------------------------------------------------------------------*/
+static void onRequestFinished(void *argument, enum Result res)
+{
+  struct QueueContext * const context = argument;
+  uint32_t depth;
+
+  if (res != E_OK)
+    abort();
+
+  /*
+   * Requests of the same transfer are completed before they are removed
+   * from the queue, therefore they observe the same queue depth.
+   */
+  if (ifGetParam(context->card, IF_MMCSD_QUEUE_DEPTH, &depth) != E_OK)
+    abort();
+  if (context->completed && depth == context->depth)
+    ++context->merged;
+
+  context->depth = depth;
+  ++context->completed;
+}
+/*----------------------------------------------------------------------------*/
+static void runErase(void *argument, size_t iterations)
+{
+  uint32_t group;
+
+  if (ifGetParam(argument, IF_MMCSD_ERASE_GROUP_SIZE, &group) != E_OK)
+    abort();
+  if (!group || group > sizeof(buffer))
+    abort();
+
+  const uint64_t limit = IMAGE_CAPACITY / group;
+  uint64_t index = 0;
+
+  while (iterations--)
+  {
+    /* Skip the first group to catch wrong address conversions */
+    const uint64_t position = (index++ % (limit - 1) + 1) * group;
+
+    memset(buffer, 0xA5, group);
+    if (ifSetParam(argument, IF_POSITION_64, &position) != E_OK)
+      abort();
+    if (ifWrite(argument, buffer, group) != group)
+      abort();
+
+    if (ifSetParam(argument, IF_MMCSD_ERASE_64, &position) != E_OK)
+      abort();
+
+    if (ifSetParam(argument, IF_POSITION_64, &position) != E_OK)
+      abort();
+    if (ifRead(argument, buffer, group) != group)
+      abort();
+
+    for (size_t offset = 0; offset < group; ++offset)
+    {
+      if (buffer[offset])
+        abort();
+    }
+  }
+}
+/*----------------------------------------------------------------------------*/
+static void runQueue(void *argument, size_t iterations)
+{
+  static uint8_t pattern[QUEUE_REQUESTS * BLOCK_SIZE];
+  struct QueueContext context = {.card = argument};
+  const uint64_t limit = IMAGE_CAPACITY / sizeof(pattern);
+  uint64_t index = 0;
+
+  while (iterations--)
+  {
+    const uint64_t position = (index % limit) * sizeof(pattern);
+
+    for (size_t offset = 0; offset < sizeof(pattern); ++offset)
+      pattern[offset] = (uint8_t)(index + offset / BLOCK_SIZE);
+    ++index;
+
+    transferQueue(&context, pattern, position, true);
+    memset(buffer, 0, sizeof(pattern));
+    transferQueue(&context, buffer, position, false);
+
+    if (memcmp(buffer, pattern, sizeof(pattern)))
+      abort();
+  }
+}
+/*----------------------------------------------------------------------------*/
+static void runRead(void *argument, size_t iterations)
+{
+  const uint64_t limit = IMAGE_CAPACITY / TRANSFER_SIZE;
+  uint64_t index = 0;
+
+  while (iterations--)
+  {
+    const uint64_t position = (index++ % limit) * TRANSFER_SIZE;
+
+    if (ifSetParam(argument, IF_POSITION_64, &position) != E_OK)
+      abort();
+    if (ifRead(argument, buffer, TRANSFER_SIZE) != TRANSFER_SIZE)
+      abort();
+  }
+}
+/*----------------------------------------------------------------------------*/
+static void runWrite(void *argument, size_t iterations)
+{
+  writeSequence(argument, iterations, TRANSFER_SIZE);
+}
+/*----------------------------------------------------------------------------*/
+static void runWriteLarge(void *argument, size_t iterations)
+{
+  writeSequence(argument, iterations, LARGE_TRANSFER_SIZE);
+}
+/*----------------------------------------------------------------------------*/
+static void setupCard(struct CardContext *context, const char *path,
+    const struct SdCardEmulatorProfile *profile, bool predefined,
+    size_t requests)
+{
+  context->sdio = init(SdCardEmulator, &(struct SdCardEmulatorConfig){
+      .path = path,
+      .profile = profile,
+      .capacity = IMAGE_CAPACITY,
+      .rate = 50000000,
+      .wide = true
+  });
+  if (context->sdio == NULL)
+    abort();
+
+  context->card = init(MMCSD, &(struct MMCSDConfig){
+      .interface = context->sdio,
+      .merge = requests ? requests * BLOCK_SIZE : 0,
+      .requests = requests,
+      .crc = true,
+      .predefined = predefined
+  });
+  if (context->card == NULL)
+    abort();
+}
+/*----------------------------------------------------------------------------*/
+static void transferQueue(struct QueueContext *context, uint8_t *data,
+    uint64_t position, bool write)
+{
+  static struct MMCSDRequest requests[QUEUE_REQUESTS];
+
+  context->completed = 0;
+  context->merged = 0;
+
+  /*
+   * Blocks are submitted in reverse order and the buffers of neighbouring
+   * blocks are not adjacent, so that the queue has to sort requests and
+   * merge them using the bounce buffer.
+   */
+  for (size_t index = 0; index < QUEUE_REQUESTS; ++index)
+  {
+    const size_t block = QUEUE_REQUESTS - 1 - index;
+    const size_t slot = (block & 1) ? block - 1 : block + 1;
+
+    requests[index] = (struct MMCSDRequest){
+        .callback = onRequestFinished,
+        .argument = context,
+        .buffer = data + slot * BLOCK_SIZE,
+        .position = position + block * BLOCK_SIZE,
+        .length = BLOCK_SIZE,
+        .write = write
+    };
+
+    if (mmcsdEnqueue(context->card, &requests[index]) != E_OK)
+      abort();
+  }
+
+  /* Card commands should not interleave with queued transfers */
+  if (ifSetParam(context->card, IF_MMCSD_ERASE_64, &position) != E_BUSY)
+    abort();
+
+  while (context->completed != QUEUE_REQUESTS)
+    usleep(10);
+
+  /* Requests submitted after the first one should be merged together */
+  if (!context->merged)
+    abort();
+}
+/*----------------------------------------------------------------------------*/
+static void writeSequence(void *card, size_t iterations, size_t size)
+{
+  const uint64_t limit = IMAGE_CAPACITY / size;
+  uint64_t index = 0;
+
+  while (iterations--)
+  {
+    const uint64_t position = (index++ % limit) * size;
+
+    if (ifSetParam(card, IF_POSITION_64, &position) != E_OK)
+      abort();
+    if (ifWrite(card, buffer, size) != size)
+      abort();
+  }
+}
+#endif
+/*----------------------------------------------------------------------------*/
+void benchMmcsd(void)
+{
+#if defined(CONFIG_GENERIC_MMCSD) \
+    && defined(CONFIG_PLATFORM_LINUX_SD_CARD_EMULATOR)
+  /* Latency profile of a typical Class 10 card */
+  static const struct SdCardEmulatorProfile profile = {
+      .command = 5,
+      .access = 100,
+      .program = 20,
+      .erased = 10,
+      .erase = 2000,
+      .stop = 500,
+      .stallPeriod = 512,
+      .stall = 20000
+  };
+
+  char path[] = "/tmp/halm_bench_XXXXXX";
+  const int file = mkstemp(path);
+  struct CardContext context;
+
+  if (file == -1)
+    abort();
+  close(file);
+
+  /* Card without delays shows the software overhead of the stack */
+  setupCard(&context, path, NULL, false, 0);
+
+  benchRun(&(const struct BenchCase){
+      .name = "mmcsd.read_4k",
+      .run = runRead,
+      .argument = context.card,
+      .iterations = 20000,
+      .bytes = TRANSFER_SIZE
+  });
+  benchRun(&(const struct BenchCase){
+      .name = "mmcsd.write_4k",
+      .run = runWrite,
+      .argument = context.card,
+      .iterations = 20000,
+      .bytes = TRANSFER_SIZE
+  });
+  benchRun(&(const struct BenchCase){
+      .name = "mmcsd.erase",
+      .run = runErase,
+      .argument = context.card,
+      .iterations = 1000
+  });
+
+  deinit(context.card);
+  deinit(context.sdio);
+
+  /* Emulated bus and card latencies show the achievable throughput */
+  setupCard(&context, path, &profile, false, 0);
+
+  benchRun(&(const struct BenchCase){
+      .name = "mmcsd.read_4k_timed",
+      .run = runRead,
+      .argument = context.card,
+      .iterations = 100,
+      .bytes = TRANSFER_SIZE
+  });
+  benchRun(&(const struct BenchCase){
+      .name = "mmcsd.write_4k_timed",
+      .run = runWrite,
+      .argument = context.card,
+      .iterations = 100,
+      .bytes = TRANSFER_SIZE
+  });
+  benchRun(&(const struct BenchCase){
+      .name = "mmcsd.write_64k_timed",
+      .run = runWriteLarge,
+      .argument = context.card,
+      .iterations = 50,
+      .bytes = LARGE_TRANSFER_SIZE
+  });
+
+  deinit(context.card);
+  deinit(context.sdio);
+
+  /* Block count and pre-erase hints are sent before multiple block writes */
+  setupCard(&context, path, &profile, true, 0);
+
+  benchRun(&(const struct BenchCase){
+      .name = "mmcsd.write_64k_predefined",
+      .run = runWriteLarge,
+      .argument = context.card,
+      .iterations = 50,
+      .bytes = LARGE_TRANSFER_SIZE
+  });
+
+  deinit(context.card);
+  deinit(context.sdio);
+
+  /* Queued requests are sorted and merged while the card is busy */
+  setupCard(&context, path, &profile, false, QUEUE_REQUESTS);
+
+  benchRun(&(const struct BenchCase){
+      .name = "mmcsd.queue_merge_timed",
+      .run = runQueue,
+      .argument = context.card,
+      .iterations = 20,
+      .bytes = QUEUE_REQUESTS * BLOCK_SIZE * 2
+  });
+
+  deinit(context.card);
+  deinit(context.sdio);
+
+  unlink(path);
+#endif
+}
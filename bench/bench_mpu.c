@@ -0,0 +1,187 @@
+/*
+ * bench_mpu.c
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the MIT License
+ */
+
+#include "bench.h"
+
+/*
+ * Region planner does not access MPU registers, therefore it is compiled
+ * into the benchmark directly, bypassing the selection of core headers.
+ */
+#define HALM_CORE_CORTEX_MPU_H_
+#include <halm/core/cortex/armv7m/mpu.h>
+#include "../core/cortex/armv7m/mpu_planner.c"
+#include <stdlib.h>
+/*----------------------------------------------------------------------------*/
+#define MAX_REGIONS     32
+#define WINDOW_COUNT    64
+
+struct Interval
+{
+  uint64_t begin;
+  uint64_t end;
+};
+
+struct PlanContext
+{
+  /* State of the pseudo-random generator */
+  uint32_t seed;
+};
+/*----------------------------------------------------------------------------*/
+static void checkPlan(uintptr_t, size_t, const struct MpuRegionConfig *,
+    size_t);
+static int compareIntervals(const void *, const void *);
+static uint32_t nextRandom(struct PlanContext *);
+static void runPlan(void *, size_t);
+/*----------------------------------------------------------------------------*/
+static void checkPlan(uintptr_t address, size_t size,
+    const struct MpuRegionConfig *configs, size_t count)
+{
+  struct Interval intervals[MAX_REGIONS * SUBREGION_COUNT];
+  const uint64_t begin = (uint64_t)address & ~31ULL;
+  const uint64_t end = ((uint64_t)address + size + 31) & ~31ULL;
+  size_t total = 0;
+
+  /* Collect enabled parts of all regions */
+  for (size_t index = 0; index < count; ++index)
+  {
+    const uint32_t control = configs[index].control;
+    const unsigned int order = RASR_SIZE_VALUE(control) + 1;
+    const uint64_t regionBegin = configs[index].address;
+    const uint64_t regionSize = 1ULL << order;
+    const uint8_t subregions = RASR_SRD_VALUE(control);
+
+    if (!(control & RASR_ENABLE) || order < MIN_REGION_ORDER)
+      abort();
+    if (regionBegin & (regionSize - 1))
+      abort();
+
+    if (order < MIN_SUBREGION_ORDER)
+    {
+      /* Subregions are not supported by small regions */
+      if (subregions)
+        abort();
+
+      intervals[total++] = (struct Interval){
+          regionBegin, regionBegin + regionSize
+      };
+      continue;
+    }
+
+    /* Region with all subregions disabled is useless */
+    if (subregions == 0xFF)
+      abort();
+
+    const uint64_t subSize = regionSize / SUBREGION_COUNT;
+
+    for (unsigned int sub = 0; sub < SUBREGION_COUNT; ++sub)
+    {
+      if (!(subregions & (1 << sub)))
+      {
+        const uint64_t subBegin = regionBegin + sub * subSize;
+
+        intervals[total++] = (struct Interval){
+            subBegin, subBegin + subSize
+        };
+      }
+    }
+  }
+
+  qsort(intervals, total, sizeof(intervals[0]), compareIntervals);
+
+  /* Union of enabled parts should match the window exactly */
+  uint64_t covered = begin;
+
+  for (size_t index = 0; index < total; ++index)
+  {
+    if (intervals[index].begin < begin || intervals[index].end > end)
+      abort();
+    if (intervals[index].begin > covered)
+      abort();
+
+    if (intervals[index].end > covered)
+      covered = intervals[index].end;
+  }
+
+  if (covered != end)
+    abort();
+}
+/*----------------------------------------------------------------------------*/
+static int compareIntervals(const void *a, const void *b)
+{
+  const uint64_t x = ((const struct Interval *)a)->begin;
+  const uint64_t y = ((const struct Interval *)b)->begin;
+
+  return (x > y) - (x < y);
+}
+/*----------------------------------------------------------------------------*/
+static uint32_t nextRandom(struct PlanContext *context)
+{
+  /* Xorshift generator with a fixed seed keeps results reproducible */
+  uint32_t value = context->seed;
+
+  value ^= value << 13;
+  value ^= value >> 17;
+  value ^= value << 5;
+
+  context->seed = value;
+  return value;
+}
+/*----------------------------------------------------------------------------*/
+static void runPlan(void *argument, size_t iterations)
+{
+  struct PlanContext * const context = argument;
+
+  while (iterations--)
+  {
+    for (size_t index = 0; index < WINDOW_COUNT; ++index)
+    {
+      struct MpuRegionConfig configs[MAX_REGIONS];
+      const uint32_t address = nextRandom(context);
+      const uint32_t limit = UINT32_MAX - address;
+
+      /* Window sizes are distributed over all orders of magnitude */
+      uint32_t size = nextRandom(context) >> (nextRandom(context) % 32);
+
+      if (size > limit)
+        size = limit;
+      if (!size)
+        size = 1;
+
+      const size_t count = mpuPlanRegions(address, size, 0, configs,
+          MAX_REGIONS);
+
+      if (!count)
+        abort();
+      checkPlan(address, size, configs, count);
+    }
+  }
+}
+/*----------------------------------------------------------------------------*/
+void benchMpu(void)
+{
+  struct PlanContext context = {
+      .seed = 0x2545F491
+  };
+  struct MpuRegionConfig configs[MAX_REGIONS];
+
+  /* Aligned power-of-two window is covered by a single region */
+  if (mpuPlanRegions(0x20200000, 0x10000, 0, configs, MAX_REGIONS) != 1)
+    abort();
+  checkPlan(0x20200000, 0x10000, configs, 1);
+
+  /* Empty window and insufficient capacity are rejected */
+  if (mpuPlanRegions(0x20000000, 0, 0, configs, MAX_REGIONS))
+    abort();
+  if (mpuPlanRegions(0x20000020, 0x1000, 0, configs, 1))
+    abort();
+
+  benchRun(&(const struct BenchCase){
+      .name = "mpu.plan_regions",
+      .run = runPlan,
+      .argument = &context,
+      .iterations = 200
+  });
+}
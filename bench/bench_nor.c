@@ -0,0 +1,145 @@
+/*
+ * bench_nor.c
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the MIT License
+ */
+
+#include "bench.h"
+
+#if defined(CONFIG_GENERIC_NOR_FLASH) \
+    && defined(CONFIG_PLATFORM_LINUX_SPIM_EMULATOR)
+#include <halm/generic/flash.h>
+#include <halm/generic/nor_flash.h>
+#include <halm/platform/generic/spim_emulator.h>
+#include <stdlib.h>
+/*----------------------------------------------------------------------------*/
+#define MEMORY_CAPACITY       (16UL << 20)
+#define TRANSFER_SIZE         4096
+
+struct MemoryContext
+{
+  void *spim;
+  void *flash;
+};
+/*----------------------------------------------------------------------------*/
+static void releaseMemory(struct MemoryContext *);
+static void runProgram(void *, size_t);
+static void runRead(void *, size_t);
+static void setupMemory(struct MemoryContext *, bool, bool);
+/*----------------------------------------------------------------------------*/
+static uint8_t buffer[TRANSFER_SIZE];
+/*----------------------------------------------------------------------------*/
+static void releaseMemory(struct MemoryContext *context)
+{
+  deinit(context->flash);
+  deinit(context->spim);
+}
+/*----------------------------------------------------------------------------*/
+static void runProgram(void *argument, size_t iterations)
+{
+  const uint32_t limit = MEMORY_CAPACITY / TRANSFER_SIZE;
+  uint32_t index = 0;
+
+  while (iterations--)
+  {
+    const uint32_t position = (index++ % limit) * TRANSFER_SIZE;
+
+    if (ifSetParam(argument, IF_FLASH_ERASE_SECTOR, &position) != E_OK)
+      abort();
+    if (ifSetParam(argument, IF_POSITION, &position) != E_OK)
+      abort();
+    if (ifWrite(argument, buffer, TRANSFER_SIZE) != TRANSFER_SIZE)
+      abort();
+  }
+}
+/*----------------------------------------------------------------------------*/
+static void runRead(void *argument, size_t iterations)
+{
+  const uint32_t limit = MEMORY_CAPACITY / TRANSFER_SIZE;
+  uint32_t index = 0;
+
+  while (iterations--)
+  {
+    const uint32_t position = (index++ % limit) * TRANSFER_SIZE;
+
+    if (ifSetParam(argument, IF_POSITION, &position) != E_OK)
+      abort();
+    if (ifRead(argument, buffer, TRANSFER_SIZE) != TRANSFER_SIZE)
+      abort();
+  }
+}
+/*----------------------------------------------------------------------------*/
+static void setupMemory(struct MemoryContext *context, bool wide, bool xip)
+{
+  context->spim = init(SpimEmulator, &(struct SpimEmulatorConfig){
+      .capacity = MEMORY_CAPACITY,
+      .profile = NULL,
+      .dtr = true,
+      .wide = wide
+  });
+  if (context->spim == NULL)
+    abort();
+
+  context->flash = init(NorFlash, &(struct NorFlashConfig){
+      .spim = context->spim,
+      .dtr = true,
+      .xip = xip
+  });
+  if (context->flash == NULL)
+    abort();
+}
+#endif
+/*----------------------------------------------------------------------------*/
+void benchNor(void)
+{
+#if defined(CONFIG_GENERIC_NOR_FLASH) \
+    && defined(CONFIG_PLATFORM_LINUX_SPIM_EMULATOR)
+  struct MemoryContext context;
+
+  /* Indirect reads show the overhead of command descriptors */
+  setupMemory(&context, true, false);
+
+  benchRun(&(const struct BenchCase){
+      .name = "nor.read_4k_indirect",
+      .run = runRead,
+      .argument = context.flash,
+      .iterations = 20000,
+      .bytes = TRANSFER_SIZE
+  });
+  benchRun(&(const struct BenchCase){
+      .name = "nor.program_4k",
+      .run = runProgram,
+      .argument = context.flash,
+      .iterations = 5000,
+      .bytes = TRANSFER_SIZE
+  });
+
+  releaseMemory(&context);
+
+  /* Memory-mapped reads bypass the command interface */
+  setupMemory(&context, true, true);
+
+  benchRun(&(const struct BenchCase){
+      .name = "nor.read_4k_xip",
+      .run = runRead,
+      .argument = context.flash,
+      .iterations = 20000,
+      .bytes = TRANSFER_SIZE
+  });
+
+  releaseMemory(&context);
+
+  /* Serial memory without IO2 and IO3 lines uses dual modes */
+  setupMemory(&context, false, false);
+
+  benchRun(&(const struct BenchCase){
+      .name = "nor.read_4k_dual",
+      .run = runRead,
+      .argument = context.flash,
+      .iterations = 20000,
+      .bytes = TRANSFER_SIZE
+  });
+
+  releaseMemory(&context);
+#endif
+}
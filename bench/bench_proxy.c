@@ -0,0 +1,216 @@
+/*
+ * bench_proxy.c
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the MIT License
+ */
+
+#include "bench.h"
+
+#ifdef CONFIG_GENERIC_BUFFERING_PROXY
+#include <halm/generic/buffering_proxy.h>
+#include <assert.h>
+#include <stdlib.h>
+/*----------------------------------------------------------------------------*/
+#define BUFFER_COUNT      4
+#define BUFFER_SIZE       64
+#define SUBSCRIBER_COUNT  3
+
+/* Stream that completes every request immediately */
+struct LoopStream
+{
+  struct Stream base;
+};
+/*----------------------------------------------------------------------------*/
+static void runFanout(void *, size_t);
+static void runRead(void *, size_t);
+static void runReadZerocopy(void *, size_t);
+static void runWrite(void *, size_t);
+static void runWriteZerocopy(void *, size_t);
+/*----------------------------------------------------------------------------*/
+static enum Result loopInit(void *, const void *);
+static void loopDeinit(void *);
+static void loopClear(void *);
+static enum Result loopEnqueue(void *, struct StreamRequest *);
+/*----------------------------------------------------------------------------*/
+static const struct StreamClass * const LoopStream =
+    &(const struct StreamClass){
+    .size = sizeof(struct LoopStream),
+    .init = loopInit,
+    .deinit = loopDeinit,
+
+    .clear = loopClear,
+    .enqueue = loopEnqueue
+};
+/*----------------------------------------------------------------------------*/
+static void runFanout(void *argument, size_t iterations)
+{
+  while (iterations--)
+  {
+    /* Each subscriber consumes the same buffer in place */
+    for (size_t index = 0; index < SUBSCRIBER_COUNT; ++index)
+    {
+      struct StreamRequest * const request =
+          bufferingProxyFetch(argument, index);
+
+      assert(request != NULL && request->length == BUFFER_SIZE);
+      bufferingProxyRelease(argument, request);
+    }
+  }
+}
+/*----------------------------------------------------------------------------*/
+static void runRead(void *argument, size_t iterations)
+{
+  uint8_t buffer[BUFFER_SIZE];
+
+  while (iterations--)
+  {
+    [[maybe_unused]] const size_t count =
+        ifRead(argument, buffer, sizeof(buffer));
+    assert(count == sizeof(buffer));
+  }
+}
+/*----------------------------------------------------------------------------*/
+static void runReadZerocopy(void *argument, size_t iterations)
+{
+  while (iterations--)
+  {
+    struct StreamRequest * const request = bufferingProxyAcquire(argument);
+
+    assert(request != NULL && request->length == BUFFER_SIZE);
+    bufferingProxyRelease(argument, request);
+  }
+}
+/*----------------------------------------------------------------------------*/
+static void runWrite(void *argument, size_t iterations)
+{
+  uint8_t buffer[BUFFER_SIZE] = {0};
+
+  while (iterations--)
+  {
+    [[maybe_unused]] const size_t count =
+        ifWrite(argument, buffer, sizeof(buffer));
+    assert(count == sizeof(buffer));
+  }
+}
+/*----------------------------------------------------------------------------*/
+static void runWriteZerocopy(void *argument, size_t iterations)
+{
+  while (iterations--)
+  {
+    struct StreamRequest * const request = bufferingProxyAllocate(argument);
+    assert(request != NULL);
+
+    request->length = BUFFER_SIZE;
+
+    [[maybe_unused]] const enum Result res =
+        bufferingProxySubmit(argument, request);
+    assert(res == E_OK);
+  }
+}
+/*----------------------------------------------------------------------------*/
+static enum Result loopInit(void *, const void *)
+{
+  return E_OK;
+}
+/*----------------------------------------------------------------------------*/
+static void loopDeinit(void *)
+{
+}
+/*----------------------------------------------------------------------------*/
+static void loopClear(void *)
+{
+}
+/*----------------------------------------------------------------------------*/
+static enum Result loopEnqueue(void *, struct StreamRequest *request)
+{
+  /* Input requests are returned full, output requests are consumed */
+  if (request->length == 0)
+    request->length = request->capacity;
+
+  request->callback(request->argument, request, STREAM_REQUEST_COMPLETED);
+  return E_OK;
+}
+/*----------------------------------------------------------------------------*/
+void benchProxy(void)
+{
+  struct Stream * const rx = init(LoopStream, NULL);
+  struct Stream * const tx = init(LoopStream, NULL);
+
+  if (rx == NULL || tx == NULL)
+    abort();
+
+  /* Wrapped interface is not accessed during data transfers */
+  const struct BufferingProxyConfig config = {
+      .pipe = rx,
+      .rx = {rx, BUFFER_COUNT, BUFFER_SIZE},
+      .tx = {tx, BUFFER_COUNT, BUFFER_SIZE}
+  };
+  struct Interface * const proxy = init(BufferingProxy, &config);
+
+  if (proxy == NULL)
+    abort();
+
+  benchRun(&(const struct BenchCase){
+      .name = "buffering_proxy.read",
+      .run = runRead,
+      .argument = proxy,
+      .iterations = 200000,
+      .bytes = BUFFER_SIZE
+  });
+  benchRun(&(const struct BenchCase){
+      .name = "buffering_proxy.write",
+      .run = runWrite,
+      .argument = proxy,
+      .iterations = 200000,
+      .bytes = BUFFER_SIZE
+  });
+  benchRun(&(const struct BenchCase){
+      .name = "buffering_proxy.read_zerocopy",
+      .run = runReadZerocopy,
+      .argument = proxy,
+      .iterations = 200000,
+      .bytes = BUFFER_SIZE
+  });
+  benchRun(&(const struct BenchCase){
+      .name = "buffering_proxy.write_zerocopy",
+      .run = runWriteZerocopy,
+      .argument = proxy,
+      .iterations = 200000,
+      .bytes = BUFFER_SIZE
+  });
+
+  deinit(proxy);
+
+  /* Buffers are shared by subscribers instead of being copied */
+  const struct BufferingProxyConfig fanoutConfig = {
+      .pipe = rx,
+      .rx = {
+          .stream = rx,
+          .count = BUFFER_COUNT,
+          .size = BUFFER_SIZE,
+          .subscribers = SUBSCRIBER_COUNT
+      }
+  };
+  struct Interface * const fanout = init(BufferingProxy, &fanoutConfig);
+
+  if (fanout == NULL)
+    abort();
+
+  benchRun(&(const struct BenchCase){
+      .name = "buffering_proxy.fanout",
+      .run = runFanout,
+      .argument = fanout,
+      .iterations = 200000,
+      .bytes = BUFFER_SIZE * SUBSCRIBER_COUNT
+  });
+
+  deinit(fanout);
+  deinit(tx);
+  deinit(rx);
+}
+#else
+/*----------------------------------------------------------------------------*/
+void benchProxy(void)
+{
+}
+#endif
@@ -0,0 +1,450 @@
+/*
+ * bench_sdio_spi.c
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the MIT License
+ */
+
+#include "bench.h"
+
+#ifdef CONFIG_GENERIC_SDIO_SPI
+#include <halm/generic/mmcsd_defs.h>
+#include <halm/generic/sdio.h>
+#include <halm/generic/sdio_defs.h>
+#include <halm/generic/sdio_spi.h>
+#include <halm/generic/spi.h>
+#include <stdlib.h>
+#include <string.h>
+/*----------------------------------------------------------------------------*/
+#define BLOCK_COUNT           4
+#define BLOCK_SIZE            512
+#define BURST_LENGTH          64
+#define IMAGE_BLOCKS          64
+#define OUTPUT_SIZE           16384
+
+/* Card keeps the data line low longer than the retry limit of writes */
+#define BUSY_LONG             6000
+#define BUSY_SHORT            200
+#define TOKEN_GAP             39
+
+enum WriteState
+{
+  WRITE_IDLE,
+  WRITE_TOKEN,
+  WRITE_DATA
+};
+
+struct SpiCard
+{
+  struct Interface base;
+
+  void (*callback)(void *);
+  void *callbackArgument;
+
+  /* Bytes to be sent by the card */
+  uint8_t output[OUTPUT_SIZE];
+  size_t head;
+  size_t tail;
+
+  /* Command being received */
+  uint8_t command[6];
+  size_t received;
+
+  /* Position and progress of the block being written */
+  size_t position;
+  size_t offset;
+
+  /* Length of the busy state after each written block */
+  size_t busy;
+  /* Number of read transactions on the bus */
+  size_t reads;
+  /* Current state of a write transfer */
+  uint8_t state;
+  /* Transfer completion is pending */
+  bool pending;
+};
+
+struct CardContext
+{
+  struct SpiCard *card;
+  void *sdio;
+};
+/*----------------------------------------------------------------------------*/
+static void checkTimeouts(size_t);
+static void completeTransfer(struct CardContext *);
+static void parseCommand(struct SpiCard *);
+static void pushBlock(struct SpiCard *, size_t);
+static void pushByte(struct SpiCard *, uint8_t);
+static void pushFill(struct SpiCard *, uint8_t, size_t);
+static void readBlocks(struct CardContext *);
+static void receiveByte(struct SpiCard *, uint8_t);
+static void runRead(void *, size_t);
+static void runWrite(void *, size_t);
+static void setupCard(struct CardContext *, size_t, size_t);
+static enum Result writeBlocks(struct CardContext *);
+
+static enum Result cardInit(void *, const void *);
+static void cardSetCallback(void *, void (*)(void *), void *);
+static enum Result cardGetParam(void *, int, void *);
+static enum Result cardSetParam(void *, int, const void *);
+static size_t cardRead(void *, void *, size_t);
+static size_t cardWrite(void *, const void *, size_t);
+/*----------------------------------------------------------------------------*/
+static const struct InterfaceClass * const SpiCard =
+    &(const struct InterfaceClass){
+    .size = sizeof(struct SpiCard),
+    .init = cardInit,
+    .deinit = NULL, /* Default destructor */
+
+    .setCallback = cardSetCallback,
+    .getParam = cardGetParam,
+    .setParam = cardSetParam,
+    .read = cardRead,
+    .write = cardWrite
+};
+/*----------------------------------------------------------------------------*/
+static uint8_t buffer[BLOCK_COUNT * BLOCK_SIZE];
+static uint8_t image[IMAGE_BLOCKS * BLOCK_SIZE];
+/*----------------------------------------------------------------------------*/
+static void checkTimeouts(size_t burst)
+{
+  struct CardContext context;
+
+  /* Busy state shorter than the retry limit should be awaited */
+  setupCard(&context, burst, BUSY_SHORT);
+  if (writeBlocks(&context) != E_OK)
+    abort();
+  deinit(context.sdio);
+  deinit(context.card);
+
+  /* Retry limit should not depend on the length of polling bursts */
+  setupCard(&context, burst, BUSY_LONG);
+  if (writeBlocks(&context) != E_TIMEOUT)
+    abort();
+  deinit(context.sdio);
+  deinit(context.card);
+}
+/*----------------------------------------------------------------------------*/
+static void completeTransfer(struct CardContext *context)
+{
+  /* Completions are delivered iteratively to keep the stack shallow */
+  while (context->card->pending)
+  {
+    context->card->pending = false;
+    context->card->callback(context->card->callbackArgument);
+  }
+}
+/*----------------------------------------------------------------------------*/
+static void parseCommand(struct SpiCard *card)
+{
+  const unsigned int code = card->command[0] & 0x3F;
+  const uint32_t argument = ((uint32_t)card->command[1] << 24)
+      | ((uint32_t)card->command[2] << 16)
+      | ((uint32_t)card->command[3] << 8)
+      | (uint32_t)card->command[4];
+
+  /* R1 response follows a single filler byte */
+  card->head = card->tail = 0;
+  pushByte(card, 0xFF);
+  pushByte(card, 0x00);
+
+  switch (code)
+  {
+    case CMD17_READ_SINGLE_BLOCK:
+      pushBlock(card, argument);
+      break;
+
+    case CMD18_READ_MULTIPLE_BLOCK:
+      for (size_t index = 0; index < BLOCK_COUNT; ++index)
+        pushBlock(card, argument + index);
+      break;
+
+    case CMD24_WRITE_BLOCK:
+    case CMD25_WRITE_MULTIPLE_BLOCK:
+      card->position = argument * BLOCK_SIZE;
+      card->state = WRITE_TOKEN;
+      break;
+
+    default:
+      break;
+  }
+}
+/*----------------------------------------------------------------------------*/
+static void pushBlock(struct SpiCard *card, size_t block)
+{
+  pushFill(card, 0xFF, TOKEN_GAP);
+  pushByte(card, 0xFE);
+  for (size_t index = 0; index < BLOCK_SIZE; ++index)
+    pushByte(card, image[block * BLOCK_SIZE + index]);
+  pushFill(card, 0x00, 2);
+}
+/*----------------------------------------------------------------------------*/
+static void pushByte(struct SpiCard *card, uint8_t value)
+{
+  if (card->tail == OUTPUT_SIZE)
+    abort();
+  card->output[card->tail++] = value;
+}
+/*----------------------------------------------------------------------------*/
+static void pushFill(struct SpiCard *card, uint8_t value, size_t count)
+{
+  while (count--)
+    pushByte(card, value);
+}
+/*----------------------------------------------------------------------------*/
+static void readBlocks(struct CardContext *context)
+{
+  const uint32_t command = SDIO_COMMAND(CMD18_READ_MULTIPLE_BLOCK,
+      SDIO_RESPONSE_SHORT, SDIO_DATA_MODE);
+  const uint32_t argument = 8;
+
+  ifSetParam(context->sdio, IF_SDIO_COMMAND, &command);
+  ifSetParam(context->sdio, IF_SDIO_ARGUMENT, &argument);
+  ifRead(context->sdio, buffer, sizeof(buffer));
+  completeTransfer(context);
+
+  if (ifGetParam(context->sdio, IF_STATUS, NULL) != E_OK)
+    abort();
+  if (memcmp(buffer, image + argument * BLOCK_SIZE, sizeof(buffer)))
+    abort();
+}
+/*----------------------------------------------------------------------------*/
+static void receiveByte(struct SpiCard *card, uint8_t value)
+{
+  switch ((enum WriteState)card->state)
+  {
+    case WRITE_TOKEN:
+      if (value == 0xFE || value == 0xFC)
+      {
+        /* Start token of a data block */
+        card->offset = 0;
+        card->state = WRITE_DATA;
+      }
+      else if (value == 0xFD)
+      {
+        /* Stop token of a multiple block write */
+        card->head = card->tail = 0;
+        pushByte(card, 0xFF);
+        pushFill(card, 0x00, card->busy);
+        card->state = WRITE_IDLE;
+      }
+      return;
+
+    case WRITE_DATA:
+      /* Block data followed by a checksum */
+      if (card->offset < BLOCK_SIZE)
+        image[card->position + card->offset] = value;
+
+      if (++card->offset == BLOCK_SIZE + 2)
+      {
+        card->head = card->tail = 0;
+        pushByte(card, 0xE5);
+        pushFill(card, 0x00, card->busy);
+        card->position += BLOCK_SIZE;
+        card->state = WRITE_TOKEN;
+      }
+      return;
+
+    default:
+      break;
+  }
+
+  /* Commands start with the transmission bit */
+  if (!card->received && (value & 0xC0) != 0x40)
+    return;
+
+  card->command[card->received++] = value;
+
+  if (card->received == sizeof(card->command))
+  {
+    card->received = 0;
+    parseCommand(card);
+  }
+}
+/*----------------------------------------------------------------------------*/
+static void runRead(void *argument, size_t iterations)
+{
+  while (iterations--)
+    readBlocks(argument);
+}
+/*----------------------------------------------------------------------------*/
+static void runWrite(void *argument, size_t iterations)
+{
+  while (iterations--)
+  {
+    if (writeBlocks(argument) != E_OK)
+      abort();
+  }
+}
+/*----------------------------------------------------------------------------*/
+static void setupCard(struct CardContext *context, size_t burst, size_t busy)
+{
+  context->card = init(SpiCard, NULL);
+  if (context->card == NULL)
+    abort();
+  context->card->busy = busy;
+
+  context->sdio = init(SdioSpi, &(struct SdioSpiConfig){
+      .interface = context->card,
+      .burst = burst,
+      .cs = PIN(0, 0)
+  });
+  if (context->sdio == NULL)
+    abort();
+}
+/*----------------------------------------------------------------------------*/
+static enum Result writeBlocks(struct CardContext *context)
+{
+  const uint32_t command = SDIO_COMMAND(CMD25_WRITE_MULTIPLE_BLOCK,
+      SDIO_RESPONSE_SHORT, SDIO_DATA_MODE | SDIO_WRITE_MODE);
+  const uint32_t argument = 20;
+
+  for (size_t index = 0; index < sizeof(buffer); ++index)
+    buffer[index] = (uint8_t)(index ^ 0x5A);
+
+  ifSetParam(context->sdio, IF_SDIO_COMMAND, &command);
+  ifSetParam(context->sdio, IF_SDIO_ARGUMENT, &argument);
+  ifWrite(context->sdio, buffer, sizeof(buffer));
+  completeTransfer(context);
+
+  const enum Result res = ifGetParam(context->sdio, IF_STATUS, NULL);
+
+  if (res == E_OK
+      && memcmp(buffer, image + argument * BLOCK_SIZE, sizeof(buffer)))
+  {
+    abort();
+  }
+
+  return res;
+}
+/*----------------------------------------------------------------------------*/
+static enum Result cardInit(void *object, const void *)
+{
+  struct SpiCard * const card = object;
+
+  card->callback = NULL;
+  card->head = 0;
+  card->tail = 0;
+  card->received = 0;
+  card->position = 0;
+  card->offset = 0;
+  card->busy = 0;
+  card->reads = 0;
+  card->state = WRITE_IDLE;
+  card->pending = false;
+
+  return E_OK;
+}
+/*----------------------------------------------------------------------------*/
+static void cardSetCallback(void *object, void (*callback)(void *),
+    void *argument)
+{
+  struct SpiCard * const card = object;
+
+  card->callbackArgument = argument;
+  card->callback = callback;
+}
+/*----------------------------------------------------------------------------*/
+static enum Result cardGetParam(void *, int parameter, void *data)
+{
+  switch ((enum IfParameter)parameter)
+  {
+    case IF_RATE:
+      *(uint32_t *)data = 25000000;
+      return E_OK;
+
+    default:
+      return E_INVALID;
+  }
+}
+/*----------------------------------------------------------------------------*/
+static enum Result cardSetParam(void *, int, const void *)
+{
+  return E_OK;
+}
+/*----------------------------------------------------------------------------*/
+static size_t cardRead(void *object, void *data, size_t length)
+{
+  struct SpiCard * const card = object;
+  uint8_t * const position = data;
+
+  /* Data line stays high when the card has nothing to send */
+  for (size_t index = 0; index < length; ++index)
+  {
+    position[index] = card->head < card->tail ?
+        card->output[card->head++] : 0xFF;
+  }
+
+  ++card->reads;
+  card->pending = true;
+  return length;
+}
+/*----------------------------------------------------------------------------*/
+static size_t cardWrite(void *object, const void *data, size_t length)
+{
+  struct SpiCard * const card = object;
+  const uint8_t * const position = data;
+
+  for (size_t index = 0; index < length; ++index)
+    receiveByte(card, position[index]);
+
+  card->pending = true;
+  return length;
+}
+#endif
+/*----------------------------------------------------------------------------*/
+void benchSdioSpi(void)
+{
+#ifdef CONFIG_GENERIC_SDIO_SPI
+  struct CardContext single;
+  struct CardContext burst;
+
+  for (size_t index = 0; index < sizeof(image); ++index)
+    image[index] = (uint8_t)(index * 7 + index / BLOCK_SIZE);
+
+  checkTimeouts(0);
+  checkTimeouts(BURST_LENGTH);
+
+  setupCard(&single, 0, BUSY_SHORT);
+  setupCard(&burst, BURST_LENGTH, BUSY_SHORT);
+
+  /* Bursts should reduce the number of bus transactions */
+  readBlocks(&single);
+  readBlocks(&burst);
+  if (burst.card->reads >= single.card->reads)
+    abort();
+
+  benchRun(&(const struct BenchCase){
+      .name = "sdio_spi.read_byte",
+      .run = runRead,
+      .argument = &single,
+      .iterations = 2000,
+      .bytes = sizeof(buffer)
+  });
+  benchRun(&(const struct BenchCase){
+      .name = "sdio_spi.read_burst",
+      .run = runRead,
+      .argument = &burst,
+      .iterations = 2000,
+      .bytes = sizeof(buffer)
+  });
+  benchRun(&(const struct BenchCase){
+      .name = "sdio_spi.write_byte",
+      .run = runWrite,
+      .argument = &single,
+      .iterations = 2000,
+      .bytes = sizeof(buffer)
+  });
+  benchRun(&(const struct BenchCase){
+      .name = "sdio_spi.write_burst",
+      .run = runWrite,
+      .argument = &burst,
+      .iterations = 2000,
+      .bytes = sizeof(buffer)
+  });
+
+  deinit(burst.sdio);
+  deinit(burst.card);
+  deinit(single.sdio);
+  deinit(single.card);
+#endif
+}
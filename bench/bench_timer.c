@@ -0,0 +1,181 @@
+/*
+ * bench_timer.c
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the MIT License
+ */
+
+#include "bench.h"
+
+#ifdef CONFIG_GENERIC_TIMER_FACTORY
+#include <halm/generic/timer_factory.h>
+#include <stdlib.h>
+/*----------------------------------------------------------------------------*/
+#define TIMER_COUNT 32
+
+/* Base timer with interrupts generated by the benchmark */
+struct ManualTimer
+{
+  struct Timer base;
+
+  void (*callback)(void *);
+  void *callbackArgument;
+};
+/*----------------------------------------------------------------------------*/
+static void onTimerEvent(void *);
+static void runArm(void *, size_t);
+static void runExpire(void *, size_t);
+/*----------------------------------------------------------------------------*/
+static enum Result tmrInit(void *, const void *);
+static void tmrDeinit(void *);
+static void tmrEnable(void *);
+static void tmrDisable(void *);
+static void tmrSetCallback(void *, void (*)(void *), void *);
+static uint32_t tmrGetFrequency(const void *);
+static uint32_t tmrGetOverflow(const void *);
+static void tmrSetValue(void *, uint32_t);
+/*----------------------------------------------------------------------------*/
+static const struct TimerClass * const ManualTimer =
+    &(const struct TimerClass){
+    .size = sizeof(struct ManualTimer),
+    .init = tmrInit,
+    .deinit = tmrDeinit,
+
+    .enable = tmrEnable,
+    .disable = tmrDisable,
+    .setAutostop = NULL,
+    .setCallback = tmrSetCallback,
+    .getFrequency = tmrGetFrequency,
+    .setFrequency = NULL,
+    .getOverflow = tmrGetOverflow,
+    .setOverflow = NULL,
+    .getValue = NULL,
+    .setValue = tmrSetValue
+};
+/*----------------------------------------------------------------------------*/
+static struct ManualTimer *base;
+static struct Timer *probe;
+static volatile uint32_t events;
+/*----------------------------------------------------------------------------*/
+static void onTimerEvent(void *)
+{
+  ++events;
+}
+/*----------------------------------------------------------------------------*/
+static void runArm(void *, size_t iterations)
+{
+  /* Probe timer is inserted in the middle of the list of active timers */
+  while (iterations--)
+  {
+    timerEnable(probe);
+    timerDisable(probe);
+  }
+}
+/*----------------------------------------------------------------------------*/
+static void runExpire(void *, size_t iterations)
+{
+  /* Periodic timers with distinct periods expire on most ticks */
+  while (iterations--)
+    base->callback(base->callbackArgument);
+}
+/*----------------------------------------------------------------------------*/
+static enum Result tmrInit(void *object, const void *)
+{
+  struct ManualTimer * const timer = object;
+
+  timer->callback = NULL;
+  timer->callbackArgument = NULL;
+  return E_OK;
+}
+/*----------------------------------------------------------------------------*/
+static void tmrDeinit(void *)
+{
+}
+/*----------------------------------------------------------------------------*/
+static void tmrEnable(void *)
+{
+}
+/*----------------------------------------------------------------------------*/
+static void tmrDisable(void *)
+{
+}
+/*----------------------------------------------------------------------------*/
+static void tmrSetCallback(void *object, void (*callback)(void *),
+    void *argument)
+{
+  struct ManualTimer * const timer = object;
+
+  timer->callbackArgument = argument;
+  timer->callback = callback;
+}
+/*----------------------------------------------------------------------------*/
+static uint32_t tmrGetFrequency(const void *)
+{
+  return 1000000;
+}
+/*----------------------------------------------------------------------------*/
+static uint32_t tmrGetOverflow(const void *)
+{
+  return 1000;
+}
+/*----------------------------------------------------------------------------*/
+static void tmrSetValue(void *, uint32_t)
+{
+}
+/*----------------------------------------------------------------------------*/
+void benchTimer(void)
+{
+  struct Timer *timers[TIMER_COUNT];
+
+  base = init(ManualTimer, NULL);
+  if (base == NULL)
+    abort();
+
+  const struct TimerFactoryConfig config = {
+      .timer = &base->base
+  };
+  struct TimerFactory * const factory = init(TimerFactory, &config);
+
+  if (factory == NULL)
+    abort();
+  timerEnable(factory);
+
+  for (size_t index = 0; index < TIMER_COUNT; ++index)
+  {
+    timers[index] = timerFactoryCreate(factory);
+    if (timers[index] == NULL)
+      abort();
+
+    timerSetCallback(timers[index], onTimerEvent, NULL);
+    timerSetOverflow(timers[index], (uint32_t)(index + 1) * 2);
+    timerEnable(timers[index]);
+  }
+
+  probe = timerFactoryCreate(factory);
+  if (probe == NULL)
+    abort();
+  timerSetCallback(probe, onTimerEvent, NULL);
+  timerSetOverflow(probe, TIMER_COUNT);
+
+  benchRun(&(const struct BenchCase){
+      .name = "timer_factory.arm",
+      .run = runArm,
+      .iterations = 200000
+  });
+  benchRun(&(const struct BenchCase){
+      .name = "timer_factory.expire",
+      .run = runExpire,
+      .iterations = 200000
+  });
+
+  deinit(probe);
+  for (size_t index = 0; index < TIMER_COUNT; ++index)
+    deinit(timers[index]);
+  deinit(factory);
+  deinit(base);
+}
+#else
+/*----------------------------------------------------------------------------*/
+void benchTimer(void)
+{
+}
+#endif
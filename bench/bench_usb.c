@@ -0,0 +1,71 @@
+/*
+ * bench_usb.c
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the MIT License
+ */
+
+#include "bench.h"
+#include <halm/usb/usb_defs.h>
+#include <halm/usb/usb_string.h>
+/*----------------------------------------------------------------------------*/
+#define PAYLOAD_SIZE 256
+/*----------------------------------------------------------------------------*/
+static void runLanguages(void *, size_t);
+static void runStrings(void *, size_t);
+/*----------------------------------------------------------------------------*/
+static const enum UsbLangId languages[] = {
+    LANGID_ENGLISH_US,
+    LANGID_GERMAN,
+    LANGID_FRENCH,
+    LANGID_RUSSIAN
+};
+
+static const char * const strings[] = {
+    "HALM Benchmark Device",
+    "Serial Console",
+    "Mass Storage Interface",
+    "Прибор для измерений"
+};
+
+static uint8_t payload[PAYLOAD_SIZE];
+static volatile uint8_t sink;
+/*----------------------------------------------------------------------------*/
+static void runLanguages(void *, size_t iterations)
+{
+  struct UsbDescriptor header;
+
+  while (iterations--)
+  {
+    usbStringMultiHeader(&header, payload, languages, ARRAY_SIZE(languages));
+    sink = header.length;
+  }
+}
+/*----------------------------------------------------------------------------*/
+static void runStrings(void *, size_t iterations)
+{
+  struct UsbDescriptor header;
+
+  /* UTF-8 to UTF-16 conversion dominates string descriptor generation */
+  while (iterations--)
+  {
+    for (size_t index = 0; index < ARRAY_SIZE(strings); ++index)
+    {
+      usbStringWrap(&header, payload, strings[index]);
+      sink = header.length;
+    }
+  }
+}
+/*----------------------------------------------------------------------------*/
+void benchUsb(void)
+{
+  benchRun(&(const struct BenchCase){
+      .name = "usb.string_languages",
+      .run = runLanguages,
+      .iterations = 200000
+  });
+  benchRun(&(const struct BenchCase){
+      .name = "usb.string_descriptors",
+      .run = runStrings,
+      .iterations = 50000
+  });
+}
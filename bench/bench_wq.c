@@ -0,0 +1,391 @@
+/*
+ * bench_wq.c
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the MIT License
+ */
+
+#include "bench.h"
+#include <halm/pm.h>
+#include <halm/wq.h>
+#include <stdlib.h>
+
+#if defined(CONFIG_GENERIC_WQ) && !defined(CONFIG_GENERIC_WQ_NONSTOP)
+#  include <halm/generic/work_queue.h>
+#  define BENCH_WQ
+#  ifdef CONFIG_GENERIC_WQ_DELAYED
+#    include <halm/timer.h>
+#    define BENCH_WQ_DELAYED
+#  endif
+#endif
+
+#if defined(CONFIG_GENERIC_WQ_IRQ) && !defined(CONFIG_GENERIC_WQ_IRQ_NONSTOP)
+#  include <halm/generic/work_queue_irq.h>
+#  define BENCH_WQ_IRQ
+#endif
+
+#if defined(CONFIG_GENERIC_WQ_UNIQUE) \
+    && !defined(CONFIG_GENERIC_WQ_UNIQUE_NONSTOP)
+#  include <halm/generic/work_queue_unique.h>
+#  define BENCH_WQ_UNIQUE
+#endif
+/*----------------------------------------------------------------------------*/
+#define BATCH_SIZE 256
+#define DELAY_SPAN 16
+#define UNIQUE_MAX 512
+
+#ifdef BENCH_WQ_DELAYED
+/* Tick timer with interrupts generated by the benchmark */
+struct TickTimer
+{
+  struct Timer base;
+
+  void (*callback)(void *);
+  void *callbackArgument;
+};
+#endif
+
+#ifdef BENCH_WQ_UNIQUE
+struct UniqueContext
+{
+  void *wq;
+  size_t distinct;
+};
+#endif
+/*----------------------------------------------------------------------------*/
+[[maybe_unused]] static void countTask(void *);
+[[maybe_unused]] static void runLoop(void *, size_t);
+[[maybe_unused]] static void stopTask(void *);
+
+#ifdef BENCH_WQ_DELAYED
+static void runDelayed(void *, size_t);
+static void tickTask(void *);
+static void tickStopTask(void *);
+
+static enum Result tickInit(void *, const void *);
+static void tickEnable(void *);
+static void tickDisable(void *);
+static void tickSetCallback(void *, void (*)(void *), void *);
+#endif
+
+#ifdef BENCH_WQ_IRQ
+static void runIrq(void *, size_t);
+#endif
+
+#ifdef BENCH_WQ_UNIQUE
+static void runUnique(void *, size_t);
+static void runUniqueCase(const char *, size_t);
+#endif
+/*----------------------------------------------------------------------------*/
+static volatile uint32_t counters[BATCH_SIZE];
+
+#ifdef BENCH_WQ_UNIQUE
+static volatile uint32_t uniqueCounters[UNIQUE_MAX];
+#endif
+
+#ifdef BENCH_WQ_DELAYED
+static const struct TimerClass * const TickTimer =
+    &(const struct TimerClass){
+    .size = sizeof(struct TickTimer),
+    .init = tickInit,
+    .deinit = NULL,
+
+    .enable = tickEnable,
+    .disable = tickDisable,
+    .setAutostop = NULL,
+    .setCallback = tickSetCallback,
+    .getFrequency = NULL,
+    .setFrequency = NULL,
+    .getOverflow = NULL,
+    .setOverflow = NULL,
+    .getValue = NULL,
+    .setValue = NULL
+};
+
+static struct WqDelayedTask delayed[BATCH_SIZE + 1];
+static struct TickTimer *ticker;
+static bool tickerPending;
+static bool tickerStopped;
+#endif
+/*----------------------------------------------------------------------------*/
+[[maybe_unused]] static void countTask(void *argument)
+{
+  ++*(volatile uint32_t *)argument;
+}
+/*----------------------------------------------------------------------------*/
+[[maybe_unused]] static void runLoop(void *argument, size_t iterations)
+{
+  while (iterations)
+  {
+    const size_t count = iterations < BATCH_SIZE ? iterations : BATCH_SIZE;
+
+    /*
+     * Distinct arguments keep all tasks pending in unique queues,
+     * the last task terminates the dispatch loop.
+     */
+    for (size_t index = 0; index < count; ++index)
+    {
+      if (wqAdd(argument, countTask, (void *)&counters[index]) != E_OK)
+        abort();
+    }
+    if (wqAdd(argument, stopTask, argument) != E_OK)
+      abort();
+
+    wqStart(argument);
+    iterations -= count;
+  }
+}
+/*----------------------------------------------------------------------------*/
+[[maybe_unused]] static void stopTask(void *argument)
+{
+  wqStop(argument);
+}
+/*----------------------------------------------------------------------------*/
+#ifdef BENCH_WQ_DELAYED
+static void runDelayed(void *argument, size_t iterations)
+{
+  while (iterations)
+  {
+    const size_t count = iterations < BATCH_SIZE ? iterations : BATCH_SIZE;
+
+    /* Deadlines are spread over several ticks of the timer */
+    for (size_t index = 0; index < count; ++index)
+    {
+      if (wqAddDelayed(argument, &delayed[index], countTask,
+          (void *)&counters[index], index % DELAY_SPAN) != E_OK)
+      {
+        abort();
+      }
+    }
+    if (wqAddDelayed(argument, &delayed[BATCH_SIZE], tickStopTask, argument,
+        DELAY_SPAN) != E_OK)
+    {
+      abort();
+    }
+
+    /* Timer ticks are generated by a regular task of the same queue */
+    tickerStopped = false;
+    if (!tickerPending)
+    {
+      tickerPending = true;
+      if (wqAdd(argument, tickTask, argument) != E_OK)
+        abort();
+    }
+
+    wqStart(argument);
+    iterations -= count;
+  }
+}
+/*----------------------------------------------------------------------------*/
+static void tickTask(void *argument)
+{
+  if (!tickerStopped)
+  {
+    if (ticker->callback != NULL)
+      ticker->callback(ticker->callbackArgument);
+
+    if (wqAdd(argument, tickTask, argument) != E_OK)
+      abort();
+  }
+  else
+    tickerPending = false;
+}
+/*----------------------------------------------------------------------------*/
+static void tickStopTask(void *argument)
+{
+  tickerStopped = true;
+  wqStop(argument);
+}
+/*----------------------------------------------------------------------------*/
+static enum Result tickInit(void *object, const void *)
+{
+  struct TickTimer * const timer = object;
+
+  timer->callback = NULL;
+  timer->callbackArgument = NULL;
+  return E_OK;
+}
+/*----------------------------------------------------------------------------*/
+static void tickEnable(void *)
+{
+}
+/*----------------------------------------------------------------------------*/
+static void tickDisable(void *)
+{
+}
+/*----------------------------------------------------------------------------*/
+static void tickSetCallback(void *object, void (*callback)(void *),
+    void *argument)
+{
+  struct TickTimer * const timer = object;
+
+  timer->callbackArgument = argument;
+  timer->callback = callback;
+}
+#endif
+/*----------------------------------------------------------------------------*/
+#ifdef BENCH_WQ_IRQ
+static void runIrq(void *argument, size_t iterations)
+{
+  while (iterations)
+  {
+    const size_t count = iterations < BATCH_SIZE ? iterations : BATCH_SIZE;
+
+    for (size_t index = 0; index < count; ++index)
+    {
+      if (wqAdd(argument, countTask, (void *)&counters[index]) != E_OK)
+        abort();
+    }
+
+    /* Interrupts are not available on the host, run the handler directly */
+    wqIrqUpdate(argument);
+    iterations -= count;
+  }
+}
+#endif
+/*----------------------------------------------------------------------------*/
+#ifdef BENCH_WQ_UNIQUE
+static void runUnique(void *argument, size_t iterations)
+{
+  const struct UniqueContext * const context = argument;
+
+  while (iterations)
+  {
+    const size_t count = iterations < context->distinct ?
+        iterations : context->distinct;
+
+    /* Each task is known to the queue, lookup cost depends on the count */
+    for (size_t index = 0; index < count; ++index)
+    {
+      if (wqAdd(context->wq, countTask, (void *)&uniqueCounters[index])
+          != E_OK)
+      {
+        abort();
+      }
+    }
+    if (wqAdd(context->wq, stopTask, context->wq) != E_OK)
+      abort();
+
+    wqStart(context->wq);
+    iterations -= count;
+  }
+}
+/*----------------------------------------------------------------------------*/
+static void runUniqueCase(const char *name, size_t distinct)
+{
+  struct UniqueContext context = {
+      .wq = init(WorkQueueUnique,
+          &(struct WorkQueueUniqueConfig){UNIQUE_MAX + 1}),
+      .distinct = distinct
+  };
+
+  if (context.wq == NULL)
+    abort();
+
+  benchRun(&(const struct BenchCase){
+      .name = name,
+      .run = runUnique,
+      .argument = &context,
+      .iterations = 200000
+  });
+
+  deinit(context.wq);
+}
+#endif
+/*----------------------------------------------------------------------------*/
+#if defined(CONFIG_GENERIC_WQ_PM) && !defined(CONFIG_PM)
+void pmChangeState(enum PmState)
+{
+  /* Dispatch loop is never idle during the benchmark */
+}
+#endif
+/*----------------------------------------------------------------------------*/
+WqCounter wqGetTime(void)
+{
+  return (WqCounter)(benchTime() / 1000);
+}
+/*----------------------------------------------------------------------------*/
+void benchWorkQueue(void)
+{
+#ifdef BENCH_WQ
+  struct WorkQueue * const wq = init(WorkQueue,
+      &(struct WorkQueueConfig){.size = BATCH_SIZE + 1});
+
+  if (wq == NULL)
+    abort();
+
+  benchRun(&(const struct BenchCase){
+      .name = "work_queue.dispatch",
+      .run = runLoop,
+      .argument = wq,
+      .iterations = 200000
+  });
+
+  deinit(wq);
+#endif
+
+#ifdef BENCH_WQ_DELAYED
+  ticker = init(TickTimer, NULL);
+
+  if (ticker == NULL)
+    abort();
+
+  struct WorkQueue * const wqDelayed = init(WorkQueue,
+      &(struct WorkQueueConfig){
+          .size = BATCH_SIZE + 1,
+          .delayed = BATCH_SIZE + 1,
+          .timer = ticker
+      });
+
+  if (wqDelayed == NULL)
+    abort();
+
+  benchRun(&(const struct BenchCase){
+      .name = "work_queue.delayed",
+      .run = runDelayed,
+      .argument = wqDelayed,
+      .iterations = 200000
+  });
+
+  deinit(wqDelayed);
+  deinit(ticker);
+#endif
+
+#ifdef BENCH_WQ_IRQ
+  struct WorkQueue * const wqIrq = init(WorkQueueIrq,
+      &(struct WorkQueueIrqConfig){BATCH_SIZE, 0, 0});
+
+  if (wqIrq == NULL)
+    abort();
+  wqStart(wqIrq);
+
+  benchRun(&(const struct BenchCase){
+      .name = "work_queue_irq.dispatch",
+      .run = runIrq,
+      .argument = wqIrq,
+      .iterations = 200000
+  });
+
+  deinit(wqIrq);
+#endif
+
+#ifdef BENCH_WQ_UNIQUE
+  struct WorkQueue * const wqUnique = init(WorkQueueUnique,
+      &(struct WorkQueueUniqueConfig){BATCH_SIZE + 1});
+
+  if (wqUnique == NULL)
+    abort();
+
+  benchRun(&(const struct BenchCase){
+      .name = "work_queue_unique.dispatch",
+      .run = runLoop,
+      .argument = wqUnique,
+      .iterations = 200000
+  });
+
+  deinit(wqUnique);
+
+  runUniqueCase("work_queue_unique.add_8", 8);
+  runUniqueCase("work_queue_unique.add_64", 64);
+  runUniqueCase("work_queue_unique.add_512", 512);
+#endif
+}
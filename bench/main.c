@@ -0,0 +1,106 @@
+/*
+ * main.c
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the MIT License
+ */
+
+#include "bench.h"
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+/*----------------------------------------------------------------------------*/
+#define SAMPLE_COUNT 7
+/*----------------------------------------------------------------------------*/
+static int compareSamples(const void *, const void *);
+/*----------------------------------------------------------------------------*/
+static const char *filter = NULL;
+static size_t reported = 0;
+/*----------------------------------------------------------------------------*/
+static int compareSamples(const void *a, const void *b)
+{
+  const uint64_t x = *(const uint64_t *)a;
+  const uint64_t y = *(const uint64_t *)b;
+
+  return (x > y) - (x < y);
+}
+/*----------------------------------------------------------------------------*/
+void benchRun(const struct BenchCase *entry)
+{
+  if (filter != NULL && strstr(entry->name, filter) == NULL)
+    return;
+
+  uint64_t samples[SAMPLE_COUNT];
+
+  /* Warm up caches and branch predictors, the first pass is discarded */
+  entry->run(entry->argument, entry->iterations);
+
+  for (size_t index = 0; index < SAMPLE_COUNT; ++index)
+  {
+    const uint64_t begin = benchTime();
+    entry->run(entry->argument, entry->iterations);
+    samples[index] = benchTime() - begin;
+  }
+
+  qsort(samples, SAMPLE_COUNT, sizeof(samples[0]), compareSamples);
+
+  /* Minimum is the least noisy estimate, median shows the spread */
+  const uint64_t best = samples[0] ? samples[0] : 1;
+  const uint64_t median = samples[SAMPLE_COUNT / 2];
+  const double seconds = (double)best / 1e9;
+  const double operations = (double)entry->iterations;
+
+  printf("%s\n    {\"name\": \"%s\", \"iterations\": %zu, "
+      "\"min_ns\": %" PRIu64 ", \"median_ns\": %" PRIu64 ", "
+      "\"ns_per_op\": %.3f, \"ops_per_sec\": %.1f",
+      reported ? "," : "", entry->name, entry->iterations, best, median,
+      (double)best / operations, operations / seconds);
+
+  if (entry->bytes)
+  {
+    printf(", \"bytes_per_sec\": %.1f",
+        operations * (double)entry->bytes / seconds);
+  }
+
+  printf("}");
+  ++reported;
+}
+/*----------------------------------------------------------------------------*/
+uint64_t benchTime(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+/*----------------------------------------------------------------------------*/
+int main(int argc, char *argv[])
+{
+  /* Optional argument selects cases containing the given substring */
+  if (argc > 1)
+    filter = argv[1];
+
+  printf("{\n  \"samples\": %d,\n  \"results\": [", SAMPLE_COUNT);
+
+  benchBlockPool();
+  benchClock();
+  benchCrc();
+  benchDma();
+  benchFlashScheduler();
+  benchGovernor();
+  benchIdle();
+  benchInstrumentedProxy();
+  benchMemoryRegion();
+  benchMmcsd();
+  benchMpu();
+  benchNor();
+  benchProxy();
+  benchSdioSpi();
+  benchTimer();
+  benchUsb();
+  benchWorkQueue();
+
+  printf("\n  ]\n}\n");
+  return EXIT_SUCCESS;
+}
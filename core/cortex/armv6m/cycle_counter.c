@@ -0,0 +1,194 @@
+/*
+ * cycle_counter.c
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the MIT License
+ */
+
+#include <halm/core/core_defs.h>
+#include <halm/core/cortex/cycle_counter.h>
+#include <halm/core/cortex/scb_defs.h>
+#include <halm/core/cortex/systick.h>
+#include <halm/core/cortex/systick_defs.h>
+#include <halm/irq.h>
+#include <assert.h>
+
+#ifdef CONFIG_CORE_CORTEX_CYCLE_COUNTER_WQ
+#  include <halm/wq.h>
+#endif
+/*----------------------------------------------------------------------------*/
+/* SysTick is initialized with the full reload range */
+#define PERIOD (TIMER_RESOLUTION + 1)
+/*----------------------------------------------------------------------------*/
+static void onTimerOverflow(void *);
+static uint64_t readCounter(const struct CycleCounter *);
+static bool setInstance(struct CycleCounter *);
+/*----------------------------------------------------------------------------*/
+static enum Result tmrInit(void *, const void *);
+static void tmrEnable(void *);
+static void tmrDisable(void *);
+static uint32_t tmrGetFrequency(const void *);
+static uint32_t tmrGetOverflow(const void *);
+static uint32_t tmrGetValue(const void *);
+static void tmrSetValue(void *, uint32_t);
+static uint64_t tmrGetValue64(const void *);
+static void tmrSetValue64(void *, uint64_t);
+
+#ifndef CONFIG_CORE_CORTEX_CYCLE_COUNTER_NO_DEINIT
+static void tmrDeinit(void *);
+#else
+#  define tmrDeinit deletedDestructorTrap
+#endif
+/*----------------------------------------------------------------------------*/
+const struct Timer64Class * const CycleCounter =
+    &(const struct Timer64Class){
+    .base = {
+        .size = sizeof(struct CycleCounter),
+        .init = tmrInit,
+        .deinit = tmrDeinit,
+
+        .enable = tmrEnable,
+        .disable = tmrDisable,
+        .setAutostop = NULL,
+        .setCallback = NULL,
+        .getFrequency = tmrGetFrequency,
+        .setFrequency = NULL,
+        .getOverflow = tmrGetOverflow,
+        .setOverflow = NULL,
+        .getValue = tmrGetValue,
+        .setValue = tmrSetValue
+    },
+
+    .getValue64 = tmrGetValue64,
+    .setValue64 = tmrSetValue64
+};
+/*----------------------------------------------------------------------------*/
+static struct CycleCounter *instance = NULL;
+/*----------------------------------------------------------------------------*/
+static void onTimerOverflow(void *object)
+{
+  struct CycleCounter * const timer = object;
+  timer->epoch += PERIOD;
+}
+/*----------------------------------------------------------------------------*/
+static uint64_t readCounter(const struct CycleCounter *timer)
+{
+  const IrqState state = irqSave();
+  uint64_t epoch = timer->epoch;
+  uint32_t value = timerGetValue(timer->timer);
+
+  /*
+   * Overflow interrupt could be pending while interrupts are disabled,
+   * the counter is read again to get the value after the overflow.
+   */
+  if (SCB->ICSR & ICSR_PENDSTSET)
+  {
+    epoch += PERIOD;
+    value = timerGetValue(timer->timer);
+  }
+
+  irqRestore(state);
+  return epoch + value;
+}
+/*----------------------------------------------------------------------------*/
+static bool setInstance(struct CycleCounter *object)
+{
+  if (instance == NULL)
+  {
+    instance = object;
+    return true;
+  }
+  else
+    return false;
+}
+/*----------------------------------------------------------------------------*/
+#ifdef CONFIG_CORE_CORTEX_CYCLE_COUNTER_WQ
+[[gnu::weak]] WqCounter wqGetTime(void)
+{
+  return instance != NULL ? (WqCounter)readCounter(instance) : 0;
+}
+#endif
+/*----------------------------------------------------------------------------*/
+static enum Result tmrInit(void *object, const void *)
+{
+  struct CycleCounter * const timer = object;
+
+  if (!setInstance(timer))
+    return E_BUSY;
+
+  /* SysTick is used exclusively, the counter is extended in the handler */
+  timer->timer = init(SysTick, NULL);
+  if (timer->timer == NULL)
+  {
+    instance = NULL;
+    return E_BUSY;
+  }
+
+  timer->epoch = 0;
+  timer->last = 0;
+
+  timerSetCallback(timer->timer, onTimerOverflow, timer);
+
+  return E_OK;
+}
+/*----------------------------------------------------------------------------*/
+#ifndef CONFIG_CORE_CORTEX_CYCLE_COUNTER_NO_DEINIT
+static void tmrDeinit(void *object)
+{
+  struct CycleCounter * const timer = object;
+
+  deinit(timer->timer);
+  instance = NULL;
+}
+#endif
+/*----------------------------------------------------------------------------*/
+static void tmrEnable(void *object)
+{
+  struct CycleCounter * const timer = object;
+  timerEnable(timer->timer);
+}
+/*----------------------------------------------------------------------------*/
+static void tmrDisable(void *object)
+{
+  struct CycleCounter * const timer = object;
+  timerDisable(timer->timer);
+}
+/*----------------------------------------------------------------------------*/
+static uint32_t tmrGetFrequency(const void *object)
+{
+  const struct CycleCounter * const timer = object;
+  return timerGetFrequency(timer->timer);
+}
+/*----------------------------------------------------------------------------*/
+static uint32_t tmrGetOverflow(const void *)
+{
+  /* Lower part of the extended counter uses the full 32-bit range */
+  return 0;
+}
+/*----------------------------------------------------------------------------*/
+static uint32_t tmrGetValue(const void *object)
+{
+  return (uint32_t)readCounter(object);
+}
+/*----------------------------------------------------------------------------*/
+static void tmrSetValue(void *object, uint32_t value)
+{
+  tmrSetValue64(object, value);
+}
+/*----------------------------------------------------------------------------*/
+static uint64_t tmrGetValue64(const void *object)
+{
+  return readCounter(object);
+}
+/*----------------------------------------------------------------------------*/
+static void tmrSetValue64(void *object, uint64_t value)
+{
+  struct CycleCounter * const timer = object;
+  const IrqState state = irqSave();
+
+  /* Pending overflow is discarded together with the hardware counter */
+  timerSetValue(timer->timer, 0);
+  SCB->ICSR = ICSR_PENDSTCLR;
+  timer->epoch = value;
+
+  irqRestore(state);
+}
@@ -0,0 +1,181 @@
+/*
+ * cycle_counter.c
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the MIT License
+ */
+
+#include <halm/clock.h>
+#include <halm/core/core_defs.h>
+#include <halm/core/cortex/armv7m/dwt_defs.h>
+#include <halm/core/cortex/cycle_counter.h>
+#include <halm/core/cortex/scb_defs.h>
+#include <halm/irq.h>
+#include <assert.h>
+
+#ifdef CONFIG_CORE_CORTEX_CYCLE_COUNTER_WQ
+#  include <halm/wq.h>
+#endif
+/*----------------------------------------------------------------------------*/
+static uint64_t readCounter(struct CycleCounter *);
+static bool setInstance(struct CycleCounter *);
+/*----------------------------------------------------------------------------*/
+static enum Result tmrInit(void *, const void *);
+static void tmrEnable(void *);
+static void tmrDisable(void *);
+static uint32_t tmrGetFrequency(const void *);
+static uint32_t tmrGetOverflow(const void *);
+static uint32_t tmrGetValue(const void *);
+static void tmrSetValue(void *, uint32_t);
+static uint64_t tmrGetValue64(const void *);
+static void tmrSetValue64(void *, uint64_t);
+
+#ifndef CONFIG_CORE_CORTEX_CYCLE_COUNTER_NO_DEINIT
+static void tmrDeinit(void *);
+#else
+#  define tmrDeinit deletedDestructorTrap
+#endif
+/*----------------------------------------------------------------------------*/
+const struct Timer64Class * const CycleCounter =
+    &(const struct Timer64Class){
+    .base = {
+        .size = sizeof(struct CycleCounter),
+        .init = tmrInit,
+        .deinit = tmrDeinit,
+
+        .enable = tmrEnable,
+        .disable = tmrDisable,
+        .setAutostop = NULL,
+        .setCallback = NULL,
+        .getFrequency = tmrGetFrequency,
+        .setFrequency = NULL,
+        .getOverflow = tmrGetOverflow,
+        .setOverflow = NULL,
+        .getValue = tmrGetValue,
+        .setValue = tmrSetValue
+    },
+
+    .getValue64 = tmrGetValue64,
+    .setValue64 = tmrSetValue64
+};
+/*----------------------------------------------------------------------------*/
+extern const struct ClockClass * const MainClock;
+static struct CycleCounter *instance = NULL;
+/*----------------------------------------------------------------------------*/
+static uint64_t readCounter(struct CycleCounter *timer)
+{
+  const IrqState state = irqSave();
+  const uint32_t value = DWT->CYCCNT;
+
+  /* Overflow is detected when the counter is lower than the previous value */
+  if (value < timer->last)
+    timer->epoch += 1ULL << 32;
+  timer->last = value;
+
+  const uint64_t result = timer->epoch + value;
+
+  irqRestore(state);
+  return result;
+}
+/*----------------------------------------------------------------------------*/
+static bool setInstance(struct CycleCounter *object)
+{
+  if (instance == NULL)
+  {
+    instance = object;
+    return true;
+  }
+  else
+    return false;
+}
+/*----------------------------------------------------------------------------*/
+#ifdef CONFIG_CORE_CORTEX_CYCLE_COUNTER_WQ
+[[gnu::weak]] WqCounter wqGetTime(void)
+{
+  /* Counter wraps around, differences of timestamps remain correct */
+  return instance != NULL ? (WqCounter)DWT->CYCCNT : 0;
+}
+#endif
+/*----------------------------------------------------------------------------*/
+static enum Result tmrInit(void *object, const void *)
+{
+  struct CycleCounter * const timer = object;
+
+  if (!setInstance(timer))
+    return E_BUSY;
+
+  /* Enable the DWT unit, software unlock is required on Cortex-M7 only */
+  SCB->DEMCR |= DEMCR_TRCENA;
+  DWT->LAR = LAR_KEY;
+
+  if (DWT->CTRL & CTRL_NOCYCCNT)
+  {
+    instance = NULL;
+    return E_DEVICE;
+  }
+
+  timer->timer = NULL;
+  timer->epoch = 0;
+  timer->last = 0;
+
+  /* Configure the counter but leave it in the disabled state */
+  DWT->CTRL &= ~CTRL_CYCCNTENA;
+  DWT->CYCCNT = 0;
+
+  return E_OK;
+}
+/*----------------------------------------------------------------------------*/
+#ifndef CONFIG_CORE_CORTEX_CYCLE_COUNTER_NO_DEINIT
+static void tmrDeinit(void *)
+{
+  DWT->CTRL &= ~CTRL_CYCCNTENA;
+  instance = NULL;
+}
+#endif
+/*----------------------------------------------------------------------------*/
+static void tmrEnable(void *)
+{
+  DWT->CTRL |= CTRL_CYCCNTENA;
+}
+/*----------------------------------------------------------------------------*/
+static void tmrDisable(void *)
+{
+  DWT->CTRL &= ~CTRL_CYCCNTENA;
+}
+/*----------------------------------------------------------------------------*/
+static uint32_t tmrGetFrequency(const void *)
+{
+  return clockFrequency(MainClock);
+}
+/*----------------------------------------------------------------------------*/
+static uint32_t tmrGetOverflow(const void *)
+{
+  /* Counter uses the full 32-bit range */
+  return 0;
+}
+/*----------------------------------------------------------------------------*/
+static uint32_t tmrGetValue(const void *)
+{
+  return DWT->CYCCNT;
+}
+/*----------------------------------------------------------------------------*/
+static void tmrSetValue(void *object, uint32_t value)
+{
+  tmrSetValue64(object, value);
+}
+/*----------------------------------------------------------------------------*/
+static uint64_t tmrGetValue64(const void *)
+{
+  return readCounter(instance);
+}
+/*----------------------------------------------------------------------------*/
+static void tmrSetValue64(void *object, uint64_t value)
+{
+  struct CycleCounter * const timer = object;
+  const IrqState state = irqSave();
+
+  DWT->CYCCNT = (uint32_t)value;
+  timer->epoch = value & ~(uint64_t)UINT32_MAX;
+  timer->last = (uint32_t)value;
+
+  irqRestore(state);
+}
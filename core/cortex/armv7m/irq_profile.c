@@ -0,0 +1,256 @@
+/*
+ * irq_profile.c
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the MIT License
+ */
+
+#include <halm/core/core_defs.h>
+#include <halm/core/cortex/armv7m/dwt_defs.h>
+#include <halm/core/cortex/irq_profile.h>
+#include <halm/core/cortex/nvic.h>
+#include <halm/core/cortex/scb_defs.h>
+#include <xcore/bits.h>
+#include <stdlib.h>
+#include <string.h>
+/*----------------------------------------------------------------------------*/
+#define CORE_VECTORS  16
+#define MAX_VECTORS   256
+#define MAX_GROUPS    ((MAX_VECTORS - CORE_VECTORS + 31) >> 5)
+/*----------------------------------------------------------------------------*/
+typedef void (*IsrHandler)(void);
+
+struct IrqRecord
+{
+  struct IrqInfo info;
+
+  /* Time when the interrupt was observed pending */
+  uint32_t timestamp;
+};
+/*----------------------------------------------------------------------------*/
+static void clearRecord(struct IrqRecord *, IrqNumber);
+static void dispatchInterrupt(void);
+static void markPendingInterrupts(uint32_t);
+static void updateLatency(struct IrqRecord *, uint32_t);
+static void updateRecord(struct IrqRecord *, uint32_t, uint8_t);
+/*----------------------------------------------------------------------------*/
+static struct
+{
+  /* Original vector table */
+  const IsrHandler *original;
+  /* Profiling data for external interrupts */
+  struct IrqRecord *records;
+  /* Number of external interrupts */
+  size_t count;
+  /* Interrupts observed pending with valid timestamps */
+  uint32_t marked[MAX_GROUPS];
+
+  /* Total time of handlers that preempted the current handler */
+  uint32_t nested;
+  /* Current nesting depth */
+  uint8_t depth;
+} profile = {
+    .original = NULL,
+    .records = NULL,
+    .count = 0,
+    .marked = {0},
+    .nested = 0,
+    .depth = 0
+};
+
+/* Vector table should be aligned on the table size rounded up to power of 2 */
+[[gnu::aligned(MAX_VECTORS * sizeof(IsrHandler))]]
+    static IsrHandler table[MAX_VECTORS];
+/*----------------------------------------------------------------------------*/
+static void clearRecord(struct IrqRecord *record, IrqNumber irq)
+{
+  memset(record, 0, sizeof(*record));
+
+  record->info.irq = irq;
+  record->info.execution.min = UINT32_MAX;
+}
+/*----------------------------------------------------------------------------*/
+static void dispatchInterrupt(void)
+{
+  const size_t index = ICSR_VECTACTIVE_VALUE(SCB->ICSR) - CORE_VECTORS;
+  struct IrqRecord * const record = &profile.records[index];
+  uint32_t * const marked = &profile.marked[index >> 5];
+  const uint32_t mask = BIT(index & 31);
+  IrqState state;
+
+  state = irqSave();
+
+  const uint32_t begin = DWT->CYCCNT;
+  const uint32_t nested = profile.nested;
+  const uint8_t depth = ++profile.depth;
+
+  if (*marked & mask)
+  {
+    *marked &= ~mask;
+    updateLatency(record, begin - record->timestamp);
+  }
+
+  irqRestore(state);
+
+  profile.original[index + CORE_VECTORS]();
+
+  state = irqSave();
+
+  const uint32_t end = DWT->CYCCNT;
+  const uint32_t elapsed = end - begin;
+
+  /* Preempted handler excludes the whole time of this handler */
+  const uint32_t execution = elapsed - (profile.nested - nested);
+  profile.nested = nested + elapsed;
+  --profile.depth;
+
+  updateRecord(record, execution, depth);
+  markPendingInterrupts(end);
+
+  irqRestore(state);
+}
+/*----------------------------------------------------------------------------*/
+static void markPendingInterrupts(uint32_t timestamp)
+{
+  const size_t groups = (profile.count + 31) >> 5;
+
+  for (size_t group = 0; group < groups; ++group)
+  {
+    /* Disabled interrupts are ignored */
+    const uint32_t pending = NVIC->ISPR[group] & NVIC->ISER[group];
+    uint32_t added = pending & ~profile.marked[group];
+
+    /*
+     * Marks of interrupts that are no longer pending are dropped, pending
+     * state could be cleared by software without running the handler.
+     */
+    profile.marked[group] = pending;
+
+    while (added)
+    {
+      const unsigned int bit = 31 - countLeadingZeros32(added);
+
+      added &= ~BIT(bit);
+      profile.records[(group << 5) + bit].timestamp = timestamp;
+    }
+  }
+}
+/*----------------------------------------------------------------------------*/
+static void updateLatency(struct IrqRecord *record, uint32_t latency)
+{
+  struct IrqInfo * const info = &record->info;
+
+  ++info->latency.count;
+  if (info->latency.max < latency)
+    info->latency.max = latency;
+  info->latency.total += latency;
+}
+/*----------------------------------------------------------------------------*/
+static void updateRecord(struct IrqRecord *record, uint32_t execution,
+    uint8_t depth)
+{
+  struct IrqInfo * const info = &record->info;
+  unsigned int bucket = execution ? 31 - countLeadingZeros32(execution) : 0;
+
+  if (bucket >= IRQ_PROFILE_BUCKETS)
+    bucket = IRQ_PROFILE_BUCKETS - 1;
+
+  ++info->count;
+  ++info->histogram[bucket];
+
+  if (info->depth < depth)
+    info->depth = depth;
+
+  if (info->execution.min > execution)
+    info->execution.min = execution;
+  if (info->execution.max < execution)
+    info->execution.max = execution;
+  info->execution.total += execution;
+}
+/*----------------------------------------------------------------------------*/
+enum Result irqProfileInit(void)
+{
+  if (profile.records != NULL)
+    return E_BUSY;
+
+  /* Enable the cycle counter */
+  SCB->DEMCR |= DEMCR_TRCENA;
+  DWT->LAR = LAR_KEY;
+
+  if (DWT->CTRL & CTRL_NOCYCCNT)
+    return E_DEVICE;
+  DWT->CTRL |= CTRL_CYCCNTENA;
+
+  const size_t count = MIN((ICTR_INTLINESNUM_VALUE(SCB->ICTR) + 1) << 5,
+      MAX_VECTORS - CORE_VECTORS);
+  struct IrqRecord * const records = malloc(count * sizeof(struct IrqRecord));
+
+  if (records == NULL)
+    return E_MEMORY;
+
+  for (size_t index = 0; index < count; ++index)
+    clearRecord(&records[index], (IrqNumber)index);
+
+  /* Address of the current table is read at run time */
+  const IsrHandler * const original = (const IsrHandler *)(uintptr_t)SCB->VTOR;
+
+  for (size_t index = 0; index < CORE_VECTORS; ++index)
+    table[index] = original[index];
+  for (size_t index = CORE_VECTORS; index < CORE_VECTORS + count; ++index)
+    table[index] = dispatchInterrupt;
+
+  const IrqState state = irqSave();
+
+  profile.original = original;
+  profile.records = records;
+  profile.count = count;
+  profile.nested = 0;
+  profile.depth = 0;
+  memset(profile.marked, 0, sizeof(profile.marked));
+  nvicSetVectorTableOffset((uint32_t)(uintptr_t)table);
+
+  irqRestore(state);
+  return E_OK;
+}
+/*----------------------------------------------------------------------------*/
+void irqProfileDeinit(void)
+{
+  if (profile.records == NULL)
+    return;
+
+  const IrqState state = irqSave();
+  struct IrqRecord * const records = profile.records;
+
+  nvicSetVectorTableOffset((uint32_t)(uintptr_t)profile.original);
+  profile.records = NULL;
+  profile.count = 0;
+
+  irqRestore(state);
+  free(records);
+}
+/*----------------------------------------------------------------------------*/
+void irqProfile(IrqProfileCallback callback, void *argument)
+{
+  for (size_t index = 0; index < profile.count; ++index)
+  {
+    const IrqState state = irqSave();
+    const struct IrqInfo info = profile.records[index].info;
+    irqRestore(state);
+
+    if (info.count)
+      callback(argument, &info);
+  }
+}
+/*----------------------------------------------------------------------------*/
+void irqProfileReset(void)
+{
+  for (size_t index = 0; index < profile.count; ++index)
+  {
+    const IrqState state = irqSave();
+
+    /* Timestamp of the pending interrupt is cleared with the record */
+    clearRecord(&profile.records[index], (IrqNumber)index);
+    profile.marked[index >> 5] &= ~BIT(index & 31);
+
+    irqRestore(state);
+  }
+}
@@ -13,7 +13,9 @@
 /*----------------------------------------------------------------------------*/
 static bool computeAttributedRegion(uintptr_t, size_t, uint32_t,
     struct MpuRegionConfig *);
+static size_t countFreeRegions(void);
 static MpuRegion findFreeRegion(void);
+static inline bool isRegionFree(unsigned int);
 /*----------------------------------------------------------------------------*/
 /**
  * Compute MPU region parameters with given attributes.
@@ -93,12 +95,32 @@ static bool computeAttributedRegion(uintptr_t address, size_t size,
   return true;
 }
 /*----------------------------------------------------------------------------*/
+/**
+ * Count free (unused) regions in the Memory Protection Unit.
+ *
+ * @return Number of regions that are currently disabled.
+ */
+static size_t countFreeRegions(void)
+{
+  const unsigned int count = TYPE_DREGION_VALUE(MPU->TYPE);
+  size_t available = 0;
+
+  __dsb();
+
+  for (unsigned int index = 0; index < count; ++index)
+  {
+    if (isRegionFree(index))
+      ++available;
+  }
+
+  return available;
+}
+/*----------------------------------------------------------------------------*/
 /**
  * Find a free (unused) region in the Memory Protection Unit.
  *
  * Scans all available MPU regions and returns the index of the first region
- * that is currently disabled. A region is considered free if both
- * the enable bit and the size field are zero in its RASR register.
+ * that is currently disabled.
  *
  * @return Index of the first free MPU region if found or -1 if no free regions
  * are available.
@@ -111,15 +133,29 @@ static MpuRegion findFreeRegion(void)
 
   for (unsigned int index = 0; index < count; ++index)
   {
-    MPU->RNR = index;
-
-    if (!(MPU->RASR & (RASR_ENABLE | RASR_SIZE_MASK)))
+    if (isRegionFree(index))
       return index;
   }
 
   return -1;
 }
 /*----------------------------------------------------------------------------*/
+/**
+ * Check whether the region of the Memory Protection Unit is free (unused).
+ *
+ * A region is considered free if both the enable bit and the size field
+ * are zero in its RASR register. Function selects the region in the RNR
+ * register as a side effect.
+ *
+ * @param index Index of the MPU region.
+ * @return @b true when the region is currently disabled.
+ */
+static inline bool isRegionFree(unsigned int index)
+{
+  MPU->RNR = index;
+  return !(MPU->RASR & (RASR_ENABLE | RASR_SIZE_MASK));
+}
+/*----------------------------------------------------------------------------*/
 /**
  * Add a new region to the Memory Protection Unit.
  *
@@ -160,6 +196,45 @@ MpuRegion mpuAddRegion(uintptr_t address, size_t size, enum MpuPreset preset,
   return region;
 }
 /*----------------------------------------------------------------------------*/
+/**
+ * Add a set of precomputed regions to the Memory Protection Unit.
+ *
+ * Regions are assigned to free region slots in the order of the array.
+ * Nothing is changed when the number of free slots is insufficient for
+ * the whole set.
+ *
+ * @param configs Array of region configurations, for example computed
+ * by the region planner.
+ * @param count Number of elements in the array.
+ * @param regions Optional array where identifiers of the added regions
+ * will be stored.
+ * @return @b true if all regions were added or @b false if there are not
+ * enough free regions.
+ */
+bool mpuAddRegions(const struct MpuRegionConfig *configs, size_t count,
+    MpuRegion *regions)
+{
+  if (countFreeRegions() < count)
+    return false;
+
+  for (size_t index = 0; index < count; ++index)
+  {
+    const MpuRegion region = findFreeRegion();
+
+    /* RNR register is already initialized by findFreeRegion() */
+    MPU->RBAR = configs[index].address;
+    MPU->RASR = configs[index].control;
+
+    if (regions != NULL)
+      regions[index] = region;
+  }
+
+  __dsb();
+  __isb();
+
+  return true;
+}
+/*----------------------------------------------------------------------------*/
 /**
  * Compute an MPU region configuration based on input parameters.
  *
@@ -183,50 +258,8 @@ bool mpuComputeRegion(uintptr_t address, size_t size, enum MpuPreset preset,
     enum MpuAccessPermission access, bool executable, bool shareable,
     struct MpuRegionConfig *config)
 {
-  static const uint8_t accessPermissionMap[] = {
-      [MPU_ACCESS_FULL] = AP_FULL_ACCESS,
-      [MPU_ACCESS_NONE] = AP_NO_ACCESS,
-      [MPU_ACCESS_READ_ONLY] = AP_READ_ONLY,
-      [MPU_ACCESS_RW_NA] = AP_RW_NA,
-      [MPU_ACCESS_RW_RO] = AP_RW_RO,
-      [MPU_ACCESS_RO_NA] = AP_RO_NA
-  };
-
-  assert(access < ARRAY_SIZE(accessPermissionMap));
-
-  uint32_t attributes = RASR_AP(accessPermissionMap[access]);
-
-  switch (preset)
-  {
-    case MPU_REGION_DEVICE:
-      attributes |= shareable ? RASR_B : RASR_TEX(2);
-      break;
-
-    case MPU_REGION_NORMAL_NONCACHEABLE:
-      attributes |= RASR_TEX(1);
-      break;
-
-    case MPU_REGION_NORMAL_WRITE_BACK:
-      attributes |= RASR_B | RASR_C;
-      break;
-
-    case MPU_REGION_NORMAL_WRITE_BACK_RW_ALLOCATE:
-      attributes |= RASR_B | RASR_C | RASR_TEX(1);
-      break;
-
-    case MPU_REGION_NORMAL_WRITE_THROUGH:
-      attributes |= RASR_C;
-      break;
-
-    default:
-      break;
-  }
-
-  if (shareable && preset != MPU_REGION_DEVICE)
-    attributes |= RASR_S;
-
-  if (!executable)
-    attributes |= RASR_XN;
+  const uint32_t attributes = mpuComputeAttributes(preset, access,
+      executable, shareable);
 
   return computeAttributedRegion(address, size, attributes, config);
 }
@@ -0,0 +1,207 @@
+/*
+ * mpu_planner.c
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the MIT License
+ */
+
+#include <halm/core/cortex/armv7m/mpu_defs.h>
+#include <halm/core/cortex/mpu.h>
+#include <xcore/helpers.h>
+#include <assert.h>
+/*----------------------------------------------------------------------------*/
+#define MIN_REGION_ORDER      5
+#define MAX_REGION_ORDER      32
+#define MIN_SUBREGION_ORDER   8
+#define SUBREGION_COUNT       8
+/*----------------------------------------------------------------------------*/
+static uint64_t planRegion(uint64_t, uint64_t, uint64_t, uint32_t,
+    struct MpuRegionConfig *);
+/*----------------------------------------------------------------------------*/
+/**
+ * Select a region that covers the longest part of the window.
+ *
+ * Checks naturally aligned regions of all sizes that contain the current
+ * position and selects the region that extends the covered part of
+ * the window as far as possible without covering memory outside the window.
+ * Subregions of large regions are disabled to trim the region to the window.
+ *
+ * @param begin Start address of the window.
+ * @param end End address of the window.
+ * @param position Start address of the uncovered part of the window.
+ * @param attributes Pre-computed MPU attribute bits.
+ * @param config Pointer to a structure where the region configuration
+ * will be stored.
+ * @return End address of the covered part of the window or @b position
+ * when no suitable region is found.
+ */
+static uint64_t planRegion(uint64_t begin, uint64_t end, uint64_t position,
+    uint32_t attributes, struct MpuRegionConfig *config)
+{
+  uint64_t covered = position;
+
+  for (unsigned int order = MIN_REGION_ORDER; order <= MAX_REGION_ORDER;
+      ++order)
+  {
+    const uint64_t regionSize = 1ULL << order;
+    const uint64_t regionBegin = position & ~(regionSize - 1);
+    const uint64_t regionEnd = regionBegin + regionSize;
+    uint64_t first;
+    uint64_t last;
+    uint8_t subregions = 0;
+
+    if (order < MIN_SUBREGION_ORDER)
+    {
+      /* Small regions have no subregions and should fit into the window */
+      if (regionBegin < begin || regionEnd > end)
+        continue;
+
+      first = regionBegin;
+      last = regionEnd;
+    }
+    else
+    {
+      const uint64_t subSize = regionSize / SUBREGION_COUNT;
+
+      /* Subregion with the current position may be already covered */
+      first = position & ~(subSize - 1);
+      last = MIN(regionEnd, end & ~(subSize - 1));
+
+      if (first < begin || last <= position)
+        continue;
+
+      /* Disable subregions outside of the window */
+      for (unsigned int sub = 0; sub < SUBREGION_COUNT; ++sub)
+      {
+        const uint64_t subBegin = regionBegin + sub * subSize;
+
+        if (subBegin < first || subBegin >= last)
+          subregions |= 1 << sub;
+      }
+    }
+
+    /* Smaller regions are preferred when the coverage is the same */
+    if (last > covered)
+    {
+      covered = last;
+
+      config->address = (uint32_t)regionBegin;
+      config->control = RASR_ENABLE | RASR_SIZE(order - 1)
+          | RASR_SRD(subregions) | attributes;
+    }
+  }
+
+  return covered;
+}
+/*----------------------------------------------------------------------------*/
+/**
+ * Compute MPU attribute bits based on input parameters.
+ *
+ * @param preset Memory type preset.
+ * @param access Access permissions for privileged and unprivileged modes.
+ * @param executable If @b false, sets the Execute Never bit to prevent
+ * instruction fetches.
+ * @param shareable If @b true and preset is not DEVICE, sets the Shareable bit.
+ * @return Attribute bits of the Region Attribute and Size Register.
+ */
+uint32_t mpuComputeAttributes(enum MpuPreset preset,
+    enum MpuAccessPermission access, bool executable, bool shareable)
+{
+  static const uint8_t accessPermissionMap[] = {
+      [MPU_ACCESS_FULL] = AP_FULL_ACCESS,
+      [MPU_ACCESS_NONE] = AP_NO_ACCESS,
+      [MPU_ACCESS_READ_ONLY] = AP_READ_ONLY,
+      [MPU_ACCESS_RW_NA] = AP_RW_NA,
+      [MPU_ACCESS_RW_RO] = AP_RW_RO,
+      [MPU_ACCESS_RO_NA] = AP_RO_NA
+  };
+
+  assert(access < ARRAY_SIZE(accessPermissionMap));
+
+  uint32_t attributes = RASR_AP(accessPermissionMap[access]);
+
+  switch (preset)
+  {
+    case MPU_REGION_DEVICE:
+      attributes |= shareable ? RASR_B : RASR_TEX(2);
+      break;
+
+    case MPU_REGION_NORMAL_NONCACHEABLE:
+      attributes |= RASR_TEX(1);
+      break;
+
+    case MPU_REGION_NORMAL_WRITE_BACK:
+      attributes |= RASR_B | RASR_C;
+      break;
+
+    case MPU_REGION_NORMAL_WRITE_BACK_RW_ALLOCATE:
+      attributes |= RASR_B | RASR_C | RASR_TEX(1);
+      break;
+
+    case MPU_REGION_NORMAL_WRITE_THROUGH:
+      attributes |= RASR_C;
+      break;
+
+    default:
+      break;
+  }
+
+  if (shareable && preset != MPU_REGION_DEVICE)
+    attributes |= RASR_S;
+
+  if (!executable)
+    attributes |= RASR_XN;
+
+  return attributes;
+}
+/*----------------------------------------------------------------------------*/
+/**
+ * Decompose a memory window into a minimal set of MPU regions.
+ *
+ * Covers an arbitrary window with naturally aligned regions and trims large
+ * regions with Subregion Disable bits, so that memory outside the window
+ * keeps its attributes. Boundaries of the window are expanded to 32 bytes,
+ * which is the minimal region size. Computed regions may overlap, overlapped
+ * parts have the same attributes. Function does not access MPU registers.
+ *
+ * @param address Starting address of the window.
+ * @param size Size of the window in bytes.
+ * @param attributes Pre-computed MPU attribute bits.
+ * @param configs Pointer to an array where region configurations
+ * will be stored.
+ * @param capacity Number of elements in the array.
+ * @return Number of computed regions or zero when the window is empty
+ * or the number of required regions exceeds the capacity of the array.
+ */
+size_t mpuPlanRegions(uintptr_t address, size_t size, uint32_t attributes,
+    struct MpuRegionConfig *configs, size_t capacity)
+{
+  const uint64_t granule = 1ULL << MIN_REGION_ORDER;
+  const uint64_t begin = (uint64_t)address & ~(granule - 1);
+  const uint64_t end = ((uint64_t)address + size + granule - 1)
+      & ~(granule - 1);
+
+  if (!size || end > (1ULL << MAX_REGION_ORDER))
+    return 0;
+
+  uint64_t position = begin;
+  size_t count = 0;
+
+  while (position < end)
+  {
+    struct MpuRegionConfig config;
+
+    if (count == capacity)
+      return 0;
+
+    const uint64_t covered = planRegion(begin, end, position, attributes,
+        &config);
+
+    /* Window boundaries are aligned, minimal region is always suitable */
+    assert(covered > position);
+
+    configs[count++] = config;
+    position = covered;
+  }
+
+  return count;
+}
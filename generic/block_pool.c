@@ -0,0 +1,251 @@
+/*
+ * block_pool.c
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the MIT License
+ */
+
+#include <halm/generic/block_pool.h>
+#include <halm/irq.h>
+#include <assert.h>
+#include <stdalign.h>
+#include <stdlib.h>
+/*----------------------------------------------------------------------------*/
+static inline uintptr_t alignValue(uintptr_t, size_t);
+static size_t getBlockSize(size_t, size_t);
+static size_t getDefaultAlignment(size_t);
+static void initSlab(struct BlockPoolSlab *, uint8_t *, size_t, size_t);
+static void *popBlock(struct BlockPoolSlab *);
+/*----------------------------------------------------------------------------*/
+static enum Result poolInit(void *, const void *);
+static void poolDeinit(void *);
+/*----------------------------------------------------------------------------*/
+const struct EntityClass * const BlockPool = &(const struct EntityClass){
+    .size = sizeof(struct BlockPool),
+    .init = poolInit,
+    .deinit = poolDeinit
+};
+/*----------------------------------------------------------------------------*/
+static inline uintptr_t alignValue(uintptr_t value, size_t alignment)
+{
+  return (value + alignment - 1) & ~(uintptr_t)(alignment - 1);
+}
+/*----------------------------------------------------------------------------*/
+static size_t getBlockSize(size_t size, size_t alignment)
+{
+  /* Free blocks hold a pointer to the next free block */
+  if (size < sizeof(void *))
+    size = sizeof(void *);
+
+  return (size_t)alignValue(size, alignment);
+}
+/*----------------------------------------------------------------------------*/
+static size_t getDefaultAlignment(size_t alignment)
+{
+  if (alignment < alignof(max_align_t))
+    alignment = alignof(max_align_t);
+
+  assert((alignment & (alignment - 1)) == 0);
+  return alignment;
+}
+/*----------------------------------------------------------------------------*/
+static void initSlab(struct BlockPoolSlab *slab, uint8_t *memory,
+    size_t size, size_t count)
+{
+  slab->begin = memory;
+  slab->end = memory + size * count;
+  slab->head = NULL;
+
+  /* Blocks are linked in the order of addresses */
+  for (size_t index = count; index > 0; --index)
+  {
+    void ** const block = (void **)(memory + size * (index - 1));
+
+    *block = slab->head;
+    slab->head = block;
+  }
+
+  slab->info = (struct BlockPoolInfo){
+      .size = size,
+      .count = count,
+      .used = 0,
+      .peak = 0,
+      .borrowed = 0,
+      .failures = 0
+  };
+}
+/*----------------------------------------------------------------------------*/
+static void *popBlock(struct BlockPoolSlab *slab)
+{
+  void ** const block = slab->head;
+
+  slab->head = *block;
+  if (++slab->info.used > slab->info.peak)
+    slab->info.peak = slab->info.used;
+
+  return block;
+}
+/*----------------------------------------------------------------------------*/
+void *blockPoolAlloc(void *object, size_t size)
+{
+  struct BlockPool * const pool = object;
+  struct BlockPoolSlab *preferred = NULL;
+  void *block = NULL;
+
+  const IrqState state = irqSave();
+
+  for (size_t index = 0; index < pool->count; ++index)
+  {
+    struct BlockPoolSlab * const slab = &pool->slabs[index];
+
+    if (slab->info.size < size)
+      continue;
+
+    if (preferred == NULL)
+      preferred = slab;
+
+    if (slab->head != NULL)
+    {
+      block = popBlock(slab);
+
+      if (slab != preferred)
+        ++preferred->info.borrowed;
+      break;
+    }
+  }
+
+  if (block == NULL && preferred != NULL)
+    ++preferred->info.failures;
+
+  irqRestore(state);
+  return block;
+}
+/*----------------------------------------------------------------------------*/
+void blockPoolFree(void *object, void *block)
+{
+  struct BlockPool * const pool = object;
+
+  if (block == NULL)
+    return;
+
+  for (size_t index = 0; index < pool->count; ++index)
+  {
+    struct BlockPoolSlab * const slab = &pool->slabs[index];
+
+    if ((uint8_t *)block >= slab->begin && (uint8_t *)block < slab->end)
+    {
+      assert(((uint8_t *)block - slab->begin) % slab->info.size == 0);
+
+      const IrqState state = irqSave();
+
+      assert(slab->info.used > 0);
+      *(void **)block = slab->head;
+      slab->head = block;
+      --slab->info.used;
+
+      irqRestore(state);
+      return;
+    }
+  }
+
+  /* Block does not belong to the pool */
+  assert(false);
+}
+/*----------------------------------------------------------------------------*/
+enum Result blockPoolGetInfo(const void *object, size_t index,
+    struct BlockPoolInfo *info)
+{
+  const struct BlockPool * const pool = object;
+
+  if (index >= pool->count)
+    return E_VALUE;
+
+  const IrqState state = irqSave();
+  *info = pool->slabs[index].info;
+  irqRestore(state);
+
+  return E_OK;
+}
+/*----------------------------------------------------------------------------*/
+size_t blockPoolGetRequiredSize(const struct BlockSlab *slabs, size_t count,
+    size_t alignment)
+{
+  alignment = getDefaultAlignment(alignment);
+
+  size_t total = alignment - 1;
+
+  for (size_t index = 0; index < count; ++index)
+    total += getBlockSize(slabs[index].size, alignment) * slabs[index].count;
+
+  return total;
+}
+/*----------------------------------------------------------------------------*/
+static enum Result poolInit(void *object, const void *configBase)
+{
+  const struct BlockPoolConfig * const config = configBase;
+  assert(config != NULL);
+  assert(config->slabs != NULL && config->count > 0);
+  assert(config->arena == NULL || config->size > 0);
+
+  struct BlockPool * const pool = object;
+  const size_t alignment = getDefaultAlignment(config->alignment);
+  const size_t required = blockPoolGetRequiredSize(config->slabs,
+      config->count, alignment);
+  uint8_t *arena;
+
+  pool->count = config->count;
+  pool->memory = NULL;
+
+  if (config->arena != NULL)
+  {
+    const uintptr_t begin = alignValue((uintptr_t)config->arena, alignment);
+    const size_t padding = (size_t)(begin - (uintptr_t)config->arena);
+
+    /* Region should fit all blocks after the alignment of the address */
+    if (padding + required - (alignment - 1) > config->size)
+      return E_VALUE;
+
+    arena = (uint8_t *)begin;
+  }
+  else
+  {
+    pool->memory = malloc(required);
+    if (pool->memory == NULL)
+      return E_MEMORY;
+
+    arena = (uint8_t *)alignValue((uintptr_t)pool->memory, alignment);
+  }
+
+  pool->slabs = malloc(sizeof(struct BlockPoolSlab) * config->count);
+  if (pool->slabs == NULL)
+  {
+    free(pool->memory);
+    return E_MEMORY;
+  }
+
+  for (size_t index = 0; index < config->count; ++index)
+  {
+    const size_t size = getBlockSize(config->slabs[index].size, alignment);
+    const size_t count = config->slabs[index].count;
+
+    assert(index == 0 || config->slabs[index - 1].size
+        <= config->slabs[index].size);
+
+    initSlab(&pool->slabs[index], arena, size, count);
+    arena += size * count;
+  }
+
+  return E_OK;
+}
+/*----------------------------------------------------------------------------*/
+static void poolDeinit(void *object)
+{
+  struct BlockPool * const pool = object;
+
+#ifndef NDEBUG
+  for (size_t index = 0; index < pool->count; ++index)
+    assert(pool->slabs[index].info.used == 0);
+#endif
+
+  free(pool->slabs);
+  free(pool->memory);
+}
@@ -8,12 +8,30 @@
 #include <halm/irq.h>
 #include <assert.h>
 #include <stdint.h>
+#include <stdlib.h>
+
+#ifdef CONFIG_GENERIC_BLOCK_POOL
+#  include <halm/generic/block_pool.h>
+#endif
+/*----------------------------------------------------------------------------*/
+struct RxRequest
+{
+  struct StreamRequest base;
+
+  /* Number of subscribers holding the request */
+  size_t references;
+};
 /*----------------------------------------------------------------------------*/
+static void *allocArena(struct BufferingProxy *, size_t);
 static bool enqueueRxRequests(struct BufferingProxy *);
+static void freeArena(struct BufferingProxy *);
 static void onRxStreamEvent(void *, struct StreamRequest *,
     enum StreamRequestStatus);
 static void onTxStreamEvent(void *, struct StreamRequest *,
     enum StreamRequestStatus);
+static void publishRxRequest(struct BufferingProxy *, struct StreamRequest *);
+static void recycleRxRequest(struct BufferingProxy *, struct StreamRequest *);
+static void releaseRxRequest(struct BufferingProxy *, struct StreamRequest *);
 /*----------------------------------------------------------------------------*/
 static enum Result interfaceInit(void *, const void *);
 static void interfaceDeinit(void *);
@@ -36,6 +54,18 @@ const struct InterfaceClass * const BufferingProxy =
     .write = interfaceWrite
 };
 /*----------------------------------------------------------------------------*/
+static void *allocArena(struct BufferingProxy *interface, size_t size)
+{
+#ifdef CONFIG_GENERIC_BLOCK_POOL
+  if (interface->pool != NULL)
+    return blockPoolAlloc(interface->pool, size);
+#else
+  assert(interface->pool == NULL);
+#endif
+
+  return malloc(size);
+}
+/*----------------------------------------------------------------------------*/
 static bool enqueueRxRequests(struct BufferingProxy *interface)
 {
   bool completed = true;
@@ -56,6 +86,19 @@ static bool enqueueRxRequests(struct BufferingProxy *interface)
   return completed;
 }
 /*----------------------------------------------------------------------------*/
+static void freeArena(struct BufferingProxy *interface)
+{
+#ifdef CONFIG_GENERIC_BLOCK_POOL
+  if (interface->pool != NULL)
+  {
+    blockPoolFree(interface->pool, interface->arena);
+    return;
+  }
+#endif
+
+  free(interface->arena);
+}
+/*----------------------------------------------------------------------------*/
 static void onRxStreamEvent(void *argument, struct StreamRequest *request,
     enum StreamRequestStatus status)
 {
@@ -63,7 +106,10 @@ static void onRxStreamEvent(void *argument, struct StreamRequest *request,
 
   if (status == STREAM_REQUEST_COMPLETED)
   {
-    pointerQueuePushBack(&interface->rxQueue, request);
+    if (interface->subscriberCount)
+      publishRxRequest(interface, request);
+    else
+      pointerQueuePushBack(&interface->rxQueue, request);
 
     if (interface->callback != NULL)
       interface->callback(interface->callbackArgument);
@@ -83,6 +129,172 @@ static void onTxStreamEvent(void *argument, struct StreamRequest *request,
     interface->callback(interface->callbackArgument);
 }
 /*----------------------------------------------------------------------------*/
+static void publishRxRequest(struct BufferingProxy *interface,
+    struct StreamRequest *request)
+{
+  ((struct RxRequest *)request)->references = interface->subscriberCount;
+  ++interface->rxPublished;
+
+  for (size_t index = 0; index < interface->subscriberCount; ++index)
+  {
+    struct BufferingProxySubscriber * const subscriber =
+        &interface->subscribers[index];
+
+    /* Lagging subscriber loses the oldest buffer */
+    if (pointerQueueSize(&subscriber->queue) >= interface->subscriberLag)
+    {
+      struct StreamRequest * const oldest =
+          pointerQueueFront(&subscriber->queue);
+
+      pointerQueuePopFront(&subscriber->queue);
+      ++subscriber->dropped;
+      releaseRxRequest(interface, oldest);
+    }
+
+    pointerQueuePushBack(&subscriber->queue, request);
+
+    const size_t size = pointerQueueSize(&subscriber->queue);
+
+    if (size > subscriber->peak)
+      subscriber->peak = size;
+  }
+}
+/*----------------------------------------------------------------------------*/
+static void recycleRxRequest(struct BufferingProxy *interface,
+    struct StreamRequest *request)
+{
+  if (streamEnqueue(interface->rx, request) != E_OK)
+  {
+    const IrqState state = irqSave();
+    pointerArrayPushBack(&interface->rxPool, request);
+    irqRestore(state);
+  }
+}
+/*----------------------------------------------------------------------------*/
+static void releaseRxRequest(struct BufferingProxy *interface,
+    struct StreamRequest *request)
+{
+  struct RxRequest * const entry = (struct RxRequest *)request;
+  bool last;
+  IrqState state;
+
+  state = irqSave();
+  last = --entry->references == 0;
+  if (last)
+    --interface->rxPublished;
+  irqRestore(state);
+
+  /* Request is returned to the stream after the release by all subscribers */
+  if (last)
+    recycleRxRequest(interface, request);
+}
+/*----------------------------------------------------------------------------*/
+struct StreamRequest *bufferingProxyAcquire(void *object)
+{
+  struct BufferingProxy * const interface = object;
+
+  if (interface->subscriberCount)
+    return bufferingProxyFetch(interface, 0);
+
+  struct StreamRequest *request = NULL;
+  const IrqState state = irqSave();
+
+  if (!pointerQueueEmpty(&interface->rxQueue))
+  {
+    request = pointerQueueFront(&interface->rxQueue);
+    pointerQueuePopFront(&interface->rxQueue);
+  }
+
+  irqRestore(state);
+  return request;
+}
+/*----------------------------------------------------------------------------*/
+struct StreamRequest *bufferingProxyAllocate(void *object)
+{
+  struct BufferingProxy * const interface = object;
+  struct StreamRequest *request = NULL;
+  const IrqState state = irqSave();
+
+  if (!pointerArrayEmpty(&interface->txPool))
+  {
+    request = pointerArrayBack(&interface->txPool);
+    pointerArrayPopBack(&interface->txPool);
+  }
+
+  irqRestore(state);
+
+  if (request != NULL)
+    request->length = 0;
+  return request;
+}
+/*----------------------------------------------------------------------------*/
+struct StreamRequest *bufferingProxyFetch(void *object, size_t index)
+{
+  struct BufferingProxy * const interface = object;
+  assert(index < interface->subscriberCount);
+
+  PointerQueue * const queue = &interface->subscribers[index].queue;
+  struct StreamRequest *request = NULL;
+  const IrqState state = irqSave();
+
+  if (!pointerQueueEmpty(queue))
+  {
+    request = pointerQueueFront(queue);
+    pointerQueuePopFront(queue);
+  }
+
+  irqRestore(state);
+  return request;
+}
+/*----------------------------------------------------------------------------*/
+void bufferingProxyGetStatistics(void *object, size_t index,
+    struct BufferingProxyStatistics *statistics)
+{
+  struct BufferingProxy * const interface = object;
+  assert(index < interface->subscriberCount);
+
+  const struct BufferingProxySubscriber * const subscriber =
+      &interface->subscribers[index];
+  const IrqState state = irqSave();
+
+  statistics->lag = pointerQueueSize(&subscriber->queue);
+  statistics->peak = subscriber->peak;
+  statistics->dropped = subscriber->dropped;
+
+  irqRestore(state);
+}
+/*----------------------------------------------------------------------------*/
+void bufferingProxyRelease(void *object, struct StreamRequest *request)
+{
+  struct BufferingProxy * const interface = object;
+
+  if (interface->subscriberCount)
+    releaseRxRequest(interface, request);
+  else
+    recycleRxRequest(interface, request);
+}
+/*----------------------------------------------------------------------------*/
+enum Result bufferingProxySubmit(void *object, struct StreamRequest *request)
+{
+  struct BufferingProxy * const interface = object;
+  assert(request->length <= interface->txBufferSize);
+
+  enum Result res = E_OK;
+
+  /* Empty requests are returned to the pool without transmission */
+  if (request->length)
+    res = streamEnqueue(interface->tx, request);
+
+  if (!request->length || res != E_OK)
+  {
+    const IrqState state = irqSave();
+    pointerArrayPushBack(&interface->txPool, request);
+    irqRestore(state);
+  }
+
+  return res;
+}
+/*----------------------------------------------------------------------------*/
 static enum Result interfaceInit(void *object, const void *configBase)
 {
   const struct BufferingProxyConfig * const config = configBase;
@@ -94,6 +306,7 @@ static enum Result interfaceInit(void *object, const void *configBase)
   interface->callback = NULL;
   interface->callbackArgument = NULL;
   interface->pipe = config->pipe;
+  interface->pool = config->pool;
   interface->rx = config->rx.stream;
   interface->tx = config->tx.stream;
 
@@ -127,11 +340,42 @@ static enum Result interfaceInit(void *object, const void *configBase)
   if (!pointerArrayInit(&interface->txPool, interface->txBufferCount))
     return E_MEMORY;
 
-  const size_t rxSize = sizeof(struct StreamRequest) + interface->rxBufferSize;
+  interface->subscribers = NULL;
+  interface->subscriberCount = 0;
+  interface->subscriberLag = 0;
+  interface->rxPublished = 0;
+
+  if (interface->rx != NULL && config->rx.subscribers)
+  {
+    interface->subscribers = malloc(config->rx.subscribers
+        * sizeof(struct BufferingProxySubscriber));
+    if (interface->subscribers == NULL)
+      return E_MEMORY;
+
+    for (size_t index = 0; index < config->rx.subscribers; ++index)
+    {
+      struct BufferingProxySubscriber * const subscriber =
+          &interface->subscribers[index];
+
+      if (!pointerQueueInit(&subscriber->queue, interface->rxBufferCount))
+        return E_MEMORY;
+
+      subscriber->peak = 0;
+      subscriber->dropped = 0;
+      ++interface->subscriberCount;
+    }
+
+    if (config->rx.lag)
+      interface->subscriberLag = MIN(config->rx.lag, interface->rxBufferCount);
+    else
+      interface->subscriberLag = MAX(interface->rxBufferCount / 2, 1);
+  }
+
+  const size_t rxSize = sizeof(struct RxRequest) + interface->rxBufferSize;
   const size_t txSize = sizeof(struct StreamRequest) + interface->txBufferSize;
   const size_t poolSize =
       rxSize * interface->rxBufferCount + txSize * interface->txBufferCount;
-  uint8_t *arena = malloc(poolSize);
+  uint8_t *arena = allocArena(interface, poolSize);
 
   if (arena == NULL)
     return E_MEMORY;
@@ -139,13 +383,15 @@ static enum Result interfaceInit(void *object, const void *configBase)
 
   for (size_t index = 0; index < interface->rxBufferCount; ++index)
   {
-    struct StreamRequest * const request = (struct StreamRequest *)arena;
+    struct RxRequest * const entry = (struct RxRequest *)arena;
+    struct StreamRequest * const request = &entry->base;
 
     request->capacity = interface->rxBufferSize;
     request->length = 0;
     request->callback = onRxStreamEvent;
     request->argument = interface;
-    request->buffer = arena + sizeof(struct StreamRequest);
+    request->buffer = arena + sizeof(struct RxRequest);
+    entry->references = 0;
 
     pointerArrayPushBack(&interface->rxPool, (void *)request);
     arena += rxSize;
@@ -173,7 +419,11 @@ static void interfaceDeinit(void *object)
 {
   struct BufferingProxy * const interface = object;
 
-  free(interface->arena);
+  for (size_t index = 0; index < interface->subscriberCount; ++index)
+    pointerQueueDeinit(&interface->subscribers[index].queue);
+  free(interface->subscribers);
+
+  freeArena(interface);
   pointerArrayDeinit(&interface->txPool);
   pointerArrayDeinit(&interface->rxPool);
   pointerQueueDeinit(&interface->rxQueue);
@@ -198,15 +448,21 @@ static enum Result interfaceGetParam(void *object, int parameter, void *data)
       if (interface->rx == NULL)
         return E_INVALID;
 
-      *(size_t *)data = pointerQueueSize(&interface->rxQueue);
+      if (interface->subscriberCount)
+        *(size_t *)data = pointerQueueSize(&interface->subscribers[0].queue);
+      else
+        *(size_t *)data = pointerQueueSize(&interface->rxQueue);
       return E_OK;
 
     case IF_RX_PENDING:
       if (interface->rx == NULL)
         return E_INVALID;
 
-      *(size_t *)data = interface->rxBufferCount
-          - pointerQueueSize(&interface->rxQueue);
+      if (interface->subscriberCount)
+        *(size_t *)data = interface->rxBufferCount - interface->rxPublished;
+      else
+        *(size_t *)data = interface->rxBufferCount
+            - pointerQueueSize(&interface->rxQueue);
       return E_OK;
 
     case IF_TX_AVAILABLE:
@@ -242,69 +498,38 @@ static size_t interfaceRead(void *object, void *buffer,
     [[maybe_unused]] size_t length)
 {
   struct BufferingProxy * const interface = object;
-  uint8_t *bufferPosition = buffer;
-
   assert(length >= interface->rxBufferSize);
 
-  if (!pointerQueueEmpty(&interface->rxQueue))
-  {
-    struct StreamRequest * const request =
-        pointerQueueFront(&interface->rxQueue);
-
-    const size_t bytesToRead = request->length;
-    IrqState state;
-
-    state = irqSave();
-    pointerQueuePopFront(&interface->rxQueue);
-    irqRestore(state);
+  struct StreamRequest * const request = bufferingProxyAcquire(interface);
+  size_t bytesRead = 0;
 
-    memcpy(bufferPosition, request->buffer, bytesToRead);
-    bufferPosition += bytesToRead;
-
-    if (streamEnqueue(interface->rx, request) != E_OK)
-    {
-      state = irqSave();
-      pointerArrayPushBack(&interface->rxPool, request);
-      irqRestore(state);
-    }
+  if (request != NULL)
+  {
+    bytesRead = request->length;
+    memcpy(buffer, request->buffer, bytesRead);
+    bufferingProxyRelease(interface, request);
   }
 
-  return bufferPosition - (uint8_t *)buffer;
+  return bytesRead;
 }
 /*----------------------------------------------------------------------------*/
 static size_t interfaceWrite(void *object, const void *buffer, size_t length)
 {
   struct BufferingProxy * const interface = object;
-  const uint8_t *bufferPosition = buffer;
-
   assert(length <= interface->txBufferSize);
 
-  if (length && !pointerArrayEmpty(&interface->txPool))
-  {
-    const size_t bytesToWrite = MIN(length, interface->txBufferSize);
-    struct StreamRequest *request;
-    IrqState state;
+  if (!length)
+    return 0;
 
-    state = irqSave();
-    request = pointerArrayBack(&interface->txPool);
-    pointerArrayPopBack(&interface->txPool);
-    irqRestore(state);
+  struct StreamRequest * const request = bufferingProxyAllocate(interface);
 
-    request->length = bytesToWrite;
-    memcpy(request->buffer, bufferPosition, bytesToWrite);
+  if (request == NULL)
+    return 0;
 
-    if (streamEnqueue(interface->tx, request) == E_OK)
-    {
-      bufferPosition += bytesToWrite;
-      length -= bytesToWrite;
-    }
-    else
-    {
-      state = irqSave();
-      pointerArrayPushBack(&interface->txPool, request);
-      irqRestore(state);
-    }
-  }
+  const size_t bytesToWrite = MIN(length, interface->txBufferSize);
+
+  request->length = bytesToWrite;
+  memcpy(request->buffer, buffer, bytesToWrite);
 
-  return bufferPosition - (const uint8_t *)buffer;
+  return bufferingProxySubmit(interface, request) == E_OK ? bytesToWrite : 0;
 }
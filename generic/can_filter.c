@@ -0,0 +1,221 @@
+/*
+ * can_filter.c
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the MIT License
+ */
+
+#include <halm/generic/can_filter.h>
+#include <xcore/bits.h>
+#include <assert.h>
+#include <stdlib.h>
+/*----------------------------------------------------------------------------*/
+#define FLAG_EXT    BIT(29)
+#define SLOT_EMPTY  UINT32_MAX
+/*----------------------------------------------------------------------------*/
+static void compileRules(struct CanFilterEngine *);
+static size_t findGroup(const struct CanFilterEngine *, uint32_t);
+static inline size_t hashKey(uint32_t, uint8_t);
+static void insertKey(struct CanFilterEngine *, uint32_t, uint8_t);
+static inline bool isExactMask(uint32_t);
+static struct CanFilterRule makeRule(const struct CANFilter *, bool);
+/*----------------------------------------------------------------------------*/
+static void compileRules(struct CanFilterEngine *engine)
+{
+  engine->groupCount = 0;
+
+  /* Exact identifiers are checked first as the most common case */
+  for (size_t index = 0; index < engine->count; ++index)
+  {
+    const uint32_t mask = engine->rules[index].mask;
+
+    if (isExactMask(mask) && findGroup(engine, mask) == engine->groupCount)
+      engine->groups[engine->groupCount++] = mask;
+  }
+
+  for (size_t index = 0; index < engine->count; ++index)
+  {
+    const uint32_t mask = engine->rules[index].mask;
+
+    if (findGroup(engine, mask) == engine->groupCount)
+      engine->groups[engine->groupCount++] = mask;
+  }
+
+  for (size_t index = 0; index <= engine->slotMask; ++index)
+    engine->slots[index].key = SLOT_EMPTY;
+
+  for (size_t index = 0; index < engine->count; ++index)
+  {
+    const struct CanFilterRule rule = engine->rules[index];
+    insertKey(engine, rule.id & rule.mask, (uint8_t)findGroup(engine,
+        rule.mask));
+  }
+}
+/*----------------------------------------------------------------------------*/
+static size_t findGroup(const struct CanFilterEngine *engine, uint32_t mask)
+{
+  size_t index = 0;
+
+  while (index < engine->groupCount && engine->groups[index] != mask)
+    ++index;
+
+  return index;
+}
+/*----------------------------------------------------------------------------*/
+static inline size_t hashKey(uint32_t key, uint8_t group)
+{
+  /* Multiplicative hashing, group index selects a different sequence */
+  const uint32_t value = (key ^ ((uint32_t)group << 24)) * 0x9E3779B1UL;
+  return (size_t)(value ^ (value >> 16));
+}
+/*----------------------------------------------------------------------------*/
+static void insertKey(struct CanFilterEngine *engine, uint32_t key,
+    uint8_t group)
+{
+  size_t index = hashKey(key, group) & engine->slotMask;
+
+  while (engine->slots[index].key != SLOT_EMPTY)
+  {
+    /* Duplicate rules are stored once */
+    if (engine->slots[index].key == key && engine->slots[index].group == group)
+      return;
+
+    index = (index + 1) & engine->slotMask;
+  }
+
+  engine->slots[index].key = key;
+  engine->slots[index].group = group;
+}
+/*----------------------------------------------------------------------------*/
+static inline bool isExactMask(uint32_t mask)
+{
+  return mask == (FLAG_EXT | MASK(29)) || mask == (FLAG_EXT | MASK(11));
+}
+/*----------------------------------------------------------------------------*/
+static struct CanFilterRule makeRule(const struct CANFilter *filter, bool ext)
+{
+  struct CanFilterRule rule;
+
+  /* Format flag is a part of the mask, frames of other format never match */
+  if (ext)
+  {
+    rule.id = (filter->id & MASK(29)) | FLAG_EXT;
+    rule.mask = (filter->mask & MASK(29)) | FLAG_EXT;
+  }
+  else
+  {
+    rule.id = filter->id & MASK(11);
+    rule.mask = (filter->mask & MASK(11)) | FLAG_EXT;
+  }
+
+  return rule;
+}
+/*----------------------------------------------------------------------------*/
+bool canFilterEngineInit(struct CanFilterEngine *engine, size_t capacity)
+{
+  /* Group index is stored in a single byte */
+  assert(capacity <= UINT8_MAX + 1);
+
+  /* Keep load factor of the hash set below one half */
+  size_t slots = 2;
+
+  while (slots < capacity * 2)
+    slots <<= 1;
+
+  engine->capacity = capacity;
+  engine->count = 0;
+  engine->groupCount = 0;
+  engine->slotMask = slots - 1;
+  engine->hits = 0;
+  engine->drops = 0;
+
+  engine->rules = malloc(sizeof(struct CanFilterRule) * capacity);
+  engine->groups = malloc(sizeof(uint32_t) * capacity);
+  engine->slots = malloc(sizeof(struct CanFilterSlot) * slots);
+
+  if ((capacity && (engine->rules == NULL || engine->groups == NULL))
+      || engine->slots == NULL)
+  {
+    canFilterEngineDeinit(engine);
+    return false;
+  }
+
+  compileRules(engine);
+  return true;
+}
+/*----------------------------------------------------------------------------*/
+void canFilterEngineDeinit(struct CanFilterEngine *engine)
+{
+  free(engine->slots);
+  free(engine->groups);
+  free(engine->rules);
+}
+/*----------------------------------------------------------------------------*/
+bool canFilterEngineAdd(struct CanFilterEngine *engine,
+    const struct CANFilter *filter, bool ext)
+{
+  if (engine->count == engine->capacity)
+    return false;
+
+  engine->rules[engine->count++] = makeRule(filter, ext);
+  compileRules(engine);
+
+  return true;
+}
+/*----------------------------------------------------------------------------*/
+void canFilterEngineClear(struct CanFilterEngine *engine)
+{
+  engine->count = 0;
+  compileRules(engine);
+}
+/*----------------------------------------------------------------------------*/
+bool canFilterEngineMatch(const struct CanFilterEngine *engine, uint32_t id,
+    bool ext)
+{
+  if (!engine->count)
+    return true;
+
+  const uint32_t key = ext ? ((id & MASK(29)) | FLAG_EXT) : (id & MASK(11));
+
+  for (size_t group = 0; group < engine->groupCount; ++group)
+  {
+    const uint32_t masked = key & engine->groups[group];
+    size_t index = hashKey(masked, (uint8_t)group) & engine->slotMask;
+
+    while (engine->slots[index].key != SLOT_EMPTY)
+    {
+      if (engine->slots[index].key == masked
+          && engine->slots[index].group == group)
+      {
+        return true;
+      }
+
+      index = (index + 1) & engine->slotMask;
+    }
+  }
+
+  return false;
+}
+/*----------------------------------------------------------------------------*/
+bool canFilterEngineRemove(struct CanFilterEngine *engine,
+    const struct CANFilter *filter, bool ext)
+{
+  const struct CanFilterRule target = makeRule(filter, ext);
+  size_t count = 0;
+
+  for (size_t index = 0; index < engine->count; ++index)
+  {
+    const struct CanFilterRule rule = engine->rules[index];
+
+    if (rule.id != target.id || rule.mask != target.mask)
+      engine->rules[count++] = rule;
+  }
+
+  if (count != engine->count)
+  {
+    engine->count = count;
+    compileRules(engine);
+    return true;
+  }
+  else
+    return false;
+}
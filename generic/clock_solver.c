@@ -0,0 +1,384 @@
+/*
+ * clock_solver.c
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the MIT License
+ */
+
+#include <halm/generic/clock_solver.h>
+#include <xcore/bits.h>
+#include <assert.h>
+/*----------------------------------------------------------------------------*/
+#define LPC_GEN2_USB_FREQUENCY 48000000
+#define PPM_SCALE              1000000ULL
+/*----------------------------------------------------------------------------*/
+static bool calcError(const struct ClockSolverConfig *, enum ClockSolverTarget,
+    uint32_t, uint64_t *);
+static bool evaluate(const struct ClockSolverPll *,
+    const struct ClockSolverConfig *, uint8_t, uint32_t, uint16_t,
+    struct ClockSolution *);
+static bool lpcGen2UsbValidate(uint32_t, uint16_t, uint16_t);
+static bool lpcGen2Validate(uint32_t, uint16_t, uint16_t);
+static bool m48xValidate(uint32_t, uint16_t, uint16_t);
+static bool selectDivider(const struct ClockSolverDivider *,
+    const struct ClockSolverConfig *, uint8_t, uint32_t,
+    struct ClockSolution *, uint64_t *);
+static bool stm32F4AudioValidate(uint32_t, uint16_t, uint16_t);
+static uint32_t stm32F4InputDivisor(uint32_t);
+static bool stm32F4MainValidate(uint32_t, uint16_t, uint16_t);
+/*----------------------------------------------------------------------------*/
+static const uint16_t lpcGen2Divisors[] = {2, 4, 8, 16};
+
+static const struct ClockSolverDivider lpcGen2SystemDividers[] = {
+    /* System AHB clock divider */
+    {1, 255, BIT(CLOCK_SOLVER_CORE), false}
+};
+
+static const struct ClockSolverDivider lpcGen2UsbDividers[] = {
+    /* USB clock is taken directly from the PLL output */
+    {1, 1, BIT(CLOCK_SOLVER_USB), false}
+};
+
+const struct ClockSolverPll * const LpcGen2SystemPllModel =
+    &(const struct ClockSolverPll){
+    .validate = lpcGen2Validate,
+    .divisors = lpcGen2Divisors,
+    .dividers = lpcGen2SystemDividers,
+    .divisorCount = ARRAY_SIZE(lpcGen2Divisors),
+    .dividerCount = ARRAY_SIZE(lpcGen2SystemDividers),
+    .inputMin = 10000000,
+    .inputMax = 25000000,
+    .vcoMin = 156000000,
+    .vcoMax = 320000000,
+    .outputMax = 100000000,
+    .multiplierMin = 2,
+    .multiplierMax = 512
+};
+
+const struct ClockSolverPll * const LpcGen2UsbPllModel =
+    &(const struct ClockSolverPll){
+    .validate = lpcGen2UsbValidate,
+    .divisors = lpcGen2Divisors,
+    .dividers = lpcGen2UsbDividers,
+    .divisorCount = ARRAY_SIZE(lpcGen2Divisors),
+    .dividerCount = ARRAY_SIZE(lpcGen2UsbDividers),
+    .inputMin = 10000000,
+    .inputMax = 25000000,
+    .vcoMin = 156000000,
+    .vcoMax = 320000000,
+    .outputMax = LPC_GEN2_USB_FREQUENCY,
+    .multiplierMin = 2,
+    .multiplierMax = 512
+};
+/*----------------------------------------------------------------------------*/
+static const uint16_t m48xDivisors[] = {1, 2, 4};
+
+static const struct ClockSolverDivider m48xDividers[] = {
+    /* HCLK divider */
+    {1, 16, BIT(CLOCK_SOLVER_CORE), false},
+    /* USB clock divider */
+    {1, 16, BIT(CLOCK_SOLVER_USB), false},
+    /* SDH0 clock divider */
+    {1, 256, BIT(CLOCK_SOLVER_SDIO), false},
+    /* I2S0 clock divider */
+    {1, 16, BIT(CLOCK_SOLVER_AUDIO), false}
+};
+
+const struct ClockSolverPll * const M48xSystemPllModel =
+    &(const struct ClockSolverPll){
+    .validate = m48xValidate,
+    .divisors = m48xDivisors,
+    .dividers = m48xDividers,
+    .divisorCount = ARRAY_SIZE(m48xDivisors),
+    .dividerCount = ARRAY_SIZE(m48xDividers),
+    .inputMin = 4000000,
+    .inputMax = 24000000,
+    .vcoMin = 200000000,
+    .vcoMax = 500000000,
+    .multiplierMin = 1,
+    .multiplierMax = 125
+};
+/*----------------------------------------------------------------------------*/
+static const uint16_t stm32F4MainDivisors[] = {2, 4, 6, 8};
+static const uint16_t stm32F4AudioDivisors[] = {2, 3, 4, 5, 6, 7};
+
+static const struct ClockSolverDivider stm32F4MainDividers[] = {
+    /* PLLP output */
+    {1, 1, BIT(CLOCK_SOLVER_CORE), false},
+    /* PLLQ output is shared by USB and SDIO */
+    {2, 15, BIT(CLOCK_SOLVER_USB) | BIT(CLOCK_SOLVER_SDIO), true}
+};
+
+static const struct ClockSolverDivider stm32F4AudioDividers[] = {
+    /* PLLI2SR output */
+    {1, 1, BIT(CLOCK_SOLVER_AUDIO), false}
+};
+
+const struct ClockSolverPll * const Stm32F4MainPllModel =
+    &(const struct ClockSolverPll){
+    .validate = stm32F4MainValidate,
+    .divisors = stm32F4MainDivisors,
+    .dividers = stm32F4MainDividers,
+    .divisorCount = ARRAY_SIZE(stm32F4MainDivisors),
+    .dividerCount = ARRAY_SIZE(stm32F4MainDividers),
+    .inputMin = 4000000,
+    .inputMax = 26000000,
+    .vcoMin = 100000000,
+    .vcoMax = 432000000,
+    .multiplierMin = 1,
+    .multiplierMax = 432
+};
+
+const struct ClockSolverPll * const Stm32F4AudioPllModel =
+    &(const struct ClockSolverPll){
+    .validate = stm32F4AudioValidate,
+    .divisors = stm32F4AudioDivisors,
+    .dividers = stm32F4AudioDividers,
+    .divisorCount = ARRAY_SIZE(stm32F4AudioDivisors),
+    .dividerCount = ARRAY_SIZE(stm32F4AudioDividers),
+    .inputMin = 4000000,
+    .inputMax = 26000000,
+    .vcoMin = 100000000,
+    .vcoMax = 432000000,
+    .multiplierMin = 1,
+    .multiplierMax = 432
+};
+/*----------------------------------------------------------------------------*/
+static bool calcError(const struct ClockSolverConfig *config,
+    enum ClockSolverTarget target, uint32_t frequency, uint64_t *error)
+{
+  const uint32_t expected = config->frequencies[target];
+  uint64_t difference;
+
+  if (target == CLOCK_SOLVER_CORE || target == CLOCK_SOLVER_SDIO)
+  {
+    /* Clock must not exceed the maximum frequency */
+    if (frequency > expected)
+      return false;
+
+    difference = expected - frequency;
+  }
+  else
+  {
+    difference = frequency > expected ?
+        frequency - expected : expected - frequency;
+  }
+
+  const uint64_t ppm = difference * PPM_SCALE / expected;
+
+  if (target == CLOCK_SOLVER_USB && ppm > config->usbTolerance)
+    return false;
+
+  *error += ppm;
+  return true;
+}
+/*----------------------------------------------------------------------------*/
+static bool evaluate(const struct ClockSolverPll *model,
+    const struct ClockSolverConfig *config, uint8_t requested,
+    uint32_t vco, uint16_t divisor, struct ClockSolution *solution)
+{
+  const uint32_t output = vco / divisor;
+  uint64_t error = 0;
+
+  for (size_t index = 0; index < model->dividerCount; ++index)
+  {
+    const struct ClockSolverDivider * const divider = model->dividers + index;
+
+    if (!(divider->targets & requested))
+      continue;
+
+    if (!selectDivider(divider, config, requested,
+        divider->vco ? vco : output, solution, &error))
+    {
+      return false;
+    }
+  }
+
+  solution->error = error < UINT32_MAX ? (uint32_t)error : UINT32_MAX;
+  solution->vco = vco;
+  solution->divisor = divisor;
+  return true;
+}
+/*----------------------------------------------------------------------------*/
+static bool lpcGen2UsbValidate(uint32_t input, uint16_t multiplier,
+    uint16_t divisor)
+{
+  /* Clock driver accepts only the exact USB frequency at the PLL output */
+  return lpcGen2Validate(input, multiplier, divisor)
+      && input * multiplier / divisor == LPC_GEN2_USB_FREQUENCY;
+}
+/*----------------------------------------------------------------------------*/
+static bool lpcGen2Validate(uint32_t, uint16_t multiplier, uint16_t divisor)
+{
+  /* Feedback is taken from the PLL output, multiplier is M x 2P */
+  const unsigned int msel = multiplier / divisor;
+  return msel * divisor == multiplier && msel >= 1 && msel <= 32;
+}
+/*----------------------------------------------------------------------------*/
+static bool m48xValidate(uint32_t input, uint16_t multiplier, uint16_t)
+{
+  uint32_t indiv = 1;
+
+  /* Same reference divider selection as in the clocking driver */
+  while (input / indiv >= 8000000)
+    ++indiv;
+  if (indiv > 33 || input / indiv < 4000000 || (2 * input) % indiv)
+    return false;
+
+  const uint32_t reference = 2 * input / indiv;
+  const uint32_t fco = input * multiplier;
+  const uint32_t fbdiv = fco / reference;
+
+  return fbdiv >= 2 && fbdiv <= 513 && fbdiv * reference == fco;
+}
+/*----------------------------------------------------------------------------*/
+static bool selectDivider(const struct ClockSolverDivider *divider,
+    const struct ClockSolverConfig *config, uint8_t requested,
+    uint32_t frequency, struct ClockSolution *solution, uint64_t *error)
+{
+  const uint8_t targets = divider->targets & requested;
+  uint64_t bestError = UINT64_MAX;
+  uint32_t bestValue = 0;
+
+  for (uint32_t value = divider->min; value <= divider->max; ++value)
+  {
+    const uint32_t output = frequency / value;
+    uint64_t currentError = 0;
+    bool feasible = true;
+
+    for (size_t target = 0; feasible && target < CLOCK_SOLVER_TARGET_COUNT;
+        ++target)
+    {
+      if (targets & BIT(target))
+        feasible = calcError(config, target, output, &currentError);
+    }
+
+    if (feasible && currentError < bestError)
+    {
+      bestError = currentError;
+      bestValue = value;
+
+      if (!bestError)
+        break;
+    }
+  }
+
+  if (!bestValue)
+    return false;
+
+  for (size_t target = 0; target < CLOCK_SOLVER_TARGET_COUNT; ++target)
+  {
+    if (targets & BIT(target))
+    {
+      solution->dividers[target] = (uint16_t)bestValue;
+      solution->frequencies[target] = frequency / bestValue;
+    }
+  }
+
+  *error += bestError;
+  return true;
+}
+/*----------------------------------------------------------------------------*/
+static bool stm32F4AudioValidate(uint32_t input, uint16_t multiplier,
+    uint16_t)
+{
+  const uint32_t pllm = stm32F4InputDivisor(input);
+  const uint32_t plln = pllm * multiplier;
+
+  return pllm && plln >= 192 && plln <= 432;
+}
+/*----------------------------------------------------------------------------*/
+static uint32_t stm32F4InputDivisor(uint32_t input)
+{
+  /* Input divider is selected by the driver for a 2 MHz reference */
+  const uint32_t pllm = (input + 2000000 - 1) / 2000000;
+
+  if (pllm < 2 || pllm > 63 || input % pllm)
+    return 0;
+  else
+    return pllm;
+}
+/*----------------------------------------------------------------------------*/
+static bool stm32F4MainValidate(uint32_t input, uint16_t multiplier,
+    uint16_t)
+{
+  const uint32_t pllm = stm32F4InputDivisor(input);
+  const uint32_t plln = pllm * multiplier;
+
+  return pllm && plln >= 64 && plln <= 432;
+}
+/*----------------------------------------------------------------------------*/
+enum Result clockSolverFind(const struct ClockSolverPll *model,
+    const struct ClockSolverConfig *config, struct ClockSolution *solution)
+{
+  assert(model != NULL);
+  assert(config != NULL);
+  assert(solution != NULL);
+
+  if (config->input < model->inputMin || config->input > model->inputMax)
+    return E_VALUE;
+
+  uint8_t driven = 0;
+  uint8_t requested = 0;
+
+  for (size_t index = 0; index < model->dividerCount; ++index)
+    driven |= model->dividers[index].targets;
+
+  for (size_t target = 0; target < CLOCK_SOLVER_TARGET_COUNT; ++target)
+  {
+    if (config->frequencies[target] && (driven & BIT(target)))
+      requested |= BIT(target);
+  }
+
+  if (!requested)
+    return E_VALUE;
+
+  /* Only multipliers that keep the oscillator within limits are checked */
+  uint32_t multiplierMin = (model->vcoMin + config->input - 1) / config->input;
+  uint32_t multiplierMax = model->vcoMax / config->input;
+
+  if (multiplierMin < model->multiplierMin)
+    multiplierMin = model->multiplierMin;
+  if (multiplierMax > model->multiplierMax)
+    multiplierMax = model->multiplierMax;
+
+  struct ClockSolution best = {.error = UINT32_MAX};
+  bool found = false;
+
+  for (uint32_t multiplier = multiplierMin; multiplier <= multiplierMax;
+      ++multiplier)
+  {
+    const uint32_t vco = config->input * multiplier;
+
+    for (size_t index = 0; index < model->divisorCount; ++index)
+    {
+      const uint16_t divisor = model->divisors[index];
+      struct ClockSolution candidate = {
+          .multiplier = (uint16_t)multiplier
+      };
+
+      if (model->outputMax && vco / divisor > model->outputMax)
+        continue;
+      if (model->validate != NULL
+          && !model->validate(config->input, (uint16_t)multiplier, divisor))
+      {
+        continue;
+      }
+
+      if (!evaluate(model, config, requested, vco, divisor, &candidate))
+        continue;
+
+      /* Lower oscillator frequency is preferred for equal errors */
+      if (!found || candidate.error < best.error)
+      {
+        best = candidate;
+        found = true;
+      }
+    }
+  }
+
+  if (!found)
+    return E_ERROR;
+
+  *solution = best;
+  return E_OK;
+}
@@ -0,0 +1,112 @@
+/*
+ * dma_ring.c
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the MIT License
+ */
+
+#include <halm/generic/dma_ring.h>
+#include <assert.h>
+/*----------------------------------------------------------------------------*/
+static void onDmaEvent(void *);
+/*----------------------------------------------------------------------------*/
+static void onDmaEvent(void *argument)
+{
+  struct DmaRing * const ring = argument;
+  const enum Result res = dmaStatus(ring->dma);
+  size_t position;
+
+  if (res == E_BUSY)
+  {
+    /* Remaining periods of the pass including the active one */
+    const size_t queued = dmaQueued(ring->dma);
+
+    assert(queued > 0 && queued <= ring->periods);
+    position = ring->periods - queued;
+  }
+  else if (res == E_OK)
+  {
+    /* Channel is stopped after the end of the pass */
+    position = ring->periods;
+  }
+  else
+  {
+    if (ring->callback != NULL)
+      ring->callback(ring->callbackArgument, ring->next, res);
+    return;
+  }
+
+  size_t count;
+
+  if (position > ring->next)
+  {
+    count = position - ring->next;
+  }
+  else
+  {
+    /* Each interrupt completes at least one period */
+    count = ring->periods - ring->next + position;
+
+    if (position == ring->next)
+      ++ring->overruns;
+  }
+
+  while (count--)
+  {
+    const size_t index = ring->next;
+
+    if (++ring->next == ring->periods)
+      ring->next = 0;
+
+    if (ring->callback != NULL)
+      ring->callback(ring->callbackArgument, index, E_OK);
+  }
+}
+/*----------------------------------------------------------------------------*/
+void dmaRingInit(struct DmaRing *ring, void *dma, size_t periods)
+{
+  assert(dma != NULL);
+  assert(periods > 0);
+
+  ring->dma = dma;
+  ring->callback = NULL;
+  ring->callbackArgument = NULL;
+  ring->periods = periods;
+  ring->next = 0;
+  ring->overruns = 0;
+
+  dmaSetCallback(dma, onDmaEvent, ring);
+}
+/*----------------------------------------------------------------------------*/
+void dmaRingSetCallback(struct DmaRing *ring,
+    void (*callback)(void *, size_t, enum Result), void *argument)
+{
+  ring->callbackArgument = argument;
+  ring->callback = callback;
+}
+/*----------------------------------------------------------------------------*/
+enum Result dmaRingStart(struct DmaRing *ring)
+{
+  ring->next = 0;
+
+  const enum Result res = dmaEnable(ring->dma);
+
+  if (res != E_OK)
+    return res;
+
+  /*
+   * Completed position is derived from the number of remaining periods,
+   * the channel should report the same number of periods as the ring has.
+   */
+  if (dmaQueued(ring->dma) != ring->periods)
+  {
+    dmaDisable(ring->dma);
+    return E_VALUE;
+  }
+
+  return E_OK;
+}
+/*----------------------------------------------------------------------------*/
+void dmaRingStop(struct DmaRing *ring)
+{
+  dmaDisable(ring->dma);
+}
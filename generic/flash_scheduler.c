@@ -0,0 +1,612 @@
+/*
+ * flash_scheduler.c
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the MIT License
+ */
+
+#include <halm/generic/flash_scheduler.h>
+#include <halm/timer.h>
+#include <halm/wq.h>
+#include <xcore/asm.h>
+#include <xcore/bits.h>
+#include <assert.h>
+#include <string.h>
+/*----------------------------------------------------------------------------*/
+static uint32_t binToValue(size_t);
+static enum Result completeRequest(struct FlashScheduler *);
+static void finishRequest(struct FlashScheduler *, enum Result);
+static enum Result flushRequests(struct FlashScheduler *, uint32_t, size_t);
+static uint32_t getPercentile(const struct FlashScheduler *, uint32_t);
+static uint32_t getUnitSize(const struct FlashScheduler *, int);
+static void onPollerEvent(void *);
+static void pauseErase(struct FlashScheduler *);
+static enum Result prepareAccess(struct FlashScheduler *, size_t);
+static void recordLatency(struct FlashScheduler *, uint32_t);
+static void scheduleService(struct FlashScheduler *);
+static void serviceTask(void *);
+static enum Result startRequest(struct FlashScheduler *);
+static size_t valueToBin(uint32_t);
+static void waitForErase(struct FlashScheduler *);
+static void waitInterval(const struct FlashScheduler *);
+/*----------------------------------------------------------------------------*/
+static enum Result schedulerInit(void *, const void *);
+static void schedulerDeinit(void *);
+static void schedulerSetCallback(void *, void (*)(void *), void *);
+static enum Result schedulerGetParam(void *, int, void *);
+static enum Result schedulerSetParam(void *, int, const void *);
+static size_t schedulerRead(void *, void *, size_t);
+static size_t schedulerWrite(void *, const void *, size_t);
+/*----------------------------------------------------------------------------*/
+const struct InterfaceClass * const FlashScheduler =
+    &(const struct InterfaceClass){
+    .size = sizeof(struct FlashScheduler),
+    .init = schedulerInit,
+    .deinit = schedulerDeinit,
+
+    .setCallback = schedulerSetCallback,
+    .getParam = schedulerGetParam,
+    .setParam = schedulerSetParam,
+    .read = schedulerRead,
+    .write = schedulerWrite
+};
+/*----------------------------------------------------------------------------*/
+static uint32_t binToValue(size_t bin)
+{
+  if (bin < 4)
+    return (uint32_t)bin;
+
+  /* Upper bound of the bin */
+  const unsigned int order = (unsigned int)(bin / 4) + 1;
+  const uint32_t lower = (uint32_t)(4 + (bin & 3)) << (order - 2);
+
+  return lower + (1UL << (order - 2)) - 1;
+}
+/*----------------------------------------------------------------------------*/
+static enum Result completeRequest(struct FlashScheduler *scheduler)
+{
+  enum Result res;
+
+  if (!scheduler->running)
+  {
+    res = startRequest(scheduler);
+
+    if (res != E_OK || !scheduler->async)
+    {
+      finishRequest(scheduler, res);
+      return res;
+    }
+  }
+  else if (scheduler->suspended)
+  {
+    ifSetParam(scheduler->flash, IF_FLASH_ERASE_RESUME, NULL);
+    scheduler->suspended = false;
+  }
+
+  while ((res = ifGetParam(scheduler->flash, IF_STATUS, NULL)) == E_BUSY);
+
+  finishRequest(scheduler, res);
+  return res;
+}
+/*----------------------------------------------------------------------------*/
+static void finishRequest(struct FlashScheduler *scheduler, enum Result res)
+{
+  flashRequestQueuePopFront(&scheduler->requests);
+  scheduler->running = false;
+  scheduler->suspended = false;
+
+  if (res != E_OK)
+    scheduler->status = res;
+}
+/*----------------------------------------------------------------------------*/
+static enum Result flushRequests(struct FlashScheduler *scheduler,
+    uint32_t address, size_t length)
+{
+  const size_t size = flashRequestQueueSize(&scheduler->requests);
+  size_t count = 0;
+
+  /* Find the last queued request that overlaps the region */
+  for (size_t index = 0; index < size; ++index)
+  {
+    const struct FlashSchedulerRequest * const request =
+        flashRequestQueueAt(&scheduler->requests, index);
+    const uint32_t unit = getUnitSize(scheduler, request->parameter);
+
+    /* Region of the request is unknown when the unit size is ambiguous */
+    if (!unit || (request->address < address + length
+        && address < request->address + unit))
+    {
+      count = index + 1;
+    }
+  }
+
+  /* Requests are completed in order of their arrival */
+  while (count--)
+  {
+    const enum Result res = completeRequest(scheduler);
+
+    if (res != E_OK)
+      return res;
+  }
+
+  return E_OK;
+}
+/*----------------------------------------------------------------------------*/
+static uint32_t getPercentile(const struct FlashScheduler *scheduler,
+    uint32_t percent)
+{
+  const uint32_t count = scheduler->latency.count;
+  const uint32_t threshold =
+      (uint32_t)(((uint64_t)count * percent + 99) / 100);
+  uint32_t accumulated = 0;
+
+  if (!count)
+    return 0;
+
+  for (size_t bin = 0; bin < FLASH_SCHEDULER_BINS; ++bin)
+  {
+    accumulated += scheduler->latency.histogram[bin];
+
+    if (accumulated >= threshold)
+      return MIN(binToValue(bin), scheduler->latency.max);
+  }
+
+  return scheduler->latency.max;
+}
+/*----------------------------------------------------------------------------*/
+static uint32_t getUnitSize(const struct FlashScheduler *scheduler,
+    int parameter)
+{
+  return parameter == IF_FLASH_ERASE_BLOCK ?
+      scheduler->blockSize : scheduler->sectorSize;
+}
+/*----------------------------------------------------------------------------*/
+static void onPollerEvent(void *argument)
+{
+  struct FlashScheduler * const scheduler = argument;
+  wqAdd(scheduler->wq, serviceTask, scheduler);
+}
+/*----------------------------------------------------------------------------*/
+static void pauseErase(struct FlashScheduler *scheduler)
+{
+  if (!scheduler->running || scheduler->suspended)
+    return;
+
+  if (scheduler->suspendable)
+  {
+    waitInterval(scheduler);
+
+    const enum Result res = ifSetParam(scheduler->flash,
+        IF_FLASH_ERASE_SUSPEND, NULL);
+
+    if (res == E_OK)
+    {
+      scheduler->suspended = true;
+      return;
+    }
+    else if (res == E_INVALID)
+      scheduler->suspendable = false;
+  }
+
+  /* Wait for completion of the current erase, next requests stay queued */
+  completeRequest(scheduler);
+  scheduleService(scheduler);
+}
+/*----------------------------------------------------------------------------*/
+static enum Result prepareAccess(struct FlashScheduler *scheduler,
+    size_t length)
+{
+  const enum Result res = flushRequests(scheduler, scheduler->position,
+      length);
+
+  if (res != E_OK)
+    return res;
+
+  pauseErase(scheduler);
+  return ifSetParam(scheduler->flash, IF_POSITION, &scheduler->position);
+}
+/*----------------------------------------------------------------------------*/
+static void recordLatency(struct FlashScheduler *scheduler, uint32_t ticks)
+{
+  const uint32_t frequency = timerGetFrequency(scheduler->timer);
+  const uint64_t value = (uint64_t)ticks * 1000000 / frequency;
+  const uint32_t latency = (uint32_t)MIN(value, UINT32_MAX);
+
+  ++scheduler->latency.histogram[valueToBin(latency)];
+  ++scheduler->latency.count;
+
+  if (latency > scheduler->latency.max)
+    scheduler->latency.max = latency;
+}
+/*----------------------------------------------------------------------------*/
+static void scheduleService(struct FlashScheduler *scheduler)
+{
+  if (!scheduler->pending)
+    scheduler->pending = wqAdd(scheduler->wq, serviceTask, scheduler) == E_OK;
+}
+/*----------------------------------------------------------------------------*/
+static void serviceTask(void *argument)
+{
+  struct FlashScheduler * const scheduler = argument;
+
+  scheduler->pending = false;
+
+  if (scheduler->running)
+  {
+    /* Erase is resumed when there are no more pending reads and writes */
+    if (scheduler->suspended)
+    {
+      ifSetParam(scheduler->flash, IF_FLASH_ERASE_RESUME, NULL);
+      scheduler->suspended = false;
+
+      if (scheduler->timer != NULL)
+        scheduler->resumed = timerGetValue(scheduler->timer);
+    }
+
+    const enum Result res = ifGetParam(scheduler->flash, IF_STATUS, NULL);
+
+    if (res == E_BUSY)
+    {
+      waitForErase(scheduler);
+      return;
+    }
+
+    finishRequest(scheduler, res);
+  }
+
+  if (!flashRequestQueueEmpty(&scheduler->requests))
+  {
+    const enum Result res = startRequest(scheduler);
+
+    if (res != E_OK || !scheduler->async)
+    {
+      /* Next request is started on the next pass of the work queue */
+      finishRequest(scheduler, res);
+      scheduleService(scheduler);
+    }
+    else
+      waitForErase(scheduler);
+
+    return;
+  }
+
+  if (scheduler->poller != NULL)
+    timerDisable(scheduler->poller);
+
+  if (scheduler->callback != NULL)
+    scheduler->callback(scheduler->callbackArgument);
+}
+/*----------------------------------------------------------------------------*/
+static enum Result startRequest(struct FlashScheduler *scheduler)
+{
+  const struct FlashSchedulerRequest request =
+      flashRequestQueueFront(&scheduler->requests);
+  const enum Result res = ifSetParam(scheduler->flash, request.parameter,
+      &request.address);
+
+  if (res == E_OK && scheduler->async)
+  {
+    scheduler->running = true;
+
+    if (scheduler->timer != NULL)
+      scheduler->resumed = timerGetValue(scheduler->timer);
+  }
+
+  return res;
+}
+/*----------------------------------------------------------------------------*/
+static size_t valueToBin(uint32_t value)
+{
+  if (value < 4)
+    return value;
+
+  /* Four bins per octave */
+  const unsigned int order = 31 - countLeadingZeros32(value);
+  const size_t bin = (order - 1) * 4 + ((value >> (order - 2)) & 3);
+
+  return MIN(bin, FLASH_SCHEDULER_BINS - 1);
+}
+/*----------------------------------------------------------------------------*/
+static void waitForErase(struct FlashScheduler *scheduler)
+{
+  /* Background erase operations are started only when the poller is set */
+  assert(scheduler->poller != NULL);
+  timerEnable(scheduler->poller);
+}
+/*----------------------------------------------------------------------------*/
+static void waitInterval(const struct FlashScheduler *scheduler)
+{
+  if (scheduler->timer == NULL || !scheduler->interval)
+    return;
+
+  while (timerGetValue(scheduler->timer) - scheduler->resumed
+      < scheduler->interval)
+  {
+    barrier();
+  }
+}
+/*----------------------------------------------------------------------------*/
+static enum Result schedulerInit(void *object, const void *configBase)
+{
+  const struct FlashSchedulerConfig * const config = configBase;
+  assert(config != NULL);
+  assert(config->flash != NULL && config->wq != NULL);
+  assert(config->requests);
+
+  struct FlashScheduler * const scheduler = object;
+  enum Result res;
+
+  res = ifGetParam(config->flash, IF_SIZE, &scheduler->capacity);
+  if (res != E_OK)
+    return res;
+
+  /* Unit sizes are set to zero when they are ambiguous or unsupported */
+  if (ifGetParam(config->flash, IF_FLASH_SECTOR_SIZE, &scheduler->sectorSize)
+      != E_OK)
+  {
+    scheduler->sectorSize = 0;
+  }
+  if (ifGetParam(config->flash, IF_FLASH_BLOCK_SIZE, &scheduler->blockSize)
+      != E_OK)
+  {
+    scheduler->blockSize = 0;
+  }
+
+  if (!flashRequestQueueInit(&scheduler->requests, config->requests))
+    return E_MEMORY;
+
+  scheduler->callback = NULL;
+  scheduler->callbackArgument = NULL;
+  scheduler->flash = config->flash;
+  scheduler->wq = config->wq;
+  scheduler->timer = config->timer;
+  scheduler->poller = config->poller;
+  scheduler->position = 0;
+  scheduler->interval = 0;
+  scheduler->resumed = 0;
+  scheduler->status = E_OK;
+  scheduler->pending = false;
+  scheduler->running = false;
+  scheduler->suspended = false;
+
+  memset(&scheduler->latency, 0, sizeof(scheduler->latency));
+
+  /*
+   * Erase operations are started in background only when the status can be
+   * polled by the timer, otherwise the service task would occupy the work
+   * queue until the end of the erase. Erase operations are suspended only
+   * when they are started in background.
+   */
+  scheduler->async = scheduler->poller != NULL
+      && ifSetParam(scheduler->flash, IF_ZEROCOPY, NULL) == E_OK;
+  scheduler->suspendable = scheduler->async;
+
+  if (scheduler->timer != NULL)
+  {
+    const uint32_t frequency = timerGetFrequency(scheduler->timer);
+
+    scheduler->interval =
+        (uint32_t)((uint64_t)config->interval * frequency / 1000000);
+  }
+
+  if (scheduler->poller != NULL)
+    timerSetCallback(scheduler->poller, onPollerEvent, scheduler);
+
+  return E_OK;
+}
+/*----------------------------------------------------------------------------*/
+static void schedulerDeinit(void *object)
+{
+  struct FlashScheduler * const scheduler = object;
+
+  if (scheduler->poller != NULL)
+  {
+    timerDisable(scheduler->poller);
+    timerSetCallback(scheduler->poller, NULL, NULL);
+  }
+
+  /* Queued requests are completed before the interface is released */
+  flushRequests(scheduler, 0, scheduler->capacity);
+
+  if (scheduler->async)
+    ifSetParam(scheduler->flash, IF_BLOCKING, NULL);
+
+  flashRequestQueueDeinit(&scheduler->requests);
+}
+/*----------------------------------------------------------------------------*/
+static void schedulerSetCallback(void *object, void (*callback)(void *),
+    void *argument)
+{
+  struct FlashScheduler * const scheduler = object;
+
+  scheduler->callbackArgument = argument;
+  scheduler->callback = callback;
+}
+/*----------------------------------------------------------------------------*/
+static enum Result schedulerGetParam(void *object, int parameter, void *data)
+{
+  struct FlashScheduler * const scheduler = object;
+
+  switch ((enum FlashSchedulerParameter)parameter)
+  {
+    case IF_FLASH_SCHEDULER_LATENCY:
+    {
+      struct FlashSchedulerLatency * const latency = data;
+
+      if (scheduler->timer == NULL)
+        return E_INVALID;
+
+      latency->count = scheduler->latency.count;
+      latency->p50 = getPercentile(scheduler, 50);
+      latency->p90 = getPercentile(scheduler, 90);
+      latency->p99 = getPercentile(scheduler, 99);
+      latency->max = scheduler->latency.max;
+      return E_OK;
+    }
+
+    case IF_FLASH_SCHEDULER_PENDING:
+      *(size_t *)data = flashRequestQueueSize(&scheduler->requests);
+      return E_OK;
+
+    default:
+      break;
+  }
+
+  switch ((enum FlashParameter)parameter)
+  {
+    case IF_FLASH_BLOCK_SIZE:
+    case IF_FLASH_SECTOR_SIZE:
+    case IF_FLASH_PAGE_SIZE:
+      return ifGetParam(scheduler->flash, parameter, data);
+
+    default:
+      break;
+  }
+
+  switch ((enum IfParameter)parameter)
+  {
+    case IF_POSITION:
+      *(uint32_t *)data = scheduler->position;
+      return E_OK;
+
+    case IF_SIZE:
+      *(uint32_t *)data = scheduler->capacity;
+      return E_OK;
+
+    case IF_STATUS:
+    {
+      if (!flashRequestQueueEmpty(&scheduler->requests))
+        return E_BUSY;
+
+      /* Error of the failed erase operation is reported once */
+      const enum Result res = scheduler->status;
+
+      scheduler->status = E_OK;
+      return res;
+    }
+
+    default:
+      return E_INVALID;
+  }
+}
+/*----------------------------------------------------------------------------*/
+static enum Result schedulerSetParam(void *object, int parameter,
+    const void *data)
+{
+  struct FlashScheduler * const scheduler = object;
+
+  switch ((enum FlashSchedulerParameter)parameter)
+  {
+    case IF_FLASH_SCHEDULER_RESET:
+      memset(&scheduler->latency, 0, sizeof(scheduler->latency));
+      return E_OK;
+
+    default:
+      break;
+  }
+
+  switch ((enum FlashParameter)parameter)
+  {
+    case IF_FLASH_ERASE_BLOCK:
+    case IF_FLASH_ERASE_SECTOR:
+    {
+      const uint32_t address = *(const uint32_t *)data;
+      const uint32_t unit = getUnitSize(scheduler, parameter);
+
+      if (parameter == IF_FLASH_ERASE_BLOCK && !unit)
+        return E_INVALID;
+      if (address >= scheduler->capacity || (unit && address % unit))
+        return E_ADDRESS;
+      if (flashRequestQueueFull(&scheduler->requests))
+        return E_FULL;
+
+      flashRequestQueuePushBack(&scheduler->requests,
+          (struct FlashSchedulerRequest){address, (uint8_t)parameter});
+      scheduleService(scheduler);
+      return E_OK;
+    }
+
+    case IF_FLASH_ERASE_PAGE:
+    case IF_FLASH_SUSPEND:
+    case IF_FLASH_RESUME:
+    {
+      /* Queued operations are completed before a direct operation */
+      const enum Result res = flushRequests(scheduler, 0, scheduler->capacity);
+
+      if (res != E_OK)
+        return res;
+
+      return ifSetParam(scheduler->flash, parameter, data);
+    }
+
+    default:
+      break;
+  }
+
+  switch ((enum IfParameter)parameter)
+  {
+    case IF_POSITION:
+    {
+      const uint32_t position = *(const uint32_t *)data;
+
+      if (position < scheduler->capacity)
+      {
+        scheduler->position = position;
+        return E_OK;
+      }
+      else
+        return E_ADDRESS;
+    }
+
+    case IF_BLOCKING:
+      return E_OK;
+
+    default:
+      return E_INVALID;
+  }
+}
+/*----------------------------------------------------------------------------*/
+static size_t schedulerRead(void *object, void *buffer, size_t length)
+{
+  struct FlashScheduler * const scheduler = object;
+  const uint32_t timestamp = scheduler->timer != NULL ?
+      timerGetValue(scheduler->timer) : 0;
+
+  if (length > scheduler->capacity - scheduler->position)
+    length = scheduler->capacity - scheduler->position;
+
+  if (prepareAccess(scheduler, length) != E_OK)
+    return 0;
+
+  const size_t count = ifRead(scheduler->flash, buffer, length);
+
+  scheduler->position += count;
+
+  if (scheduler->timer != NULL)
+    recordLatency(scheduler, timerGetValue(scheduler->timer) - timestamp);
+
+  /* Suspended erase is resumed by the service task */
+  if (scheduler->suspended)
+    scheduleService(scheduler);
+
+  return count;
+}
+/*----------------------------------------------------------------------------*/
+static size_t schedulerWrite(void *object, const void *buffer, size_t length)
+{
+  struct FlashScheduler * const scheduler = object;
+
+  if (length > scheduler->capacity - scheduler->position)
+    length = scheduler->capacity - scheduler->position;
+
+  if (prepareAccess(scheduler, length) != E_OK)
+    return 0;
+
+  const size_t count = ifWrite(scheduler->flash, buffer, length);
+
+  scheduler->position += count;
+
+  if (scheduler->suspended)
+    scheduleService(scheduler);
+
+  return count;
+}
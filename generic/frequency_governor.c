@@ -0,0 +1,270 @@
+/*
+ * frequency_governor.c
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the MIT License
+ */
+
+#include <halm/generic/frequency_governor.h>
+#include <halm/irq.h>
+#include <halm/pm.h>
+#include <halm/timer.h>
+#include <assert.h>
+
+#ifdef CONFIG_GENERIC_WQ
+#  include <halm/generic/work_queue.h>
+#endif
+
+#ifdef CONFIG_GENERIC_WQ_IRQ
+#  include <halm/generic/work_queue_irq.h>
+#endif
+
+#ifdef CONFIG_GENERIC_WQ_UNIQUE
+#  include <halm/generic/work_queue_unique.h>
+#endif
+/*----------------------------------------------------------------------------*/
+#define DEFAULT_DOWN_THRESHOLD  30
+#define DEFAULT_UP_THRESHOLD    80
+/*----------------------------------------------------------------------------*/
+static size_t calcLoad(const struct FrequencyGovernor *, WqCounter);
+static bool isLoadSupported(const void *);
+static size_t selectLatencyPoint(const struct FrequencyGovernor *,
+    WqCounter);
+static size_t selectLoadPoint(const struct FrequencyGovernor *, size_t);
+static void onTimerEvent(void *);
+static void sampleTask(void *);
+static enum Result switchPoint(struct FrequencyGovernor *, size_t);
+/*----------------------------------------------------------------------------*/
+static enum Result governorInit(void *, const void *);
+static void governorDeinit(void *);
+/*----------------------------------------------------------------------------*/
+const struct EntityClass * const FrequencyGovernor =
+    &(const struct EntityClass){
+    .size = sizeof(struct FrequencyGovernor),
+    .init = governorInit,
+    .deinit = governorDeinit
+};
+/*----------------------------------------------------------------------------*/
+static size_t calcLoad(const struct FrequencyGovernor *governor,
+    WqCounter loops)
+{
+  /* Number of idle loops is proportional to the core frequency */
+  const uint64_t expected = (uint64_t)governor->calibration
+      * governor->points[governor->current]
+      / governor->points[governor->count - 1];
+
+  if (!expected || loops >= expected)
+    return 0;
+
+  return (size_t)(100 - (uint64_t)loops * 100 / expected);
+}
+/*----------------------------------------------------------------------------*/
+static bool isLoadSupported(const void *wq)
+{
+  const struct WorkQueueClass * const type =
+      (const struct WorkQueueClass *)CLASS(wq);
+
+  /*
+   * Work queues of the library report zero idle loops when they are built
+   * without load measurement, the load would always be at the maximum.
+   */
+#if defined(CONFIG_GENERIC_WQ) && !defined(CONFIG_GENERIC_WQ_LOAD)
+  if (type == WorkQueue)
+    return false;
+#endif
+#ifdef CONFIG_GENERIC_WQ_IRQ
+  if (type == WorkQueueIrq)
+    return false;
+#endif
+#if defined(CONFIG_GENERIC_WQ_UNIQUE) \
+    && !defined(CONFIG_GENERIC_WQ_UNIQUE_LOAD)
+  if (type == WorkQueueUnique)
+    return false;
+#endif
+
+  return type->statistics != NULL;
+}
+/*----------------------------------------------------------------------------*/
+static size_t selectLatencyPoint(const struct FrequencyGovernor *governor,
+    WqCounter latency)
+{
+  const size_t current = governor->current;
+
+  if (governor->overload || latency > governor->latency)
+  {
+    /* Latency limit is violated, use the highest operating point */
+    return governor->count - 1;
+  }
+
+  if (current > 0 && latency < governor->latency / 2)
+  {
+    /* Estimate the latency at the lower point from the frequency ratio */
+    const uint64_t estimated = (uint64_t)latency * governor->points[current]
+        / governor->points[current - 1];
+
+    if (estimated < governor->latency / 2)
+      return current - 1;
+  }
+
+  return current;
+}
+/*----------------------------------------------------------------------------*/
+static size_t selectLoadPoint(const struct FrequencyGovernor *governor,
+    size_t load)
+{
+  const size_t current = governor->current;
+
+  if (governor->overload || load > governor->up)
+    return governor->count - 1;
+  if (current > 0 && load < governor->down)
+    return current - 1;
+
+  return current;
+}
+/*----------------------------------------------------------------------------*/
+static void onTimerEvent(void *argument)
+{
+  struct FrequencyGovernor * const governor = argument;
+
+  if (governor->pending)
+    return;
+
+  governor->timestamp = wqGetTime();
+
+  if (wqAdd(governor->wq, sampleTask, governor) == E_OK)
+    governor->pending = true;
+  else
+    governor->overload = true;
+}
+/*----------------------------------------------------------------------------*/
+static void sampleTask(void *argument)
+{
+  struct FrequencyGovernor * const governor = argument;
+  const WqCounter latency = wqGetTime() - governor->timestamp;
+  size_t next = governor->current;
+
+  switch (governor->policy)
+  {
+    case GOVERNOR_ONDEMAND:
+    {
+      struct WqInfo info;
+
+      wqStatistics(governor->wq, &info);
+      next = selectLoadPoint(governor, calcLoad(governor, info.loops));
+      break;
+    }
+
+    case GOVERNOR_PERFORMANCE:
+      next = governor->count - 1;
+      break;
+
+    case GOVERNOR_LATENCY:
+      next = selectLatencyPoint(governor, latency);
+      break;
+  }
+
+  const IrqState state = irqSave();
+  governor->overload = false;
+  governor->pending = false;
+  irqRestore(state);
+
+  if (next != governor->current)
+    switchPoint(governor, next);
+}
+/*----------------------------------------------------------------------------*/
+static enum Result switchPoint(struct FrequencyGovernor *governor,
+    size_t index)
+{
+  const enum Result res = governor->apply(governor->argument, index);
+
+  if (res == E_OK)
+  {
+    governor->current = index;
+
+    /* Peripherals recalculate dividers when the active state is entered */
+    pmChangeState(PM_ACTIVE);
+  }
+
+  return res;
+}
+/*----------------------------------------------------------------------------*/
+size_t frequencyGovernorGetPoint(const void *object)
+{
+  return ((const struct FrequencyGovernor *)object)->current;
+}
+/*----------------------------------------------------------------------------*/
+enum Result frequencyGovernorSetPolicy(void *object,
+    enum GovernorPolicy policy)
+{
+  struct FrequencyGovernor * const governor = object;
+
+  if (policy == GOVERNOR_ONDEMAND)
+  {
+    /* Load is calculated from the idle loop counter of the work queue */
+    if (!isLoadSupported(governor->wq) || !governor->calibration)
+      return E_INVALID;
+  }
+  else if (policy == GOVERNOR_LATENCY)
+  {
+    if (!governor->latency)
+      return E_INVALID;
+  }
+
+  const size_t highest = governor->count - 1;
+
+  governor->policy = policy;
+
+  if (policy == GOVERNOR_PERFORMANCE && governor->current != highest)
+    return switchPoint(governor, highest);
+
+  return E_OK;
+}
+/*----------------------------------------------------------------------------*/
+static enum Result governorInit(void *object, const void *configBase)
+{
+  const struct FrequencyGovernorConfig * const config = configBase;
+  assert(config != NULL);
+  assert(config->wq != NULL && config->timer != NULL);
+  assert(config->points != NULL && config->count > 0);
+  assert(config->apply != NULL);
+  assert(config->up <= 100 && config->down <= 100);
+
+  struct FrequencyGovernor * const governor = object;
+
+  governor->wq = config->wq;
+  governor->timer = config->timer;
+  governor->apply = config->apply;
+  governor->argument = config->argument;
+  governor->points = config->points;
+  governor->count = config->count;
+  governor->calibration = config->calibration;
+  governor->latency = config->latency;
+  governor->timestamp = 0;
+  governor->up = config->up ? config->up : DEFAULT_UP_THRESHOLD;
+  governor->down = config->down ? config->down : DEFAULT_DOWN_THRESHOLD;
+  governor->pending = false;
+  governor->overload = false;
+  governor->policy = GOVERNOR_PERFORMANCE;
+
+  /* Governor starts from the highest operating point */
+  enum Result res;
+
+  governor->current = governor->count - 1;
+  if ((res = governor->apply(governor->argument, governor->current)) != E_OK)
+    return res;
+
+  if ((res = frequencyGovernorSetPolicy(governor, config->policy)) != E_OK)
+    return res;
+
+  timerSetCallback(governor->timer, onTimerEvent, governor);
+  timerEnable(governor->timer);
+
+  return E_OK;
+}
+/*----------------------------------------------------------------------------*/
+static void governorDeinit(void *object)
+{
+  struct FrequencyGovernor * const governor = object;
+
+  timerDisable(governor->timer);
+  timerSetCallback(governor->timer, NULL, NULL);
+}
@@ -0,0 +1,235 @@
+/*
+ * idle_coordinator.c
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the MIT License
+ */
+
+#include <halm/generic/idle_coordinator.h>
+#include <halm/generic/timer_factory.h>
+#include <halm/irq.h>
+#include <halm/timer.h>
+#include <assert.h>
+#include <stdlib.h>
+/*----------------------------------------------------------------------------*/
+#define US_PER_SECOND 1000000
+/*----------------------------------------------------------------------------*/
+static uint32_t getClockValue(const struct IdleCoordinator *);
+static uint32_t getRemainingTime(struct IdleCoordinator *);
+static bool prepareWakeup(struct IdleCoordinator *, uint32_t);
+static inline uint32_t ticksToTime(uint32_t, uint32_t);
+static inline uint32_t timeToTicks(uint32_t, uint32_t);
+/*----------------------------------------------------------------------------*/
+static enum Result coordinatorInit(void *, const void *);
+static void coordinatorDeinit(void *);
+/*----------------------------------------------------------------------------*/
+const struct EntityClass * const IdleCoordinator =
+    &(const struct EntityClass){
+    .size = sizeof(struct IdleCoordinator),
+    .init = coordinatorInit,
+    .deinit = coordinatorDeinit
+};
+/*----------------------------------------------------------------------------*/
+static uint32_t getClockValue(const struct IdleCoordinator *coordinator)
+{
+  return coordinator->clock != NULL ? timerGetValue(coordinator->clock) : 0;
+}
+/*----------------------------------------------------------------------------*/
+static uint32_t getRemainingTime(struct IdleCoordinator *coordinator)
+{
+  const size_t count = pointerArraySize(&coordinator->factories);
+  uint32_t remaining = UINT32_MAX;
+
+  for (size_t index = 0; index < count; ++index)
+  {
+    void * const factory = *pointerArrayAt(&coordinator->factories, index);
+    const uint32_t time = ticksToTime(timerFactoryGetDeadline(factory),
+        timerGetFrequency(factory));
+
+    if (time < remaining)
+      remaining = time;
+  }
+
+  return remaining;
+}
+/*----------------------------------------------------------------------------*/
+static bool prepareWakeup(struct IdleCoordinator *coordinator,
+    uint32_t latency)
+{
+  const size_t count = pointerArraySize(&coordinator->factories);
+
+  for (size_t index = 0; index < count; ++index)
+  {
+    void * const factory = *pointerArrayAt(&coordinator->factories, index);
+    const uint32_t advance = timeToTicks(latency, timerGetFrequency(factory));
+
+    if (timerFactorySetWakeup(factory, advance) != E_OK)
+    {
+      /* Restore wake-up times of already reprogrammed factories */
+      while (index--)
+      {
+        timerFactorySetWakeup(*pointerArrayAt(&coordinator->factories, index),
+            0);
+      }
+
+      return false;
+    }
+  }
+
+  return true;
+}
+/*----------------------------------------------------------------------------*/
+static inline uint32_t ticksToTime(uint32_t ticks, uint32_t frequency)
+{
+  const uint64_t time = (uint64_t)ticks * US_PER_SECOND / frequency;
+  return time < UINT32_MAX ? (uint32_t)time : UINT32_MAX;
+}
+/*----------------------------------------------------------------------------*/
+static inline uint32_t timeToTicks(uint32_t time, uint32_t frequency)
+{
+  /* Round up to wake up not later than required */
+  return (uint32_t)(((uint64_t)time * frequency + US_PER_SECOND - 1)
+      / US_PER_SECOND);
+}
+/*----------------------------------------------------------------------------*/
+void idleCoordinatorEnter(void *object)
+{
+  struct IdleCoordinator * const coordinator = object;
+  const uint32_t remaining = getRemainingTime(coordinator);
+  size_t index = coordinator->count;
+
+  while (index--)
+  {
+    const struct IdleState * const entry = &coordinator->states[index];
+
+    if ((uint64_t)entry->latency + entry->residency > remaining)
+      continue;
+
+    /* Latency is compensated by reprogramming of timer factories */
+    if (entry->latency && !prepareWakeup(coordinator, entry->latency))
+      continue;
+
+    struct IdleInfo * const info = &coordinator->info[index];
+    const uint32_t begin = getClockValue(coordinator);
+
+    pmChangeState(entry->state);
+
+    uint32_t elapsed;
+
+    if (coordinator->clock != NULL)
+    {
+      const uint32_t end = getClockValue(coordinator);
+      const uint32_t overflow = timerGetOverflow(coordinator->clock);
+      uint32_t delta = end - begin;
+
+      if (end < begin && overflow)
+        delta += overflow;
+
+      elapsed = ticksToTime(delta,
+          timerGetFrequency(coordinator->clock));
+
+      if (elapsed > remaining)
+        ++info->misses;
+    }
+    else
+      elapsed = remaining;
+
+    ++info->entries;
+    if (elapsed > entry->latency)
+      info->residency += elapsed - entry->latency;
+
+    return;
+  }
+
+  ++coordinator->skips;
+}
+/*----------------------------------------------------------------------------*/
+enum Result idleCoordinatorGetInfo(const void *object, size_t index,
+    struct IdleInfo *info)
+{
+  const struct IdleCoordinator * const coordinator = object;
+
+  if (index >= coordinator->count)
+    return E_VALUE;
+
+  const IrqState state = irqSave();
+  *info = coordinator->info[index];
+  irqRestore(state);
+
+  return E_OK;
+}
+/*----------------------------------------------------------------------------*/
+uint32_t idleCoordinatorGetSkips(const void *object)
+{
+  return ((const struct IdleCoordinator *)object)->skips;
+}
+/*----------------------------------------------------------------------------*/
+enum Result idleCoordinatorRegister(void *object, void *factory)
+{
+  struct IdleCoordinator * const coordinator = object;
+  enum Result res = E_FULL;
+
+  const IrqState state = irqSave();
+
+  if (!pointerArrayFull(&coordinator->factories))
+  {
+    pointerArrayPushBack(&coordinator->factories, factory);
+    res = E_OK;
+  }
+
+  irqRestore(state);
+  return res;
+}
+/*----------------------------------------------------------------------------*/
+void idleCoordinatorUnregister(void *object, const void *factory)
+{
+  struct IdleCoordinator * const coordinator = object;
+  const IrqState state = irqSave();
+  const size_t count = pointerArraySize(&coordinator->factories);
+
+  for (size_t index = 0; index < count; ++index)
+  {
+    void ** const entry = pointerArrayAt(&coordinator->factories, index);
+
+    if (*entry == factory)
+    {
+      /* Order of factories is not important */
+      *entry = pointerArrayBack(&coordinator->factories);
+      pointerArrayPopBack(&coordinator->factories);
+      break;
+    }
+  }
+
+  irqRestore(state);
+}
+/*----------------------------------------------------------------------------*/
+static enum Result coordinatorInit(void *object, const void *configBase)
+{
+  const struct IdleCoordinatorConfig * const config = configBase;
+  assert(config != NULL);
+  assert(config->states != NULL && config->count > 0);
+  assert(config->capacity > 0);
+
+  struct IdleCoordinator * const coordinator = object;
+
+  coordinator->clock = config->clock;
+  coordinator->states = config->states;
+  coordinator->count = config->count;
+  coordinator->skips = 0;
+
+  coordinator->info = calloc(config->count, sizeof(struct IdleInfo));
+  if (coordinator->info == NULL)
+    return E_MEMORY;
+
+  if (!pointerArrayInit(&coordinator->factories, config->capacity))
+    return E_MEMORY;
+
+  return E_OK;
+}
+/*----------------------------------------------------------------------------*/
+static void coordinatorDeinit(void *object)
+{
+  struct IdleCoordinator * const coordinator = object;
+
+  pointerArrayDeinit(&coordinator->factories);
+  free(coordinator->info);
+}
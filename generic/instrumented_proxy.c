@@ -0,0 +1,307 @@
+/*
+ * instrumented_proxy.c
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the MIT License
+ */
+
+#include <halm/generic/instrumented_proxy.h>
+#include <halm/irq.h>
+#include <halm/timer.h>
+#include <xcore/bits.h>
+#include <assert.h>
+#include <string.h>
+/*----------------------------------------------------------------------------*/
+static void addTimingSample(struct InstrumentedProxyTiming *, uint32_t);
+static void clearStatistics(struct InstrumentedProxyStatistics *);
+static void clearTiming(struct InstrumentedProxyTiming *);
+static uint32_t getElapsedTime(const struct InstrumentedProxy *, uint32_t);
+static uint32_t getTime(const struct InstrumentedProxy *);
+static void interfaceCallback(void *);
+static enum Result countResult(struct InstrumentedProxy *, enum Result);
+static void startTransfer(struct InstrumentedProxy *, uint32_t);
+static void updateChannel(struct InstrumentedProxy *,
+    struct InstrumentedProxyChannel *, uint32_t, size_t, size_t);
+/*----------------------------------------------------------------------------*/
+static enum Result interfaceInit(void *, const void *);
+static void interfaceDeinit(void *);
+static void interfaceSetCallback(void *, void (*)(void *), void *);
+static enum Result interfaceGetParam(void *, int, void *);
+static enum Result interfaceSetParam(void *, int, const void *);
+static size_t interfaceRead(void *, void *, size_t);
+static size_t interfaceWrite(void *, const void *, size_t);
+/*----------------------------------------------------------------------------*/
+const struct InterfaceClass * const InstrumentedProxy =
+    &(const struct InterfaceClass){
+    .size = sizeof(struct InstrumentedProxy),
+    .init = interfaceInit,
+    .deinit = interfaceDeinit,
+
+    .setCallback = interfaceSetCallback,
+    .getParam = interfaceGetParam,
+    .setParam = interfaceSetParam,
+    .read = interfaceRead,
+    .write = interfaceWrite
+};
+/*----------------------------------------------------------------------------*/
+static void addTimingSample(struct InstrumentedProxyTiming *timing,
+    uint32_t value)
+{
+  unsigned int bucket = value ? 31 - countLeadingZeros32(value) : 0;
+
+  if (bucket >= INSTRUMENTED_PROXY_BUCKETS)
+    bucket = INSTRUMENTED_PROXY_BUCKETS - 1;
+
+  ++timing->count;
+  ++timing->histogram[bucket];
+
+  if (timing->min > value)
+    timing->min = value;
+  if (timing->max < value)
+    timing->max = value;
+  timing->total += value;
+}
+/*----------------------------------------------------------------------------*/
+static void clearStatistics(struct InstrumentedProxyStatistics *statistics)
+{
+  memset(statistics, 0, sizeof(*statistics));
+
+  clearTiming(&statistics->rx.latency);
+  clearTiming(&statistics->tx.latency);
+  clearTiming(&statistics->completion);
+}
+/*----------------------------------------------------------------------------*/
+static void clearTiming(struct InstrumentedProxyTiming *timing)
+{
+  memset(timing, 0, sizeof(*timing));
+  timing->min = UINT32_MAX;
+}
+/*----------------------------------------------------------------------------*/
+static enum Result countResult(struct InstrumentedProxy *interface,
+    enum Result res)
+{
+  if (res < E_RESULT_END)
+  {
+    const IrqState state = irqSave();
+    ++interface->statistics.results[res];
+    irqRestore(state);
+  }
+
+  return res;
+}
+/*----------------------------------------------------------------------------*/
+static uint32_t getElapsedTime(const struct InstrumentedProxy *interface,
+    uint32_t begin)
+{
+  const uint32_t end = getTime(interface);
+  uint32_t elapsed = end - begin;
+
+  if (end < begin)
+  {
+    /* Zero overflow value is used by timers with the full 32-bit range */
+    const uint32_t overflow = timerGetOverflow(interface->clock);
+
+    if (overflow)
+      elapsed += overflow;
+  }
+
+  return elapsed;
+}
+/*----------------------------------------------------------------------------*/
+static uint32_t getTime(const struct InstrumentedProxy *interface)
+{
+  return interface->clock != NULL ? timerGetValue(interface->clock) : 0;
+}
+/*----------------------------------------------------------------------------*/
+static void interfaceCallback(void *argument)
+{
+  struct InstrumentedProxy * const interface = argument;
+  struct InstrumentedProxyStatistics * const statistics =
+      &interface->statistics;
+
+  ++statistics->callbacks;
+
+  if (interface->pending)
+  {
+    const enum Result res = ifGetParam(interface->pipe, IF_STATUS, NULL);
+
+    /* Transfer is still in progress when the status is busy */
+    if (res != E_BUSY)
+    {
+      interface->pending = false;
+
+      if (interface->clock != NULL)
+      {
+        addTimingSample(&statistics->completion,
+            getElapsedTime(interface, interface->timestamp));
+      }
+
+      if (res < E_RESULT_END)
+        ++statistics->status[res];
+    }
+  }
+
+  if (interface->callback != NULL)
+    interface->callback(interface->callbackArgument);
+}
+/*----------------------------------------------------------------------------*/
+static void startTransfer(struct InstrumentedProxy *interface, uint32_t begin)
+{
+  if (interface->zerocopy)
+  {
+    /*
+     * Completion may be signaled before the wrapped interface returns,
+     * therefore the transfer is marked as pending in advance. Completion
+     * time is measured from the start of the transfer.
+     */
+    const IrqState state = irqSave();
+
+    interface->timestamp = begin;
+    interface->pending = true;
+
+    irqRestore(state);
+  }
+}
+/*----------------------------------------------------------------------------*/
+static void updateChannel(struct InstrumentedProxy *interface,
+    struct InstrumentedProxyChannel *channel, uint32_t begin,
+    size_t requested, size_t transferred)
+{
+  const IrqState state = irqSave();
+
+  ++channel->calls;
+  channel->bytes += transferred;
+  if (transferred < requested)
+    ++channel->partial;
+
+  if (interface->clock != NULL)
+    addTimingSample(&channel->latency, getElapsedTime(interface, begin));
+
+  /* Transfer was not started, completion callback is not expected */
+  if (interface->zerocopy && !transferred)
+    interface->pending = false;
+
+  irqRestore(state);
+}
+/*----------------------------------------------------------------------------*/
+static enum Result interfaceInit(void *object, const void *configBase)
+{
+  const struct InstrumentedProxyConfig * const config = configBase;
+  assert(config != NULL);
+  assert(config->pipe != NULL);
+
+  struct InstrumentedProxy * const interface = object;
+
+  interface->callback = NULL;
+  interface->callbackArgument = NULL;
+  interface->pipe = config->pipe;
+  interface->clock = config->clock;
+  interface->timestamp = 0;
+  interface->pending = false;
+  interface->zerocopy = false;
+
+  clearStatistics(&interface->statistics);
+  return E_OK;
+}
+/*----------------------------------------------------------------------------*/
+static void interfaceDeinit(void *object)
+{
+  struct InstrumentedProxy * const interface = object;
+
+  if (interface->callback != NULL)
+    ifSetCallback(interface->pipe, NULL, NULL);
+}
+/*----------------------------------------------------------------------------*/
+static void interfaceSetCallback(void *object, void (*callback)(void *),
+    void *argument)
+{
+  struct InstrumentedProxy * const interface = object;
+
+  interface->callbackArgument = argument;
+  interface->callback = callback;
+
+  /* Wrapped interface keeps the callback mode selected by the user */
+  if (callback != NULL)
+    ifSetCallback(interface->pipe, interfaceCallback, interface);
+  else
+    ifSetCallback(interface->pipe, NULL, NULL);
+}
+/*----------------------------------------------------------------------------*/
+static enum Result interfaceGetParam(void *object, int parameter, void *data)
+{
+  struct InstrumentedProxy * const interface = object;
+
+  switch ((enum InstrumentedProxyParameter)parameter)
+  {
+    case IF_PROXY_STATISTICS:
+    {
+      const IrqState state = irqSave();
+      memcpy(data, &interface->statistics, sizeof(interface->statistics));
+      irqRestore(state);
+      return E_OK;
+    }
+
+    default:
+      break;
+  }
+
+  return countResult(interface, ifGetParam(interface->pipe, parameter, data));
+}
+/*----------------------------------------------------------------------------*/
+static enum Result interfaceSetParam(void *object, int parameter,
+    const void *data)
+{
+  struct InstrumentedProxy * const interface = object;
+
+  switch ((enum InstrumentedProxyParameter)parameter)
+  {
+    case IF_PROXY_RESET:
+    {
+      const IrqState state = irqSave();
+      clearStatistics(&interface->statistics);
+      irqRestore(state);
+      return E_OK;
+    }
+
+    default:
+      break;
+  }
+
+  const enum Result res = ifSetParam(interface->pipe, parameter, data);
+
+  if (res == E_OK)
+  {
+    /* Track the transfer mode for completion time measurement */
+    if (parameter == IF_ZEROCOPY)
+      interface->zerocopy = true;
+    else if (parameter == IF_BLOCKING)
+      interface->zerocopy = false;
+  }
+
+  return countResult(interface, res);
+}
+/*----------------------------------------------------------------------------*/
+static size_t interfaceRead(void *object, void *buffer, size_t length)
+{
+  struct InstrumentedProxy * const interface = object;
+  const uint32_t begin = getTime(interface);
+
+  startTransfer(interface, begin);
+
+  const size_t count = ifRead(interface->pipe, buffer, length);
+
+  updateChannel(interface, &interface->statistics.rx, begin, length, count);
+  return count;
+}
+/*----------------------------------------------------------------------------*/
+static size_t interfaceWrite(void *object, const void *buffer, size_t length)
+{
+  struct InstrumentedProxy * const interface = object;
+  const uint32_t begin = getTime(interface);
+
+  startTransfer(interface, begin);
+
+  const size_t count = ifWrite(interface->pipe, buffer, length);
+
+  updateChannel(interface, &interface->statistics.tx, begin, length, count);
+  return count;
+}
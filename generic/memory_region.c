@@ -0,0 +1,248 @@
+/*
+ * memory_region.c
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the MIT License
+ */
+
+#include <halm/generic/memory_region.h>
+#include <halm/irq.h>
+#include <assert.h>
+#include <malloc.h>
+#include <stdalign.h>
+#include <stdlib.h>
+#include <string.h>
+/*----------------------------------------------------------------------------*/
+struct MemoryRegionEntry
+{
+  /* Region boundaries */
+  uintptr_t begin;
+  uintptr_t end;
+  /* First free address */
+  uintptr_t position;
+
+  /* Last allocated block and the free address before its allocation */
+  uintptr_t last;
+  uintptr_t previous;
+
+  const char *name;
+  uint8_t flags;
+};
+/*----------------------------------------------------------------------------*/
+static void *allocHeapMemory(size_t, size_t);
+static void *allocRegionMemory(struct MemoryRegionEntry *, size_t, size_t);
+static struct MemoryRegionEntry *findRegion(uintptr_t, size_t);
+static int getRegionScore(const struct MemoryRegionEntry *, enum MemoryHint);
+/*----------------------------------------------------------------------------*/
+static struct MemoryRegionEntry regions[CONFIG_GENERIC_MEMORY_REGION_COUNT];
+static size_t regionCount = 0;
+/*----------------------------------------------------------------------------*/
+static void *allocHeapMemory(size_t size, size_t alignment)
+{
+  if (alignment > alignof(max_align_t))
+    return memalign(alignment, size);
+  else
+    return malloc(size);
+}
+/*----------------------------------------------------------------------------*/
+static void *allocRegionMemory(struct MemoryRegionEntry *region, size_t size,
+    size_t alignment)
+{
+  const uintptr_t address = (region->position + alignment - 1)
+      & ~(uintptr_t)(alignment - 1);
+
+  if (address < region->position || address > region->end
+      || region->end - address < size)
+  {
+    return NULL;
+  }
+
+  region->previous = region->position;
+  region->last = address;
+  region->position = address + size;
+
+  return (void *)address;
+}
+/*----------------------------------------------------------------------------*/
+static struct MemoryRegionEntry *findRegion(uintptr_t address, size_t size)
+{
+  for (size_t index = 0; index < regionCount; ++index)
+  {
+    struct MemoryRegionEntry * const region = &regions[index];
+
+    if (address >= region->begin && address < region->end
+        && region->end - address >= size)
+    {
+      return region;
+    }
+  }
+
+  return NULL;
+}
+/*----------------------------------------------------------------------------*/
+static int getRegionScore(const struct MemoryRegionEntry *region,
+    enum MemoryHint hint)
+{
+  switch (hint)
+  {
+    case MEMORY_HINT_DMA:
+      if (!(region->flags & MEMORY_DMA))
+        return -1;
+
+      /* Coherent memory does not require cache maintenance */
+      return (region->flags & MEMORY_COHERENT) ? 2 : 1;
+
+    case MEMORY_HINT_FAST:
+      return (region->flags & MEMORY_FAST) ? 1 : -1;
+
+    case MEMORY_HINT_BULK:
+      return (region->flags & MEMORY_BULK) ? 1 : -1;
+
+    default:
+      return -1;
+  }
+}
+/*----------------------------------------------------------------------------*/
+void *memoryRegionAlloc(enum MemoryHint hint, size_t size, size_t alignment)
+{
+  assert(alignment > 0 && (alignment & (alignment - 1)) == 0);
+
+  void *block = NULL;
+  uint32_t checked = 0;
+
+  const IrqState state = irqSave();
+
+  /* Regions are tried in the order of scores and registration */
+  while (block == NULL)
+  {
+    struct MemoryRegionEntry *candidate = NULL;
+    size_t position = 0;
+    int best = -1;
+
+    for (size_t index = 0; index < regionCount; ++index)
+    {
+      if (checked & (1UL << index))
+        continue;
+
+      const int score = getRegionScore(&regions[index], hint);
+
+      if (score > best)
+      {
+        candidate = &regions[index];
+        position = index;
+        best = score;
+      }
+    }
+
+    if (candidate == NULL)
+      break;
+
+    checked |= 1UL << position;
+    block = allocRegionMemory(candidate, size, alignment);
+  }
+
+  irqRestore(state);
+
+  if (block == NULL)
+    block = allocHeapMemory(size, alignment);
+
+  return block;
+}
+/*----------------------------------------------------------------------------*/
+void *memoryRegionAllocNamed(const char *name, size_t size, size_t alignment)
+{
+  assert(alignment > 0 && (alignment & (alignment - 1)) == 0);
+
+  void *block = NULL;
+
+  const IrqState state = irqSave();
+
+  for (size_t index = 0; index < regionCount; ++index)
+  {
+    if (!strcmp(regions[index].name, name))
+    {
+      block = allocRegionMemory(&regions[index], size, alignment);
+      break;
+    }
+  }
+
+  irqRestore(state);
+  return block;
+}
+/*----------------------------------------------------------------------------*/
+void memoryRegionFree(void *block)
+{
+  if (block == NULL)
+    return;
+
+  const IrqState state = irqSave();
+  struct MemoryRegionEntry * const region = findRegion((uintptr_t)block, 0);
+
+  if (region != NULL)
+  {
+    /* Only the last allocation could be returned to the region */
+    if (region->last == (uintptr_t)block)
+    {
+      region->position = region->previous;
+      region->last = 0;
+    }
+  }
+
+  irqRestore(state);
+
+  if (region == NULL)
+    free(block);
+}
+/*----------------------------------------------------------------------------*/
+uint8_t memoryRegionGetFlags(const void *address, size_t size)
+{
+  const struct MemoryRegionEntry * const region =
+      findRegion((uintptr_t)address, size);
+
+  return region != NULL ? region->flags : 0;
+}
+/*----------------------------------------------------------------------------*/
+enum Result memoryRegionRegister(const struct MemoryRegion *config)
+{
+  assert(config != NULL);
+  assert(config->name != NULL);
+  assert(config->address != NULL && config->size > 0);
+
+  const uintptr_t begin = (uintptr_t)config->address;
+  const uintptr_t end = begin + config->size;
+  enum Result res = E_OK;
+
+  const IrqState state = irqSave();
+
+  if (regionCount == CONFIG_GENERIC_MEMORY_REGION_COUNT)
+  {
+    res = E_FULL;
+  }
+  else
+  {
+    for (size_t index = 0; index < regionCount; ++index)
+    {
+      /* Regions should not overlap */
+      if (begin < regions[index].end && regions[index].begin < end)
+      {
+        res = E_EXIST;
+        break;
+      }
+    }
+  }
+
+  if (res == E_OK)
+  {
+    regions[regionCount++] = (struct MemoryRegionEntry){
+        .begin = begin,
+        .end = end,
+        .position = begin,
+        .last = 0,
+        .previous = begin,
+        .name = config->name,
+        .flags = config->flags
+    };
+  }
+
+  irqRestore(state);
+  return res;
+}
@@ -8,10 +8,17 @@
 #include <halm/generic/mmcsd.h>
 #include <halm/generic/mmcsd_defs.h>
 #include <halm/generic/sdio_defs.h>
+#include <halm/irq.h>
+#include <halm/timer.h>
 #include <xcore/asm.h>
 #include <xcore/memory.h>
 #include <assert.h>
+#include <stdlib.h>
 #include <string.h>
+
+#ifdef CONFIG_GENERIC_MMCSD_PM
+#  include <halm/pm.h>
+#endif
 /*----------------------------------------------------------------------------*/
 #define DEFAULT_BLOCK_SIZE 512
 
@@ -20,6 +27,9 @@ enum State
   STATE_IDLE,
   STATE_GET_STATUS,
   STATE_SELECT_CARD,
+  STATE_APP_COMMAND,
+  STATE_PRE_ERASE,
+  STATE_BLOCK_COUNT,
   STATE_TRANSFER,
   STATE_STOP,
   STATE_HALT,
@@ -27,6 +37,7 @@ enum State
 };
 /*----------------------------------------------------------------------------*/
 static enum Result initStepEnableCrc(struct MMCSD *);
+static enum Result initStepMmcEnableCache(struct MMCSD *);
 static enum Result initStepMmcReadOCR(struct MMCSD *);
 static enum Result initStepMmcSetBusWidth(struct MMCSD *);
 static enum Result initStepMmcSetHighSpeed(struct MMCSD *, enum MMCSDSpeed);
@@ -36,33 +47,60 @@ static enum Result initStepReadCSD(struct MMCSD *);
 static enum Result initStepReadExtCSD(struct MMCSD *);
 static enum Result initStepReadRCA(struct MMCSD *);
 static enum Result initStepSdReadOCR(struct MMCSD *);
+static enum Result initStepSdReadSCR(struct MMCSD *);
 static enum Result initStepSdSetBusWidth(struct MMCSD *);
 static enum Result initStepSendReset(struct MMCSD *);
 static enum Result initStepSetBlockLength(struct MMCSD *);
 static enum Result initStepSetRCA(struct MMCSD *, uint32_t);
 static enum Result initStepSpiReadOCR(struct MMCSD *);
 /*----------------------------------------------------------------------------*/
+static void completeRequests(struct MMCSD *, enum Result);
+static void dispatchRequests(struct MMCSD *);
 static enum Result eraseSectorGroup(struct MMCSD *, uint32_t);
 static enum Result executeCommand(struct MMCSD *, uint32_t, uint32_t,
     uint32_t *, bool);
 static bool extractBit(const uint32_t *, unsigned int);
 static uint32_t extractBits(const uint32_t *, unsigned int, unsigned int);
+static enum Result flushCache(struct MMCSD *);
+static enum Result getCardStatusResult(uint32_t);
 static enum Result identifyCard(struct MMCSD *);
 static enum Result initializeCard(struct MMCSD *);
+static void insertRequest(struct MMCSD *, struct MMCSDRequest *);
 static void interruptHandler(void *);
 static enum Result isCardReady(struct MMCSD *);
+static bool isTransferCompleted(const struct MMCSD *);
+static uint32_t makeDataArgument(const struct MMCSD *, uint64_t);
+static uint32_t makeDataCommand(const struct MMCSD *, size_t, bool);
+static enum State nextTransferStep(const struct MMCSD *, enum State);
 static bool onCardSelectionFinished(struct MMCSD *);
+static void onLocalRequestFinished(void *, enum Result);
+static void onTransferFinished(struct MMCSD *);
 static bool onTransferStateSetupFinished(struct MMCSD *);
 static void parseCardSpecificData(struct MMCSD *, const uint32_t *);
+static enum Result readRegister(struct MMCSD *, uint32_t, uint32_t, void *,
+    size_t);
+static void releaseQueue(struct MMCSD *);
+static enum Result reserveQueue(struct MMCSD *);
+static void resumeQueue(struct MMCSD *);
+static void selectRequests(struct MMCSD *);
 static enum Result setTransferState(struct MMCSD *);
 static enum Result startCardSelection(struct MMCSD *);
+static enum Result startDataTransfer(struct MMCSD *);
+static void startQueue(struct MMCSD *);
+static enum Result startRequests(struct MMCSD *);
 static enum Result startTransfer(struct MMCSD *);
+static enum Result startTransferSequence(struct MMCSD *, uint32_t, uint32_t,
+    uintptr_t, size_t);
 static enum Result startTransferStateSetup(struct MMCSD *);
+static enum Result startTransferStep(struct MMCSD *, enum State);
 static enum Result terminateTransfer(struct MMCSD *);
 static enum Result transferBuffer(struct MMCSD *, uint32_t, uint32_t,
     uintptr_t, size_t);
+static size_t transferLocalRequest(struct MMCSD *, void *, size_t, bool);
+static void waitTransfer(const struct MMCSD *);
 /*----------------------------------------------------------------------------*/
 static enum Result cardInit(void *, const void *);
+static void cardDeinit(void *);
 static void cardSetCallback(void *, void (*)(void *), void *);
 static enum Result cardGetParam(void *, int, void *);
 static enum Result cardSetParam(void *, int, const void *);
@@ -72,7 +110,7 @@ static size_t cardWrite(void *, const void *, size_t);
 const struct InterfaceClass * const MMCSD = &(const struct InterfaceClass){
     .size = sizeof(struct MMCSD),
     .init = cardInit,
-    .deinit = NULL, /* Default destructor */
+    .deinit = cardDeinit,
 
     .setCallback = cardSetCallback,
     .getParam = cardGetParam,
@@ -88,6 +126,13 @@ static enum Result initStepEnableCrc(struct MMCSD *device)
       CMD59_CRC_ENABLED, NULL, true);
 }
 /*----------------------------------------------------------------------------*/
+static enum Result initStepMmcEnableCache(struct MMCSD *device)
+{
+  return executeCommand(device,
+      SDIO_COMMAND(CMD6_SWITCH, MMCSD_RESPONSE_R1B, SDIO_CHECK_CRC),
+      MMC_CACHE_CTRL_PATTERN | MMC_CACHE_CTRL_ENABLE, NULL, true);
+}
+/*----------------------------------------------------------------------------*/
 static enum Result initStepMmcReadOCR(struct MMCSD *device)
 {
   uint32_t ocr = 0;
@@ -260,39 +305,32 @@ static enum Result initStepReadExtCSD(struct MMCSD *device)
       MMCSD_RESPONSE_R1, SDIO_DATA_MODE | SDIO_CHECK_CRC);
 
   uint8_t csd[DEFAULT_BLOCK_SIZE];
-  enum Result res;
+  const enum Result res = readRegister(device, command, 0, csd, sizeof(csd));
 
-  res = ifSetParam(device->interface, IF_SDIO_COMMAND, &command);
-  if (res != E_OK)
-    return res;
-  res = ifSetParam(device->interface, IF_SDIO_ARGUMENT, &(uint32_t){0});
   if (res != E_OK)
     return res;
 
-  const size_t queued = ifRead(device->interface, csd, sizeof(csd));
-  enum Result status;
-
-  if (queued == sizeof(csd))
+  if (device->info.capacityType == CAPACITY_HC)
   {
-    do
+    /* Process SEC_COUNT parameter [215:212] */
+    uint32_t sectors;
+    memcpy(&sectors, &csd[EXT_CSD_SEC_COUNT], sizeof(sectors));
+    device->info.sectorCount = fromLittleEndian32(sectors);
+
+    /* Process HC_ERASE_GRP_SIZE parameter [224] */
+    if (csd[EXT_CSD_HC_ERASE_GRP_SIZE] != 0)
     {
-      status = ifGetParam(device->interface, IF_STATUS, NULL);
+      device->info.eraseGroupSize =
+          csd[EXT_CSD_HC_ERASE_GRP_SIZE] * ((512 * 1024) >> BLOCK_POW);
     }
-    while (status == E_BUSY);
   }
-  else
-    return E_INTERFACE;
 
-  /* Process SEC_COUNT parameter [215:212] */
-  uint32_t sectors;
-  memcpy(&sectors, &csd[212], sizeof(sectors));
-  device->info.sectorCount = fromLittleEndian32(sectors);
+  /* Process CACHE_SIZE parameter [252:249] */
+  uint32_t cache;
+  memcpy(&cache, &csd[EXT_CSD_CACHE_SIZE], sizeof(cache));
 
-  /* Process HC_ERASE_GRP_SIZE parameter [224] */
-  if (csd[224] != 0)
-  {
-    device->info.eraseGroupSize = csd[224] * ((512 * 1024) >> BLOCK_POW);
-  }
+  if (!cache)
+    device->info.cache = false;
 
   return E_OK;
 }
@@ -363,6 +401,40 @@ static enum Result initStepSdReadOCR(struct MMCSD *device)
   return res;
 }
 /*----------------------------------------------------------------------------*/
+static enum Result initStepSdReadSCR(struct MMCSD *device)
+{
+  static const uint32_t command = SDIO_COMMAND(ACMD51_SEND_SCR,
+      MMCSD_RESPONSE_R1, SDIO_DATA_MODE | SDIO_CHECK_CRC);
+
+  uint32_t scr[SCR_SIZE / sizeof(uint32_t)];
+  enum Result res;
+
+  res = executeCommand(device,
+      SDIO_COMMAND(CMD55_APP_CMD, MMCSD_RESPONSE_R1, SDIO_CHECK_CRC),
+      (device->info.cardAddress << 16), NULL, true);
+  if (res != E_OK)
+    return res;
+
+  res = ifSetParam(device->interface, IF_SDIO_BLOCK_SIZE,
+      &(uint32_t){SCR_SIZE});
+  if (res != E_OK)
+    return res;
+
+  res = readRegister(device, command, 0, scr, sizeof(scr));
+
+  /* Restore data block size */
+  ifSetParam(device->interface, IF_SDIO_BLOCK_SIZE,
+      &(uint32_t){DEFAULT_BLOCK_SIZE});
+
+  if (res == E_OK)
+  {
+    /* Register is sent in big-endian order, process CMD_SUPPORT [33:32] */
+    device->info.count = (fromBigEndian32(scr[0]) & SCR_CMD23_SUPPORT) != 0;
+  }
+
+  return res;
+}
+/*----------------------------------------------------------------------------*/
 static enum Result initStepSdSetBusWidth(struct MMCSD *device)
 {
   enum Result res;
@@ -420,36 +492,133 @@ static enum Result initStepSpiReadOCR(struct MMCSD *device)
   return res;
 }
 /*----------------------------------------------------------------------------*/
+static void completeRequests(struct MMCSD *device, enum Result res)
+{
+  PointerArray * const active = &device->queue.active;
+  const size_t count = pointerArraySize(active);
+
+  if (device->timer != NULL)
+  {
+    device->queue.time +=
+        (uint32_t)(timerGetValue(device->timer) - device->queue.timestamp);
+  }
+  device->queue.completed += (uint32_t)count;
+
+  if (device->queue.bounce && res == E_OK)
+  {
+    const uint8_t *position = device->queue.buffer;
+
+    /* Copy data of merged read requests from the merge buffer */
+    for (size_t index = 0; index < count; ++index)
+    {
+      const struct MMCSDRequest * const request = *pointerArrayAt(active,
+          index);
+
+      if (!request->write)
+        memcpy(request->buffer, position, request->length);
+      position += request->length;
+    }
+  }
+
+  for (size_t index = 0; index < count; ++index)
+  {
+    struct MMCSDRequest * const request = *pointerArrayAt(active, index);
+    request->callback(request->argument, res);
+  }
+
+  pointerArrayClear(active);
+}
+/*----------------------------------------------------------------------------*/
+static void dispatchRequests(struct MMCSD *device)
+{
+  IrqState state;
+
+  device->queue.dispatching = true;
+
+  while (1)
+  {
+    state = irqSave();
+
+    /* Exit when the transfer is in progress or there are no more requests */
+    if (!pointerArrayEmpty(&device->queue.active)
+        || pointerArrayEmpty(&device->queue.pending))
+    {
+      break;
+    }
+
+    selectRequests(device);
+    irqRestore(state);
+
+    /* Transfer may be completed before the function returns */
+    const enum Result res = startRequests(device);
+
+    if (res != E_OK)
+      completeRequests(device, res);
+  }
+
+  device->queue.dispatching = false;
+  if (pointerArrayEmpty(&device->queue.active))
+    releaseQueue(device);
+
+  irqRestore(state);
+}
+/*----------------------------------------------------------------------------*/
 static enum Result eraseSectorGroup(struct MMCSD *device, uint32_t sector)
 {
-  const uint32_t argument = device->info.capacityType == CAPACITY_SC ?
-      (sector << BLOCK_POW) : sector;
+  const bool sd = device->info.cardType <= CARD_SD_2_0;
+  /* Group size is in sectors, block-addressed cards erase at least one */
+  const uint32_t group = MAX(device->info.eraseGroupSize, 1);
+  /* SD erase commands address the first and the last block of the range */
+  uint32_t end = sd ? sector + group - 1 : sector;
+  uint32_t argument = sector;
+  /* Card status is available in native modes only, SPI reports R1 errors */
+  uint32_t status = 0;
+  uint32_t * const response = device->mode != SDIO_SPI ? &status : NULL;
   enum Result res;
 
+  if (device->info.capacityType == CAPACITY_SC)
+  {
+    argument <<= BLOCK_POW;
+    end <<= BLOCK_POW;
+  }
+
+  /* Commands can't be interleaved with queued transfers */
+  if (reserveQueue(device) != E_OK)
+    return E_BUSY;
+
   /* Lock the bus */
   ifSetParam(device->interface, IF_ACQUIRE, NULL);
 
   res = executeCommand(device,
-      SDIO_COMMAND(CMD35_ERASE_GROUP_START, MMCSD_RESPONSE_R1, SDIO_CHECK_CRC),
-      argument, NULL, true);
+      SDIO_COMMAND(sd ? CMD32_ERASE_WR_BLK_START : CMD35_ERASE_GROUP_START,
+          MMCSD_RESPONSE_R1, SDIO_CHECK_CRC),
+      argument, response, true);
+  if (res == E_OK)
+    res = getCardStatusResult(status);
   if (res != E_OK)
     goto error;
 
   res = executeCommand(device,
-      SDIO_COMMAND(CMD36_ERASE_GROUP_END, MMCSD_RESPONSE_R1, SDIO_CHECK_CRC),
-      argument, NULL, true);
+      SDIO_COMMAND(sd ? CMD33_ERASE_WR_BLK_END : CMD36_ERASE_GROUP_END,
+          MMCSD_RESPONSE_R1, SDIO_CHECK_CRC),
+      end, response, true);
+  if (res == E_OK)
+    res = getCardStatusResult(status);
   if (res != E_OK)
     goto error;
 
   res = executeCommand(device,
       SDIO_COMMAND(CMD38_ERASE, MMCSD_RESPONSE_R1B, SDIO_CHECK_CRC),
-      0, NULL, true);
+      0, response, true);
+  if (res == E_OK)
+    res = getCardStatusResult(status);
   if (res != E_OK)
     goto error;
 
 error:
   /* Release the bus */
   ifSetParam(device->interface, IF_RELEASE, NULL);
+  resumeQueue(device);
 
   return res;
 }
@@ -519,6 +688,38 @@ static uint32_t extractBits(const uint32_t *data, unsigned int start,
   return value & MASK(end - start + 1);
 }
 /*----------------------------------------------------------------------------*/
+static enum Result flushCache(struct MMCSD *device)
+{
+  enum Result res;
+
+  /* Commands can't be interleaved with queued transfers */
+  if (reserveQueue(device) != E_OK)
+    return E_BUSY;
+
+  /* Lock the bus */
+  ifSetParam(device->interface, IF_ACQUIRE, NULL);
+
+  res = executeCommand(device,
+      SDIO_COMMAND(CMD6_SWITCH, MMCSD_RESPONSE_R1B, SDIO_CHECK_CRC),
+      MMC_FLUSH_CACHE_PATTERN | MMC_FLUSH_CACHE_FLUSH, NULL, true);
+
+  /* Release the bus */
+  ifSetParam(device->interface, IF_RELEASE, NULL);
+  resumeQueue(device);
+
+  return res;
+}
+/*----------------------------------------------------------------------------*/
+static enum Result getCardStatusResult(uint32_t status)
+{
+  if (status & CARD_STATUS_ADDRESS_MASK)
+    return E_ADDRESS;
+  else if (status & CARD_STATUS_ERROR_MASK)
+    return E_ERROR;
+  else
+    return E_OK;
+}
+/*----------------------------------------------------------------------------*/
 static enum Result identifyCard(struct MMCSD *device)
 {
   enum Result res;
@@ -597,16 +798,36 @@ static enum Result identifyCard(struct MMCSD *device)
     {
       if ((res = initStepSdSetBusWidth(device)) != E_OK)
         return res;
+
+      /* Check support of the CMD23 command */
+      if (device->predefined)
+      {
+        if ((res = initStepSdReadSCR(device)) != E_OK)
+          return res;
+      }
     }
   }
 
   /* Read Extended CSD register of the MMC */
-  if (device->info.cardType == CARD_MMC_4_0
-      && device->info.capacityType == CAPACITY_HC)
+  if (device->info.cardType == CARD_MMC_4_0)
   {
-    if ((res = initStepReadExtCSD(device)) != E_OK)
-      return res;
+    if (device->mode != SDIO_SPI)
+      device->info.count = device->predefined;
+
+    if (device->info.capacityType == CAPACITY_HC || device->info.cache)
+    {
+      if ((res = initStepReadExtCSD(device)) != E_OK)
+        return res;
+    }
+
+    if (device->info.cache)
+    {
+      if ((res = initStepMmcEnableCache(device)) != E_OK)
+        return res;
+    }
   }
+  else
+    device->info.cache = false;
 
   return E_OK;
 }
@@ -659,6 +880,28 @@ error:
   return res;
 }
 /*----------------------------------------------------------------------------*/
+static void insertRequest(struct MMCSD *device, struct MMCSDRequest *request)
+{
+  PointerArray * const pending = &device->queue.pending;
+  size_t index = pointerArraySize(pending);
+
+  pointerArrayPushBack(pending, request);
+
+  /* Requests with equal positions are served in order of arrival */
+  while (index > 0)
+  {
+    void * const previous = *pointerArrayAt(pending, index - 1);
+
+    if (((const struct MMCSDRequest *)previous)->position <= request->position)
+      break;
+
+    *pointerArrayAt(pending, index) = previous;
+    --index;
+  }
+
+  *pointerArrayAt(pending, index) = request;
+}
+/*----------------------------------------------------------------------------*/
 static void interruptHandler(void *object)
 {
   struct MMCSD * const device = object;
@@ -682,6 +925,21 @@ static void interruptHandler(void *object)
       }
       break;
 
+    case STATE_APP_COMMAND:
+    case STATE_PRE_ERASE:
+    case STATE_BLOCK_COUNT:
+    {
+      const enum State next = nextTransferStep(device, device->transfer.state);
+
+      if (ifGetParam(device->interface, IF_STATUS, NULL) != E_OK
+          || startTransferStep(device, next) != E_OK)
+      {
+        event = true;
+        device->transfer.state = STATE_ERROR;
+      }
+      break;
+    }
+
     case STATE_TRANSFER:
     {
       enum Result res = ifGetParam(device->interface, IF_STATUS, NULL);
@@ -738,14 +996,7 @@ static void interruptHandler(void *object)
   }
 
   if (event)
-  {
-    /* Release the bus */
-    ifSetCallback(device->interface, NULL, NULL);
-    ifSetParam(device->interface, IF_RELEASE, NULL);
-
-    if (device->callback != NULL)
-      device->callback(device->callbackArgument);
-  }
+    onTransferFinished(device);
 }
 /*----------------------------------------------------------------------------*/
 static enum Result isCardReady(struct MMCSD *device)
@@ -771,10 +1022,96 @@ static enum Result isCardReady(struct MMCSD *device)
   }
 }
 /*----------------------------------------------------------------------------*/
+static bool isTransferCompleted(const struct MMCSD *device)
+{
+  if (device->queue.enabled)
+    return device->queue.status != E_BUSY;
+
+  return device->transfer.state == STATE_IDLE
+      || device->transfer.state == STATE_ERROR;
+}
+/*----------------------------------------------------------------------------*/
+static uint32_t makeDataArgument(const struct MMCSD *device, uint64_t position)
+{
+  return device->info.capacityType == CAPACITY_SC ?
+      (uint32_t)position : (uint32_t)(position >> BLOCK_POW);
+}
+/*----------------------------------------------------------------------------*/
+static uint32_t makeDataCommand(const struct MMCSD *device, size_t length,
+    bool write)
+{
+  const bool multiple = (length >> BLOCK_POW) > 1;
+  uint32_t flags = SDIO_DATA_MODE;
+  enum MMCSDCommand code;
+
+  if (device->crc)
+    flags |= SDIO_CHECK_CRC;
+
+  if (write)
+  {
+    flags |= SDIO_WRITE_MODE;
+    code = multiple ? CMD25_WRITE_MULTIPLE_BLOCK : CMD24_WRITE_BLOCK;
+  }
+  else
+    code = multiple ? CMD18_READ_MULTIPLE_BLOCK : CMD17_READ_SINGLE_BLOCK;
+
+  const enum MMCSDResponse response = device->mode == SDIO_SPI ?
+      MMCSD_RESPONSE_NONE : MMCSD_RESPONSE_R1;
+
+  return SDIO_COMMAND(code, response, flags);
+}
+/*----------------------------------------------------------------------------*/
+static enum State nextTransferStep(const struct MMCSD *device,
+    enum State state)
+{
+  switch (state)
+  {
+    case STATE_APP_COMMAND:
+      return STATE_PRE_ERASE;
+
+    case STATE_PRE_ERASE:
+      return device->transfer.count ? STATE_BLOCK_COUNT : STATE_TRANSFER;
+
+    default:
+      return STATE_TRANSFER;
+  }
+}
+/*----------------------------------------------------------------------------*/
 static bool onCardSelectionFinished(struct MMCSD *device)
 {
-  device->transfer.state = STATE_TRANSFER;
-  return startTransfer(device) == E_OK;
+  return startDataTransfer(device) == E_OK;
+}
+/*----------------------------------------------------------------------------*/
+static void onLocalRequestFinished(void *argument, enum Result res)
+{
+  struct MMCSD * const device = argument;
+
+  device->queue.status = res == E_OK ? E_OK : E_ERROR;
+
+  if (device->callback != NULL)
+    device->callback(device->callbackArgument);
+}
+/*----------------------------------------------------------------------------*/
+static void onTransferFinished(struct MMCSD *device)
+{
+  if (device->queue.enabled)
+  {
+    completeRequests(device,
+        device->transfer.state == STATE_IDLE ? E_OK : E_INTERFACE);
+
+    /* Next requests are started by the dispatch loop when it is active */
+    if (!device->queue.dispatching)
+      dispatchRequests(device);
+  }
+  else
+  {
+    /* Release the bus */
+    ifSetCallback(device->interface, NULL, NULL);
+    ifSetParam(device->interface, IF_RELEASE, NULL);
+
+    if (device->callback != NULL)
+      device->callback(device->callbackArgument);
+  }
 }
 /*----------------------------------------------------------------------------*/
 static bool onTransferStateSetupFinished(struct MMCSD *device)
@@ -784,9 +1121,7 @@ static bool onTransferStateSetupFinished(struct MMCSD *device)
   switch (isCardReady(device))
   {
     case E_OK:
-      device->transfer.state = STATE_TRANSFER;
-
-      if (startTransfer(device) != E_OK)
+      if (startDataTransfer(device) != E_OK)
         completed = false;
       break;
 
@@ -818,7 +1153,7 @@ static void parseCardSpecificData(struct MMCSD *device,
 
   /* Erase group size */
 
-  if (device->info.cardType == CARD_MMC)
+  if (device->info.cardType >= CARD_MMC)
   {
     const uint32_t eraseGroupSize = extractBits(response, 42, 46);
     const uint32_t eraseGroupMult = extractBits(response, 37, 41);
@@ -829,9 +1164,23 @@ static void parseCardSpecificData(struct MMCSD *device,
   {
     const uint32_t eraseSectorSize = extractBits(response, 39, 45);
     const bool eraseBlockEnable = extractBit(response, 46);
+    const uint32_t writeBlockLength = extractBits(response, 22, 25);
 
-    device->info.eraseGroupSize = eraseBlockEnable ? 1 : (eraseSectorSize + 1);
-    device->info.eraseGroupSize <<= 9;
+    if (eraseBlockEnable || writeBlockLength < BLOCK_POW)
+    {
+      device->info.eraseGroupSize = 1;
+    }
+    else
+    {
+      /* Erase sector size is expressed in write blocks */
+      device->info.eraseGroupSize =
+          (eraseSectorSize + 1) << (writeBlockLength - BLOCK_POW);
+    }
+  }
+  else
+  {
+    /* Block-addressed SD cards erase single sectors */
+    device->info.eraseGroupSize = 1;
   }
 
   /* Sector count */
@@ -852,6 +1201,142 @@ static void parseCardSpecificData(struct MMCSD *device,
   }
 }
 /*----------------------------------------------------------------------------*/
+static enum Result readRegister(struct MMCSD *device, uint32_t command,
+    uint32_t argument, void *buffer, size_t length)
+{
+  enum Result res;
+
+  res = ifSetParam(device->interface, IF_SDIO_COMMAND, &command);
+  if (res != E_OK)
+    return res;
+  res = ifSetParam(device->interface, IF_SDIO_ARGUMENT, &argument);
+  if (res != E_OK)
+    return res;
+
+  if (ifRead(device->interface, buffer, length) != length)
+    return E_INTERFACE;
+
+  do
+  {
+    res = ifGetParam(device->interface, IF_STATUS, NULL);
+  }
+  while (res == E_BUSY);
+
+  return res;
+}
+/*----------------------------------------------------------------------------*/
+static void releaseQueue(struct MMCSD *device)
+{
+  /* Release the bus */
+  ifSetCallback(device->interface, NULL, NULL);
+  ifSetParam(device->interface, IF_RELEASE, NULL);
+
+  device->queue.running = false;
+}
+/*----------------------------------------------------------------------------*/
+static enum Result reserveQueue(struct MMCSD *device)
+{
+  if (!device->queue.enabled)
+    return E_OK;
+
+  /* Queued requests will wait until the card command is completed */
+  const IrqState state = irqSave();
+  const bool running = device->queue.running;
+
+  device->queue.running = true;
+  irqRestore(state);
+
+  return running ? E_BUSY : E_OK;
+}
+/*----------------------------------------------------------------------------*/
+static void resumeQueue(struct MMCSD *device)
+{
+  if (!device->queue.enabled)
+    return;
+
+  const IrqState state = irqSave();
+  const bool start = !pointerArrayEmpty(&device->queue.pending);
+
+  if (!start)
+    device->queue.running = false;
+  irqRestore(state);
+
+  if (start)
+    startQueue(device);
+}
+/*----------------------------------------------------------------------------*/
+static void selectRequests(struct MMCSD *device)
+{
+  PointerArray * const pending = &device->queue.pending;
+  const size_t count = pointerArraySize(pending);
+  size_t first = 0;
+
+  /*
+   * Requests are served in order of increasing positions starting from
+   * the end of the previous transfer, the search wraps around after
+   * the last request.
+   */
+  while (first < count)
+  {
+    const struct MMCSDRequest * const request = *pointerArrayAt(pending,
+        first);
+
+    if (request->position >= device->queue.head)
+      break;
+    ++first;
+  }
+  if (first == count)
+    first = 0;
+
+  const struct MMCSDRequest *previous = *pointerArrayAt(pending, first);
+  uint64_t end = previous->position + previous->length;
+  size_t length = previous->length;
+  size_t last = first + 1;
+  bool adjacent = true;
+
+  /* Merge requests that continue the selected one into a single transfer */
+  while (last < count)
+  {
+    const struct MMCSDRequest * const next = *pointerArrayAt(pending, last);
+
+    if (next->position != end || next->write != previous->write)
+      break;
+
+    const bool contiguous = adjacent
+        && (const uint8_t *)previous->buffer + previous->length
+            == (const uint8_t *)next->buffer;
+
+    if (!contiguous && length + next->length > device->queue.capacity)
+      break;
+
+    adjacent = contiguous;
+    end += next->length;
+    length += next->length;
+    previous = next;
+    ++last;
+  }
+
+  device->queue.bounce = !adjacent;
+  device->queue.head = end;
+
+  const size_t selected = last - first;
+
+  for (size_t index = first; index < last; ++index)
+  {
+    pointerArrayPushBack(&device->queue.active,
+        *pointerArrayAt(pending, index));
+  }
+
+  /* Remove selected requests from the pending list */
+  for (size_t index = last; index < count; ++index)
+  {
+    *pointerArrayAt(pending, index - selected) =
+        *pointerArrayAt(pending, index);
+  }
+  for (size_t index = 0; index < selected; ++index)
+    pointerArrayPopBack(pending);
+}
+/*----------------------------------------------------------------------------*/
 static enum Result setTransferState(struct MMCSD *device)
 {
   /* Relative card address should be initialized */
@@ -901,6 +1386,67 @@ static enum Result startCardSelection(struct MMCSD *device)
   }
 }
 /*----------------------------------------------------------------------------*/
+static enum Result startDataTransfer(struct MMCSD *device)
+{
+  enum State step = STATE_TRANSFER;
+
+  if (device->transfer.erase)
+    step = STATE_APP_COMMAND;
+  else if (device->transfer.count)
+    step = STATE_BLOCK_COUNT;
+
+  return startTransferStep(device, step);
+}
+/*----------------------------------------------------------------------------*/
+static void startQueue(struct MMCSD *device)
+{
+  /* Request queue holds the bus until all requests are completed */
+  ifSetParam(device->interface, IF_ACQUIRE, NULL);
+  ifSetParam(device->interface, IF_ZEROCOPY, NULL);
+  ifSetCallback(device->interface, interruptHandler, device);
+
+  dispatchRequests(device);
+}
+/*----------------------------------------------------------------------------*/
+static enum Result startRequests(struct MMCSD *device)
+{
+  PointerArray * const active = &device->queue.active;
+  const size_t count = pointerArraySize(active);
+  const struct MMCSDRequest * const first = *pointerArrayAt(active, 0);
+  uint8_t *buffer = first->buffer;
+  size_t length = 0;
+
+  if (device->queue.bounce)
+  {
+    buffer = device->queue.buffer;
+
+    /* Copy data of merged write requests to the merge buffer */
+    for (size_t index = 0; index < count; ++index)
+    {
+      const struct MMCSDRequest * const request = *pointerArrayAt(active,
+          index);
+
+      if (request->write)
+        memcpy(buffer + length, request->buffer, request->length);
+      length += request->length;
+    }
+  }
+  else
+  {
+    for (size_t index = 0; index < count; ++index)
+      length += ((const struct MMCSDRequest *)*pointerArrayAt(active,
+          index))->length;
+  }
+
+  if (device->timer != NULL)
+    device->queue.timestamp = timerGetValue(device->timer);
+
+  return startTransferSequence(device,
+      makeDataCommand(device, length, first->write),
+      makeDataArgument(device, first->position),
+      (uintptr_t)buffer, length);
+}
+/*----------------------------------------------------------------------------*/
 static enum Result startTransfer(struct MMCSD *device)
 {
   enum Result res;
@@ -932,6 +1478,35 @@ static enum Result startTransfer(struct MMCSD *device)
   return queued == device->transfer.length ? E_OK : E_INTERFACE;
 }
 /*----------------------------------------------------------------------------*/
+static enum Result startTransferSequence(struct MMCSD *device,
+    uint32_t command, uint32_t argument, uintptr_t buffer, size_t length)
+{
+  device->transfer.argument = argument;
+  device->transfer.command = command;
+  device->transfer.buffer = buffer;
+  device->transfer.length = length;
+
+  const bool multiple = (length >> BLOCK_POW) > 1;
+  const bool write = (COMMAND_FLAG_VALUE(command) & SDIO_WRITE_MODE) != 0;
+
+  /* Card stops multiple block transfers when the block count is known */
+  device->transfer.count = multiple && device->info.count;
+  device->transfer.erase = multiple && write && device->predefined
+      && device->mode != SDIO_SPI && device->info.cardType <= CARD_SD_2_0;
+  device->transfer.autostop = multiple && !device->transfer.count;
+
+  if (device->mode != SDIO_SPI)
+  {
+    device->transfer.state = STATE_GET_STATUS;
+    return startTransferStateSetup(device);
+  }
+  else
+  {
+    device->transfer.state = STATE_TRANSFER;
+    return startTransfer(device);
+  }
+}
+/*----------------------------------------------------------------------------*/
 static enum Result startTransferStateSetup(struct MMCSD *device)
 {
   const uint32_t address = device->info.cardAddress << 16;
@@ -951,6 +1526,54 @@ static enum Result startTransferStateSetup(struct MMCSD *device)
   }
 }
 /*----------------------------------------------------------------------------*/
+static enum Result startTransferStep(struct MMCSD *device, enum State step)
+{
+  const uint32_t blocks = (uint32_t)(device->transfer.length >> BLOCK_POW);
+
+  /* Preparation commands are executed synchronously when possible */
+  while (step != STATE_TRANSFER)
+  {
+    uint32_t argument;
+    uint32_t command;
+
+    switch (step)
+    {
+      case STATE_APP_COMMAND:
+        argument = device->info.cardAddress << 16;
+        command = SDIO_COMMAND(CMD55_APP_CMD, MMCSD_RESPONSE_R1,
+            SDIO_CHECK_CRC);
+        break;
+
+      case STATE_PRE_ERASE:
+        argument = blocks & ACMD23_BLOCK_COUNT_MASK;
+        command = SDIO_COMMAND(ACMD23_SET_WR_BLK_ERASE_COUNT,
+            MMCSD_RESPONSE_R1, SDIO_CHECK_CRC);
+        break;
+
+      default:
+        argument = blocks;
+        command = SDIO_COMMAND(CMD23_SET_BLOCK_COUNT, MMCSD_RESPONSE_R1,
+            SDIO_CHECK_CRC);
+        break;
+    }
+
+    device->transfer.state = step;
+
+    const enum Result res = executeCommand(device, command, argument,
+        NULL, false);
+
+    if (res == E_BUSY)
+      return E_OK;
+    if (res != E_OK)
+      return res;
+
+    step = nextTransferStep(device, step);
+  }
+
+  device->transfer.state = STATE_TRANSFER;
+  return startTransfer(device);
+}
+/*----------------------------------------------------------------------------*/
 static enum Result terminateTransfer(struct MMCSD *device)
 {
   const uint32_t flags = SDIO_STOP_TRANSFER | SDIO_CHECK_CRC;
@@ -969,21 +1592,7 @@ static enum Result transferBuffer(struct MMCSD *device,
   ifSetParam(device->interface, IF_ZEROCOPY, NULL);
   ifSetCallback(device->interface, interruptHandler, device);
 
-  device->transfer.argument = argument;
-  device->transfer.command = command;
-  device->transfer.buffer = buffer;
-  device->transfer.length = length;
-
-  if (device->mode != SDIO_SPI)
-  {
-    device->transfer.state = STATE_GET_STATUS;
-    res = startTransferStateSetup(device);
-  }
-  else
-  {
-    device->transfer.state = STATE_TRANSFER;
-    res = startTransfer(device);
-  }
+  res = startTransferSequence(device, command, argument, buffer, length);
 
   if (res != E_OK)
   {
@@ -1001,12 +1610,7 @@ static enum Result transferBuffer(struct MMCSD *device,
 
   if (device->blocking)
   {
-    while (device->transfer.state != STATE_IDLE
-        && device->transfer.state != STATE_ERROR)
-    {
-      barrier();
-    }
-
+    waitTransfer(device);
     res = device->transfer.state == STATE_ERROR ? E_INTERFACE : E_OK;
   }
   else
@@ -1015,6 +1619,108 @@ static enum Result transferBuffer(struct MMCSD *device,
   return res;
 }
 /*----------------------------------------------------------------------------*/
+static size_t transferLocalRequest(struct MMCSD *device, void *buffer,
+    size_t length, bool write)
+{
+  /* Previous request should be completed */
+  if (device->queue.status == E_BUSY)
+    return 0;
+
+  device->queue.local = (struct MMCSDRequest){
+      .callback = onLocalRequestFinished,
+      .argument = device,
+      .buffer = buffer,
+      .position = device->transfer.position,
+      .length = length,
+      .write = write
+  };
+  device->queue.status = E_BUSY;
+
+  if (mmcsdEnqueue(device, &device->queue.local) != E_OK)
+  {
+    device->queue.status = E_ERROR;
+    return 0;
+  }
+
+  if (device->blocking)
+  {
+    waitTransfer(device);
+    return device->queue.status == E_OK ? length : 0;
+  }
+  else
+    return length;
+}
+/*----------------------------------------------------------------------------*/
+static void waitTransfer(const struct MMCSD *device)
+{
+  while (!isTransferCompleted(device))
+  {
+#ifdef CONFIG_GENERIC_MMCSD_PM
+    /*
+     * Disable interrupts to avoid entering sleep mode when the transfer
+     * is completed between the status check and the sleep instruction.
+     */
+    const IrqState state = irqSave();
+
+    if (!isTransferCompleted(device))
+      pmChangeState(PM_SLEEP);
+    irqRestore(state);
+#endif
+
+    barrier();
+  }
+}
+/*----------------------------------------------------------------------------*/
+enum Result mmcsdEnqueue(void *object, struct MMCSDRequest *request)
+{
+  assert(request != NULL);
+  assert(request->callback != NULL);
+
+  struct MMCSD * const device = object;
+
+  if (!device->queue.enabled)
+    return E_INVALID;
+
+  /* Check address alignment and request length */
+  if (((request->position | request->length) & MASK(BLOCK_POW))
+      || !request->length)
+  {
+    return E_VALUE;
+  }
+
+  /* Check address range */
+  const uint64_t sectors = request->length >> BLOCK_POW;
+  const uint64_t position = request->position >> BLOCK_POW;
+
+  if (position >= device->info.sectorCount
+      || sectors > device->info.sectorCount - position)
+  {
+    return E_VALUE;
+  }
+
+  const IrqState state = irqSave();
+  const size_t queued = pointerArraySize(&device->queue.pending)
+      + pointerArraySize(&device->queue.active);
+
+  if (queued == pointerArrayCapacity(&device->queue.pending))
+  {
+    irqRestore(state);
+    return E_FULL;
+  }
+
+  insertRequest(device, request);
+
+  const bool start = !device->queue.running;
+
+  device->queue.running = true;
+  irqRestore(state);
+
+  if (start)
+    startQueue(device);
+
+  return E_OK;
+}
+/*----------------------------------------------------------------------------*/
 static enum Result cardInit(void *object, const void *configBase)
 {
   const struct MMCSDConfig * const config = configBase;
@@ -1024,6 +1730,7 @@ static enum Result cardInit(void *object, const void *configBase)
   device->callbackArgument = NULL;
 
   device->interface = config->interface;
+  device->timer = config->timer;
   device->transfer.position = 0;
 
   device->info.sectorCount = 0;
@@ -1031,8 +1738,11 @@ static enum Result cardInit(void *object, const void *configBase)
   device->info.eraseGroupSize = 0;
   device->info.capacityType = CAPACITY_SC;
   device->info.cardType = CARD_SD;
+  device->info.count = false;
+  device->info.cache = config->cache;
   device->blocking = true;
   device->crc = config->crc;
+  device->predefined = config->predefined;
 
   device->transfer.buffer = 0;
   device->transfer.length = 0;
@@ -1041,8 +1751,68 @@ static enum Result cardInit(void *object, const void *configBase)
   device->transfer.command = 0;
   device->transfer.state = STATE_IDLE;
   device->transfer.autostop = false;
+  device->transfer.count = false;
+  device->transfer.erase = false;
+
+  device->queue.buffer = NULL;
+  device->queue.capacity = 0;
+  device->queue.head = 0;
+  device->queue.time = 0;
+  device->queue.completed = 0;
+  device->queue.timestamp = 0;
+  device->queue.status = E_OK;
+  device->queue.bounce = false;
+  device->queue.dispatching = false;
+  device->queue.enabled = config->requests > 0;
+  device->queue.running = false;
+
+  if (device->queue.enabled)
+  {
+    if (!pointerArrayInit(&device->queue.pending, config->requests))
+      return E_MEMORY;
+
+    if (!pointerArrayInit(&device->queue.active, config->requests))
+    {
+      pointerArrayDeinit(&device->queue.pending);
+      return E_MEMORY;
+    }
+
+    if (config->merge)
+    {
+      device->queue.buffer = malloc(config->merge);
+
+      if (device->queue.buffer == NULL)
+      {
+        cardDeinit(device);
+        return E_MEMORY;
+      }
+
+      device->queue.capacity = config->merge;
+    }
+  }
 
-  return initializeCard(device);
+  const enum Result res = initializeCard(device);
+
+  if (res != E_OK)
+    cardDeinit(device);
+
+  return res;
+}
+/*----------------------------------------------------------------------------*/
+static void cardDeinit(void *object)
+{
+  struct MMCSD * const device = object;
+
+  /* Write back the contents of the volatile cache */
+  if (device->info.cache)
+    flushCache(device);
+
+  if (device->queue.enabled)
+  {
+    free(device->queue.buffer);
+    pointerArrayDeinit(&device->queue.active);
+    pointerArrayDeinit(&device->queue.pending);
+  }
 }
 /*----------------------------------------------------------------------------*/
 static void cardSetCallback(void *object, void (*callback)(void *),
@@ -1064,6 +1834,42 @@ static enum Result cardGetParam(void *object, int parameter, void *data)
       *(uint32_t *)data = (uint32_t)device->info.eraseGroupSize << BLOCK_POW;
       return E_OK;
 
+    case IF_MMCSD_QUEUE_DEPTH:
+    {
+      if (!device->queue.enabled)
+        return E_INVALID;
+
+      const IrqState state = irqSave();
+
+      *(uint32_t *)data = (uint32_t)(pointerArraySize(&device->queue.pending)
+          + pointerArraySize(&device->queue.active));
+
+      irqRestore(state);
+      return E_OK;
+    }
+
+    case IF_MMCSD_SERVICE_TIME:
+    {
+      if (!device->queue.enabled || device->timer == NULL)
+        return E_INVALID;
+
+      const IrqState state = irqSave();
+      const uint64_t time = device->queue.time;
+      const uint32_t completed = device->queue.completed;
+      irqRestore(state);
+
+      uint64_t average = 0;
+
+      if (completed)
+      {
+        const uint32_t frequency = timerGetFrequency(device->timer);
+        average = (time / completed) * 1000000 / frequency;
+      }
+
+      *(uint32_t *)data = (uint32_t)MIN(average, UINT32_MAX);
+      return E_OK;
+    }
+
     default:
       break;
   }
@@ -1098,6 +1904,9 @@ static enum Result cardGetParam(void *object, int parameter, void *data)
 
     case IF_STATUS:
     {
+      if (device->queue.enabled)
+        return (enum Result)device->queue.status;
+
       switch ((enum State)device->transfer.state)
       {
         case STATE_IDLE:
@@ -1152,6 +1961,9 @@ static enum Result cardSetParam(void *object, int parameter, const void *data)
       return eraseSectorGroup(device, (uint32_t)(position >> BLOCK_POW));
     }
 
+    case IF_MMCSD_FLUSH:
+      return device->info.cache ? flushCache(device) : E_OK;
+
     default:
       break;
   }
@@ -1207,25 +2019,17 @@ static size_t cardRead(void *object, void *buffer, size_t length)
 {
   assert((length & MASK(BLOCK_POW)) == 0);
 
-  const uint32_t blocks = length >> BLOCK_POW;
   struct MMCSD * const device = object;
 
-  if (!blocks)
+  if (!length)
     return 0;
 
-  uint32_t flags = SDIO_DATA_MODE;
-
-  if (device->crc)
-    flags |= SDIO_CHECK_CRC;
-  device->transfer.autostop = blocks > 1;
+  if (device->queue.enabled)
+    return transferLocalRequest(device, buffer, length, false);
 
-  const enum MMCSDCommand code = blocks == 1 ?
-      CMD17_READ_SINGLE_BLOCK : CMD18_READ_MULTIPLE_BLOCK;
-  const enum MMCSDResponse response = device->mode == SDIO_SPI ?
-      MMCSD_RESPONSE_NONE : MMCSD_RESPONSE_R1;
-  const uint32_t argument = device->info.capacityType == CAPACITY_SC ?
-      device->transfer.position : (device->transfer.position >> BLOCK_POW);
-  const uint32_t command = SDIO_COMMAND(code, response, flags);
+  const uint32_t argument = makeDataArgument(device,
+      device->transfer.position);
+  const uint32_t command = makeDataCommand(device, length, false);
 
   const enum Result res = transferBuffer(device, command, argument,
       (uintptr_t)buffer, length);
@@ -1237,26 +2041,19 @@ static size_t cardWrite(void *object, const void *buffer, size_t length)
 {
   assert((length & MASK(BLOCK_POW)) == 0);
 
-  const uint32_t blocks = length >> BLOCK_POW;
   struct MMCSD * const device = object;
 
-  if (!blocks)
+  if (!length)
     return 0;
 
-  uint32_t flags = SDIO_DATA_MODE | SDIO_WRITE_MODE;
-
-  if (device->crc)
-    flags |= SDIO_CHECK_CRC;
-  device->transfer.autostop = blocks > 1;
+  /* Buffer is not modified during write requests */
+  if (device->queue.enabled)
+    return transferLocalRequest(device, (void *)buffer, length, true);
 
   /* TODO Protect position reading */
-  const enum MMCSDCommand code = blocks == 1 ?
-      CMD24_WRITE_BLOCK : CMD25_WRITE_MULTIPLE_BLOCK;
-  const enum MMCSDResponse response = device->mode == SDIO_SPI ?
-      MMCSD_RESPONSE_NONE : MMCSD_RESPONSE_R1;
-  const uint32_t argument = device->info.capacityType == CAPACITY_SC ?
-      device->transfer.position : (device->transfer.position >> BLOCK_POW);
-  const uint32_t command = SDIO_COMMAND(code, response, flags);
+  const uint32_t argument = makeDataArgument(device,
+      device->transfer.position);
+  const uint32_t command = makeDataCommand(device, length, true);
 
   const enum Result res = transferBuffer(device, command, argument,
       (uintptr_t)buffer, length);
@@ -0,0 +1,1112 @@
+/*
+ * nor_flash.c
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the MIT License
+ */
+
+#include <halm/generic/flash.h>
+#include <halm/generic/nor_flash.h>
+#include <halm/generic/nor_flash_defs.h>
+#include <xcore/asm.h>
+#include <xcore/memory.h>
+#include <assert.h>
+#include <string.h>
+/*----------------------------------------------------------------------------*/
+#define DEFAULT_PAGE_SIZE   256
+#define FAST_READ_WAIT      8
+#define MAX_CAPACITY_3B     (1UL << 24)
+#define MIN_BFPT_DWORDS     9
+#define READ_CHUNK_SIZE     4096
+
+struct ReadModeEntry
+{
+  /* Feature bit in the first DWORD of the table */
+  uint32_t feature;
+  /* DWORD with timing parameters, zero for fixed timings */
+  uint8_t dword;
+  /* Offset of timing parameters in the DWORD */
+  uint8_t offset;
+  /* Operation code, zero when code is read from the table */
+  uint8_t code;
+  /* Number of lines used in the address phase */
+  uint8_t address;
+  /* Number of lines used in the data phase */
+  uint8_t data;
+  /* Read mode */
+  enum NorFlashReadMode mode;
+};
+/*----------------------------------------------------------------------------*/
+static enum Result changeClocking(struct NorFlash *, bool);
+static enum Result completeErase(struct NorFlash *);
+static enum Result enableQuadMode(struct NorFlash *, uint8_t);
+static enum Result enterIndirectMode(struct NorFlash *);
+static enum Result enterMappedMode(struct NorFlash *);
+static enum Result eraseUnit(struct NorFlash *, uint8_t, uint32_t);
+static enum Result execute(struct NorFlash *, const struct SpimCommand *,
+    size_t);
+static enum Result executeSimple(struct NorFlash *, uint8_t);
+static enum Result getEraseStatus(struct NorFlash *);
+static bool makeReadCommand(struct SpimCommand *, uint8_t, uint8_t, uint8_t,
+    uint8_t, uint8_t, uint8_t);
+static void onSpimEvent(void *);
+static enum Result parseGeometry(struct NorFlash *, const uint32_t *, size_t);
+static enum Result programPage(struct NorFlash *, uint32_t, const void *,
+    size_t);
+static enum Result readSfdp(struct NorFlash *, uint32_t *, size_t *);
+static enum Result readSfdpData(struct NorFlash *, uint32_t, void *, size_t);
+static enum Result readStatus(struct NorFlash *, uint8_t, uint8_t *);
+static enum Result selectReadMode(struct NorFlash *, const uint32_t *,
+    size_t, bool);
+static enum Result writeStatus(struct NorFlash *, uint8_t, const uint8_t *,
+    size_t);
+/*----------------------------------------------------------------------------*/
+static enum Result norInit(void *, const void *);
+static void norDeinit(void *);
+static void norSetCallback(void *, void (*)(void *), void *);
+static enum Result norGetParam(void *, int, void *);
+static enum Result norSetParam(void *, int, const void *);
+static size_t norRead(void *, void *, size_t);
+static size_t norWrite(void *, const void *, size_t);
+/*----------------------------------------------------------------------------*/
+const struct InterfaceClass * const NorFlash =
+    &(const struct InterfaceClass){
+    .size = sizeof(struct NorFlash),
+    .init = norInit,
+    .deinit = norDeinit,
+
+    .setCallback = norSetCallback,
+    .getParam = norGetParam,
+    .setParam = norSetParam,
+    .read = norRead,
+    .write = norWrite
+};
+/*----------------------------------------------------------------------------*/
+/* Read modes ordered by throughput, fastest modes first */
+static const struct ReadModeEntry readModes[] = {
+    {
+        BFPT_FAST_READ_144 | BFPT_DTR, 3, BFPT_READ_144_OFFSET,
+        CMD_FAST_READ_QUAD_IO_DTR, 4, 4, NOR_FLASH_READ_1_4_4_DTR
+    }, {
+        BFPT_FAST_READ_144, 3, BFPT_READ_144_OFFSET,
+        0, 4, 4, NOR_FLASH_READ_1_4_4
+    }, {
+        BFPT_FAST_READ_114, 3, BFPT_READ_114_OFFSET,
+        0, 1, 4, NOR_FLASH_READ_1_1_4
+    }, {
+        BFPT_FAST_READ_122 | BFPT_DTR, 4, BFPT_READ_122_OFFSET,
+        CMD_FAST_READ_DUAL_IO_DTR, 2, 2, NOR_FLASH_READ_1_2_2_DTR
+    }, {
+        BFPT_FAST_READ_122, 4, BFPT_READ_122_OFFSET,
+        0, 2, 2, NOR_FLASH_READ_1_2_2
+    }, {
+        BFPT_FAST_READ_112, 4, BFPT_READ_112_OFFSET,
+        0, 1, 2, NOR_FLASH_READ_1_1_2
+    }, {
+        BFPT_DTR, 0, 0,
+        CMD_FAST_READ_DTR, 1, 1, NOR_FLASH_READ_1_1_1_DTR
+    }, {
+        0, 0, 0,
+        CMD_FAST_READ, 1, 1, NOR_FLASH_READ_1_1_1_FAST
+    }
+};
+/*----------------------------------------------------------------------------*/
+static inline bool isDtrMode(enum NorFlashReadMode mode)
+{
+  return mode == NOR_FLASH_READ_1_1_1_DTR || mode == NOR_FLASH_READ_1_2_2_DTR
+      || mode == NOR_FLASH_READ_1_4_4_DTR;
+}
+/*----------------------------------------------------------------------------*/
+static enum Result changeClocking(struct NorFlash *interface, bool read)
+{
+  if (!isDtrMode(interface->mode))
+    return E_OK;
+
+  return ifSetParam(interface->spim, read ? IF_SPIM_DDR : IF_SPIM_SDR, NULL);
+}
+/*----------------------------------------------------------------------------*/
+static enum Result completeErase(struct NorFlash *interface)
+{
+  static const struct SpimCommand poll = {
+      .flags = SPIM_OPCODE | SPIM_POLL,
+      .code = CMD_READ_STATUS
+  };
+  enum Result res;
+
+  if (!interface->erasing)
+    return E_OK;
+
+  if ((res = enterIndirectMode(interface)) != E_OK)
+    return res;
+
+  if (interface->suspended)
+  {
+    if ((res = executeSimple(interface, interface->resumeCode)) != E_OK)
+      return res;
+    interface->suspended = false;
+  }
+
+  if ((res = execute(interface, &poll, 1)) != E_OK)
+    return res;
+
+  interface->erasing = false;
+  return E_OK;
+}
+/*----------------------------------------------------------------------------*/
+static enum Result enableQuadMode(struct NorFlash *interface, uint8_t qer)
+{
+  uint8_t status[2];
+  uint8_t bit;
+  uint8_t code;
+  enum Result res;
+
+  switch (qer)
+  {
+    case BFPT_QER_NONE:
+      return E_OK;
+
+    case BFPT_QER_SR1_BIT6:
+      if ((res = readStatus(interface, CMD_READ_STATUS, &status[0])) != E_OK)
+        return res;
+      if (status[0] & SR1_QE)
+        return E_OK;
+
+      status[0] |= SR1_QE;
+      res = writeStatus(interface, CMD_WRITE_STATUS, status, 1);
+      code = CMD_READ_STATUS;
+      bit = SR1_QE;
+      break;
+
+    case BFPT_QER_SR2_BIT7:
+      if ((res = readStatus(interface, CMD_READ_STATUS_2_ALT, &status[0]))
+          != E_OK)
+      {
+        return res;
+      }
+      if (status[0] & SR2_QE_ALT)
+        return E_OK;
+
+      status[0] |= SR2_QE_ALT;
+      res = writeStatus(interface, CMD_WRITE_STATUS_2_ALT, status, 1);
+      code = CMD_READ_STATUS_2_ALT;
+      bit = SR2_QE_ALT;
+      break;
+
+    case BFPT_QER_SR2_BIT1_NO_READ:
+      /* Status register 2 can not be read, verification is skipped */
+      if ((res = readStatus(interface, CMD_READ_STATUS, &status[0])) != E_OK)
+        return res;
+
+      status[1] = SR2_QE;
+      return writeStatus(interface, CMD_WRITE_STATUS, status, 2);
+
+    case BFPT_QER_SR2_BIT1_KEEP:
+    case BFPT_QER_SR2_BIT1:
+      if ((res = readStatus(interface, CMD_READ_STATUS, &status[0])) != E_OK)
+        return res;
+      if ((res = readStatus(interface, CMD_READ_STATUS_2, &status[1]))
+          != E_OK)
+      {
+        return res;
+      }
+      if (status[1] & SR2_QE)
+        return E_OK;
+
+      status[1] |= SR2_QE;
+      res = writeStatus(interface, CMD_WRITE_STATUS, status, 2);
+      code = CMD_READ_STATUS_2;
+      bit = SR2_QE;
+      break;
+
+    case BFPT_QER_SR2_BIT1_DIRECT:
+      if ((res = readStatus(interface, CMD_READ_STATUS_2, &status[0]))
+          != E_OK)
+      {
+        return res;
+      }
+      if (status[0] & SR2_QE)
+        return E_OK;
+
+      status[0] |= SR2_QE;
+      res = writeStatus(interface, CMD_WRITE_STATUS_2, status, 1);
+      code = CMD_READ_STATUS_2;
+      bit = SR2_QE;
+      break;
+
+    default:
+      return E_DEVICE;
+  }
+
+  if (res != E_OK)
+    return res;
+
+  /* Verify that the Quad Enable bit was set */
+  if ((res = readStatus(interface, code, &status[0])) != E_OK)
+    return res;
+
+  return (status[0] & bit) ? E_OK : E_DEVICE;
+}
+/*----------------------------------------------------------------------------*/
+static enum Result enterIndirectMode(struct NorFlash *interface)
+{
+  enum Result res;
+
+  if (interface->mapped)
+  {
+    if ((res = ifSetParam(interface->spim, IF_SPIM_INDIRECT, NULL)) != E_OK)
+      return res;
+    interface->mapped = false;
+  }
+
+  return changeClocking(interface, false);
+}
+/*----------------------------------------------------------------------------*/
+static enum Result enterMappedMode(struct NorFlash *interface)
+{
+  enum Result res;
+
+  if (interface->mapped)
+    return E_OK;
+
+  if ((res = changeClocking(interface, true)) != E_OK)
+    return res;
+  if ((res = ifSetParam(interface->spim, IF_SPIM_LOAD, &interface->read))
+      != E_OK)
+  {
+    return res;
+  }
+  if ((res = ifSetParam(interface->spim, IF_SPIM_MEMORY_MAPPED, NULL))
+      != E_OK)
+  {
+    return res;
+  }
+
+  interface->mapped = true;
+  return E_OK;
+}
+/*----------------------------------------------------------------------------*/
+static enum Result eraseUnit(struct NorFlash *interface, uint8_t code,
+    uint32_t address)
+{
+  const struct SpimCommand commands[] = {
+      {
+          .flags = SPIM_OPCODE,
+          .code = CMD_WRITE_ENABLE
+      }, {
+          .address = address,
+          .flags = SPIM_OPCODE,
+          .code = code,
+          .width = interface->width
+      }, {
+          .flags = SPIM_OPCODE | SPIM_POLL,
+          .code = CMD_READ_STATUS
+      }
+  };
+  enum Result res;
+
+  if ((res = completeErase(interface)) != E_OK)
+    return res;
+  if ((res = enterIndirectMode(interface)) != E_OK)
+    return res;
+
+  if (interface->blocking)
+    return execute(interface, commands, ARRAY_SIZE(commands));
+
+  /* Completion is checked later by reading the status register */
+  if ((res = execute(interface, commands, ARRAY_SIZE(commands) - 1)) == E_OK)
+    interface->erasing = true;
+
+  return res;
+}
+/*----------------------------------------------------------------------------*/
+static enum Result execute(struct NorFlash *interface,
+    const struct SpimCommand *commands, size_t count)
+{
+  const struct SpimSequence sequence = {commands, count};
+  return ifSetParam(interface->spim, IF_SPIM_SEQUENCE, &sequence);
+}
+/*----------------------------------------------------------------------------*/
+static enum Result executeSimple(struct NorFlash *interface, uint8_t code)
+{
+  const struct SpimCommand command = {
+      .flags = SPIM_OPCODE,
+      .code = code
+  };
+
+  return execute(interface, &command, 1);
+}
+/*----------------------------------------------------------------------------*/
+static enum Result getEraseStatus(struct NorFlash *interface)
+{
+  uint8_t status;
+  enum Result res;
+
+  if (!interface->erasing)
+    return E_OK;
+  if (interface->suspended)
+    return E_BUSY;
+
+  if ((res = enterIndirectMode(interface)) != E_OK)
+    return res;
+  if ((res = readStatus(interface, CMD_READ_STATUS, &status)) != E_OK)
+    return res;
+
+  if (status & SR1_WIP)
+    return E_BUSY;
+
+  interface->erasing = false;
+  return E_OK;
+}
+/*----------------------------------------------------------------------------*/
+static bool makeReadCommand(struct SpimCommand *command, uint8_t code,
+    uint8_t width, uint8_t address, uint8_t data, uint8_t mode, uint8_t wait)
+{
+  uint16_t flags = SPIM_OPCODE;
+  uint8_t post = 0;
+
+  if (address > 1)
+    flags |= SPIM_ADDRESS_PARALLEL | SPIM_POST_PARALLEL | SPIM_DELAY_PARALLEL;
+  if (data > 1)
+    flags |= SPIM_DATA_PARALLEL;
+
+  if (mode)
+  {
+    if (mode * address == 8)
+    {
+      /* Mode bits disable continuous read mode of the memory */
+      flags |= SPIM_POST;
+      post = 0xFF;
+    }
+    else
+    {
+      /* Mode clocks are sent as dummy clocks */
+      wait += mode;
+    }
+  }
+
+  /* Dummy clocks are sent on the lines of the address phase */
+  if ((wait * address) % 8)
+    return false;
+
+  *command = (struct SpimCommand){
+      .flags = flags,
+      .code = code,
+      .width = width,
+      .post = post,
+      .delay = (uint8_t)(wait * address / 8)
+  };
+  return true;
+}
+/*----------------------------------------------------------------------------*/
+static void onSpimEvent(void *argument)
+{
+  struct NorFlash * const interface = argument;
+  interface->busy = false;
+}
+/*----------------------------------------------------------------------------*/
+static enum Result parseGeometry(struct NorFlash *interface,
+    const uint32_t *bfpt, size_t count)
+{
+  uint32_t density = bfpt[1];
+
+  /* Memory density in bits */
+  if (density & BFPT_DENSITY_EXPONENT)
+  {
+    density &= BFPT_DENSITY_MASK;
+
+    /* Memories larger than 4 GiB are not supported */
+    if (density > 35)
+      return E_DEVICE;
+    density = 1UL << (density - 3);
+  }
+  else
+    density = (density + 1) >> 3;
+
+  interface->capacity = density;
+  interface->width = 3;
+
+  /* Enable 4-byte addressing when the memory is larger than 16 MiB */
+  if (interface->capacity > MAX_CAPACITY_3B)
+  {
+    const uint32_t mode = BFPT_ADDRESS_VALUE(bfpt[0]);
+
+    if (mode == BFPT_ADDRESS_3B_4B)
+    {
+      /* Enter command B7h is assumed when the table is too short */
+      if (count < 16 || (bfpt[15] & BFPT_ENTER_4B_B7))
+      {
+        const enum Result res = executeSimple(interface,
+            CMD_ENTER_4B_ADDRESS);
+
+        if (res != E_OK)
+          return res;
+
+        interface->width = 4;
+      }
+    }
+    else if (mode == BFPT_ADDRESS_4B)
+    {
+      interface->width = 4;
+    }
+
+    if (interface->width == 3)
+      interface->capacity = MAX_CAPACITY_3B;
+  }
+
+  /* Select the smallest and the largest erase units */
+  uint32_t sectorSize = 0;
+  uint32_t blockSize = 0;
+
+  for (size_t index = 0; index < 4; ++index)
+  {
+    const uint32_t dword = bfpt[7 + index / 2];
+    const uint8_t offset = (index & 1) ? 16 : 0;
+    const uint32_t exponent = BFPT_ERASE_SIZE_VALUE(dword, offset);
+
+    if (!exponent || exponent > 31)
+      continue;
+
+    const uint32_t size = 1UL << exponent;
+    const uint8_t code = BFPT_ERASE_OPCODE_VALUE(dword, offset);
+
+    if (!sectorSize || size < sectorSize)
+    {
+      sectorSize = size;
+      interface->sectorErase = code;
+    }
+    if (size > blockSize)
+    {
+      blockSize = size;
+      interface->blockErase = code;
+    }
+  }
+
+  if (!sectorSize)
+  {
+    /* Fall back to the 4 KiB erase command from the first DWORD */
+    if ((bfpt[0] & BFPT_ERASE_4K_MASK) != BFPT_ERASE_4K_SUPPORTED)
+      return E_DEVICE;
+
+    sectorSize = blockSize = 4096;
+    interface->sectorErase = BFPT_ERASE_4K_OPCODE_VALUE(bfpt[0]);
+  }
+
+  interface->sectorSize = sectorSize;
+  interface->blockSize = blockSize != sectorSize ? blockSize : 0;
+
+  /* Erase suspend and resume commands */
+  if (count >= 13 && !(bfpt[11] & BFPT_SUSPEND_UNSUPPORTED))
+  {
+    interface->suspendCode = BFPT_ERASE_SUSPEND_OPCODE_VALUE(bfpt[12]);
+    interface->resumeCode = BFPT_ERASE_RESUME_OPCODE_VALUE(bfpt[12]);
+
+    if (!interface->suspendCode || !interface->resumeCode)
+      interface->suspendCode = interface->resumeCode = 0;
+  }
+
+  if (count >= 11 && BFPT_PAGE_SIZE_VALUE(bfpt[10]))
+    interface->pageSize = 1UL << BFPT_PAGE_SIZE_VALUE(bfpt[10]);
+  else
+    interface->pageSize = DEFAULT_PAGE_SIZE;
+
+  return E_OK;
+}
+/*----------------------------------------------------------------------------*/
+static enum Result programPage(struct NorFlash *interface, uint32_t address,
+    const void *buffer, size_t length)
+{
+  const struct SpimCommand commands[] = {
+      {
+          .flags = SPIM_OPCODE,
+          .code = CMD_WRITE_ENABLE
+      }, {
+          .buffer = (void *)buffer,
+          .address = address,
+          .length = (uint32_t)length,
+          .flags = SPIM_OPCODE | SPIM_WRITE,
+          .code = CMD_PAGE_PROGRAM,
+          .width = interface->width
+      }, {
+          .flags = SPIM_OPCODE | SPIM_POLL,
+          .code = CMD_READ_STATUS
+      }
+  };
+  const struct SpimSequence sequence = {commands, ARRAY_SIZE(commands)};
+  enum Result res;
+
+  /* Word-aligned pages are programmed using DMA of the memory interface */
+  if ((length & 3) || ((uintptr_t)buffer & 3))
+    return ifSetParam(interface->spim, IF_SPIM_SEQUENCE, &sequence);
+
+  interface->busy = true;
+
+  if ((res = ifSetParam(interface->spim, IF_ZEROCOPY, NULL)) != E_OK)
+  {
+    /* Zero-copy mode is unsupported, fall back to the blocking mode */
+    interface->busy = false;
+    return ifSetParam(interface->spim, IF_SPIM_SEQUENCE, &sequence);
+  }
+
+  res = ifSetParam(interface->spim, IF_SPIM_SEQUENCE, &sequence);
+
+  if (res == E_BUSY)
+  {
+    while (interface->busy)
+      barrier();
+
+    res = ifGetParam(interface->spim, IF_STATUS, NULL);
+  }
+
+  ifSetParam(interface->spim, IF_BLOCKING, NULL);
+  return res;
+}
+/*----------------------------------------------------------------------------*/
+static enum Result readSfdp(struct NorFlash *interface, uint32_t *bfpt,
+    size_t *count)
+{
+  uint8_t header[SFDP_HEADER_SIZE];
+  uint32_t signature;
+  enum Result res;
+
+  if ((res = readSfdpData(interface, 0, header, sizeof(header))) != E_OK)
+    return res;
+
+  memcpy(&signature, header, sizeof(signature));
+  if (fromLittleEndian32(signature) != SFDP_SIGNATURE)
+    return E_DEVICE;
+
+  const size_t headers = (size_t)header[SFDP_HEADER_NPH] + 1;
+
+  for (size_t index = 0; index < headers; ++index)
+  {
+    const uint32_t address = SFDP_HEADER_SIZE
+        + index * SFDP_PARAMETER_HEADER_SIZE;
+    uint8_t parameter[SFDP_PARAMETER_HEADER_SIZE];
+
+    res = readSfdpData(interface, address, parameter, sizeof(parameter));
+    if (res != E_OK)
+      return res;
+
+    const uint16_t id = parameter[SFDP_PARAMETER_ID_LSB]
+        | (uint16_t)(parameter[SFDP_PARAMETER_ID_MSB] << 8);
+
+    if (id != SFDP_BFPT_ID
+        || parameter[SFDP_PARAMETER_MAJOR] != SFDP_BFPT_MAJOR)
+    {
+      continue;
+    }
+
+    const uint32_t pointer = parameter[SFDP_PARAMETER_POINTER]
+        | ((uint32_t)parameter[SFDP_PARAMETER_POINTER + 1] << 8)
+        | ((uint32_t)parameter[SFDP_PARAMETER_POINTER + 2] << 16);
+    const size_t length = MIN(parameter[SFDP_PARAMETER_LENGTH],
+        SFDP_BFPT_MAX_DWORDS);
+
+    if (length < MIN_BFPT_DWORDS)
+      return E_DEVICE;
+
+    res = readSfdpData(interface, pointer, bfpt, length * sizeof(uint32_t));
+    if (res != E_OK)
+      return res;
+
+    for (size_t dword = 0; dword < length; ++dword)
+      bfpt[dword] = fromLittleEndian32(bfpt[dword]);
+
+    *count = length;
+    return E_OK;
+  }
+
+  return E_DEVICE;
+}
+/*----------------------------------------------------------------------------*/
+static enum Result readSfdpData(struct NorFlash *interface, uint32_t address,
+    void *buffer, size_t length)
+{
+  const struct SpimCommand command = {
+      .buffer = buffer,
+      .address = address,
+      .length = (uint32_t)length,
+      .flags = SPIM_OPCODE,
+      .code = CMD_READ_SFDP,
+      .width = SFDP_ADDRESS_LENGTH,
+      .delay = SFDP_DUMMY_BYTES
+  };
+
+  return execute(interface, &command, 1);
+}
+/*----------------------------------------------------------------------------*/
+static enum Result readStatus(struct NorFlash *interface, uint8_t code,
+    uint8_t *value)
+{
+  const struct SpimCommand command = {
+      .buffer = value,
+      .length = 1,
+      .flags = SPIM_OPCODE,
+      .code = code
+  };
+
+  return execute(interface, &command, 1);
+}
+/*----------------------------------------------------------------------------*/
+static enum Result selectReadMode(struct NorFlash *interface,
+    const uint32_t *bfpt, size_t count, bool dtr)
+{
+  const uint8_t qer = count >= 15 ? BFPT_QER_VALUE(bfpt[14]) : BFPT_QER_NONE;
+  bool quad = count >= 15;
+
+  for (size_t index = 0; index < ARRAY_SIZE(readModes); ++index)
+  {
+    const struct ReadModeEntry * const entry = &readModes[index];
+    const bool ddr = isDtrMode(entry->mode);
+    const uint8_t lanes = MAX(entry->address, entry->data);
+    uint8_t code = entry->code;
+    uint8_t mode = 0;
+    uint8_t wait = FAST_READ_WAIT;
+
+    if ((bfpt[0] & entry->feature) != entry->feature || (ddr && !dtr))
+      continue;
+
+    if (entry->dword)
+    {
+      const uint32_t value = bfpt[entry->dword - 1];
+
+      if (!code)
+        code = BFPT_READ_OPCODE_VALUE(value, entry->offset);
+      mode = BFPT_READ_MODE_VALUE(value, entry->offset);
+      wait = BFPT_READ_WAIT_VALUE(value, entry->offset);
+    }
+
+    if (!code)
+      continue;
+
+    if (lanes == 4)
+    {
+      /* Quad Enable requirements are unknown in tables shorter than 15 */
+      if (!quad)
+        continue;
+
+      if (ifSetParam(interface->spim, IF_SPIM_QUAD, NULL) != E_OK
+          || enableQuadMode(interface, qer) != E_OK)
+      {
+        quad = false;
+        continue;
+      }
+    }
+    else if (lanes == 2)
+    {
+      if (ifSetParam(interface->spim, IF_SPIM_DUAL, NULL) != E_OK)
+        continue;
+    }
+    else
+    {
+      /* Single-wire modes use the default lane setting */
+      ifSetParam(interface->spim, IF_SPIM_DUAL, NULL);
+    }
+
+    struct SpimCommand command;
+
+    if (!makeReadCommand(&command, code, interface->width, entry->address,
+        entry->data, mode, wait))
+    {
+      continue;
+    }
+
+    if (ddr && ifSetParam(interface->spim, IF_SPIM_DDR, NULL) != E_OK)
+      continue;
+
+    const enum Result res = ifGetParam(interface->spim, IF_SPIM_PREPARE,
+        &command);
+
+    if (ddr)
+      ifSetParam(interface->spim, IF_SPIM_SDR, NULL);
+
+    if (res == E_OK)
+    {
+      interface->read = command;
+      interface->mode = entry->mode;
+      return E_OK;
+    }
+  }
+
+  /* Undo the lane setting of failed parallel modes */
+  ifSetParam(interface->spim, IF_SPIM_DUAL, NULL);
+
+  /* Standard read command is supported by all memories */
+  interface->read = (struct SpimCommand){
+      .flags = SPIM_OPCODE,
+      .code = CMD_READ,
+      .width = interface->width
+  };
+  interface->mode = NOR_FLASH_READ_1_1_1;
+
+  return ifGetParam(interface->spim, IF_SPIM_PREPARE, &interface->read);
+}
+/*----------------------------------------------------------------------------*/
+static enum Result writeStatus(struct NorFlash *interface, uint8_t code,
+    const uint8_t *buffer, size_t length)
+{
+  const struct SpimCommand commands[] = {
+      {
+          .flags = SPIM_OPCODE,
+          .code = CMD_WRITE_ENABLE
+      }, {
+          .buffer = (void *)buffer,
+          .length = (uint32_t)length,
+          .flags = SPIM_OPCODE | SPIM_WRITE,
+          .code = code
+      }, {
+          .flags = SPIM_OPCODE | SPIM_POLL,
+          .code = CMD_READ_STATUS
+      }
+  };
+
+  return execute(interface, commands, ARRAY_SIZE(commands));
+}
+/*----------------------------------------------------------------------------*/
+static enum Result norInit(void *object, const void *configBase)
+{
+  const struct NorFlashConfig * const config = configBase;
+  assert(config != NULL);
+  assert(config->spim != NULL);
+
+  struct NorFlash * const interface = object;
+  uint32_t bfpt[SFDP_BFPT_MAX_DWORDS];
+  size_t count = 0;
+  enum Result res;
+
+  interface->callback = NULL;
+  interface->callbackArgument = NULL;
+  interface->spim = config->spim;
+  interface->window = 0;
+  interface->position = 0;
+  interface->blockErase = 0;
+  interface->sectorErase = 0;
+  interface->suspendCode = 0;
+  interface->resumeCode = 0;
+  interface->mode = NOR_FLASH_READ_1_1_1;
+  interface->blocking = true;
+  interface->busy = false;
+  interface->erasing = false;
+  interface->mapped = false;
+  interface->suspended = false;
+  interface->xip = false;
+
+  ifSetParam(interface->spim, IF_SPIM_INDIRECT, NULL);
+  ifSetParam(interface->spim, IF_SPIM_SDR, NULL);
+  if ((res = ifSetParam(interface->spim, IF_BLOCKING, NULL)) != E_OK)
+    return res;
+
+  /* Memory may be left in the power-down mode */
+  if ((res = executeSimple(interface, CMD_RELEASE_POWER_DOWN)) != E_OK)
+    return res;
+
+  memset(bfpt, 0, sizeof(bfpt));
+  if ((res = readSfdp(interface, bfpt, &count)) != E_OK)
+    return res;
+  if ((res = parseGeometry(interface, bfpt, count)) != E_OK)
+    return res;
+  if ((res = selectReadMode(interface, bfpt, count, config->dtr)) != E_OK)
+    return res;
+
+  if (config->xip)
+  {
+    uintptr_t window;
+
+    if (ifGetParam(interface->spim, IF_SPIM_MEMORY_MAPPED_ADDRESS, &window)
+        == E_OK)
+    {
+      interface->window = window;
+      interface->xip = true;
+    }
+  }
+
+  ifSetCallback(interface->spim, onSpimEvent, interface);
+  return E_OK;
+}
+/*----------------------------------------------------------------------------*/
+static void norDeinit(void *object)
+{
+  struct NorFlash * const interface = object;
+
+  completeErase(interface);
+  enterIndirectMode(interface);
+  ifSetCallback(interface->spim, NULL, NULL);
+}
+/*----------------------------------------------------------------------------*/
+static void norSetCallback(void *object, void (*callback)(void *),
+    void *argument)
+{
+  struct NorFlash * const interface = object;
+
+  interface->callbackArgument = argument;
+  interface->callback = callback;
+}
+/*----------------------------------------------------------------------------*/
+static enum Result norGetParam(void *object, int parameter, void *data)
+{
+  struct NorFlash * const interface = object;
+
+  switch ((enum FlashParameter)parameter)
+  {
+    case IF_FLASH_BLOCK_SIZE:
+      if (interface->blockSize)
+      {
+        *(uint32_t *)data = interface->blockSize;
+        return E_OK;
+      }
+      else
+        return E_INVALID;
+
+    case IF_FLASH_SECTOR_SIZE:
+      *(uint32_t *)data = interface->sectorSize;
+      return E_OK;
+
+    case IF_FLASH_PAGE_SIZE:
+      *(uint32_t *)data = interface->pageSize;
+      return E_OK;
+
+    default:
+      break;
+  }
+
+  switch ((enum IfParameter)parameter)
+  {
+    case IF_POSITION:
+      *(uint32_t *)data = interface->position;
+      return E_OK;
+
+    case IF_SIZE:
+      *(uint32_t *)data = interface->capacity;
+      return E_OK;
+
+    case IF_STATUS:
+      return getEraseStatus(interface);
+
+    default:
+      return E_INVALID;
+  }
+}
+/*----------------------------------------------------------------------------*/
+static enum Result norSetParam(void *object, int parameter, const void *data)
+{
+  struct NorFlash * const interface = object;
+
+  switch ((enum FlashParameter)parameter)
+  {
+    case IF_FLASH_ERASE_BLOCK:
+    {
+      const uint32_t address = *(const uint32_t *)data;
+
+      if (!interface->blockSize)
+        return E_INVALID;
+      if (address >= interface->capacity
+          || (address & (interface->blockSize - 1)))
+      {
+        return E_ADDRESS;
+      }
+
+      return eraseUnit(interface, interface->blockErase, address);
+    }
+
+    case IF_FLASH_ERASE_SECTOR:
+    {
+      const uint32_t address = *(const uint32_t *)data;
+
+      if (address >= interface->capacity
+          || (address & (interface->sectorSize - 1)))
+      {
+        return E_ADDRESS;
+      }
+
+      return eraseUnit(interface, interface->sectorErase, address);
+    }
+
+    case IF_FLASH_SUSPEND:
+    case IF_FLASH_RESUME:
+    {
+      enum Result res;
+
+      if ((res = completeErase(interface)) != E_OK)
+        return res;
+      if ((res = enterIndirectMode(interface)) != E_OK)
+        return res;
+
+      return executeSimple(interface, parameter == IF_FLASH_SUSPEND ?
+          CMD_POWER_DOWN : CMD_RELEASE_POWER_DOWN);
+    }
+
+    case IF_FLASH_ERASE_SUSPEND:
+    {
+      const struct SpimCommand commands[] = {
+          {
+              .flags = SPIM_OPCODE,
+              .code = interface->suspendCode
+          }, {
+              .flags = SPIM_OPCODE | SPIM_POLL,
+              .code = CMD_READ_STATUS
+          }
+      };
+      enum Result res;
+
+      if (!interface->suspendCode)
+        return E_INVALID;
+      if (!interface->erasing)
+        return E_IDLE;
+      if (interface->suspended)
+        return E_OK;
+
+      if ((res = enterIndirectMode(interface)) != E_OK)
+        return res;
+
+      /* Wait for the end of the suspend latency period */
+      if ((res = execute(interface, commands, ARRAY_SIZE(commands))) != E_OK)
+        return res;
+
+      interface->suspended = true;
+      return E_OK;
+    }
+
+    case IF_FLASH_ERASE_RESUME:
+    {
+      enum Result res;
+
+      if (!interface->resumeCode)
+        return E_INVALID;
+      if (!interface->suspended)
+        return E_IDLE;
+
+      if ((res = enterIndirectMode(interface)) != E_OK)
+        return res;
+      if ((res = executeSimple(interface, interface->resumeCode)) != E_OK)
+        return res;
+
+      interface->suspended = false;
+      return E_OK;
+    }
+
+    default:
+      break;
+  }
+
+  switch ((enum IfParameter)parameter)
+  {
+    case IF_POSITION:
+    {
+      const uint32_t position = *(const uint32_t *)data;
+
+      if (position < interface->capacity)
+      {
+        interface->position = position;
+        return E_OK;
+      }
+      else
+        return E_ADDRESS;
+    }
+
+    case IF_BLOCKING:
+      interface->blocking = true;
+      return E_OK;
+
+    case IF_ZEROCOPY:
+      interface->blocking = false;
+      return E_OK;
+
+    default:
+      return E_INVALID;
+  }
+}
+/*----------------------------------------------------------------------------*/
+static size_t norRead(void *object, void *buffer, size_t length)
+{
+  struct NorFlash * const interface = object;
+
+  if (length > interface->capacity - interface->position)
+    length = interface->capacity - interface->position;
+
+  /* Memory array is readable only when the erase operation is suspended */
+  if (interface->erasing && !interface->suspended)
+  {
+    if (completeErase(interface) != E_OK)
+      return 0;
+  }
+
+  if (interface->xip)
+  {
+    if (enterMappedMode(interface) != E_OK)
+      return 0;
+
+    memcpy(buffer, (const void *)(interface->window + interface->position),
+        length);
+    interface->position += (uint32_t)length;
+    return length;
+  }
+
+  if (changeClocking(interface, true) != E_OK)
+    return 0;
+
+  uint8_t *position = buffer;
+  size_t left = length;
+  uint32_t address = interface->position;
+
+  while (left)
+  {
+    const size_t chunk = MIN(left, READ_CHUNK_SIZE);
+    struct SpimCommand command = interface->read;
+
+    command.buffer = position;
+    command.address = address;
+    command.length = (uint32_t)chunk;
+
+    if (execute(interface, &command, 1) != E_OK)
+    {
+      length -= left;
+      break;
+    }
+
+    address += (uint32_t)chunk;
+    position += chunk;
+    left -= chunk;
+  }
+
+  changeClocking(interface, false);
+  interface->position += (uint32_t)length;
+  return length;
+}
+/*----------------------------------------------------------------------------*/
+static size_t norWrite(void *object, const void *buffer, size_t length)
+{
+  struct NorFlash * const interface = object;
+
+  if (length > interface->capacity - interface->position)
+    length = interface->capacity - interface->position;
+
+  if (interface->erasing && !interface->suspended)
+  {
+    if (completeErase(interface) != E_OK)
+      return 0;
+  }
+  if (enterIndirectMode(interface) != E_OK)
+    return 0;
+
+  const uint8_t *position = buffer;
+  size_t left = length;
+  uint32_t address = interface->position;
+
+  while (left)
+  {
+    const size_t offset = address & (interface->pageSize - 1);
+    const size_t chunk = MIN(left, interface->pageSize - offset);
+
+    if (programPage(interface, address, position, chunk) != E_OK)
+    {
+      length -= left;
+      break;
+    }
+
+    address += (uint32_t)chunk;
+    position += chunk;
+    left -= chunk;
+  }
+
+  interface->position += (uint32_t)length;
+  return length;
+}
@@ -21,6 +21,9 @@
 
 #define BLOCK_SIZE_DEFAULT    512
 #define BLOCK_SIZE_MAX        2048
+#define LONG_RESPONSE_SIZE    18
+
+#define BACKOFF_MAX           3
 
 #define BUSY_READ_RETRIES     1000
 #define BUSY_WRITE_RETRIES    5000
@@ -126,10 +129,13 @@ static enum State stateVerifyCrcAdvance(struct SdioSpi *);
 /*----------------------------------------------------------------------------*/
 static void autoStopTransmission(struct SdioSpi *);
 static void busInit(struct SdioSpi *);
+static void consumeRetries(struct SdioSpi *, size_t);
 static void execute(struct SdioSpi *);
+static uint8_t findToken(struct SdioSpi *);
 static void interruptHandler(void *);
 static enum Result parseDataToken(struct SdioSpi *, uint8_t, enum SDIOToken);
 static enum Result parseResponseToken(struct SdioSpi *, uint8_t);
+static const uint8_t *pollBuffer(const struct SdioSpi *);
 static enum Status resultToStatus(enum Result);
 static void sendCommand(struct SdioSpi *, uint32_t, uint32_t);
 /*----------------------------------------------------------------------------*/
@@ -286,14 +292,56 @@ static enum State stateReadShortAdvance(struct SdioSpi *interface)
 /*----------------------------------------------------------------------------*/
 static void stateRequestToken(struct SdioSpi *interface)
 {
-  --interface->retries;
-  ifRead(interface->bus, interface->command.buffer, 1);
+  uint8_t *buffer = interface->command.buffer;
+  size_t length = 1;
+
+  if (interface->scan.capacity)
+  {
+    /*
+     * Bursts are shorter than the following data to make sure that
+     * at least one byte of the data will be read from the bus.
+     */
+    switch ((enum State)interface->state)
+    {
+      case STATE_WAIT_LONG:
+        length = MIN(interface->scan.capacity, LONG_RESPONSE_SIZE);
+        break;
+
+      case STATE_WAIT_READ:
+        length = MIN(interface->scan.capacity, interface->block);
+        break;
+
+      case STATE_WRITE_BUSY:
+        length = interface->scan.capacity;
+        break;
+
+      default:
+        break;
+    }
+
+    if (length > 1)
+      buffer = interface->scan.buffer;
+  }
+
+  interface->scan.length = (uint16_t)length;
+
+  /*
+   * Retries are counted in polled bytes. Polls separated by timer delays
+   * are counted in delay periods instead, longer delays are accounted
+   * when the delay starts.
+   */
+  const bool paced = interface->timer != NULL
+      && (interface->state == STATE_WAIT_READ
+          || interface->state == STATE_WRITE_BUSY);
+
+  consumeRetries(interface, paced ? 1 : length);
+  ifRead(interface->bus, buffer, length);
 }
 /*----------------------------------------------------------------------------*/
 static enum State stateWaitLongAdvance(struct SdioSpi *interface)
 {
-  const enum Result res = parseDataToken(interface,
-      interface->command.buffer[0], TOKEN_START);
+  const enum Result res = parseDataToken(interface, findToken(interface),
+      TOKEN_START);
 
   if (res == E_OK)
   {
@@ -314,8 +362,19 @@ static enum State stateWaitLongAdvance(struct SdioSpi *interface)
 /*----------------------------------------------------------------------------*/
 static void stateReadLongEnter(struct SdioSpi *interface)
 {
+  const size_t carried = interface->scan.count;
+
+  /* Part of the response may be received while waiting for the token */
+  if (carried)
+  {
+    memcpy(interface->command.buffer,
+        interface->scan.buffer + interface->scan.offset, carried);
+    interface->scan.count = 0;
+  }
+
   /* Read 128-bit response and 16-bit checksum */
-  ifRead(interface->bus, interface->command.buffer, 18);
+  ifRead(interface->bus, interface->command.buffer + carried,
+      LONG_RESPONSE_SIZE - carried);
 }
 /*----------------------------------------------------------------------------*/
 static enum State stateReadLongAdvance(struct SdioSpi *interface)
@@ -335,11 +394,12 @@ static enum State stateReadLongAdvance(struct SdioSpi *interface)
 /*----------------------------------------------------------------------------*/
 static enum State stateWaitReadAdvance(struct SdioSpi *interface)
 {
-  const enum Result res = parseDataToken(interface,
-      interface->command.buffer[0], TOKEN_START);
+  const enum Result res = parseDataToken(interface, findToken(interface),
+      TOKEN_START);
 
   if (res == E_OK)
   {
+    interface->scan.backoff = 0;
     return STATE_READ_DATA;
   }
   else if (res == E_BUSY)
@@ -358,10 +418,18 @@ static enum State stateWaitReadAdvance(struct SdioSpi *interface)
 static void stateReadDataEnter(struct SdioSpi *interface)
 {
   const size_t offset = interface->transfer.length - interface->transfer.left;
+  uint8_t * const buffer = (uint8_t *)(interface->transfer.buffer + offset);
+  const size_t carried = interface->scan.count;
+
+  /* Beginning of the block may be received while waiting for the token */
+  if (carried)
+  {
+    memcpy(buffer, interface->scan.buffer + interface->scan.offset, carried);
+    interface->scan.count = 0;
+  }
 
   interface->transfer.left -= interface->block;
-  ifRead(interface->bus, (void *)(interface->transfer.buffer + offset),
-      interface->block);
+  ifRead(interface->bus, buffer + carried, interface->block - carried);
 }
 /*----------------------------------------------------------------------------*/
 static void stateReadCrcEnter(struct SdioSpi *interface)
@@ -415,6 +483,17 @@ static enum State stateReadCrcAdvance(struct SdioSpi *interface)
 /*----------------------------------------------------------------------------*/
 static void stateDelayEnter(struct SdioSpi *interface)
 {
+  if (interface->scan.capacity)
+  {
+    /* Delay between polls grows while the card stays busy */
+    timerSetOverflow(interface->timer,
+        interface->scan.period << interface->scan.backoff);
+    consumeRetries(interface, (1 << interface->scan.backoff) - 1);
+
+    if (interface->scan.backoff < BACKOFF_MAX)
+      ++interface->scan.backoff;
+  }
+
   timerEnable(interface->timer);
 }
 /*----------------------------------------------------------------------------*/
@@ -496,7 +575,8 @@ static enum State stateWriteDelayAdvance(struct SdioSpi *)
 /*----------------------------------------------------------------------------*/
 static enum State stateWriteBusyAdvance(struct SdioSpi *interface)
 {
-  if (interface->command.buffer[0] != 0xFF)
+  /* Card releases the data line at the end of the busy state */
+  if (pollBuffer(interface)[interface->scan.length - 1] != 0xFF)
   {
     if (!interface->retries)
     {
@@ -509,6 +589,8 @@ static enum State stateWriteBusyAdvance(struct SdioSpi *interface)
   }
   else
   {
+    interface->scan.backoff = 0;
+
     if (interface->transfer.left)
       return STATE_WRITE_TOKEN;
 
@@ -622,6 +704,15 @@ static void busInit(struct SdioSpi *interface)
   ifSetParam(interface->bus, IF_SPI_UNIDIRECTIONAL, NULL);
   ifSetParam(interface->bus, IF_ZEROCOPY, NULL);
   ifSetCallback(interface->bus, interruptHandler, interface);
+
+  /* Reset polling state */
+  interface->scan.backoff = 0;
+  interface->scan.count = 0;
+}
+/*----------------------------------------------------------------------------*/
+static void consumeRetries(struct SdioSpi *interface, size_t count)
+{
+  interface->retries -= (unsigned short)MIN(interface->retries, count);
 }
 /*----------------------------------------------------------------------------*/
 static void execute(struct SdioSpi *interface)
@@ -645,6 +736,26 @@ static void execute(struct SdioSpi *interface)
   }
 }
 /*----------------------------------------------------------------------------*/
+static uint8_t findToken(struct SdioSpi *interface)
+{
+  const uint8_t * const buffer = pollBuffer(interface);
+
+  interface->scan.count = 0;
+
+  for (size_t index = 0; index < interface->scan.length; ++index)
+  {
+    if (buffer[index] != 0xFF)
+    {
+      /* Bytes following the token belong to the data */
+      interface->scan.offset = (uint16_t)(index + 1);
+      interface->scan.count = (uint16_t)(interface->scan.length - index - 1);
+      return buffer[index];
+    }
+  }
+
+  return 0xFF;
+}
+/*----------------------------------------------------------------------------*/
 static void interruptHandler(void *object)
 {
   struct SdioSpi * const interface = object;
@@ -721,6 +832,12 @@ static enum Result parseResponseToken(struct SdioSpi *interface, uint8_t token)
   return res;
 }
 /*----------------------------------------------------------------------------*/
+static const uint8_t *pollBuffer(const struct SdioSpi *interface)
+{
+  return interface->scan.length > 1 ?
+      interface->scan.buffer : interface->command.buffer;
+}
+/*----------------------------------------------------------------------------*/
 static enum Status resultToStatus(enum Result res)
 {
   switch (res)
@@ -815,6 +932,30 @@ static enum Result sdioInit(void *object, const void *configBase)
   interface->crc.capacity = 0;
 #endif
 
+  /* Polling bursts */
+  if (config->burst > 1)
+  {
+    interface->scan.capacity = MIN(config->burst, BLOCK_SIZE_MAX);
+    interface->scan.buffer = malloc(interface->scan.capacity);
+    if (interface->scan.buffer == NULL)
+    {
+      free(interface->crc.pool);
+      return E_MEMORY;
+    }
+  }
+  else
+  {
+    interface->scan.buffer = NULL;
+    interface->scan.capacity = 0;
+  }
+
+  interface->scan.period = interface->timer != NULL ?
+      timerGetOverflow(interface->timer) : 0;
+  interface->scan.length = 1;
+  interface->scan.offset = 0;
+  interface->scan.count = 0;
+  interface->scan.backoff = 0;
+
   /* Data transfer part */
   interface->transfer.buffer = 0;
   interface->transfer.left = 0;
@@ -837,6 +978,7 @@ static void sdioDeinit(void *object)
     timerSetCallback(interface->timer, NULL, NULL);
   ifSetCallback(interface->bus, NULL, NULL);
 
+  free(interface->scan.buffer);
   free(interface->crc.pool);
 }
 /*----------------------------------------------------------------------------*/
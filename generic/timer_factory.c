@@ -16,6 +16,8 @@ struct TimerFactoryClass
 {
   struct TimerClass base;
   struct Timer *(*create)(struct TimerFactory *);
+  uint32_t (*deadline)(const struct TimerFactory *);
+  enum Result (*wakeup)(struct TimerFactory *, uint32_t);
 };
 
 struct TimerFactoryEntryConfig
@@ -57,12 +59,16 @@ static uint32_t factoryGetOverflow(const void *);
 static void factorySetOverflow(void *, uint32_t);
 static uint32_t factoryGetValue(const void *);
 static struct Timer *factoryCreate(struct TimerFactory *);
+static uint32_t factoryGetDeadline(const struct TimerFactory *);
+static enum Result factorySetWakeup(struct TimerFactory *, uint32_t);
 
 static enum Result factoryInitTickless(void *, const void *);
 static void factoryEnableTickless(void *);
 static uint32_t factoryGetOverflowTickless(const void *);
 static uint32_t factoryGetValueTickless(const void *);
 static struct Timer *factoryCreateTickless(struct TimerFactory *);
+static uint32_t factoryGetDeadlineTickless(const struct TimerFactory *);
+static enum Result factorySetWakeupTickless(struct TimerFactory *, uint32_t);
 /*----------------------------------------------------------------------------*/
 const struct TimerFactoryClass * const TimerFactoryImpl =
     &(const struct TimerFactoryClass){
@@ -83,7 +89,9 @@ const struct TimerFactoryClass * const TimerFactoryImpl =
         .setValue = NULL
     },
 
-    .create = factoryCreate
+    .create = factoryCreate,
+    .deadline = factoryGetDeadline,
+    .wakeup = factorySetWakeup
 };
 
 const struct TimerClass * const TimerFactory =
@@ -108,7 +116,9 @@ const struct TimerFactoryClass * const TicklessFactoryImpl =
         .setValue = NULL
     },
 
-    .create = factoryCreateTickless
+    .create = factoryCreateTickless,
+    .deadline = factoryGetDeadlineTickless,
+    .wakeup = factorySetWakeupTickless
 };
 
 const struct TimerClass * const TicklessFactory =
@@ -412,6 +422,21 @@ static struct Timer *factoryCreate(struct TimerFactory *factory)
   return init(TimerFactoryEntry, &(struct TimerFactoryEntryConfig){factory});
 }
 /*----------------------------------------------------------------------------*/
+static uint32_t factoryGetDeadline(const struct TimerFactory *factory)
+{
+  /* Base timer interrupt is generated on each tick regardless of timers */
+  const uint32_t overflow = timerGetOverflow(factory->timer);
+  const uint32_t value = timerGetValue(factory->timer);
+
+  return value < overflow ? overflow - value : 0;
+}
+/*----------------------------------------------------------------------------*/
+static enum Result factorySetWakeup(struct TimerFactory *, uint32_t advance)
+{
+  /* Period of the base timer is fixed, early wake-up is not supported */
+  return advance ? E_INVALID : E_OK;
+}
+/*----------------------------------------------------------------------------*/
 static enum Result factoryInitTickless(void *object, const void *configBase)
 {
   const struct TimerFactoryConfig * const config = configBase;
@@ -453,6 +478,70 @@ static struct Timer *factoryCreateTickless(struct TimerFactory *factory)
   return init(TicklessFactoryEntry, &(struct TimerFactoryEntryConfig){factory});
 }
 /*----------------------------------------------------------------------------*/
+static uint32_t factoryGetDeadlineTickless(const struct TimerFactory *factory)
+{
+  const uint32_t counter = timerGetValue(factory->timer);
+  uint32_t waketime;
+
+  if (factory->head != NULL)
+  {
+    waketime = factory->head->timestamp + 1;
+    if (waketime > factory->overflow)
+      waketime -= factory->overflow + 1;
+  }
+  else
+  {
+    /* Only the periodic refresh of the base timer is scheduled */
+    waketime = timerGetOverflow(factory->timer);
+  }
+
+  /* Periodic refresh is scheduled exactly half of the range ahead */
+  const uint32_t delta = distance(waketime, counter, factory->overflow);
+  return delta <= factory->overflow / 2 ? delta : 0;
+}
+/*----------------------------------------------------------------------------*/
+static enum Result factorySetWakeupTickless(struct TimerFactory *factory,
+    uint32_t advance)
+{
+  const uint32_t overflow = factory->overflow;
+
+  if (factory->head == NULL)
+    return E_OK;
+
+  uint32_t waketime = factory->head->timestamp + 1;
+
+  if (waketime > overflow)
+    waketime -= overflow + 1;
+
+  uint32_t target = waketime - advance;
+
+  if (advance > waketime)
+    target += overflow + 1;
+
+  /* Match value should be in the future, otherwise the interrupt is lost */
+  const uint32_t delta = distance(target, timerGetValue(factory->timer),
+      overflow);
+
+  if (delta <= 1 || delta >= overflow / 2)
+    return E_VALUE;
+
+  timerSetOverflow(factory->timer, target);
+
+  /*
+   * The counter could pass the new match value during reconfiguration,
+   * the original wake-up time is restored in this case. Early interrupt
+   * does not expire any timers, the handler reprograms the base timer
+   * to the actual wake-up time.
+   */
+  if (distance(target, timerGetValue(factory->timer), overflow) > delta)
+  {
+    timerSetOverflow(factory->timer, waketime);
+    return E_BUSY;
+  }
+
+  return E_OK;
+}
+/*----------------------------------------------------------------------------*/
 static enum Result tmrInit(void *object, const void *configBase)
 {
   const struct TimerFactoryEntryConfig * const config = configBase;
@@ -626,3 +715,14 @@ void *timerFactoryCreate(void *object)
 {
   return ((const struct TimerFactoryClass *)CLASS(object))->create(object);
 }
+/*----------------------------------------------------------------------------*/
+uint32_t timerFactoryGetDeadline(const void *object)
+{
+  return ((const struct TimerFactoryClass *)CLASS(object))->deadline(object);
+}
+/*----------------------------------------------------------------------------*/
+enum Result timerFactorySetWakeup(void *object, uint32_t advance)
+{
+  return ((const struct TimerFactoryClass *)CLASS(object))->wakeup(object,
+      advance);
+}
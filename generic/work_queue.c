@@ -10,6 +10,15 @@
 #include <xcore/asm.h>
 #include <xcore/containers/tg_array.h>
 #include <xcore/containers/tg_queue.h>
+
+#ifdef CONFIG_GENERIC_WQ_DELAYED
+#  include <halm/timer.h>
+#  include <stdlib.h>
+#endif
+
+#ifdef CONFIG_GENERIC_WQ_IDLE
+#  include <halm/generic/idle_coordinator.h>
+#endif
 /*----------------------------------------------------------------------------*/
 struct WqTaskDescriptor
 {
@@ -61,15 +70,50 @@ struct WorkQueueDefault
   WqCounter previous;
 #endif
 
+#ifdef CONFIG_GENERIC_WQ_DELAYED
+  /* Binary min-heap of delayed tasks ordered by expiration time */
+  struct WqDelayedTask **heap;
+  size_t heapCapacity;
+  size_t heapSize;
+
+  /* Timer for delayed tasks */
+  void *timer;
+  /* Current time in timer ticks */
+  volatile uint32_t ticks;
+  /* Expiration time of the first delayed task has been reached */
+  volatile bool expired;
+#endif
+
+#ifdef CONFIG_GENERIC_WQ_IDLE
+  /* Optional idle coordinator */
+  void *idle;
+#endif
+
 #ifndef CONFIG_GENERIC_WQ_NONSTOP
   bool stop;
 #endif
 };
 /*----------------------------------------------------------------------------*/
+#if defined(CONFIG_GENERIC_WQ_IDLE) && !defined(CONFIG_GENERIC_WQ_LOAD)
+static void enterIdleState(struct WorkQueueDefault *);
+#else
+#  define enterIdleState(object) pmChangeState(PM_SLEEP)
+#endif
+
 #ifdef CONFIG_GENERIC_WQ_PROFILE
 static struct WqTaskDescriptor *findTaskInfo(struct WorkQueueDefault *,
     void (*)(void *));
 #endif
+
+#ifdef CONFIG_GENERIC_WQ_DELAYED
+static inline bool isEarlier(const struct WqDelayedTask *,
+    const struct WqDelayedTask *);
+static void heapInsert(struct WorkQueueDefault *, struct WqDelayedTask *);
+static void heapRemove(struct WorkQueueDefault *, size_t);
+static void heapSwap(struct WorkQueueDefault *, size_t, size_t);
+static void onTimerOverflow(void *);
+static void runDelayedTasks(struct WorkQueueDefault *);
+#endif
 /*----------------------------------------------------------------------------*/
 static enum Result workQueueInit(void *, const void *);
 static enum Result workQueueAdd(void *, void (*)(void *), void *);
@@ -87,6 +131,15 @@ static enum Result workQueueStart(void *);
 #  define workQueueProfile NULL
 #endif
 
+#ifdef CONFIG_GENERIC_WQ_DELAYED
+  static enum Result workQueueSchedule(void *, struct WqDelayedTask *,
+      void (*)(void *), void *, uint32_t, uint32_t);
+  static void workQueueCancel(void *, struct WqDelayedTask *);
+#else
+#  define workQueueSchedule NULL
+#  define workQueueCancel NULL
+#endif
+
 #ifndef CONFIG_GENERIC_WQ_NONSTOP
   static void workQueueDeinit(void *);
   static void workQueueStop(void *);
@@ -107,9 +160,22 @@ const struct WorkQueueClass * const WorkQueue =
     .profile = workQueueProfile,
     .statistics = workQueueStatistics,
     .start = workQueueStart,
-    .stop = workQueueStop
+    .stop = workQueueStop,
+
+    .schedule = workQueueSchedule,
+    .cancel = workQueueCancel
 };
 /*----------------------------------------------------------------------------*/
+#if defined(CONFIG_GENERIC_WQ_IDLE) && !defined(CONFIG_GENERIC_WQ_LOAD)
+static void enterIdleState(struct WorkQueueDefault *wq)
+{
+  if (wq->idle != NULL)
+    idleCoordinatorEnter(wq->idle);
+  else
+    pmChangeState(PM_SLEEP);
+}
+#endif
+/*----------------------------------------------------------------------------*/
 #ifdef CONFIG_GENERIC_WQ_PROFILE
 static struct WqTaskDescriptor *findTaskInfo(struct WorkQueueDefault *wq,
     void (*task)(void *))
@@ -127,6 +193,152 @@ static struct WqTaskDescriptor *findTaskInfo(struct WorkQueueDefault *wq,
 }
 #endif
 /*----------------------------------------------------------------------------*/
+#ifdef CONFIG_GENERIC_WQ_DELAYED
+static inline bool isEarlier(const struct WqDelayedTask *a,
+    const struct WqDelayedTask *b)
+{
+  return (int32_t)(a->timestamp - b->timestamp) < 0;
+}
+#endif
+/*----------------------------------------------------------------------------*/
+#ifdef CONFIG_GENERIC_WQ_DELAYED
+static void heapInsert(struct WorkQueueDefault *wq, struct WqDelayedTask *task)
+{
+  size_t index = wq->heapSize++;
+
+  wq->heap[index] = task;
+  task->index = index;
+
+  /* Sift up */
+  while (index > 0)
+  {
+    const size_t parent = (index - 1) / 2;
+
+    if (!isEarlier(wq->heap[index], wq->heap[parent]))
+      break;
+
+    heapSwap(wq, index, parent);
+    index = parent;
+  }
+}
+#endif
+/*----------------------------------------------------------------------------*/
+#ifdef CONFIG_GENERIC_WQ_DELAYED
+static void heapRemove(struct WorkQueueDefault *wq, size_t index)
+{
+  const size_t last = --wq->heapSize;
+
+  /* Mark the task as not scheduled */
+  wq->heap[index]->index = SIZE_MAX;
+
+  if (index == last)
+    return;
+
+  wq->heap[index] = wq->heap[last];
+  wq->heap[index]->index = index;
+
+  /* Sift up when the moved task is earlier than its new parent */
+  while (index > 0)
+  {
+    const size_t parent = (index - 1) / 2;
+
+    if (!isEarlier(wq->heap[index], wq->heap[parent]))
+      break;
+
+    heapSwap(wq, index, parent);
+    index = parent;
+  }
+
+  /* Sift down otherwise */
+  while (true)
+  {
+    const size_t left = index * 2 + 1;
+    const size_t right = left + 1;
+    size_t earliest = index;
+
+    if (left < last && isEarlier(wq->heap[left], wq->heap[earliest]))
+      earliest = left;
+    if (right < last && isEarlier(wq->heap[right], wq->heap[earliest]))
+      earliest = right;
+
+    if (earliest == index)
+      break;
+
+    heapSwap(wq, index, earliest);
+    index = earliest;
+  }
+}
+#endif
+/*----------------------------------------------------------------------------*/
+#ifdef CONFIG_GENERIC_WQ_DELAYED
+static void heapSwap(struct WorkQueueDefault *wq, size_t a, size_t b)
+{
+  struct WqDelayedTask * const task = wq->heap[a];
+
+  wq->heap[a] = wq->heap[b];
+  wq->heap[a]->index = a;
+  wq->heap[b] = task;
+  wq->heap[b]->index = b;
+}
+#endif
+/*----------------------------------------------------------------------------*/
+#ifdef CONFIG_GENERIC_WQ_DELAYED
+static void onTimerOverflow(void *argument)
+{
+  struct WorkQueueDefault * const wq = argument;
+  const uint32_t ticks = wq->ticks + 1;
+
+  wq->ticks = ticks;
+
+  if (wq->heapSize && (int32_t)(ticks - wq->heap[0]->timestamp) >= 0)
+    wq->expired = true;
+}
+#endif
+/*----------------------------------------------------------------------------*/
+#ifdef CONFIG_GENERIC_WQ_DELAYED
+static void runDelayedTasks(struct WorkQueueDefault *wq)
+{
+  IrqState state;
+
+  wq->expired = false;
+
+  while (true)
+  {
+    /* Critical section begin */
+    state = irqSave();
+
+    if (!wq->heapSize
+        || (int32_t)(wq->ticks - wq->heap[0]->timestamp) < 0)
+    {
+      /* Timer is not needed when there are no pending tasks */
+      if (!wq->heapSize)
+        timerDisable(wq->timer);
+
+      irqRestore(state);
+      break;
+    }
+
+    struct WqDelayedTask * const task = wq->heap[0];
+    void (*callback)(void *) = task->callback;
+    void * const argument = task->argument;
+
+    heapRemove(wq, 0);
+
+    if (task->period)
+    {
+      /* Period is counted from the expiration time to avoid drift */
+      task->timestamp += task->period;
+      heapInsert(wq, task);
+    }
+
+    irqRestore(state);
+    /* Critical section end */
+
+    callback(argument);
+  }
+}
+#endif
+/*----------------------------------------------------------------------------*/
 static enum Result workQueueInit(void *object, const void *configBase)
 {
   const struct WorkQueueConfig * const config = configBase;
@@ -143,6 +355,30 @@ static enum Result workQueueInit(void *object, const void *configBase)
   if (!wqTaskQueueInit(&wq->tasks, config->size))
     return E_MEMORY;
 
+#ifdef CONFIG_GENERIC_WQ_IDLE
+  wq->idle = config->idle;
+#endif
+
+#ifdef CONFIG_GENERIC_WQ_DELAYED
+  wq->heap = NULL;
+  wq->heapCapacity = config->delayed;
+  wq->heapSize = 0;
+  wq->timer = config->timer;
+  wq->ticks = 0;
+  wq->expired = false;
+
+  if (wq->heapCapacity)
+  {
+    assert(wq->timer != NULL);
+
+    wq->heap = malloc(sizeof(struct WqDelayedTask *) * wq->heapCapacity);
+    if (wq->heap == NULL)
+      return E_MEMORY;
+
+    timerSetCallback(wq->timer, onTimerOverflow, wq);
+  }
+#endif
+
   return E_OK;
 }
 /*----------------------------------------------------------------------------*/
@@ -152,6 +388,16 @@ static void workQueueDeinit(void *object)
   struct WorkQueueDefault * const wq = object;
 
   wqStop(wq);
+
+#ifdef CONFIG_GENERIC_WQ_DELAYED
+  if (wq->heapCapacity)
+  {
+    timerDisable(wq->timer);
+    timerSetCallback(wq->timer, NULL, NULL);
+    free(wq->heap);
+  }
+#endif
+
   wqTaskQueueDeinit(&wq->tasks);
 
 #ifdef CONFIG_GENERIC_WQ_PROFILE
@@ -213,6 +459,24 @@ static enum Result workQueueAdd(void *object, void (*callback)(void *),
   return res;
 }
 /*----------------------------------------------------------------------------*/
+#ifdef CONFIG_GENERIC_WQ_DELAYED
+static void workQueueCancel(void *object, struct WqDelayedTask *task)
+{
+  struct WorkQueueDefault * const wq = object;
+  const IrqState state = irqSave();
+
+  if (task->index < wq->heapSize && wq->heap[task->index] == task)
+  {
+    heapRemove(wq, task->index);
+
+    if (!wq->heapSize)
+      timerDisable(wq->timer);
+  }
+
+  irqRestore(state);
+}
+#endif
+/*----------------------------------------------------------------------------*/
 #ifdef CONFIG_GENERIC_WQ_PROFILE
 static void workQueueProfile(void *object, WqProfileCallback callback,
     void *argument)
@@ -240,6 +504,44 @@ static void workQueueProfile(void *object, WqProfileCallback callback,
 }
 #endif
 /*----------------------------------------------------------------------------*/
+#ifdef CONFIG_GENERIC_WQ_DELAYED
+static enum Result workQueueSchedule(void *object, struct WqDelayedTask *task,
+    void (*callback)(void *), void *argument, uint32_t delay, uint32_t period)
+{
+  assert(callback != NULL);
+  assert(delay <= INT32_MAX && period <= INT32_MAX);
+
+  struct WorkQueueDefault * const wq = object;
+  const IrqState state = irqSave();
+  enum Result res = E_OK;
+
+  /* Rescheduling of a pending task restarts the delay */
+  if (task->index < wq->heapSize && wq->heap[task->index] == task)
+    heapRemove(wq, task->index);
+
+  if (wq->heapSize < wq->heapCapacity)
+  {
+    const bool idle = wq->heapSize == 0;
+
+    task->callback = callback;
+    task->argument = argument;
+    task->period = period;
+    /* Task expires after at least the requested number of full ticks */
+    task->timestamp = wq->ticks + delay + 1;
+
+    heapInsert(wq, task);
+
+    if (idle)
+      timerEnable(wq->timer);
+  }
+  else
+    res = wq->heapCapacity ? E_FULL : E_INVALID;
+
+  irqRestore(state);
+  return res;
+}
+#endif
+/*----------------------------------------------------------------------------*/
 static enum Result workQueueStart(void *object)
 {
   struct WorkQueueDefault * const wq = object;
@@ -274,8 +576,14 @@ static enum Result workQueueStart(void *object)
      * between size comparison and sleep instruction.
      */
     state = irqSave();
+#  ifdef CONFIG_GENERIC_WQ_DELAYED
+    /* Sleep until the next task or the next tick of the delay timer */
+    if (wqTaskQueueEmpty(&wq->tasks) && !wq->expired)
+      enterIdleState(wq);
+#  else
     if (wqTaskQueueEmpty(&wq->tasks))
-      pmChangeState(PM_SLEEP);
+      enterIdleState(wq);
+#  endif
     irqRestore(state);
 #endif
 
@@ -286,6 +594,11 @@ static enum Result workQueueStart(void *object)
     /* Reload queue size */
     barrier();
 
+#ifdef CONFIG_GENERIC_WQ_DELAYED
+    if (wq->expired)
+      runDelayedTasks(wq);
+#endif
+
     while (!wqTaskQueueEmpty(&wq->tasks))
     {
       const struct WqTask task = wqTaskQueueFront(&wq->tasks);
@@ -326,6 +639,16 @@ static enum Result workQueueStart(void *object)
       irqRestore(state);
       /* Critical section end */
 #endif
+
+#ifdef CONFIG_GENERIC_WQ_DELAYED
+      /*
+       * Expired tasks are not delayed by a long queue of regular tasks.
+       * They run after the profiling of the previous task is finished,
+       * so that their time is not included in its execution time.
+       */
+      if (wq->expired)
+        runDelayedTasks(wq);
+#endif
     }
   }
 
@@ -8,8 +8,8 @@
 #include <halm/irq.h>
 #include <halm/pm.h>
 #include <xcore/asm.h>
-#include <xcore/containers/tg_array.h>
 #include <xcore/containers/tg_queue.h>
+#include <stdlib.h>
 /*----------------------------------------------------------------------------*/
 struct WqTask
 {
@@ -36,15 +36,24 @@ struct WqTaskBucket
   bool pending;
 };
 
-DEFINE_ARRAY(struct WqTaskBucket *, WqTask, wqTask)
 DEFINE_QUEUE(struct WqTaskBucket *, WqTask, wqTask)
 
 struct WorkQueueUnique
 {
   struct WorkQueue base;
 
+  /* Storage for task buckets */
   struct WqTaskBucket *pool;
-  WqTaskArray buckets;
+  /* Number of used buckets */
+  size_t count;
+  /* Maximum number of buckets */
+  size_t capacity;
+
+  /* Open addressing hash table with pointers to buckets */
+  struct WqTaskBucket **table;
+  /* Mask for hash table indices, table size is a power of two */
+  size_t mask;
+
   WqTaskQueue tasks;
 
 #ifdef CONFIG_GENERIC_WQ_UNIQUE_PROFILE
@@ -67,9 +76,9 @@ struct WorkQueueUnique
 #endif
 };
 /*----------------------------------------------------------------------------*/
-static bool findTaskBucket(struct WorkQueueUnique *, const struct WqTask *,
-    size_t *);
-static int taskComparator(const struct WqTask *, const struct WqTask *);
+static struct WqTaskBucket **findTaskBucket(struct WorkQueueUnique *,
+    const struct WqTask *);
+static inline size_t taskHash(const struct WqTask *);
 /*----------------------------------------------------------------------------*/
 static enum Result workQueueInit(void *, const void *);
 static enum Result workQueueAdd(void *, void (*)(void *), void *);
@@ -111,49 +120,39 @@ const struct WorkQueueClass * const WorkQueueUnique =
     .stop = workQueueStop
 };
 /*----------------------------------------------------------------------------*/
-static bool findTaskBucket(struct WorkQueueUnique *wq,
-    const struct WqTask *task, size_t *index)
+static struct WqTaskBucket **findTaskBucket(struct WorkQueueUnique *wq,
+    const struct WqTask *task)
 {
-  WqTaskArray * const buckets = &wq->buckets;
-  size_t left = 0;
-  size_t right = wqTaskArraySize(buckets);
+  size_t index = taskHash(task) & wq->mask;
 
-  while (left != right)
+  /*
+   * Buckets are never removed, therefore the probe sequence stops
+   * at the matching bucket or at the first empty slot.
+   */
+  while (true)
   {
-    const size_t middle = (left + right) / 2;
-    const struct WqTaskBucket * const current = *wqTaskArrayAt(buckets, middle);
-    const int result = taskComparator(&current->task, task);
+    struct WqTaskBucket ** const slot = &wq->table[index];
+    const struct WqTaskBucket * const bucket = *slot;
 
-    if (result > 0)
-    {
-      right = middle;
-    }
-    else if (result < 0)
-    {
-      left = middle + 1;
-    }
-    else
+    if (bucket == NULL || (bucket->task.callback == task->callback
+        && bucket->task.argument == task->argument))
     {
-      *index = middle;
-      return true;
+      return slot;
     }
-  }
 
-  *index = left;
-  return false;
+    index = (index + 1) & wq->mask;
+  }
 }
 /*----------------------------------------------------------------------------*/
-static int taskComparator(const struct WqTask *a, const struct WqTask *b)
+static inline size_t taskHash(const struct WqTask *task)
 {
-  if ((uintptr_t)a->callback > (uintptr_t)b->callback)
-    return 1;
-  if ((uintptr_t)a->callback < (uintptr_t)b->callback)
-    return -1;
+  /* Multiplicative hashing, low bits of pointers are mostly constant */
+  const uint32_t callback = (uint32_t)(uintptr_t)task->callback;
+  const uint32_t argument = (uint32_t)(uintptr_t)task->argument;
+  const uint32_t hash =
+      (callback * UINT32_C(0x9E3779B1)) ^ (argument * UINT32_C(0x85EBCA77));
 
-  if (a->argument == b->argument)
-    return 0;
-  else
-    return ((uintptr_t)a->argument > (uintptr_t)b->argument) ? 1 : -1;
+  return (size_t)(hash ^ (hash >> 16));
 }
 /*----------------------------------------------------------------------------*/
 static enum Result workQueueInit(void *object, const void *configBase)
@@ -164,11 +163,22 @@ static enum Result workQueueInit(void *object, const void *configBase)
 
   struct WorkQueueUnique * const wq = object;
 
+  /* Load factor of the hash table does not exceed one half */
+  size_t tableSize = 2;
+
+  while (tableSize < config->size * 2)
+    tableSize <<= 1;
+
+  wq->count = 0;
+  wq->capacity = config->size;
+  wq->mask = tableSize - 1;
+
   wq->pool = malloc(sizeof(struct WqTaskBucket) * config->size);
   if (wq->pool == NULL)
     return E_MEMORY;
 
-  if (!wqTaskArrayInit(&wq->buckets, config->size))
+  wq->table = calloc(tableSize, sizeof(struct WqTaskBucket *));
+  if (wq->table == NULL)
     return E_MEMORY;
 
   if (!wqTaskQueueInit(&wq->tasks, config->size))
@@ -184,7 +194,7 @@ static void workQueueDeinit(void *object)
 
   wqStop(wq);
   wqTaskQueueDeinit(&wq->tasks);
-  wqTaskArrayDeinit(&wq->buckets);
+  free(wq->table);
   free(wq->pool);
 }
 #endif /* CONFIG_GENERIC_WQ_UNIQUE_NONSTOP */
@@ -195,8 +205,6 @@ static enum Result workQueueAdd(void *object, void (*callback)(void *),
   assert(callback != NULL);
 
   struct WorkQueueUnique * const wq = object;
-  struct WqTaskBucket *bucket;
-  size_t index;
 
   const struct WqTask task = {
       .callback = callback,
@@ -204,11 +212,14 @@ static enum Result workQueueAdd(void *object, void (*callback)(void *),
   };
   const IrqState state = irqSave();
 
-  if (!findTaskBucket(wq, &task, &index))
+  struct WqTaskBucket ** const slot = findTaskBucket(wq, &task);
+  struct WqTaskBucket *bucket = *slot;
+
+  if (bucket == NULL)
   {
-    if (!wqTaskArrayFull(&wq->buckets))
+    if (wq->count < wq->capacity)
     {
-      bucket = &wq->pool[wqTaskArraySize(&wq->buckets)];
+      bucket = &wq->pool[wq->count++];
 
       bucket->task = task;
       bucket->pending = false;
@@ -221,17 +232,9 @@ static enum Result workQueueAdd(void *object, void (*callback)(void *),
       bucket->execution.total = 0;
 #endif
 
-      wqTaskArrayInsert(&wq->buckets, index, bucket);
-    }
-    else
-    {
-      bucket = NULL;
+      *slot = bucket;
     }
   }
-  else
-  {
-    bucket = *wqTaskArrayAt(&wq->buckets, index);
-  }
 
   enum Result res;
 
@@ -260,9 +263,9 @@ static void workQueueProfile(void *object, WqProfileCallback callback,
 {
   struct WorkQueueUnique * const wq = object;
 
-  for (size_t index = 0; index < wqTaskArraySize(&wq->buckets); ++index)
+  for (size_t index = 0; index < wq->count; ++index)
   {
-    struct WqTaskBucket * const bucket = *wqTaskArrayAt(&wq->buckets, index);
+    struct WqTaskBucket * const bucket = &wq->pool[index];
     const IrqState state = irqSave();
 
     const struct WqTaskInfo info = {
@@ -382,7 +385,7 @@ static void workQueueStatistics(void *object, struct WqInfo *statistics)
 #ifdef CONFIG_GENERIC_WQ_UNIQUE_PROFILE
   const IrqState state = irqSave();
 
-  statistics->watermark = wqTaskArraySize(&wq->buckets);
+  statistics->watermark = wq->count;
   statistics->uptime = wqGetTime() - wq->timestamp;
   statistics->latency.max = wq->latency.max;
   statistics->latency.min = wq->latency.min != WQ_COUNTER_MAX ?
@@ -104,7 +104,14 @@ typedef struct
 
   /* Offset 0xED88: Cortex-M4 */
   __rw__ uint32_t CPACR; /* Coprocessor Access Control Register */
-  __ne__ uint32_t RESERVED3[93];
+  __ne__ uint32_t RESERVED3[25];
+
+  /* Offset 0xEDF0 */
+  __rw__ uint32_t DHCSR; /* Debug Halting Control and Status Register */
+  __wo__ uint32_t DCRSR; /* Debug Core Register Selector Register */
+  __rw__ uint32_t DCRDR; /* Debug Core Register Data Register */
+  __rw__ uint32_t DEMCR; /* Debug Exception and Monitor Control Register */
+  __ne__ uint32_t RESERVED9[64];
 
   /* Offset 0xEF00 */
   __wo__ uint32_t STIR; /* Software Trigger Interrupt Register */
@@ -158,6 +165,32 @@ typedef struct
     __rw__ uint32_t DEBR[2];
   };
 } SCB_Type;
+/*------------------Data Watchpoint and Trace unit----------------------------*/
+typedef struct
+{
+  __rw__ uint32_t CTRL; /* Control Register */
+  __rw__ uint32_t CYCCNT; /* Cycle Count Register */
+  __rw__ uint32_t CPICNT; /* CPI Count Register */
+  __rw__ uint32_t EXCCNT; /* Exception Overhead Count Register */
+  __rw__ uint32_t SLEEPCNT; /* Sleep Count Register */
+  __rw__ uint32_t LSUCNT; /* LSU Count Register */
+  __rw__ uint32_t FOLDCNT; /* Folded-instruction Count Register */
+  __ro__ uint32_t PCSR; /* Program Counter Sample Register */
+
+  /* Offset 0x020 */
+  struct
+  {
+    __rw__ uint32_t COMP; /* Comparator Register */
+    __rw__ uint32_t MASK; /* Mask Register */
+    __rw__ uint32_t FUNCTION; /* Function Register */
+    __ne__ uint32_t RESERVED0;
+  } COMPARATOR[4];
+  __ne__ uint32_t RESERVED1[980];
+
+  /* Offset 0xFB0: Cortex-M7 */
+  __wo__ uint32_t LAR; /* Lock Access Register */
+  __ro__ uint32_t LSR; /* Lock Status Register */
+} DWT_Type;
 /*------------------System Tick Timer-----------------------------------------*/
 typedef struct
 {
@@ -237,6 +270,12 @@ typedef struct
       __ne__ uint8_t RESERVED4[0xE000];
       SCB_Type SCB;
     };
+
+    struct
+    {
+      __ne__ uint8_t RESERVED5[0x1000];
+      DWT_Type DWT;
+    };
   };
 } PPB_DOMAIN_Type;
 /*----------------------------------------------------------------------------*/
@@ -246,5 +285,6 @@ extern PPB_DOMAIN_Type PPB_DOMAIN;
 #define NVIC      (&PPB_DOMAIN.NVIC)
 #define MPU       (&PPB_DOMAIN.MPU)
 #define SCB       (&PPB_DOMAIN.SCB)
+#define DWT       (&PPB_DOMAIN.DWT)
 /*----------------------------------------------------------------------------*/
 #endif /* HALM_CORE_CORTEX_ARMV7M_CORE_DEFS_H_ */
@@ -0,0 +1,28 @@
+/*
+ * halm/core/cortex/armv7m/dwt_defs.h
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the MIT License
+ */
+
+#ifndef HALM_CORE_CORTEX_ARMV7M_DWT_DEFS_H_
+#define HALM_CORE_CORTEX_ARMV7M_DWT_DEFS_H_
+/*----------------------------------------------------------------------------*/
+#include <xcore/bits.h>
+/*------------------Control register------------------------------------------*/
+#define CTRL_CYCCNTENA                  BIT(0)
+#define CTRL_CPIEVTENA                  BIT(17)
+#define CTRL_EXCEVTENA                  BIT(18)
+#define CTRL_SLEEPEVTENA                BIT(19)
+#define CTRL_LSUEVTENA                  BIT(20)
+#define CTRL_FOLDEVTENA                 BIT(21)
+#define CTRL_CYCEVTENA                  BIT(22)
+#define CTRL_NOPRFCNT                   BIT(24)
+#define CTRL_NOCYCCNT                   BIT(25)
+
+#define CTRL_NUMCOMP_MASK               BIT_FIELD(MASK(4), 28)
+#define CTRL_NUMCOMP_VALUE(reg) \
+    FIELD_VALUE((reg), CTRL_NUMCOMP_MASK, 28)
+/*------------------Lock Access Register--------------------------------------*/
+#define LAR_KEY                         0xC5ACCE55UL
+/*----------------------------------------------------------------------------*/
+#endif /* HALM_CORE_CORTEX_ARMV7M_DWT_DEFS_H_ */
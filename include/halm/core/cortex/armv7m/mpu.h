@@ -48,8 +48,13 @@ BEGIN_DECLS
 
 MpuRegion mpuAddRegion(uintptr_t, size_t, enum MpuPreset,
     enum MpuAccessPermission, bool, bool);
+bool mpuAddRegions(const struct MpuRegionConfig *, size_t, MpuRegion *);
+uint32_t mpuComputeAttributes(enum MpuPreset, enum MpuAccessPermission,
+    bool, bool);
 bool mpuComputeRegion(uintptr_t, size_t, enum MpuPreset,
     enum MpuAccessPermission, bool, bool, struct MpuRegionConfig *);
+size_t mpuPlanRegions(uintptr_t, size_t, uint32_t, struct MpuRegionConfig *,
+    size_t);
 void mpuReconfigureRegion(MpuRegion, const struct MpuRegionConfig *);
 void mpuRemoveRegion(MpuRegion);
 MpuRegion mpuReserveRegion(void);
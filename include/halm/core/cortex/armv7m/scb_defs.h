@@ -12,6 +12,10 @@
 #define HALM_CORE_CORTEX_ARMV7M_SCB_DEFS_H_
 /*----------------------------------------------------------------------------*/
 #include "../armv6m/scb_defs.h"
+/*------------------Interrupt Controller Type Register------------------------*/
+#define ICTR_INTLINESNUM_MASK           BIT_FIELD(MASK(4), 0)
+#define ICTR_INTLINESNUM_VALUE(reg) \
+    FIELD_VALUE((reg), ICTR_INTLINESNUM_MASK, 0)
 /*------------------Interrupt Control and State Register----------------------*/
 #define ICSR_VECTACTIVE_MASK            BIT_FIELD(MASK(9), 0)
 #define ICSR_VECTACTIVE(value)          BIT_FIELD((value), 0)
@@ -48,5 +52,12 @@
 #define CCR_DIV_0_TRP                   BIT(4)
 #define CCR_BFHFNMIGN                   BIT(8)
 #define CCR_STKALIGN                    BIT(9)
+/*------------------Debug Exception and Monitor Control Register--------------*/
+#define DEMCR_VC_CORERESET              BIT(0)
+#define DEMCR_MON_EN                    BIT(16)
+#define DEMCR_MON_PEND                  BIT(17)
+#define DEMCR_MON_STEP                  BIT(18)
+#define DEMCR_MON_REQ                   BIT(19)
+#define DEMCR_TRCENA                    BIT(24)
 /*----------------------------------------------------------------------------*/
 #endif /* HALM_CORE_CORTEX_ARMV7M_SCB_DEFS_H_ */
@@ -0,0 +1,34 @@
+/*
+ * halm/core/cortex/cycle_counter.h
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the MIT License
+ */
+
+/**
+ * @file
+ * Free-running 64-bit counter of core clock cycles. The DWT cycle counter
+ * is used on ARMv7-M and ARMv7E-M cores, SysTick is used on ARMv6-M cores.
+ * The hardware counter is extended in software, on cores with the DWT unit
+ * the counter should be read at least once per 2^32 core cycles.
+ */
+
+#ifndef HALM_CORE_CORTEX_CYCLE_COUNTER_H_
+#define HALM_CORE_CORTEX_CYCLE_COUNTER_H_
+/*----------------------------------------------------------------------------*/
+#include <halm/timer.h>
+/*----------------------------------------------------------------------------*/
+extern const struct Timer64Class * const CycleCounter;
+
+struct CycleCounter
+{
+  struct Timer64 base;
+
+  /* Base timer on cores without the cycle counter */
+  void *timer;
+  /* Number of cycles counted before the last overflow */
+  uint64_t epoch;
+  /* Last value of the hardware counter */
+  uint32_t last;
+};
+/*----------------------------------------------------------------------------*/
+#endif /* HALM_CORE_CORTEX_CYCLE_COUNTER_H_ */
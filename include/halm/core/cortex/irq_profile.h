@@ -0,0 +1,85 @@
+/*
+ * halm/core/cortex/irq_profile.h
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the MIT License
+ */
+
+/**
+ * @file
+ * Instrumentation of interrupt handlers. External interrupt entries of the
+ * vector table are redirected to a common dispatcher that measures handler
+ * execution times with the DWT cycle counter. Time spent in nested handlers
+ * is excluded from the execution time of the preempted handler. Entry
+ * latency is measured from the moment the interrupt was observed pending
+ * at the exit of another handler, delays caused by disabled interrupts
+ * are not visible. Average latency should be calculated using the number
+ * of measured entries instead of the number of handler calls.
+ */
+
+#ifndef HALM_CORE_CORTEX_IRQ_PROFILE_H_
+#define HALM_CORE_CORTEX_IRQ_PROFILE_H_
+/*----------------------------------------------------------------------------*/
+#include <halm/irq.h>
+#include <xcore/error.h>
+#include <xcore/helpers.h>
+/*----------------------------------------------------------------------------*/
+/* Number of logarithmic histogram buckets, bucket N counts 2^N cycles */
+#define IRQ_PROFILE_BUCKETS 16
+
+struct IrqInfo
+{
+  IrqNumber irq;
+  /* Maximum nesting depth at handler entry */
+  uint8_t depth;
+  uint32_t count;
+
+  struct
+  {
+    /* Number of entries with a measured latency */
+    uint32_t count;
+    uint32_t max;
+    uint64_t total;
+  } latency;
+
+  struct
+  {
+    uint32_t max;
+    uint32_t min;
+    uint64_t total;
+  } execution;
+
+  /* Histogram of execution times */
+  uint32_t histogram[IRQ_PROFILE_BUCKETS];
+};
+
+typedef void (*IrqProfileCallback)(void *, const struct IrqInfo *);
+/*----------------------------------------------------------------------------*/
+BEGIN_DECLS
+
+/**
+ * Install the dispatcher into the vector table. The vector table is copied
+ * to the memory and the vector table offset register is updated.
+ * @return @b E_OK on success.
+ */
+enum Result irqProfileInit(void);
+
+/**
+ * Restore the original vector table and release profiling data.
+ */
+void irqProfileDeinit(void);
+
+/**
+ * Get profiling information for interrupts that were handled at least once.
+ * @param callback Callback function called for each interrupt.
+ * @param argument Callback function argument.
+ */
+void irqProfile(IrqProfileCallback callback, void *argument);
+
+/**
+ * Clear accumulated profiling information.
+ */
+void irqProfileReset(void);
+
+END_DECLS
+/*----------------------------------------------------------------------------*/
+#endif /* HALM_CORE_CORTEX_IRQ_PROFILE_H_ */
@@ -14,6 +14,16 @@
 /*----------------------------------------------------------------------------*/
 #include <xcore/entity.h>
 /*----------------------------------------------------------------------------*/
+struct DmaVector
+{
+  /** Destination memory address. */
+  void *destination;
+  /** Source memory address. */
+  const void *source;
+  /** Total number of bytes to transfer. */
+  size_t size;
+};
+
 /* Class descriptor */
 struct DmaClass
 {
@@ -32,6 +42,7 @@ struct DmaClass
   /* List management */
 
   void (*append)(void *, void *, const void *, size_t);
+  void (*appendVector)(void *, const struct DmaVector *, size_t);
   void (*clear)(void *);
   size_t (*queued)(const void *);
 };
@@ -68,7 +79,10 @@ static inline void dmaSetCallback(void *channel, void (*callback)(void *),
 
 /**
  * Enable the channel.
- * Channel goes into the error state when the operation fails.
+ * Channel goes into the error state when the operation fails. Some list
+ * channels keep the descriptor chain after the transfer is completed:
+ * enabling such channel again without appending new descriptors restarts
+ * the same chain.
  * @param channel Pointer to a Dma object.
  * @return @b E_OK on success.
  */
@@ -124,6 +138,34 @@ static inline void dmaAppend(void *channel, void *destination,
       source, size);
 }
 
+/**
+ * Append a group of descriptors to the descriptor chain.
+ * Descriptors are appended one by one when the channel has no native support
+ * for scatter-gather lists.
+ * @param channel Pointer to a Dma object.
+ * @param vector Pointer to an array of descriptors.
+ * @param count Number of descriptors in the array.
+ */
+static inline void dmaAppendVector(void *channel,
+    const struct DmaVector *vector, size_t count)
+{
+  const struct DmaClass * const type =
+      (const struct DmaClass *)CLASS(channel);
+
+  if (type->appendVector != NULL)
+  {
+    type->appendVector(channel, vector, count);
+  }
+  else
+  {
+    for (size_t index = 0; index < count; ++index)
+    {
+      type->append(channel, vector[index].destination, vector[index].source,
+          vector[index].size);
+    }
+  }
+}
+
 /**
  * Remove all descriptors from the descriptor chain.
  * @param channel Pointer to a Dma object.
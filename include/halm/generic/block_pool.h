@@ -0,0 +1,139 @@
+/*
+ * halm/generic/block_pool.h
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the MIT License
+ */
+
+/**
+ * @file
+ * Fixed-block memory pool with size-class slabs. Each slab holds a fixed
+ * number of equally sized blocks, a request is served by the smallest slab
+ * with a free block of a sufficient size. All memory is reserved during
+ * initialization, therefore allocation time is bounded and the pool is not
+ * affected by fragmentation.
+ */
+
+#ifndef HALM_GENERIC_BLOCK_POOL_H_
+#define HALM_GENERIC_BLOCK_POOL_H_
+/*----------------------------------------------------------------------------*/
+#include <xcore/entity.h>
+#include <stddef.h>
+#include <stdint.h>
+/*----------------------------------------------------------------------------*/
+extern const struct EntityClass * const BlockPool;
+
+struct BlockSlab
+{
+  /** Mandatory: block size in bytes. */
+  size_t size;
+  /** Mandatory: number of blocks. */
+  size_t count;
+};
+
+struct BlockPoolConfig
+{
+  /** Mandatory: table of slabs in ascending order of block sizes. */
+  const struct BlockSlab *slabs;
+  /** Mandatory: number of slabs in the table. */
+  size_t count;
+  /**
+   * Optional: memory region for blocks. Region is allocated on the heap
+   * when the pointer is left uninitialized.
+   */
+  void *arena;
+  /** Optional: size of the memory region, mandatory when arena is set. */
+  size_t size;
+  /**
+   * Optional: alignment of blocks, should be a power of two. Default
+   * alignment is suitable for any fundamental type, DMA buffers and cache
+   * lines may require a greater alignment.
+   */
+  size_t alignment;
+};
+
+struct BlockPoolInfo
+{
+  /** Block size in bytes after alignment. */
+  size_t size;
+  /** Total number of blocks. */
+  size_t count;
+  /** Number of allocated blocks. */
+  size_t used;
+  /** Maximum number of allocated blocks. */
+  size_t peak;
+  /** Number of requests served by a slab with larger blocks. */
+  uint32_t borrowed;
+  /** Number of requests that were not served. */
+  uint32_t failures;
+};
+
+struct BlockPoolSlab
+{
+  /* Memory of the slab */
+  uint8_t *begin;
+  uint8_t *end;
+  /* List of free blocks */
+  void *head;
+
+  /* Statistics */
+  struct BlockPoolInfo info;
+};
+
+struct BlockPool
+{
+  struct Entity base;
+
+  /* Slabs in ascending order of block sizes */
+  struct BlockPoolSlab *slabs;
+  /* Number of slabs */
+  size_t count;
+
+  /* Memory allocated on the heap */
+  void *memory;
+};
+/*----------------------------------------------------------------------------*/
+BEGIN_DECLS
+
+/**
+ * Allocate a block from the pool.
+ * Request is served by the smallest slab with a free block, the block size
+ * may exceed the requested size. Function is safe to call from interrupts.
+ * @param pool Pointer to a BlockPool object.
+ * @param size Requested size in bytes.
+ * @return Pointer to an aligned block on success or NULL when there are no
+ * suitable free blocks.
+ */
+void *blockPoolAlloc(void *pool, size_t size);
+
+/**
+ * Return a block to the pool.
+ * Function is safe to call from interrupts.
+ * @param pool Pointer to a BlockPool object.
+ * @param block Pointer to a block allocated from the same pool or NULL.
+ */
+void blockPoolFree(void *pool, void *block);
+
+/**
+ * Get usage statistics of a slab.
+ * @param pool Pointer to a BlockPool object.
+ * @param index Index of the slab in the configuration table.
+ * @param info Pointer to a structure to be filled with statistics.
+ * @return @b E_OK on success or @b E_VALUE when the index is out of range.
+ */
+enum Result blockPoolGetInfo(const void *pool, size_t index,
+    struct BlockPoolInfo *info);
+
+/**
+ * Calculate the size of a memory region required for a pool.
+ * @param slabs Table of slabs.
+ * @param count Number of slabs in the table.
+ * @param alignment Alignment of blocks or zero for the default alignment.
+ * @return Size of the memory region in bytes including the space reserved
+ * for the alignment of an arbitrary region address.
+ */
+size_t blockPoolGetRequiredSize(const struct BlockSlab *slabs, size_t count,
+    size_t alignment);
+
+END_DECLS
+/*----------------------------------------------------------------------------*/
+#endif /* HALM_GENERIC_BLOCK_POOL_H_ */
@@ -11,6 +11,7 @@
 #include <halm/generic/pointer_queue.h>
 #include <xcore/interface.h>
 #include <xcore/stream.h>
+#include <stdint.h>
 /*----------------------------------------------------------------------------*/
 extern const struct InterfaceClass * const BufferingProxy;
 
@@ -18,6 +19,11 @@ struct BufferingProxyConfig
 {
   /** Mandatory: wrapped interface. */
   void *pipe;
+  /**
+   * Optional: block pool for stream buffers. Buffers are allocated
+   * on the heap when the pool is not provided.
+   */
+  void *pool;
 
   struct
   {
@@ -27,6 +33,20 @@ struct BufferingProxyConfig
     size_t count;
     /** Optional: buffer size. */
     size_t size;
+    /**
+     * Optional: number of subscribers. Completed buffers are published
+     * to all subscribers by pointer and are returned to the stream after
+     * the release by the last subscriber. Read function serves the first
+     * subscriber. Buffers are passed to a single reader when the number
+     * of subscribers is zero.
+     */
+    size_t subscribers;
+    /**
+     * Optional: maximum number of buffers queued for each subscriber.
+     * The oldest buffer is dropped for a subscriber that reached the limit.
+     * Default limit is a half of the buffer count.
+     */
+    size_t lag;
   } rx;
 
   struct
@@ -40,6 +60,26 @@ struct BufferingProxyConfig
   } tx;
 };
 
+struct BufferingProxyStatistics
+{
+  /** Number of published buffers that are not fetched yet. */
+  size_t lag;
+  /** Maximum number of published buffers that were not fetched. */
+  size_t peak;
+  /** Number of buffers dropped because of the lag limit. */
+  uint32_t dropped;
+};
+
+struct BufferingProxySubscriber
+{
+  /* Published buffers */
+  PointerQueue queue;
+  /* Maximum queue size */
+  size_t peak;
+  /* Number of dropped buffers */
+  uint32_t dropped;
+};
+
 struct BufferingProxy
 {
   struct Interface base;
@@ -52,6 +92,7 @@ struct BufferingProxy
   struct Stream *tx;
 
   void *arena;
+  void *pool;
   size_t rxBufferCount;
   size_t rxBufferSize;
   size_t txBufferCount;
@@ -59,6 +100,32 @@ struct BufferingProxy
   PointerQueue rxQueue;
   PointerArray rxPool;
   PointerArray txPool;
+
+  struct BufferingProxySubscriber *subscribers;
+  size_t subscriberCount;
+  size_t subscriberLag;
+  size_t rxPublished;
 };
 /*----------------------------------------------------------------------------*/
+BEGIN_DECLS
+
+/*
+ * Zero-copy API. Received buffers are borrowed by the application with
+ * bufferingProxyAcquire or bufferingProxyFetch, processed in place and
+ * returned with bufferingProxyRelease. Output buffers are taken from the pool
+ * with bufferingProxyAllocate, filled in place and passed to the output stream
+ * with bufferingProxySubmit. Capacity of borrowed buffers is equal to
+ * the configured buffer size.
+ */
+
+struct StreamRequest *bufferingProxyAcquire(void *);
+struct StreamRequest *bufferingProxyAllocate(void *);
+struct StreamRequest *bufferingProxyFetch(void *, size_t);
+void bufferingProxyGetStatistics(void *, size_t,
+    struct BufferingProxyStatistics *);
+void bufferingProxyRelease(void *, struct StreamRequest *);
+enum Result bufferingProxySubmit(void *, struct StreamRequest *);
+
+END_DECLS
+/*----------------------------------------------------------------------------*/
 #endif /* HALM_GENERIC_BUFFERING_PROXY_H_ */
@@ -105,6 +105,18 @@ enum CANParameter
    */
   IF_CAN_TX_COUNT,
 
+  /**
+   * Number of received frames accepted by software filters.
+   * Parameter is read-only. Parameter type is \p uint32_t.
+   */
+  IF_CAN_FILTER_HITS,
+
+  /**
+   * Number of received frames rejected by software filters.
+   * Parameter is read-only. Parameter type is \p uint32_t.
+   */
+  IF_CAN_FILTER_DROPS,
+
   /** End of the CAN parameter list. */
   IF_CAN_PARAMETER_END
 };
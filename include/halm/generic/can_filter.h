@@ -0,0 +1,118 @@
+/*
+ * halm/generic/can_filter.h
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the MIT License
+ */
+
+#ifndef HALM_GENERIC_CAN_FILTER_H_
+#define HALM_GENERIC_CAN_FILTER_H_
+/*----------------------------------------------------------------------------*/
+#include <halm/generic/can.h>
+#include <stddef.h>
+#include <stdint.h>
+/*----------------------------------------------------------------------------*/
+/*
+ * Software acceptance filter. Rules are compiled into a table of distinct
+ * masks and an open-addressing hash set of masked identifiers, so that
+ * a lookup costs one hash probe per distinct mask. Exact identifiers
+ * share a single full-width mask group. An empty rule set accepts all frames.
+ *
+ * Lookups are safe in interrupt context, rule modifications must be
+ * serialized with lookups by the caller.
+ */
+struct CanFilterRule
+{
+  /* Identifier with the frame format flag */
+  uint32_t id;
+  /* Mask with the frame format flag */
+  uint32_t mask;
+};
+
+struct CanFilterSlot
+{
+  /* Masked identifier with the frame format flag */
+  uint32_t key;
+  /* Index of the mask group */
+  uint8_t group;
+};
+
+struct CanFilterEngine
+{
+  /* Source rules */
+  struct CanFilterRule *rules;
+  /* Distinct masks */
+  uint32_t *groups;
+  /* Hash set of masked identifiers */
+  struct CanFilterSlot *slots;
+
+  /* Maximum number of rules */
+  size_t capacity;
+  /* Number of active rules */
+  size_t count;
+  /* Number of distinct masks */
+  size_t groupCount;
+  /* Hash set size minus one, set size is a power of two */
+  size_t slotMask;
+
+  /* Accepted frames */
+  uint32_t hits;
+  /* Rejected frames */
+  uint32_t drops;
+};
+/*----------------------------------------------------------------------------*/
+BEGIN_DECLS
+
+bool canFilterEngineInit(struct CanFilterEngine *, size_t);
+void canFilterEngineDeinit(struct CanFilterEngine *);
+bool canFilterEngineAdd(struct CanFilterEngine *, const struct CANFilter *,
+    bool);
+void canFilterEngineClear(struct CanFilterEngine *);
+bool canFilterEngineMatch(const struct CanFilterEngine *, uint32_t, bool);
+bool canFilterEngineRemove(struct CanFilterEngine *, const struct CANFilter *,
+    bool);
+
+END_DECLS
+/*----------------------------------------------------------------------------*/
+BEGIN_DECLS
+
+/**
+ * Check a received frame and update hit and drop counters.
+ * @param engine Pointer to a filter engine.
+ * @param id Frame identifier.
+ * @param ext Frame has an extended identifier.
+ * @return @b true when the frame should be accepted.
+ */
+static inline bool canFilterEngineAccept(struct CanFilterEngine *engine,
+    uint32_t id, bool ext)
+{
+  if (canFilterEngineMatch(engine, id, ext))
+  {
+    ++engine->hits;
+    return true;
+  }
+  else
+  {
+    ++engine->drops;
+    return false;
+  }
+}
+
+static inline bool canFilterEngineEmpty(const struct CanFilterEngine *engine)
+{
+  return engine->count == 0;
+}
+
+static inline const struct CanFilterRule *canFilterEngineRule(
+    const struct CanFilterEngine *engine, size_t index)
+{
+  return &engine->rules[index];
+}
+
+static inline size_t canFilterEngineSize(const struct CanFilterEngine *engine)
+{
+  return engine->count;
+}
+
+END_DECLS
+/*----------------------------------------------------------------------------*/
+#endif /* HALM_GENERIC_CAN_FILTER_H_ */
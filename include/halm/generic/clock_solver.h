@@ -0,0 +1,130 @@
+/*
+ * halm/generic/clock_solver.h
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the MIT License
+ */
+
+#ifndef HALM_GENERIC_CLOCK_SOLVER_H_
+#define HALM_GENERIC_CLOCK_SOLVER_H_
+/*----------------------------------------------------------------------------*/
+#include <xcore/error.h>
+#include <xcore/helpers.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+/*----------------------------------------------------------------------------*/
+/*
+ * Clock tree solver. A PLL model describes legal ranges of the input and
+ * oscillator frequencies, allowed multiplier and output divisor values and
+ * dividers attached to the PLL. The solver enumerates the legal space and
+ * selects a configuration with the lowest summary error for requested clocks.
+ * Core and SDIO clocks are selected as high as possible without exceeding
+ * target frequencies, USB clock must stay within the configured tolerance
+ * and the audio clock is selected as close as possible to the target.
+ *
+ * Solver is independent of the hardware, results are intended to be used
+ * as multiplier and divisor values of the PllConfig structure.
+ */
+enum [[gnu::packed]] ClockSolverTarget
+{
+  CLOCK_SOLVER_CORE,
+  CLOCK_SOLVER_USB,
+  CLOCK_SOLVER_SDIO,
+  CLOCK_SOLVER_AUDIO,
+
+  CLOCK_SOLVER_TARGET_COUNT
+};
+
+struct ClockSolverDivider
+{
+  /* Minimal divisor value */
+  uint16_t min;
+  /* Maximal divisor value */
+  uint16_t max;
+  /* Bit mask of clocks driven by the divider */
+  uint8_t targets;
+  /* Divider is connected to the oscillator instead of the PLL output */
+  bool vco;
+};
+
+struct ClockSolverPll
+{
+  /* Optional check of register-level constraints */
+  bool (*validate)(uint32_t, uint16_t, uint16_t);
+
+  /* Allowed output divisor values */
+  const uint16_t *divisors;
+  /* Dividers connected to the PLL */
+  const struct ClockSolverDivider *dividers;
+  /* Number of allowed output divisor values */
+  size_t divisorCount;
+  /* Number of dividers */
+  size_t dividerCount;
+
+  /* Input frequency range */
+  uint32_t inputMin;
+  uint32_t inputMax;
+  /* Oscillator frequency range */
+  uint32_t vcoMin;
+  uint32_t vcoMax;
+  /* Maximum output frequency or zero when it is limited by dividers only */
+  uint32_t outputMax;
+  /* Multiplier range */
+  uint16_t multiplierMin;
+  uint16_t multiplierMax;
+};
+
+struct ClockSolverConfig
+{
+  /** Mandatory: PLL input frequency. */
+  uint32_t input;
+  /** Optional: target frequencies, zero for unused clocks. */
+  uint32_t frequencies[CLOCK_SOLVER_TARGET_COUNT];
+  /** Optional: maximum deviation of the USB clock in ppm. */
+  uint32_t usbTolerance;
+};
+
+struct ClockSolution
+{
+  /** Resulting frequencies, zero for unused clocks. */
+  uint32_t frequencies[CLOCK_SOLVER_TARGET_COUNT];
+  /** Summary error of requested clocks in ppm. */
+  uint32_t error;
+  /** Oscillator frequency. */
+  uint32_t vco;
+  /** Divisor values of requested clocks, zero for unused clocks. */
+  uint16_t dividers[CLOCK_SOLVER_TARGET_COUNT];
+  /** PLL multiplier in terms of the PllConfig structure. */
+  uint16_t multiplier;
+  /** PLL output divisor in terms of the PllConfig structure. */
+  uint16_t divisor;
+};
+/*----------------------------------------------------------------------------*/
+/* LPC11xx, LPC11Exx, LPC13xx and LPC13Uxx system PLL */
+extern const struct ClockSolverPll * const LpcGen2SystemPllModel;
+/* LPC11Exx and LPC13Uxx USB PLL with a fixed 48 MHz output */
+extern const struct ClockSolverPll * const LpcGen2UsbPllModel;
+/* M48x system PLL */
+extern const struct ClockSolverPll * const M48xSystemPllModel;
+/* STM32F4xx main PLL */
+extern const struct ClockSolverPll * const Stm32F4MainPllModel;
+/* STM32F4xx PLLI2S, main PLL must use the same input frequency */
+extern const struct ClockSolverPll * const Stm32F4AudioPllModel;
+/*----------------------------------------------------------------------------*/
+BEGIN_DECLS
+
+/**
+ * Find the best PLL configuration for requested clock frequencies.
+ * Requested clocks that are not driven by any divider of the PLL are ignored.
+ * @param model Pointer to a PLL model.
+ * @param config Pointer to a solver configuration.
+ * @param solution Pointer to a structure that will hold the result.
+ * @return @b E_OK on success, @b E_VALUE when the configuration is invalid
+ * or @b E_ERROR when no feasible configuration exists.
+ */
+enum Result clockSolverFind(const struct ClockSolverPll *,
+    const struct ClockSolverConfig *, struct ClockSolution *);
+
+END_DECLS
+/*----------------------------------------------------------------------------*/
+#endif /* HALM_GENERIC_CLOCK_SOLVER_H_ */
@@ -0,0 +1,84 @@
+/*
+ * halm/generic/dma_ring.h
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the MIT License
+ */
+
+/**
+ * @file
+ * Period tracker for circular DMA channels. The descriptor ring is built
+ * once by the owner of the channel and is re-armed on each start without
+ * rebuilding. The tracker converts channel interrupts into period completion
+ * events with the index of the completed period. Interrupts coalesced
+ * by a late handler are expanded into a sequence of events.
+ */
+
+#ifndef HALM_GENERIC_DMA_RING_H_
+#define HALM_GENERIC_DMA_RING_H_
+/*----------------------------------------------------------------------------*/
+#include <halm/dma.h>
+#include <stdint.h>
+/*----------------------------------------------------------------------------*/
+struct DmaRing
+{
+  /* Circular DMA channel */
+  struct Dma *dma;
+
+  void (*callback)(void *, size_t, enum Result);
+  void *callbackArgument;
+
+  /* Number of periods in the ring */
+  size_t periods;
+  /* Index of the next period to be completed */
+  size_t next;
+  /* Number of interrupts received after a full pass of the ring */
+  uint32_t overruns;
+};
+/*----------------------------------------------------------------------------*/
+BEGIN_DECLS
+
+/**
+ * Initialize the period tracker for a circular DMA channel.
+ * The number of periods is a number of interrupts generated by the channel
+ * during a pass of the ring: a number of appended descriptors for list
+ * channels or a number of parts of the buffer for channels that generate
+ * half-transfer interrupts. Channels in silent mode are not supported.
+ * The number of periods should be equal to the number of remaining
+ * periods reported by the channel at the beginning of the pass: STM32
+ * circular streams report buffer halves, therefore only two periods
+ * with half-transfer interrupts enabled are supported for them.
+ * @param ring Pointer to a DmaRing object.
+ * @param dma Pointer to a circular Dma object with a prebuilt ring.
+ * @param periods Number of periods in the ring.
+ */
+void dmaRingInit(struct DmaRing *ring, void *dma, size_t periods);
+
+/**
+ * Set the callback function for period completion events.
+ * Callback function receives the index of the completed period and
+ * @b E_OK result. In case of the channel error the callback function is
+ * called once with the index of the interrupted period and an error result.
+ * @param ring Pointer to a DmaRing object.
+ * @param callback Callback function.
+ * @param argument Callback function argument.
+ */
+void dmaRingSetCallback(struct DmaRing *ring,
+    void (*callback)(void *, size_t, enum Result), void *argument);
+
+/**
+ * Start the transfer from the first period of the prebuilt ring.
+ * @param ring Pointer to a DmaRing object.
+ * @return @b E_OK on success, @b E_VALUE when the number of periods
+ * is not supported by the channel.
+ */
+enum Result dmaRingStart(struct DmaRing *ring);
+
+/**
+ * Stop the transfer. Descriptor ring is preserved for the next start.
+ * @param ring Pointer to a DmaRing object.
+ */
+void dmaRingStop(struct DmaRing *ring);
+
+END_DECLS
+/*----------------------------------------------------------------------------*/
+#endif /* HALM_GENERIC_DMA_RING_H_ */
@@ -27,7 +27,17 @@ enum FlashParameter
   /** Place memory device in a power down mode. */
   IF_FLASH_SUSPEND,
   /** Release memory device from a power down mode. */
-  IF_FLASH_RESUME
+  IF_FLASH_RESUME,
+  /**
+   * Suspend an erase operation in progress. Erase operations are started
+   * without waiting for completion when the zero-copy mode is enabled.
+   * Suspended memory accepts read and program commands.
+   */
+  IF_FLASH_ERASE_SUSPEND,
+  /** Resume a suspended erase operation. */
+  IF_FLASH_ERASE_RESUME,
+
+  IF_FLASH_PARAMETER_END
 };
 
 struct FlashGeometry
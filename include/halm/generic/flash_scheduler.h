@@ -0,0 +1,150 @@
+/*
+ * halm/generic/flash_scheduler.h
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the MIT License
+ */
+
+/**
+ * @file
+ * Scheduler of background erase operations for flash memory interfaces.
+ * Erase requests are queued and executed by a work queue. Read and write
+ * functions have priority over queued erases: an erase in progress is
+ * suspended when the underlying interface supports erase suspend, otherwise
+ * functions wait for completion of the current erase operation only.
+ */
+
+#ifndef HALM_GENERIC_FLASH_SCHEDULER_H_
+#define HALM_GENERIC_FLASH_SCHEDULER_H_
+/*----------------------------------------------------------------------------*/
+#include <halm/generic/flash.h>
+#include <xcore/containers/tg_queue.h>
+#include <stdint.h>
+/*----------------------------------------------------------------------------*/
+extern const struct InterfaceClass * const FlashScheduler;
+
+enum FlashSchedulerParameter
+{
+  /**
+   * Get read latency statistics. Parameter type is
+   * \p struct FlashSchedulerLatency. Statistics are available only when
+   * the timer is configured.
+   */
+  IF_FLASH_SCHEDULER_LATENCY = IF_FLASH_PARAMETER_END,
+  /** Reset read latency statistics. */
+  IF_FLASH_SCHEDULER_RESET,
+  /** Get the number of queued erase operations. Parameter type is \p size_t. */
+  IF_FLASH_SCHEDULER_PENDING
+};
+
+struct FlashSchedulerLatency
+{
+  /** Number of measured read operations. */
+  uint32_t count;
+  /** Median of the read latency in microseconds. */
+  uint32_t p50;
+  /** 90th percentile of the read latency in microseconds. */
+  uint32_t p90;
+  /** 99th percentile of the read latency in microseconds. */
+  uint32_t p99;
+  /** Maximum read latency in microseconds. */
+  uint32_t max;
+};
+
+struct FlashSchedulerConfig
+{
+  /** Mandatory: underlying flash memory interface. */
+  void *flash;
+  /** Mandatory: work queue for background erase operations. */
+  void *wq;
+  /** Mandatory: capacity of the erase request queue. */
+  size_t requests;
+  /**
+   * Optional: free-running timer with a full 32-bit range for latency
+   * measurement and for enforcing of the resume interval.
+   */
+  void *timer;
+  /**
+   * Optional: periodic timer for polling of the erase status. Erase
+   * operations are started in background only when the timer is set,
+   * otherwise each erase is executed by the work queue in blocking mode.
+   */
+  void *poller;
+  /**
+   * Optional: minimal time in microseconds between an erase resume
+   * and a next erase suspend. Interval guarantees the progress of erase
+   * operations when read functions are called continuously.
+   */
+  uint32_t interval;
+};
+
+struct FlashSchedulerRequest
+{
+  /* Address of the erase unit */
+  uint32_t address;
+  /* Erase parameter of the underlying interface */
+  uint8_t parameter;
+};
+
+DEFINE_QUEUE(struct FlashSchedulerRequest, FlashRequest, flashRequest)
+
+/* Number of histogram bins: four bins per octave up to 2^25 microseconds */
+#define FLASH_SCHEDULER_BINS 100
+
+struct FlashScheduler
+{
+  struct Interface base;
+
+  void (*callback)(void *);
+  void *callbackArgument;
+
+  /* Underlying flash memory interface */
+  void *flash;
+  /* Work queue for background operations */
+  void *wq;
+  /* Timer for latency measurement */
+  void *timer;
+  /* Timer for status polling */
+  void *poller;
+
+  /* Queued erase requests, the first request is active when it is running */
+  FlashRequestQueue requests;
+
+  /* Current position */
+  uint32_t position;
+  /* Memory capacity */
+  uint32_t capacity;
+  /* Size of the block erase unit, zero when blocks are not supported */
+  uint32_t blockSize;
+  /* Size of the sector erase unit */
+  uint32_t sectorSize;
+
+  /* Minimal time between resume and suspend in timer ticks */
+  uint32_t interval;
+  /* Time of the last erase start or resume */
+  uint32_t resumed;
+
+  struct
+  {
+    /* Histogram of read latencies */
+    uint32_t histogram[FLASH_SCHEDULER_BINS];
+    /* Number of measured reads */
+    uint32_t count;
+    /* Maximum latency in microseconds */
+    uint32_t max;
+  } latency;
+
+  /* Status of the last failed erase operation */
+  enum Result status;
+  /* Erase operations are started without waiting for completion */
+  bool async;
+  /* Service task is added to the work queue */
+  bool pending;
+  /* First request in the queue is running */
+  bool running;
+  /* Erase suspend is supported by the underlying interface */
+  bool suspendable;
+  /* Active erase operation is suspended */
+  bool suspended;
+};
+/*----------------------------------------------------------------------------*/
+#endif /* HALM_GENERIC_FLASH_SCHEDULER_H_ */
@@ -0,0 +1,126 @@
+/*
+ * halm/generic/frequency_governor.h
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the MIT License
+ */
+
+/**
+ * @file
+ * Governor that switches the core clock between operating points depending
+ * on the load and the latency of a work queue. Samples are taken by a task
+ * posted to the monitored work queue on each timer event, therefore the delay
+ * of the sampling task is a latency of the work queue. Power management
+ * observers are notified with the active state after each switch so that
+ * peripherals could recalculate their clock settings.
+ */
+
+#ifndef HALM_GENERIC_FREQUENCY_GOVERNOR_H_
+#define HALM_GENERIC_FREQUENCY_GOVERNOR_H_
+/*----------------------------------------------------------------------------*/
+#include <halm/wq.h>
+#include <xcore/entity.h>
+/*----------------------------------------------------------------------------*/
+extern const struct EntityClass * const FrequencyGovernor;
+
+enum [[gnu::packed]] GovernorPolicy
+{
+  /**
+   * Select the highest operating point when the load exceeds the upper
+   * threshold and step down when the load is below the lower threshold.
+   * Work queue should be built with load measurement support, otherwise
+   * the policy is rejected. Idle loop counters of the work queue are
+   * consumed by the governor.
+   */
+  GOVERNOR_ONDEMAND,
+  /** Keep the highest operating point. */
+  GOVERNOR_PERFORMANCE,
+  /**
+   * Select the lowest operating point that keeps the latency of the work
+   * queue below the configured limit.
+   */
+  GOVERNOR_LATENCY
+};
+
+struct FrequencyGovernorConfig
+{
+  /** Mandatory: monitored work queue. */
+  void *wq;
+  /** Mandatory: periodic timer that determines the sampling interval. */
+  void *timer;
+  /** Mandatory: core frequencies of operating points in ascending order. */
+  const uint32_t *points;
+  /** Mandatory: number of operating points. */
+  size_t count;
+  /**
+   * Mandatory: function that switches the clock tree to the operating point
+   * with the specified index.
+   */
+  enum Result (*apply)(void *, size_t);
+  /** Optional: argument for the switch function. */
+  void *argument;
+  /**
+   * Optional: number of idle loops of the work queue during one sampling
+   * interval at the highest operating point. Mandatory for the on-demand
+   * policy.
+   */
+  WqCounter calibration;
+  /**
+   * Optional: latency limit in units of the @b wqGetTime function.
+   * Mandatory for the latency-bound policy.
+   */
+  WqCounter latency;
+  /** Optional: upper load threshold in percents, default is 80. */
+  uint8_t up;
+  /** Optional: lower load threshold in percents, default is 30. */
+  uint8_t down;
+  /** Mandatory: initial policy. */
+  enum GovernorPolicy policy;
+};
+
+struct FrequencyGovernor
+{
+  struct Entity base;
+
+  /* Monitored work queue */
+  void *wq;
+  /* Sampling timer */
+  void *timer;
+
+  /* Switch function and its argument */
+  enum Result (*apply)(void *, size_t);
+  void *argument;
+
+  /* Frequencies of operating points */
+  const uint32_t *points;
+  /* Number of operating points */
+  size_t count;
+  /* Index of the current operating point */
+  size_t current;
+
+  /* Idle loops per interval at the highest operating point */
+  WqCounter calibration;
+  /* Latency limit */
+  WqCounter latency;
+  /* Time when the sampling task was posted */
+  WqCounter timestamp;
+
+  /* Load thresholds in percents */
+  uint8_t up;
+  uint8_t down;
+
+  /* Active policy */
+  enum GovernorPolicy policy;
+  /* Sampling task is waiting in the work queue */
+  bool pending;
+  /* Sampling task could not be posted because the work queue is full */
+  bool overload;
+};
+/*----------------------------------------------------------------------------*/
+BEGIN_DECLS
+
+size_t frequencyGovernorGetPoint(const void *);
+enum Result frequencyGovernorSetPolicy(void *, enum GovernorPolicy);
+
+END_DECLS
+/*----------------------------------------------------------------------------*/
+#endif /* HALM_GENERIC_FREQUENCY_GOVERNOR_H_ */
@@ -0,0 +1,105 @@
+/*
+ * halm/generic/idle_coordinator.h
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the MIT License
+ */
+
+/**
+ * @file
+ * Idle coordinator selects a low-power state depending on the time left
+ * until the nearest deadline of registered timer factories. A state is
+ * selected when the wake-up latency and the minimal residency of the state
+ * fit into the remaining time. Tickless factories are reprogrammed to wake
+ * the core earlier by the wake-up latency so that timers expire on time.
+ */
+
+#ifndef HALM_GENERIC_IDLE_COORDINATOR_H_
+#define HALM_GENERIC_IDLE_COORDINATOR_H_
+/*----------------------------------------------------------------------------*/
+#include <halm/generic/pointer_array.h>
+#include <halm/pm.h>
+#include <xcore/entity.h>
+#include <stddef.h>
+/*----------------------------------------------------------------------------*/
+extern const struct EntityClass * const IdleCoordinator;
+
+struct IdleState
+{
+  /** Mandatory: low-power state of the power management subsystem. */
+  enum PmState state;
+  /** Mandatory: wake-up latency in microseconds. */
+  uint32_t latency;
+  /**
+   * Optional: minimal time in microseconds spent in the state to reduce
+   * power consumption compared to shallower states.
+   */
+  uint32_t residency;
+};
+
+struct IdleCoordinatorConfig
+{
+  /**
+   * Mandatory: platform-specific table of low-power states in ascending
+   * order of depth. Base timers of registered factories should continue
+   * counting in all states from the table.
+   */
+  const struct IdleState *states;
+  /** Mandatory: number of states in the table. */
+  size_t count;
+  /** Mandatory: maximum number of registered timer factories. */
+  size_t capacity;
+  /**
+   * Optional: free-running timer for residency measurement. Residency is
+   * estimated from deadlines when the timer is not provided.
+   */
+  void *clock;
+};
+
+struct IdleInfo
+{
+  /** Number of entries into the state. */
+  uint32_t entries;
+  /** Number of wake-ups after the expected deadline. */
+  uint32_t misses;
+  /** Time in microseconds spent in the state excluding wake-up latency. */
+  uint64_t residency;
+};
+
+struct IdleCoordinator
+{
+  struct Entity base;
+
+  /* Registered timer factories */
+  PointerArray factories;
+  /* Optional timer for residency measurement */
+  void *clock;
+
+  /* Table of low-power states */
+  const struct IdleState *states;
+  /* Statistics for each state */
+  struct IdleInfo *info;
+  /* Number of states */
+  size_t count;
+
+  /* Number of idle calls when no state was suitable */
+  uint32_t skips;
+};
+/*----------------------------------------------------------------------------*/
+BEGIN_DECLS
+
+/**
+ * Enter the deepest low-power state suitable for the nearest deadline.
+ * Function should be called with interrupts disabled, it returns immediately
+ * when no state fits into the time left until the deadline.
+ * @param coordinator Pointer to an IdleCoordinator object.
+ */
+void idleCoordinatorEnter(void *coordinator);
+
+enum Result idleCoordinatorGetInfo(const void *, size_t, struct IdleInfo *);
+uint32_t idleCoordinatorGetSkips(const void *);
+enum Result idleCoordinatorRegister(void *, void *);
+void idleCoordinatorUnregister(void *, const void *);
+
+END_DECLS
+/*----------------------------------------------------------------------------*/
+#endif /* HALM_GENERIC_IDLE_COORDINATOR_H_ */
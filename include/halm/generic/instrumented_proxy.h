@@ -0,0 +1,114 @@
+/*
+ * halm/generic/instrumented_proxy.h
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the MIT License
+ */
+
+/**
+ * @file
+ * Pass-through interface that gathers I/O statistics of the wrapped
+ * interface: number of calls, transferred bytes, call latencies, result
+ * codes and time from the start of a zero-copy transfer to the completion
+ * callback. Parameters not handled by the proxy are forwarded to the wrapped
+ * interface without changes.
+ */
+
+#ifndef HALM_GENERIC_INSTRUMENTED_PROXY_H_
+#define HALM_GENERIC_INSTRUMENTED_PROXY_H_
+/*----------------------------------------------------------------------------*/
+#include <xcore/interface.h>
+#include <stdint.h>
+/*----------------------------------------------------------------------------*/
+extern const struct InterfaceClass * const InstrumentedProxy;
+
+/* Number of logarithmic histogram buckets, bucket N counts 2^N ticks */
+#define INSTRUMENTED_PROXY_BUCKETS 16
+
+enum InstrumentedProxyParameter
+{
+  /*
+   * Identifiers are placed far from parameters of other interfaces
+   * to avoid collisions with forwarded parameters.
+   */
+
+  /** Get statistics. Parameter type is struct InstrumentedProxyStatistics. */
+  IF_PROXY_STATISTICS = 0x1000,
+  /** Clear statistics. Parameter type is none. */
+  IF_PROXY_RESET
+};
+
+struct InstrumentedProxyTiming
+{
+  /* Number of samples */
+  uint32_t count;
+  /* Times in ticks of the clock timer */
+  uint32_t max;
+  uint32_t min;
+  uint64_t total;
+  /* Histogram of times */
+  uint32_t histogram[INSTRUMENTED_PROXY_BUCKETS];
+};
+
+struct InstrumentedProxyChannel
+{
+  /* Number of transferred bytes */
+  uint64_t bytes;
+  /* Number of calls */
+  uint32_t calls;
+  /* Number of calls that transferred less than requested */
+  uint32_t partial;
+  /* Durations of calls */
+  struct InstrumentedProxyTiming latency;
+};
+
+struct InstrumentedProxyStatistics
+{
+  struct InstrumentedProxyChannel rx;
+  struct InstrumentedProxyChannel tx;
+
+  /* Time from the start of a zero-copy transfer to the completion callback */
+  struct InstrumentedProxyTiming completion;
+  /* Number of callbacks from the wrapped interface */
+  uint32_t callbacks;
+
+  /* Result codes of forwarded parameter requests */
+  uint32_t results[E_RESULT_END];
+  /* Status codes of completed zero-copy transfers */
+  uint32_t status[E_RESULT_END];
+};
+
+struct InstrumentedProxyConfig
+{
+  /** Mandatory: wrapped interface. */
+  void *pipe;
+  /**
+   * Optional: free-running timer for time measurement. Latencies are not
+   * measured when the timer is not provided.
+   */
+  void *clock;
+};
+
+struct InstrumentedProxy
+{
+  struct Interface base;
+
+  void (*callback)(void *);
+  void *callbackArgument;
+
+  /* Wrapped interface */
+  void *pipe;
+  /* Timer for time measurement */
+  void *clock;
+
+  /* Gathered statistics */
+  struct InstrumentedProxyStatistics statistics;
+  /* Start time of the pending transfer */
+  uint32_t timestamp;
+
+  /* Transfer is started and completion callback is expected */
+  bool pending;
+  /* Zero-copy mode is enabled */
+  bool zerocopy;
+};
+/*----------------------------------------------------------------------------*/
+#endif /* HALM_GENERIC_INSTRUMENTED_PROXY_H_ */
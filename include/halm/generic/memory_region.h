@@ -0,0 +1,120 @@
+/*
+ * halm/generic/memory_region.h
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the MIT License
+ */
+
+/**
+ * @file
+ * Registry of memory regions with different access properties, for example
+ * tightly coupled memory, non-cacheable SRAM banks or external SDRAM.
+ * Regions are described by the application using linker symbols and are
+ * registered during startup. Drivers allocate buffers with a placement hint
+ * and the registry selects a region with suitable properties. Memory is
+ * allocated from the heap when no suitable region is available.
+ *
+ * Memory from regions is intended for buffers that exist for the whole
+ * lifetime of the application: only the last allocation of the region
+ * is returned on release, other blocks stay reserved. Regions should not
+ * overlap with the heap.
+ */
+
+#ifndef HALM_GENERIC_MEMORY_REGION_H_
+#define HALM_GENERIC_MEMORY_REGION_H_
+/*----------------------------------------------------------------------------*/
+#include <xcore/error.h>
+#include <xcore/helpers.h>
+#include <stddef.h>
+#include <stdint.h>
+/*----------------------------------------------------------------------------*/
+enum
+{
+  /** Region is accessible by DMA controllers. */
+  MEMORY_DMA      = 0x01,
+  /** Region is not cached or is coherent with DMA transfers. */
+  MEMORY_COHERENT = 0x02,
+  /** Tightly coupled or zero wait state memory. */
+  MEMORY_FAST     = 0x04,
+  /** Large memory with a higher access latency. */
+  MEMORY_BULK     = 0x08
+};
+
+enum [[gnu::packed]] MemoryHint
+{
+  /** Allocate memory from the heap. */
+  MEMORY_HINT_DEFAULT,
+  /**
+   * Buffers for DMA transfers. DMA-accessible regions without cache
+   * maintenance requirements are preferred.
+   */
+  MEMORY_HINT_DMA,
+  /** Frequently accessed data. */
+  MEMORY_HINT_FAST,
+  /** Large buffers insensitive to access latency. */
+  MEMORY_HINT_BULK
+};
+
+struct MemoryRegion
+{
+  /** Mandatory: name of the region. */
+  const char *name;
+  /** Mandatory: start address of the region. */
+  void *address;
+  /** Mandatory: size of the region in bytes. */
+  size_t size;
+  /** Mandatory: access properties of the region. */
+  uint8_t flags;
+};
+/*----------------------------------------------------------------------------*/
+BEGIN_DECLS
+
+/**
+ * Allocate memory with the placement hint.
+ * @param hint Desired properties of the memory.
+ * @param size Size of the memory block in bytes.
+ * @param alignment Alignment of the block, should be a power of two.
+ * @return Pointer to an allocated block on success or NULL on error.
+ */
+void *memoryRegionAlloc(enum MemoryHint hint, size_t size, size_t alignment);
+
+/**
+ * Allocate memory in the region with the specified name.
+ * @param name Name of the region.
+ * @param size Size of the memory block in bytes.
+ * @param alignment Alignment of the block, should be a power of two.
+ * @return Pointer to an allocated block on success or NULL when the region
+ * is not found or there is not enough free space in the region.
+ */
+void *memoryRegionAllocNamed(const char *name, size_t size,
+    size_t alignment);
+
+/**
+ * Release memory allocated with the placement hint or by the region name.
+ * Space of a region block is reclaimed only when the block is the last
+ * allocation of the region, other region blocks stay reserved. Blocks
+ * allocated from the heap are freed.
+ * @param block Pointer to a memory block or NULL.
+ */
+void memoryRegionFree(void *block);
+
+/**
+ * Get access properties of a memory block.
+ * @param address Start address of the block.
+ * @param size Size of the block in bytes.
+ * @return Flags of the region that contains the entire block or zero when
+ * the block does not belong to registered regions.
+ */
+uint8_t memoryRegionGetFlags(const void *address, size_t size);
+
+/**
+ * Register a memory region.
+ * @param region Pointer to a region description. Name of the region should
+ * remain valid for the lifetime of the registry.
+ * @return @b E_OK on success, @b E_FULL when the registry has no free
+ * entries or @b E_EXIST when the region overlaps a registered region.
+ */
+enum Result memoryRegionRegister(const struct MemoryRegion *region);
+
+END_DECLS
+/*----------------------------------------------------------------------------*/
+#endif /* HALM_GENERIC_MEMORY_REGION_H_ */
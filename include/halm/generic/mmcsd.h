@@ -7,27 +7,93 @@
 #ifndef HALM_GENERIC_MMCSD_H_
 #define HALM_GENERIC_MMCSD_H_
 /*----------------------------------------------------------------------------*/
+#include <halm/generic/pointer_array.h>
 #include <xcore/interface.h>
 #include <stdint.h>
 /*----------------------------------------------------------------------------*/
 extern const struct InterfaceClass * const MMCSD;
 
+struct Timer;
+
 enum MMCSDParameter
 {
   /** Size of the erase group in bytes. Parameter type is \p uint32_t. */
   IF_MMCSD_ERASE_GROUP_SIZE = IF_PARAMETER_END,
-  /** Erase sector using 32-bit address. Parameter type is \p uint32_t. */
+  /**
+   * Erase sector using 32-bit address. Parameter type is \p uint32_t.
+   * Command fails with \p E_BUSY while the request queue is running.
+   */
   IF_MMCSD_ERASE,
-  /** Erase sector using 64-bit address. Parameter type is \p uint64_t. */
-  IF_MMCSD_ERASE_64
+  /**
+   * Erase sector using 64-bit address. Parameter type is \p uint64_t.
+   * Command fails with \p E_BUSY while the request queue is running.
+   */
+  IF_MMCSD_ERASE_64,
+  /**
+   * Write the contents of the device cache to the memory array.
+   * Command completes immediately when the cache is not enabled and fails
+   * with \p E_BUSY while the request queue is running.
+   */
+  IF_MMCSD_FLUSH,
+  /**
+   * Number of requests in the request queue, including requests being
+   * transferred. Parameter type is \p uint32_t.
+   */
+  IF_MMCSD_QUEUE_DEPTH,
+  /**
+   * Average service time of completed queued requests in microseconds.
+   * Available only when the timer is configured. Parameter type
+   * is \p uint32_t.
+   */
+  IF_MMCSD_SERVICE_TIME
+};
+
+struct MMCSDRequest
+{
+  /** Mandatory: function called after completion of the request. */
+  void (*callback)(void *, enum Result);
+  /** Optional: argument for the callback function. */
+  void *argument;
+  /** Mandatory: pointer to a data buffer. */
+  void *buffer;
+  /** Mandatory: position on the card in bytes, aligned to a block size. */
+  uint64_t position;
+  /** Mandatory: request length in bytes, multiple of a block size. */
+  size_t length;
+  /** Mandatory: write data to the card when set, read otherwise. */
+  bool write;
 };
 
 struct MMCSDConfig
 {
   /** Mandatory: hardware interface. */
   void *interface;
+  /**
+   * Optional: free-running timer with a full 32-bit range for service
+   * time measurement.
+   */
+  void *timer;
+  /**
+   * Optional: size of the buffer for merging of requests with
+   * non-contiguous data buffers. Only requests with adjacent data buffers
+   * are merged when the buffer is not used.
+   */
+  size_t merge;
+  /**
+   * Optional: capacity of the request queue. Read and write functions are
+   * served by the request queue when it is enabled.
+   */
+  size_t requests;
+  /** Optional: enable the volatile write cache of eMMC devices. */
+  bool cache;
   /** Optional: enable integrity checking for all transfers. */
   bool crc;
+  /**
+   * Optional: announce the length of multiple block transfers in advance.
+   * Block count is set with the CMD23 command when it is supported by
+   * the card and SD cards are asked to pre-erase blocks before writes.
+   */
+  bool predefined;
 };
 
 struct MMCSD
@@ -39,12 +105,16 @@ struct MMCSD
 
   /* Hardware interface */
   struct Interface *interface;
+  /* Timer for service time measurement */
+  struct Timer *timer;
   /* Subclass of the hardware interface */
   uint8_t mode;
   /* Enable blocking mode */
   bool blocking;
   /* Enable integrity checking */
   bool crc;
+  /* Announce the length of multiple block transfers */
+  bool predefined;
 
   struct
   {
@@ -58,6 +128,10 @@ struct MMCSD
     uint8_t capacityType;
     /* Memory card type */
     uint8_t cardType;
+    /* Block count can be set before multiple block transfers */
+    bool count;
+    /* Volatile write cache is enabled */
+    bool cache;
   } info;
 
   struct
@@ -77,7 +151,52 @@ struct MMCSD
     uint8_t state;
     /* Send stop command after current data transfer */
     bool autostop;
+    /* Set the block count before the data transfer */
+    bool count;
+    /* Set the number of blocks to be pre-erased before the data transfer */
+    bool erase;
   } transfer;
+
+  struct
+  {
+    /* Pending requests sorted by position */
+    PointerArray pending;
+    /* Requests served by the current transfer */
+    PointerArray active;
+    /* Request for read and write functions */
+    struct MMCSDRequest local;
+
+    /* Buffer for merged requests */
+    uint8_t *buffer;
+    /* Size of the merge buffer */
+    size_t capacity;
+
+    /* Position following the last served request */
+    uint64_t head;
+    /* Summary service time in timer ticks */
+    uint64_t time;
+    /* Number of completed requests */
+    uint32_t completed;
+    /* Timer value at the start of the current transfer */
+    uint32_t timestamp;
+
+    /* Status of the request for read and write functions */
+    volatile uint8_t status;
+    /* Current transfer uses the merge buffer */
+    bool bounce;
+    /* Requests are being dispatched in the current context */
+    bool dispatching;
+    /* Request queue is enabled */
+    bool enabled;
+    /* Request queue owns the bus or is reserved by a card command */
+    bool running;
+  } queue;
 };
 /*----------------------------------------------------------------------------*/
+BEGIN_DECLS
+
+enum Result mmcsdEnqueue(void *, struct MMCSDRequest *);
+
+END_DECLS
+/*----------------------------------------------------------------------------*/
 #endif /* HALM_GENERIC_MMCSD_H_ */
@@ -26,6 +26,12 @@
 #define MMC_HS_TIMING_HS                0x00000100UL
 #define MMC_HS_TIMING_HS200             0x00000200UL
 #define MMC_HS_TIMING_HS400             0x00000300UL
+
+#define MMC_CACHE_CTRL_PATTERN          0x03210000UL
+#define MMC_CACHE_CTRL_ENABLE           0x00000100UL
+
+#define MMC_FLUSH_CACHE_PATTERN         0x03200000UL
+#define MMC_FLUSH_CACHE_FLUSH           0x00000100UL
 /*------------------CMD8------------------------------------------------------*/
 #define CMD8_CONDITION_PATTERN          0x000001AAUL
 #define CMD8_RETRY_DELAY                10000
@@ -34,6 +40,8 @@
 /*------------------ACMD6-----------------------------------------------------*/
 #define ACMD6_BUS_WIDTH_1BIT            0x00000000UL
 #define ACMD6_BUS_WIDTH_4BIT            0x00000002UL
+/*------------------ACMD23----------------------------------------------------*/
+#define ACMD23_BLOCK_COUNT_MASK         0x007FFFFFUL
 /*------------------ACMD41----------------------------------------------------*/
 #define ACMD41_RETRY_DELAY              10000
 /*------------------OCR register----------------------------------------------*/
@@ -55,6 +63,15 @@
 
 /* SD: Card Capacity Status */
 #define OCR_SD_CCS                      BIT(30)
+/*------------------SCR register----------------------------------------------*/
+#define SCR_SIZE                        8
+
+/* Support of the CMD23 command, bit 33 of the register */
+#define SCR_CMD23_SUPPORT               BIT(1)
+/*------------------Extended CSD register-------------------------------------*/
+#define EXT_CSD_SEC_COUNT               212
+#define EXT_CSD_HC_ERASE_GRP_SIZE       224
+#define EXT_CSD_CACHE_SIZE              249
 /*----------------------------------------------------------------------------*/
 enum MMCSDCommand
 {
@@ -68,6 +85,7 @@ enum MMCSDCommand
   CMD16_SET_BLOCKLEN          = 16,
   CMD17_READ_SINGLE_BLOCK     = 17,
   CMD18_READ_MULTIPLE_BLOCK   = 18,
+  CMD23_SET_BLOCK_COUNT       = 23,
   CMD24_WRITE_BLOCK           = 24,
   CMD25_WRITE_MULTIPLE_BLOCK  = 25,
   CMD35_ERASE_GROUP_START     = 35,
@@ -83,6 +101,13 @@ enum MMCSDCommand
   CMD6_SWITCH                 = 6,
   CMD8_SEND_EXT_CSD           = 8,
 
+  /* Commands available only for SD cards */
+  CMD6_SWITCH_FUNC            = 6,
+  CMD32_ERASE_WR_BLK_START    = 32,
+  CMD33_ERASE_WR_BLK_END      = 33,
+  ACMD23_SET_WR_BLK_ERASE_COUNT = 23,
+  ACMD51_SEND_SCR             = 51,
+
   /* Commands available only in SDIO mode */
   CMD2_ALL_SEND_CID           = 2,
   CMD3_SEND_RELATIVE_ADDR     = 3,
@@ -0,0 +1,103 @@
+/*
+ * halm/generic/nor_flash.h
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the MIT License
+ */
+
+/**
+ * @file
+ * Generic driver for serial NOR flash memories with SFDP tables.
+ */
+
+#ifndef HALM_GENERIC_NOR_FLASH_H_
+#define HALM_GENERIC_NOR_FLASH_H_
+/*----------------------------------------------------------------------------*/
+#include <halm/generic/spim.h>
+#include <stdint.h>
+/*----------------------------------------------------------------------------*/
+extern const struct InterfaceClass * const NorFlash;
+
+enum [[gnu::packed]] NorFlashReadMode
+{
+  NOR_FLASH_READ_1_1_1,
+  NOR_FLASH_READ_1_1_1_FAST,
+  NOR_FLASH_READ_1_1_1_DTR,
+  NOR_FLASH_READ_1_1_2,
+  NOR_FLASH_READ_1_2_2,
+  NOR_FLASH_READ_1_2_2_DTR,
+  NOR_FLASH_READ_1_1_4,
+  NOR_FLASH_READ_1_4_4,
+  NOR_FLASH_READ_1_4_4_DTR
+};
+
+struct NorFlashConfig
+{
+  /** Mandatory: memory interface. */
+  void *spim;
+  /**
+   * Optional: enable DTR read modes. Dummy cycle counts of DTR commands
+   * are assumed to be equal to the counts of corresponding SDR commands.
+   */
+  bool dtr;
+  /**
+   * Optional: read data in memory-mapped mode. Interface is switched
+   * to the indirect mode during program and erase operations, therefore
+   * code must not be executed from the same memory.
+   */
+  bool xip;
+};
+
+struct NorFlash
+{
+  struct Interface base;
+
+  void (*callback)(void *);
+  void *callbackArgument;
+
+  /* Memory interface */
+  void *spim;
+  /* Address of the memory-mapped region */
+  uintptr_t window;
+
+  /* Read command selected using the SFDP table */
+  struct SpimCommand read;
+
+  /* Memory capacity in bytes */
+  uint32_t capacity;
+  /* Current position */
+  uint32_t position;
+  /* Size of the largest erase unit, zero when only one unit is available */
+  uint32_t blockSize;
+  /* Size of the smallest erase unit */
+  uint32_t sectorSize;
+  /* Size of the program page */
+  uint32_t pageSize;
+
+  /* Block erase command */
+  uint8_t blockErase;
+  /* Sector erase command */
+  uint8_t sectorErase;
+  /* Erase suspend command, zero when suspend is not supported */
+  uint8_t suspendCode;
+  /* Erase resume command */
+  uint8_t resumeCode;
+  /* Address length in bytes */
+  uint8_t width;
+  /* Selected read mode */
+  enum NorFlashReadMode mode;
+
+  /* Wait for completion of erase operations */
+  bool blocking;
+  /* Zero-copy operation of the memory interface is in progress */
+  bool busy;
+  /* Erase operation is in progress */
+  bool erasing;
+  /* Memory interface is in the memory-mapped mode */
+  bool mapped;
+  /* Erase operation is suspended */
+  bool suspended;
+  /* Read data in memory-mapped mode */
+  bool xip;
+};
+/*----------------------------------------------------------------------------*/
+#endif /* HALM_GENERIC_NOR_FLASH_H_ */
@@ -0,0 +1,136 @@
+/*
+ * halm/generic/nor_flash_defs.h
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the MIT License
+ */
+
+#ifndef HALM_GENERIC_NOR_FLASH_DEFS_H_
+#define HALM_GENERIC_NOR_FLASH_DEFS_H_
+/*----------------------------------------------------------------------------*/
+#include <xcore/bits.h>
+/*------------------Commands--------------------------------------------------*/
+#define CMD_WRITE_STATUS                0x01
+#define CMD_PAGE_PROGRAM                0x02
+#define CMD_READ                        0x03
+#define CMD_READ_STATUS                 0x05
+#define CMD_WRITE_ENABLE                0x06
+#define CMD_FAST_READ                   0x0B
+#define CMD_FAST_READ_DTR               0x0D
+#define CMD_WRITE_STATUS_2              0x31
+#define CMD_READ_STATUS_2               0x35
+#define CMD_WRITE_STATUS_2_ALT          0x3E
+#define CMD_READ_STATUS_2_ALT           0x3F
+#define CMD_READ_SFDP                   0x5A
+#define CMD_RELEASE_POWER_DOWN          0xAB
+#define CMD_ENTER_4B_ADDRESS            0xB7
+#define CMD_POWER_DOWN                  0xB9
+#define CMD_FAST_READ_DUAL_IO_DTR       0xBD
+#define CMD_FAST_READ_QUAD_IO_DTR       0xED
+/*------------------Status registers------------------------------------------*/
+#define SR1_WIP                         BIT(0)
+#define SR1_QE                          BIT(6)
+#define SR2_QE                          BIT(1)
+#define SR2_QE_ALT                      BIT(7)
+/*------------------SFDP header-----------------------------------------------*/
+#define SFDP_SIGNATURE                  0x50444653UL
+#define SFDP_HEADER_SIZE                8
+#define SFDP_PARAMETER_HEADER_SIZE      8
+#define SFDP_BFPT_ID                    0xFF00
+#define SFDP_BFPT_MAJOR                 1
+#define SFDP_BFPT_MAX_DWORDS            16
+#define SFDP_ADDRESS_LENGTH             3
+#define SFDP_DUMMY_BYTES                1
+
+#define SFDP_HEADER_NPH                 6
+
+#define SFDP_PARAMETER_ID_LSB           0
+#define SFDP_PARAMETER_MAJOR            2
+#define SFDP_PARAMETER_LENGTH           3
+#define SFDP_PARAMETER_POINTER          4
+#define SFDP_PARAMETER_ID_MSB           7
+/*------------------Basic Flash Parameter Table, DWORD 1----------------------*/
+#define BFPT_ERASE_4K_MASK              BIT_FIELD(MASK(2), 0)
+#define BFPT_ERASE_4K_SUPPORTED         BIT_FIELD(1, 0)
+
+#define BFPT_ERASE_4K_OPCODE_MASK       BIT_FIELD(MASK(8), 8)
+#define BFPT_ERASE_4K_OPCODE_VALUE(reg) \
+    FIELD_VALUE((reg), BFPT_ERASE_4K_OPCODE_MASK, 8)
+
+#define BFPT_FAST_READ_112              BIT(16)
+
+enum
+{
+  BFPT_ADDRESS_3B     = 0,
+  BFPT_ADDRESS_3B_4B  = 1,
+  BFPT_ADDRESS_4B     = 2
+};
+
+#define BFPT_ADDRESS_MASK               BIT_FIELD(MASK(2), 17)
+#define BFPT_ADDRESS_VALUE(reg) \
+    FIELD_VALUE((reg), BFPT_ADDRESS_MASK, 17)
+
+#define BFPT_DTR                        BIT(19)
+#define BFPT_FAST_READ_122              BIT(20)
+#define BFPT_FAST_READ_144              BIT(21)
+#define BFPT_FAST_READ_114              BIT(22)
+/*------------------Basic Flash Parameter Table, DWORD 2----------------------*/
+#define BFPT_DENSITY_EXPONENT           BIT(31)
+#define BFPT_DENSITY_MASK               BIT_FIELD(MASK(31), 0)
+/*------------------Basic Flash Parameter Table, DWORDs 3 and 4---------------*/
+/* Fast read parameters are packed into 16-bit halves of the DWORD */
+#define BFPT_READ_144_OFFSET            0
+#define BFPT_READ_114_OFFSET            16
+#define BFPT_READ_112_OFFSET            0
+#define BFPT_READ_122_OFFSET            16
+
+#define BFPT_READ_WAIT_VALUE(reg, offset) \
+    FIELD_VALUE((reg) >> (offset), MASK(5), 0)
+#define BFPT_READ_MODE_VALUE(reg, offset) \
+    FIELD_VALUE((reg) >> (offset), BIT_FIELD(MASK(3), 5), 5)
+#define BFPT_READ_OPCODE_VALUE(reg, offset) \
+    FIELD_VALUE((reg) >> (offset), BIT_FIELD(MASK(8), 8), 8)
+/*------------------Basic Flash Parameter Table, DWORDs 8 and 9---------------*/
+/* Erase types are packed into 16-bit halves of the DWORD */
+#define BFPT_ERASE_SIZE_VALUE(reg, offset) \
+    FIELD_VALUE((reg) >> (offset), MASK(8), 0)
+#define BFPT_ERASE_OPCODE_VALUE(reg, offset) \
+    FIELD_VALUE((reg) >> (offset), BIT_FIELD(MASK(8), 8), 8)
+/*------------------Basic Flash Parameter Table, DWORD 11---------------------*/
+#define BFPT_PAGE_SIZE_MASK             BIT_FIELD(MASK(4), 4)
+#define BFPT_PAGE_SIZE_VALUE(reg) \
+    FIELD_VALUE((reg), BFPT_PAGE_SIZE_MASK, 4)
+/*------------------Basic Flash Parameter Table, DWORD 12---------------------*/
+#define BFPT_SUSPEND_UNSUPPORTED        BIT(31)
+/*------------------Basic Flash Parameter Table, DWORD 13---------------------*/
+#define BFPT_ERASE_RESUME_OPCODE_MASK   BIT_FIELD(MASK(8), 16)
+#define BFPT_ERASE_RESUME_OPCODE_VALUE(reg) \
+    FIELD_VALUE((reg), BFPT_ERASE_RESUME_OPCODE_MASK, 16)
+
+#define BFPT_ERASE_SUSPEND_OPCODE_MASK  BIT_FIELD(MASK(8), 24)
+#define BFPT_ERASE_SUSPEND_OPCODE_VALUE(reg) \
+    FIELD_VALUE((reg), BFPT_ERASE_SUSPEND_OPCODE_MASK, 24)
+/*------------------Basic Flash Parameter Table, DWORD 15---------------------*/
+enum
+{
+  /* Device does not have a Quad Enable bit */
+  BFPT_QER_NONE               = 0,
+  /* Bit 1 of SR2, written with two bytes, SR2 can not be read */
+  BFPT_QER_SR2_BIT1_NO_READ   = 1,
+  /* Bit 6 of SR1, written with one byte */
+  BFPT_QER_SR1_BIT6           = 2,
+  /* Bit 7 of SR2, accessed with 3Eh and 3Fh commands */
+  BFPT_QER_SR2_BIT7           = 3,
+  /* Bit 1 of SR2, written with two bytes, one byte write keeps SR2 */
+  BFPT_QER_SR2_BIT1_KEEP      = 4,
+  /* Bit 1 of SR2, written with two bytes */
+  BFPT_QER_SR2_BIT1           = 5,
+  /* Bit 1 of SR2, written with 31h command */
+  BFPT_QER_SR2_BIT1_DIRECT    = 6
+};
+
+#define BFPT_QER_MASK                   BIT_FIELD(MASK(3), 20)
+#define BFPT_QER_VALUE(reg)             FIELD_VALUE((reg), BFPT_QER_MASK, 20)
+/*------------------Basic Flash Parameter Table, DWORD 16---------------------*/
+#define BFPT_ENTER_4B_B7                BIT(24)
+/*----------------------------------------------------------------------------*/
+#endif /* HALM_GENERIC_NOR_FLASH_DEFS_H_ */
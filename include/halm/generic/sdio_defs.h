@@ -42,5 +42,26 @@ enum CardState
     BIT_FIELD(MASK(4), 9)
 #define CURRENT_STATE(response) \
     FIELD_VALUE((response), CURRENT_STATE_MASK, 9)
+/*------------------Card status bits in R1 response---------------------------*/
+#define CARD_STATUS_ERROR               BIT(19)
+#define CARD_STATUS_CC_ERROR            BIT(20)
+#define CARD_STATUS_ECC_FAILED          BIT(21)
+#define CARD_STATUS_ILLEGAL_COMMAND     BIT(22)
+#define CARD_STATUS_COM_CRC_ERROR       BIT(23)
+#define CARD_STATUS_WP_VIOLATION        BIT(26)
+#define CARD_STATUS_ERASE_PARAM         BIT(27)
+#define CARD_STATUS_ERASE_SEQ_ERROR     BIT(28)
+#define CARD_STATUS_BLOCK_LEN_ERROR     BIT(29)
+#define CARD_STATUS_ADDRESS_ERROR       BIT(30)
+#define CARD_STATUS_OUT_OF_RANGE        BIT(31)
+
+#define CARD_STATUS_ADDRESS_MASK \
+    (CARD_STATUS_OUT_OF_RANGE | CARD_STATUS_ADDRESS_ERROR \
+        | CARD_STATUS_ERASE_PARAM)
+#define CARD_STATUS_ERROR_MASK \
+    (CARD_STATUS_ADDRESS_MASK | CARD_STATUS_BLOCK_LEN_ERROR \
+        | CARD_STATUS_ERASE_SEQ_ERROR | CARD_STATUS_WP_VIOLATION \
+        | CARD_STATUS_COM_CRC_ERROR | CARD_STATUS_ILLEGAL_COMMAND \
+        | CARD_STATUS_ECC_FAILED | CARD_STATUS_CC_ERROR | CARD_STATUS_ERROR)
 /*----------------------------------------------------------------------------*/
 #endif /* HALM_GENERIC_SDIO_DEFS_H_ */
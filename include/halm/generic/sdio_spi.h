@@ -32,6 +32,14 @@ struct SdioSpiConfig
    * single transfer.
    */
   size_t blocks;
+  /**
+   * Optional: length of bursts used to wait for data tokens and for the end
+   * of the busy state. Bytes following the token are reused as the beginning
+   * of the data block. Polling is performed byte-by-byte when the length
+   * is zero. When the timer is configured, delays between polls are doubled
+   * while the card stays busy. Card timeouts do not depend on the length.
+   */
+  size_t burst;
   /** Mandatory: chip select pin. */
   PinNumber cs;
 };
@@ -58,6 +66,24 @@ struct SdioSpi
     size_t capacity;
   } crc;
 
+  struct
+  {
+    /* Buffer for polling bursts */
+    uint8_t *buffer;
+    /* Buffer size, zero when polling bursts are disabled */
+    size_t capacity;
+    /* Initial timer overflow for delays between polls */
+    uint32_t period;
+    /* Length of the last burst */
+    uint16_t length;
+    /* Position of the first byte following the token */
+    uint16_t offset;
+    /* Number of received bytes following the token */
+    uint16_t count;
+    /* Current backoff step of delays between polls */
+    uint8_t backoff;
+  } scan;
+
   struct
   {
     /* Address of an input or output buffer */
@@ -14,6 +14,33 @@
 /*----------------------------------------------------------------------------*/
 #include <halm/generic/qspi.h>
 /*----------------------------------------------------------------------------*/
+enum SPIMCommandFlags
+{
+  /** Enable operation code phase. */
+  SPIM_OPCODE           = 0x0001,
+  /** Enable parallel mode for operation code phase. */
+  SPIM_OPCODE_PARALLEL  = 0x0002,
+  /** Enable parallel mode for address phase. */
+  SPIM_ADDRESS_PARALLEL = 0x0004,
+  /** Enable post-address phase. */
+  SPIM_POST             = 0x0008,
+  /** Enable parallel mode for post-address phase. */
+  SPIM_POST_PARALLEL    = 0x0010,
+  /** Enable parallel mode for dummy-cycles phase. */
+  SPIM_DELAY_PARALLEL   = 0x0020,
+  /** Enable parallel mode for data phase. */
+  SPIM_DATA_PARALLEL    = 0x0040,
+  /**
+   * Enable the poll mode. Hardware polls the memory until the bit
+   * with an index stored in the length field becomes cleared.
+   */
+  SPIM_POLL             = 0x0080,
+  /** Write data to the memory, used in command sequences. */
+  SPIM_WRITE            = 0x0100,
+  /** Command was validated and prepared by the interface. */
+  SPIM_PREPARED         = 0x8000
+};
+
 enum SPIMParameter
 {
   /**
@@ -105,8 +132,63 @@ enum SPIMParameter
   /** Command response. Parameter type is \p uint32_t. */
   IF_SPIM_RESPONSE,
 
+  /**
+   * Validate a command descriptor and store a platform-specific
+   * representation of the command in the descriptor. Prepared descriptors
+   * are loaded without additional checks. Descriptor should be prepared
+   * again after changes of any field except the address, the length and
+   * the buffer. Parameter type is \p struct \p SpimCommand.
+   */
+  IF_SPIM_PREPARE,
+  /**
+   * Load all phases of a command from a descriptor, the command is executed
+   * by a next read or write operation. Parameter type is
+   * \p struct \p SpimCommand.
+   */
+  IF_SPIM_LOAD,
+  /**
+   * Execute a sequence of commands without returning to the caller.
+   * The sequence is stopped on the first error, completion is signaled
+   * as for a single command. Commands should stay valid until the end
+   * of the sequence. Parameter type is \p struct \p SpimSequence.
+   */
+  IF_SPIM_SEQUENCE,
+
   /** End of the list. */
   IF_SPIM_PARAMETER_END
 };
+
+struct SpimCommand
+{
+  /** Data buffer, used only in command sequences. */
+  void *buffer;
+  /** Memory address. */
+  uint32_t address;
+  /** Number of data bytes or an index of the polling bit in poll mode. */
+  uint32_t length;
+  /** Platform-specific representation of the command. */
+  uint32_t prepared;
+  /**
+   * Command flags, possible values are defined in
+   * the \p enum \p SPIMCommandFlags.
+   */
+  uint16_t flags;
+  /** Operation code. */
+  uint8_t code;
+  /** Length of the address in bytes, zero to disable address phase. */
+  uint8_t width;
+  /** Post-address value. */
+  uint8_t post;
+  /** Number of delay or dummy bytes. */
+  uint8_t delay;
+};
+
+struct SpimSequence
+{
+  /** Array of commands. */
+  const struct SpimCommand *commands;
+  /** Number of commands in the array. */
+  size_t count;
+};
 /*----------------------------------------------------------------------------*/
 #endif /* HALM_GENERIC_SPIM_H_ */
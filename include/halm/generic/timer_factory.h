@@ -38,6 +38,25 @@ BEGIN_DECLS
 
 void *timerFactoryCreate(void *);
 
+/**
+ * Get time until the next interrupt of the base timer.
+ * @param factory Pointer to a timer factory object.
+ * @return Number of base timer ticks before the next wake-up.
+ */
+uint32_t timerFactoryGetDeadline(const void *factory);
+
+/**
+ * Move the next interrupt of the base timer ahead of the nearest timer
+ * expiration to compensate wake-up latency of low-power modes.
+ * Function should be called with interrupts disabled.
+ * @param factory Pointer to a timer factory object.
+ * @param advance Number of base timer ticks, zero value restores
+ * the original wake-up time.
+ * @return @b E_OK on success, @b E_INVALID when the factory does not support
+ * early wake-up and @b E_VALUE or @b E_BUSY when the deadline is too close.
+ */
+enum Result timerFactorySetWakeup(void *factory, uint32_t advance);
+
 END_DECLS
 /*----------------------------------------------------------------------------*/
 #endif /* HALM_GENERIC_TIMER_FACTORY_H_ */
@@ -15,6 +15,24 @@ struct WorkQueueConfig
 {
   /** Mandatory: number of queued tasks. */
   size_t size;
+  /**
+   * Optional: number of delayed and periodic tasks. Delayed tasks are not
+   * supported when the value is zero.
+   */
+  size_t delayed;
+  /**
+   * Optional: timer for delayed tasks, mandatory when delayed tasks are
+   * enabled. The timer should be configured for periodic interrupt
+   * generation, the period of the timer determines a resolution of delays.
+   * The timer is stopped when no delayed tasks are pending.
+   */
+  void *timer;
+  /**
+   * Optional: idle coordinator that selects the low-power state when
+   * the work queue is empty. Sleep mode is used when the coordinator
+   * is not provided.
+   */
+  void *idle;
 };
 /*----------------------------------------------------------------------------*/
 #endif /* HALM_GENERIC_WORK_QUEUE_H_ */
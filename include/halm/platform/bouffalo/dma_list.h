@@ -38,6 +38,8 @@ struct DmaList
   size_t index;
   /* Current size of the list */
   size_t queued;
+  /* Number of items in the last descriptor chain */
+  size_t length;
 
   /* Control register value */
   uint32_t control;
@@ -0,0 +1,26 @@
+/*
+ * halm/platform/generic/can.h
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the MIT License
+ */
+
+#ifndef HALM_PLATFORM_GENERIC_CAN_H_
+#define HALM_PLATFORM_GENERIC_CAN_H_
+/*----------------------------------------------------------------------------*/
+#include <halm/generic/can.h>
+/*----------------------------------------------------------------------------*/
+extern const struct InterfaceClass * const Can;
+
+struct CanConfig
+{
+  /** Mandatory: name of the SocketCAN network interface, e.g. "vcan0". */
+  const char *device;
+  /** Optional: number of filtering rules. */
+  size_t filters;
+  /** Mandatory: input queue size. */
+  size_t rxBuffers;
+  /** Optional: enable reception and transmission of CAN FD frames. */
+  bool fd;
+};
+/*----------------------------------------------------------------------------*/
+#endif /* HALM_PLATFORM_GENERIC_CAN_H_ */
@@ -14,9 +14,10 @@ struct Pin
 /*----------------------------------------------------------------------------*/
 BEGIN_DECLS
 
-static inline struct Pin pinInit(PinNumber)
+static inline struct Pin pinInit(PinNumber number)
 {
-  return (struct Pin){-1};
+  /* Pins are virtual, all used pins are valid and operations do nothing */
+  return (struct Pin){number ? 0 : -1};
 }
 
 static inline void pinInput(struct Pin)
@@ -49,9 +50,9 @@ static inline void pinToggle(struct Pin)
 {
 }
 
-static inline bool pinValid(struct Pin)
+static inline bool pinValid(struct Pin pin)
 {
-  return false;
+  return pin.handle != -1;
 }
 
 static inline void pinWrite(struct Pin, bool)
@@ -0,0 +1,68 @@
+/*
+ * halm/platform/generic/sd_card_emulator.h
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the MIT License
+ */
+
+#ifndef HALM_PLATFORM_GENERIC_SD_CARD_EMULATOR_H_
+#define HALM_PLATFORM_GENERIC_SD_CARD_EMULATOR_H_
+/*----------------------------------------------------------------------------*/
+#include <halm/generic/sdio.h>
+#include <stdint.h>
+/*----------------------------------------------------------------------------*/
+extern const struct InterfaceClass * const SdCardEmulator;
+
+struct SdCardEmulatorProfile
+{
+  /** Delay between a command and a response in microseconds. */
+  uint32_t command;
+  /** Access time before the first block of a read in microseconds. */
+  uint32_t access;
+  /** Programming time of each written block in microseconds. */
+  uint32_t program;
+  /**
+   * Programming time of each block pre-erased with the ACMD23 command
+   * in microseconds. Regular programming time is used when it is zero.
+   * Pre-erased blocks do not cause programming stalls.
+   */
+  uint32_t erased;
+  /** Duration of an erase operation in microseconds. */
+  uint32_t erase;
+  /**
+   * Busy time after the end of an open-ended multiple block write
+   * in microseconds.
+   */
+  uint32_t stop;
+  /** Period of long programming stalls in blocks, zero to disable stalls. */
+  uint32_t stallPeriod;
+  /** Duration of a programming stall in microseconds. */
+  uint32_t stall;
+};
+
+struct SdCardEmulatorConfig
+{
+  /** Mandatory: path to the card image file. */
+  const char *path;
+  /**
+   * Optional: timing profile. Commands and transfers are completed
+   * immediately in the context of the caller when the profile is not set.
+   * Otherwise completion callbacks are called from a worker thread after
+   * the emulated bus transfer time and profile delays.
+   */
+  const struct SdCardEmulatorProfile *profile;
+  /**
+   * Optional: card capacity in bytes. The image file is created or extended
+   * to the requested size. Size of the existing image is used when
+   * the capacity is zero. Capacity is rounded down to the nearest value
+   * that can be described by the CSD register.
+   */
+  uint64_t capacity;
+  /** Optional: initial bus rate, default rate is 25 MHz. */
+  uint32_t rate;
+  /** Optional: emulate standard capacity card with byte addressing. */
+  bool sdsc;
+  /** Optional: enable 4-bit data bus. */
+  bool wide;
+};
+/*----------------------------------------------------------------------------*/
+#endif /* HALM_PLATFORM_GENERIC_SD_CARD_EMULATOR_H_ */
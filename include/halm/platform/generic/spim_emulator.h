@@ -0,0 +1,57 @@
+/*
+ * halm/platform/generic/spim_emulator.h
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the MIT License
+ */
+
+#ifndef HALM_PLATFORM_GENERIC_SPIM_EMULATOR_H_
+#define HALM_PLATFORM_GENERIC_SPIM_EMULATOR_H_
+/*----------------------------------------------------------------------------*/
+#include <halm/generic/spim.h>
+#include <stdint.h>
+/*----------------------------------------------------------------------------*/
+extern const struct InterfaceClass * const SpimEmulator;
+
+struct SpimEmulatorProfile
+{
+  /** Programming time of a page in microseconds. */
+  uint32_t program;
+  /** Erase time of a 4 KiB sector in microseconds. */
+  uint32_t sector;
+  /** Erase time of a 32 KiB or 64 KiB block in microseconds. */
+  uint32_t block;
+  /** Erase time of the whole memory in microseconds. */
+  uint32_t chip;
+  /** Write time of the status registers in microseconds. */
+  uint32_t status;
+  /** Latency of the erase suspend command in microseconds. */
+  uint32_t suspend;
+  /**
+   * Time in microseconds after the erase resume command during which
+   * the erase operation makes no progress.
+   */
+  uint32_t resume;
+};
+
+struct SpimEmulatorConfig
+{
+  /**
+   * Mandatory: memory capacity in bytes. Capacity should be a power of two
+   * in the range from 64 KiB to 256 MiB. Memories larger than 16 MiB use
+   * 4-byte addressing.
+   */
+  uint32_t capacity;
+  /**
+   * Optional: timing profile. Program and erase operations are completed
+   * immediately when the profile is not set. Otherwise the memory stays
+   * busy for the time defined by the profile and poll commands wait
+   * for the completion of the operation.
+   */
+  const struct SpimEmulatorProfile *profile;
+  /** Optional: enable DTR read commands. */
+  bool dtr;
+  /** Optional: connect IO2 and IO3 lines to enable Quad I/O modes. */
+  bool wide;
+};
+/*----------------------------------------------------------------------------*/
+#endif /* HALM_PLATFORM_GENERIC_SPIM_EMULATOR_H_ */
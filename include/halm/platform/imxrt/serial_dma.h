@@ -19,7 +19,8 @@ struct SerialDmaConfig
   /**
    * Optional: memory buffer for transmit and receive queues. Queues will be
    * allocated on the heap when the pointer is set to zero.
-   * Pointer address should be aligned.
+   * Pointer address should be aligned. Cache maintenance of the output
+   * queue is skipped when the memory belongs to a coherent memory region.
    */
   void *arena;
   /** Mandatory: input buffer length. */
@@ -42,6 +42,8 @@ struct SdmaList
   size_t index;
   /* Current size of the list */
   size_t queued;
+  /* Number of items in the last descriptor chain */
+  size_t length;
 
   /* Transfer configuration register value */
   uint32_t transferConfig;
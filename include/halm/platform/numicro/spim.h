@@ -85,51 +85,16 @@ struct Spim
 
   struct
   {
-    /* Requested address */
-    uint32_t value;
-    /* Length of the address field */
-    uint8_t length;
-    /* Enable serial mode for address field */
-    bool serial;
-  } address;
+    /* Remaining commands of the sequence */
+    const struct SpimCommand *commands;
+    /* Number of remaining commands */
+    size_t count;
+  } sequence;
 
-  struct
-  {
-    /* Length of the command field */
-    uint8_t length;
-    /* Requested command code */
-    uint8_t value;
-    /* Enable serial mode for command field */
-    bool serial;
-  } command;
-
-  struct
-  {
-    /* Number of dummy bytes */
-    uint8_t length;
-    /* Enable serial mode for dummy bytes */
-    bool serial;
-  } delay;
-
-  struct
-  {
-    /* Length of the post-address field */
-    uint8_t length;
-    /* Post-address value */
-    uint8_t value;
-    /* Enable serial mode for the post-address field */
-    bool serial;
-  } post;
-
-  struct
-  {
-    /* Number of data bytes */
-    uint32_t length;
-    /* Command response */
-    uint8_t response;
-    /* Enable serial mode for data */
-    bool serial;
-  } data;
+  /* Current command */
+  struct SpimCommand command;
+  /* Command response */
+  uint8_t response;
 
   /* Operation status */
   uint8_t status;
@@ -139,8 +104,6 @@ struct Spim
   bool ddr;
   /* Memory-mapping mode flag */
   bool memmap;
-  /* Polling mode flag */
-  bool poll;
 
   /* Enable Quad I/O mode */
   bool quad;
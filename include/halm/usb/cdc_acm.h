@@ -44,6 +44,12 @@ struct CdcAcmConfig
    * 64 bytes for full-speed devices and 512 bytes for high-speed devices.
    */
   void *arena;
+  /**
+   * Optional: block pool for request descriptors and buffers. Memory is
+   * allocated on the heap when the pool is not provided. Block alignment
+   * of the pool should satisfy the alignment of USB buffers.
+   */
+  void *pool;
   /** Mandatory: number of receive buffers. */
   size_t rxBuffers;
   /** Mandatory: number of transmit buffers. */
@@ -56,6 +56,19 @@ struct WqTaskInfo
 
 typedef void (*WqProfileCallback)(void *, const struct WqTaskInfo *);
 
+struct WqDelayedTask
+{
+  void (*callback)(void *);
+  void *argument;
+
+  /* Expiration time in ticks of the work queue timer */
+  uint32_t timestamp;
+  /* Period of the task in ticks, zero for a single-shot task */
+  uint32_t period;
+  /* Position in the list of deadlines */
+  size_t index;
+};
+
 /* Class descriptor */
 struct WorkQueueClass
 {
@@ -66,6 +79,10 @@ struct WorkQueueClass
   void (*statistics)(void *, struct WqInfo *);
   enum Result (*start)(void *);
   void (*stop)(void *);
+
+  enum Result (*schedule)(void *, struct WqDelayedTask *, void (*)(void *),
+      void *, uint32_t, uint32_t);
+  void (*cancel)(void *, struct WqDelayedTask *);
 };
 
 struct WorkQueue
@@ -89,6 +106,71 @@ static inline enum Result wqAdd(void *wq, void (*callback)(void *),
       argument);
 }
 
+/**
+ * Add a task to the work queue after a delay.
+ * Task descriptor is owned by the caller and must remain valid until
+ * the task is executed or cancelled. Scheduling of an already scheduled
+ * descriptor restarts the delay. Delayed tasks are executed in the context
+ * of the work queue without an intermediate interrupt handler.
+ * @param wq Pointer to a Work Queue object.
+ * @param task Pointer to a task descriptor.
+ * @param callback Callback function.
+ * @param argument Callback function argument.
+ * @param delay Delay in ticks of the timer of the work queue.
+ * @return @b E_OK on success, @b E_INVALID when delayed tasks are not
+ * supported by the work queue.
+ */
+static inline enum Result wqAddDelayed(void *wq, struct WqDelayedTask *task,
+    void (*callback)(void *), void *argument, uint32_t delay)
+{
+  const struct WorkQueueClass * const type =
+      (const struct WorkQueueClass *)CLASS(wq);
+
+  if (type->schedule != NULL)
+    return type->schedule(wq, task, callback, argument, delay, 0);
+  else
+    return E_INVALID;
+}
+
+/**
+ * Add a periodic task to the work queue.
+ * First execution of the task occurs after one period. Task descriptor
+ * is owned by the caller and must remain valid until the task is cancelled.
+ * @param wq Pointer to a Work Queue object.
+ * @param task Pointer to a task descriptor.
+ * @param callback Callback function.
+ * @param argument Callback function argument.
+ * @param period Period in ticks of the timer of the work queue.
+ * @return @b E_OK on success, @b E_INVALID when periodic tasks are not
+ * supported by the work queue.
+ */
+static inline enum Result wqAddPeriodic(void *wq, struct WqDelayedTask *task,
+    void (*callback)(void *), void *argument, uint32_t period)
+{
+  const struct WorkQueueClass * const type =
+      (const struct WorkQueueClass *)CLASS(wq);
+
+  if (type->schedule != NULL)
+    return type->schedule(wq, task, callback, argument, period, period);
+  else
+    return E_INVALID;
+}
+
+/**
+ * Cancel a delayed or periodic task.
+ * Function does nothing when the task is not scheduled.
+ * @param wq Pointer to a Work Queue object.
+ * @param task Pointer to a task descriptor.
+ */
+static inline void wqCancel(void *wq, struct WqDelayedTask *task)
+{
+  const struct WorkQueueClass * const type =
+      (const struct WorkQueueClass *)CLASS(wq);
+
+  if (type->cancel != NULL)
+    type->cancel(wq, task);
+}
+
 /**
  * Request information about execution times.
  * Function invokes user callback for each task descriptor.
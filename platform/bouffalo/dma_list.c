@@ -35,6 +35,7 @@ static enum Result channelResidue(const void *, size_t *);
 static enum Result channelStatus(const void *);
 
 static void channelAppend(void *, void *, const void *, size_t);
+static void channelAppendVector(void *, const struct DmaVector *, size_t);
 static void channelClear(void *);
 static size_t channelQueued(const void *);
 /*----------------------------------------------------------------------------*/
@@ -52,6 +53,7 @@ const struct DmaClass * const DmaList = &(const struct DmaClass){
     .status = channelStatus,
 
     .append = channelAppend,
+    .appendVector = channelAppendVector,
     .clear = channelClear,
     .queued = channelQueued
 };
@@ -149,6 +151,7 @@ static enum Result channelInit(void *object, const void *configBase)
   channel->capacity = config->number;
   channel->index = 0;
   channel->queued = 0;
+  channel->length = 0;
   channel->control = 0;
   channel->state = STATE_IDLE;
 
@@ -189,7 +192,7 @@ static enum Result channelEnable(void *object)
   const uint8_t number = channel->base.number;
   const uint32_t mask = 1 << number;
 
-  assert(channel->state == STATE_READY);
+  assert(channel->state == STATE_READY || channel->state == STATE_DONE);
 
   if (!dmaSetInstance(number, object))
   {
@@ -197,6 +200,15 @@ static enum Result channelEnable(void *object)
     return E_BUSY;
   }
 
+  /* Descriptors of the completed chain are left intact and can be reused */
+  if (channel->state == STATE_DONE)
+    channel->queued = channel->length;
+
+  size_t index = channel->index + channel->capacity - channel->queued;
+
+  if (index >= channel->capacity)
+    index -= channel->capacity;
+
   // dmaSetMux(&channel->base);
   channel->state = STATE_BUSY;
 
@@ -205,7 +217,7 @@ static enum Result channelEnable(void *object)
   BL_DMA->INTERRCLEAR = mask;
 
   /* Start the transfer */
-  startTransfer(channel, &channel->list[0]);
+  startTransfer(channel, &channel->list[index]);
 
   return E_OK;
 }
@@ -273,50 +285,72 @@ static enum Result channelStatus(const void *object)
 /*----------------------------------------------------------------------------*/
 static void channelAppend(void *object, void *destination, const void *source,
     size_t size)
+{
+  const struct DmaVector vector = {destination, source, size};
+  channelAppendVector(object, &vector, 1);
+}
+/*----------------------------------------------------------------------------*/
+static void channelAppendVector(void *object, const struct DmaVector *vector,
+    size_t count)
 {
   struct DmaList * const channel = object;
   const uint32_t control = channel->control;
-  const uint32_t transfers = size >> CONTROL_DTW_VALUE(control);
 
-  assert(destination != NULL && source != NULL);
-  assert(!((uintptr_t)destination % (1 << CONTROL_DTW_VALUE(control))));
-  assert(!(size % (1 << CONTROL_DTW_VALUE(control))));
-  assert(!((uintptr_t)source % (1 << CONTROL_STW_VALUE(control))));
-  assert(!(size % (1 << CONTROL_STW_VALUE(control))));
-  assert(transfers > 0 && transfers <= DMA_MAX_TRANSFER_SIZE);
-  assert(channel->queued < channel->capacity);
+  assert(count > 0);
 
   if (channel->state == STATE_DONE || channel->state == STATE_ERROR)
   {
     channel->index = 0;
     channel->queued = 0;
+    channel->length = 0;
   }
 
-  struct DmaEntry * const entry = channel->list + channel->index;
+  assert(channel->queued + count <= channel->capacity);
+
   struct DmaEntry *previous = NULL;
 
   if (channel->queued)
   {
     /* There are initialized entries in the list */
-    previous = channel->index ? entry : channel->list + channel->capacity;
-    --previous;
+    previous = channel->list
+        + (channel->index ? channel->index : channel->capacity) - 1;
   }
 
-  if (++channel->index >= channel->capacity)
-    channel->index = 0;
+  for (size_t position = 0; position < count; ++position)
+  {
+    const uintptr_t destination = (uintptr_t)vector[position].destination;
+    const uintptr_t source = (uintptr_t)vector[position].source;
+    const size_t size = vector[position].size;
+    const uint32_t transfers = size >> CONTROL_DTW_VALUE(control);
 
-  entry->source = (uintptr_t)source;
-  entry->destination = (uintptr_t)destination;
-  entry->control = control | CONTROL_TS(transfers);
-  entry->next = 0;
+    assert(destination != 0 && source != 0);
+    assert(!(destination % (1 << CONTROL_DTW_VALUE(control))));
+    assert(!(size % (1 << CONTROL_DTW_VALUE(control))));
+    assert(!(source % (1 << CONTROL_STW_VALUE(control))));
+    assert(!(size % (1 << CONTROL_STW_VALUE(control))));
+    assert(transfers > 0 && transfers <= DMA_MAX_TRANSFER_SIZE);
 
-  if (previous != NULL)
-  {
-    /* Link previous element with the new one */
-    previous->next = (uintptr_t)entry;
+    struct DmaEntry * const entry = channel->list + channel->index;
+
+    if (++channel->index >= channel->capacity)
+      channel->index = 0;
+
+    entry->source = source;
+    entry->destination = destination;
+    entry->control = control | CONTROL_TS(transfers);
+    entry->next = 0;
+
+    if (previous != NULL)
+    {
+      /* Link previous element with the new one */
+      previous->next = (uintptr_t)entry;
+    }
+
+    previous = entry;
+    ++channel->queued;
   }
 
-  ++channel->queued;
+  channel->length = MIN(channel->length + count, channel->capacity);
 
   if (channel->state != STATE_BUSY)
     channel->state = STATE_READY;
@@ -328,6 +362,7 @@ static void channelClear(void *object)
 
   channel->index = 0;
   channel->queued = 0;
+  channel->length = 0;
   channel->state = STATE_IDLE;
 }
 /*----------------------------------------------------------------------------*/
@@ -0,0 +1,782 @@
+/*
+ * can.c
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the MIT License
+ */
+
+#include <halm/generic/pointer_array.h>
+#include <halm/generic/pointer_queue.h>
+#include <halm/platform/generic/can.h>
+#include <xcore/containers/tg_array.h>
+#include <uv.h>
+#include <linux/can.h>
+#include <linux/can/error.h>
+#include <linux/can/raw.h>
+#include <net/if.h>
+#include <assert.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+/*----------------------------------------------------------------------------*/
+/* Maximum number of frames transferred by a single system call */
+#define BATCH_SIZE    32
+/* Ancillary data: reception time stamp and socket drop counter */
+#define CONTROL_SIZE  \
+    (CMSG_SPACE(sizeof(struct timeval)) + CMSG_SPACE(sizeof(uint32_t)))
+/*----------------------------------------------------------------------------*/
+enum Cleanup
+{
+  CLEANUP_ALL,
+  CLEANUP_SOCKET,
+  CLEANUP_FILTERS,
+  CLEANUP_ARENA,
+  CLEANUP_RX_QUEUE,
+  CLEANUP_POOL,
+  CLEANUP_LISTENER,
+  CLEANUP_MUTEX
+};
+
+enum Mode
+{
+  MODE_LISTENER,
+  MODE_ACTIVE,
+  MODE_LOOPBACK
+};
+/*----------------------------------------------------------------------------*/
+typedef struct can_filter CanFilterEntry;
+DEFINE_ARRAY(CanFilterEntry, Filter, filter)
+/*----------------------------------------------------------------------------*/
+struct PosixCan
+{
+  struct Interface base;
+
+  void (*callback)(void *);
+  void *callbackArgument;
+
+  /* Message pool */
+  PointerArray pool;
+  /* Queue for received messages */
+  PointerQueue rxQueue;
+  /* Mutex for the message pool and the receive queue */
+  pthread_mutex_t rxQueueLock;
+  /* Pointer to a memory region used as a message pool */
+  void *arena;
+
+  /* Filter entries */
+  FilterArray filters;
+
+  uv_poll_t *listener;
+  int descriptor;
+
+  /* Frames dropped by the kernel, cumulative value reported by the socket */
+  uint32_t kernelOverrunCount;
+  /* Bus errors */
+  uint32_t errorCount;
+  /* Frames dropped due to receive queue overflow */
+  uint32_t overrunCount;
+  /* Received frames */
+  uint32_t rxCount;
+  /* Transmitted frames */
+  uint32_t txCount;
+
+  /* Current mode */
+  enum Mode mode;
+  /* Flexible data-rate frames are enabled */
+  bool fd;
+};
+/*----------------------------------------------------------------------------*/
+static bool applyAcceptanceFilters(struct PosixCan *);
+static void cleanup(struct PosixCan *, enum Cleanup);
+static bool filterAdd(struct PosixCan *, const struct CANFilter *,
+    enum CANParameter);
+static bool filterRemove(struct PosixCan *, const struct CANFilter *,
+    enum CANParameter);
+static CanFilterEntry makeFilterEntry(const struct CANFilter *,
+    enum CANParameter);
+static void onCloseCallback(uv_handle_t *);
+static void onInterfaceCallback(uv_poll_t *, int, int);
+static bool receiveFrame(struct PosixCan *, const struct canfd_frame *,
+    struct msghdr *, bool);
+static void resetQueues(struct PosixCan *);
+static bool setBusMode(struct PosixCan *, enum Mode);
+static enum Result setupSocket(struct PosixCan *, const struct CanConfig *);
+/*----------------------------------------------------------------------------*/
+static enum Result canInit(void *, const void *);
+static void canDeinit(void *);
+static void canSetCallback(void *, void (*)(void *), void *);
+static enum Result canGetParam(void *, int, void *);
+static enum Result canSetParam(void *, int, const void *);
+static size_t canRead(void *, void *, size_t);
+static size_t canWrite(void *, const void *, size_t);
+/*----------------------------------------------------------------------------*/
+const struct InterfaceClass * const Can = &(const struct InterfaceClass){
+    .size = sizeof(struct PosixCan),
+    .init = canInit,
+    .deinit = canDeinit,
+
+    .setCallback = canSetCallback,
+    .getParam = canGetParam,
+    .setParam = canSetParam,
+    .read = canRead,
+    .write = canWrite
+};
+/*----------------------------------------------------------------------------*/
+static bool applyAcceptanceFilters(struct PosixCan *interface)
+{
+  if (filterArrayEmpty(&interface->filters))
+  {
+    /* Accept all messages */
+    static const struct can_filter defaultFilter = {
+        .can_id = 0,
+        .can_mask = 0
+    };
+
+    return setsockopt(interface->descriptor, SOL_CAN_RAW, CAN_RAW_FILTER,
+        &defaultFilter, sizeof(defaultFilter)) != -1;
+  }
+  else
+  {
+    return setsockopt(interface->descriptor, SOL_CAN_RAW, CAN_RAW_FILTER,
+        filterArrayAt(&interface->filters, 0),
+        filterArraySize(&interface->filters) * sizeof(CanFilterEntry)) != -1;
+  }
+}
+/*----------------------------------------------------------------------------*/
+static void cleanup(struct PosixCan *interface, enum Cleanup step)
+{
+  switch (step)
+  {
+    case CLEANUP_ALL:
+      uv_handle_set_data((uv_handle_t *)interface->listener, NULL);
+      uv_close((uv_handle_t *)interface->listener, onCloseCallback);
+      [[fallthrough]];
+    case CLEANUP_SOCKET:
+      close(interface->descriptor);
+      [[fallthrough]];
+    case CLEANUP_FILTERS:
+      filterArrayDeinit(&interface->filters);
+      [[fallthrough]];
+    case CLEANUP_ARENA:
+      free(interface->arena);
+      [[fallthrough]];
+    case CLEANUP_RX_QUEUE:
+      pointerQueueDeinit(&interface->rxQueue);
+      [[fallthrough]];
+    case CLEANUP_POOL:
+      pointerArrayDeinit(&interface->pool);
+      [[fallthrough]];
+    case CLEANUP_LISTENER:
+      if (step != CLEANUP_ALL)
+        free(interface->listener);
+      [[fallthrough]];
+    case CLEANUP_MUTEX:
+      pthread_mutex_destroy(&interface->rxQueueLock);
+      break;
+  }
+}
+/*----------------------------------------------------------------------------*/
+static bool filterAdd(struct PosixCan *interface,
+    const struct CANFilter *filter, enum CANParameter type)
+{
+  if (filterArrayFull(&interface->filters))
+    return false;
+
+  filterArrayPushBack(&interface->filters, makeFilterEntry(filter, type));
+  return true;
+}
+/*----------------------------------------------------------------------------*/
+static bool filterRemove(struct PosixCan *interface,
+    const struct CANFilter *filter, enum CANParameter type)
+{
+  const CanFilterEntry target = makeFilterEntry(filter, type);
+  bool matched = false;
+
+  for (size_t index = 0; index < filterArraySize(&interface->filters);)
+  {
+    const CanFilterEntry entry = *filterArrayAt(&interface->filters, index);
+
+    if (entry.can_id == target.can_id && entry.can_mask == target.can_mask)
+    {
+      filterArrayErase(&interface->filters, index);
+      matched = true;
+    }
+    else
+      ++index;
+  }
+
+  return matched;
+}
+/*----------------------------------------------------------------------------*/
+static CanFilterEntry makeFilterEntry(const struct CANFilter *filter,
+    enum CANParameter type)
+{
+  CanFilterEntry entry;
+
+  switch (type)
+  {
+    case IF_CAN_FILTER_ADD_STD:
+    case IF_CAN_FILTER_REMOVE_STD:
+      /* Match standard frames only */
+      entry.can_id = filter->id & CAN_SFF_MASK;
+      entry.can_mask = (filter->mask & CAN_SFF_MASK) | CAN_EFF_FLAG;
+      break;
+
+    case IF_CAN_FILTER_ADD_EXT:
+    case IF_CAN_FILTER_REMOVE_EXT:
+      /* Match extended frames only */
+      entry.can_id = (filter->id & CAN_EFF_MASK) | CAN_EFF_FLAG;
+      entry.can_mask = (filter->mask & CAN_EFF_MASK) | CAN_EFF_FLAG;
+      break;
+
+    default:
+      /*
+       * Raw sockets can not distinguish frame formats in filters,
+       * rules for flexible data-rate frames match identifiers of any width.
+       */
+      entry.can_id = filter->id & CAN_EFF_MASK;
+      entry.can_mask = filter->mask & CAN_EFF_MASK;
+      break;
+  }
+
+  return entry;
+}
+/*----------------------------------------------------------------------------*/
+static void onCloseCallback(uv_handle_t *handle)
+{
+  free(handle);
+}
+/*----------------------------------------------------------------------------*/
+static void onInterfaceCallback(uv_poll_t *handle, int, int)
+{
+  struct PosixCan * const interface =
+      uv_handle_get_data((uv_handle_t *)handle);
+  struct canfd_frame frames[BATCH_SIZE];
+  struct iovec vectors[BATCH_SIZE];
+  struct mmsghdr headers[BATCH_SIZE];
+  alignas(struct cmsghdr) uint8_t control[BATCH_SIZE][CONTROL_SIZE];
+  bool event = false;
+  int count;
+
+  for (size_t index = 0; index < BATCH_SIZE; ++index)
+  {
+    vectors[index].iov_base = &frames[index];
+    vectors[index].iov_len = sizeof(frames[index]);
+
+    memset(&headers[index].msg_hdr, 0, sizeof(headers[index].msg_hdr));
+    headers[index].msg_hdr.msg_iov = &vectors[index];
+    headers[index].msg_hdr.msg_iovlen = 1;
+    headers[index].msg_hdr.msg_control = control[index];
+  }
+
+  pthread_mutex_lock(&interface->rxQueueLock);
+  do
+  {
+    /* Control buffer length is overwritten by the kernel on each call */
+    for (size_t index = 0; index < BATCH_SIZE; ++index)
+      headers[index].msg_hdr.msg_controllen = CONTROL_SIZE;
+
+    count = recvmmsg(interface->descriptor, headers, BATCH_SIZE,
+        MSG_DONTWAIT, NULL);
+
+    for (int index = 0; index < count; ++index)
+    {
+      if (headers[index].msg_len != CAN_MTU
+          && headers[index].msg_len != CANFD_MTU)
+      {
+        continue;
+      }
+
+      if (receiveFrame(interface, &frames[index], &headers[index].msg_hdr,
+          headers[index].msg_len == CANFD_MTU))
+      {
+        event = true;
+      }
+    }
+  }
+  while (count == BATCH_SIZE);
+  pthread_mutex_unlock(&interface->rxQueueLock);
+
+  if (event && interface->callback != NULL)
+    interface->callback(interface->callbackArgument);
+}
+/*----------------------------------------------------------------------------*/
+static bool receiveFrame(struct PosixCan *interface,
+    const struct canfd_frame *frame, struct msghdr *header, bool fd)
+{
+  uint32_t timestamp = 0;
+
+  for (struct cmsghdr *entry = CMSG_FIRSTHDR(header); entry != NULL;
+      entry = CMSG_NXTHDR(header, entry))
+  {
+    if (entry->cmsg_level != SOL_SOCKET)
+      continue;
+
+    if (entry->cmsg_type == SO_TIMESTAMP)
+    {
+      struct timeval time;
+
+      memcpy(&time, CMSG_DATA(entry), sizeof(time));
+      timestamp = (uint32_t)((uint64_t)time.tv_sec * 1000000 + time.tv_usec);
+    }
+    else if (entry->cmsg_type == SO_RXQ_OVFL)
+    {
+      memcpy(&interface->kernelOverrunCount, CMSG_DATA(entry),
+          sizeof(interface->kernelOverrunCount));
+    }
+  }
+
+  if (frame->can_id & CAN_ERR_FLAG)
+  {
+    ++interface->errorCount;
+    return false;
+  }
+
+  if (pointerArrayEmpty(&interface->pool))
+  {
+    /* Received message will be lost when queue is full */
+    ++interface->overrunCount;
+    return false;
+  }
+
+  struct CANFlexibleDataMessage * const message =
+      pointerArrayBack(&interface->pool);
+  pointerArrayPopBack(&interface->pool);
+
+  message->timestamp = timestamp;
+  message->flags = 0;
+
+  if (frame->can_id & CAN_EFF_FLAG)
+  {
+    message->id = frame->can_id & CAN_EFF_MASK;
+    message->flags |= CAN_EXT_ID;
+  }
+  else
+    message->id = frame->can_id & CAN_SFF_MASK;
+
+  if (frame->can_id & CAN_RTR_FLAG)
+    message->flags |= CAN_RTR;
+  if (fd)
+    message->flags |= CAN_FD;
+
+  message->length = MIN(frame->len, fd ? CANFD_MAX_DLEN : CAN_MAX_DLEN);
+  memcpy(message->data, frame->data, message->length);
+
+  pointerQueuePushBack(&interface->rxQueue, message);
+  ++interface->rxCount;
+
+  return true;
+}
+/*----------------------------------------------------------------------------*/
+static void resetQueues(struct PosixCan *interface)
+{
+  pthread_mutex_lock(&interface->rxQueueLock);
+  while (!pointerQueueEmpty(&interface->rxQueue))
+  {
+    void * const message = pointerQueueFront(&interface->rxQueue);
+
+    pointerQueuePopFront(&interface->rxQueue);
+    pointerArrayPushBack(&interface->pool, message);
+  }
+  pthread_mutex_unlock(&interface->rxQueueLock);
+}
+/*----------------------------------------------------------------------------*/
+static bool setBusMode(struct PosixCan *interface, enum Mode mode)
+{
+  const int loopback = mode == MODE_LOOPBACK ? 1 : 0;
+
+  /* Local loopback is always enabled to keep other sockets informed */
+  if (setsockopt(interface->descriptor, SOL_CAN_RAW, CAN_RAW_RECV_OWN_MSGS,
+      &loopback, sizeof(loopback)) == -1)
+  {
+    return false;
+  }
+
+  /* Return pending message descriptors to the pool */
+  resetQueues(interface);
+
+  interface->mode = mode;
+  return true;
+}
+/*----------------------------------------------------------------------------*/
+static enum Result setupSocket(struct PosixCan *interface,
+    const struct CanConfig *config)
+{
+  const can_err_mask_t errorMask = CAN_ERR_MASK;
+  const int enabled = 1;
+  struct sockaddr_can address;
+  enum Result res = E_INTERFACE;
+
+  const unsigned int index = if_nametoindex(config->device);
+  if (!index)
+    return E_VALUE;
+
+  interface->descriptor = socket(PF_CAN, SOCK_RAW, CAN_RAW);
+  if (interface->descriptor == -1)
+    return E_INTERFACE;
+
+  /* Kernel time stamps and drop counters are delivered as ancillary data */
+  if (setsockopt(interface->descriptor, SOL_SOCKET, SO_TIMESTAMP,
+      &enabled, sizeof(enabled)) == -1)
+  {
+    goto close_socket;
+  }
+  if (setsockopt(interface->descriptor, SOL_SOCKET, SO_RXQ_OVFL,
+      &enabled, sizeof(enabled)) == -1)
+  {
+    goto close_socket;
+  }
+
+  /* Error frames are used to count bus errors */
+  if (setsockopt(interface->descriptor, SOL_CAN_RAW, CAN_RAW_ERR_FILTER,
+      &errorMask, sizeof(errorMask)) == -1)
+  {
+    goto close_socket;
+  }
+
+  if (config->fd)
+  {
+    if (setsockopt(interface->descriptor, SOL_CAN_RAW, CAN_RAW_FD_FRAMES,
+        &enabled, sizeof(enabled)) == -1)
+    {
+      res = E_VALUE;
+      goto close_socket;
+    }
+  }
+
+  memset(&address, 0, sizeof(address));
+  address.can_family = AF_CAN;
+  address.can_ifindex = (int)index;
+
+  if (bind(interface->descriptor, (struct sockaddr *)&address,
+      sizeof(address)) == -1)
+  {
+    res = E_BUSY;
+    goto close_socket;
+  }
+
+  return E_OK;
+
+close_socket:
+  close(interface->descriptor);
+  return res;
+}
+/*----------------------------------------------------------------------------*/
+static enum Result canInit(void *object, const void *configBase)
+{
+  const struct CanConfig * const config = configBase;
+  assert(config != NULL);
+  assert(config->device != NULL);
+  assert(config->rxBuffers);
+
+  struct PosixCan * const interface = object;
+  enum Result res;
+
+  interface->callback = NULL;
+  interface->callbackArgument = NULL;
+  interface->kernelOverrunCount = 0;
+  interface->errorCount = 0;
+  interface->overrunCount = 0;
+  interface->rxCount = 0;
+  interface->txCount = 0;
+  interface->mode = MODE_LISTENER;
+  interface->fd = config->fd;
+
+  if (pthread_mutex_init(&interface->rxQueueLock, 0))
+    return E_ERROR;
+
+  interface->listener = malloc(sizeof(uv_poll_t));
+  if (interface->listener == NULL)
+  {
+    cleanup(interface, CLEANUP_MUTEX);
+    return E_MEMORY;
+  }
+
+  if (!pointerArrayInit(&interface->pool, config->rxBuffers))
+  {
+    cleanup(interface, CLEANUP_LISTENER);
+    return E_MEMORY;
+  }
+  if (!pointerQueueInit(&interface->rxQueue, config->rxBuffers))
+  {
+    cleanup(interface, CLEANUP_POOL);
+    return E_MEMORY;
+  }
+
+  interface->arena =
+      malloc(sizeof(struct CANFlexibleDataMessage) * config->rxBuffers);
+  if (interface->arena == NULL)
+  {
+    cleanup(interface, CLEANUP_RX_QUEUE);
+    return E_MEMORY;
+  }
+
+  if (!filterArrayInit(&interface->filters, config->filters))
+  {
+    cleanup(interface, CLEANUP_ARENA);
+    return E_MEMORY;
+  }
+
+  struct CANFlexibleDataMessage *message = interface->arena;
+
+  for (size_t index = 0; index < config->rxBuffers; ++index)
+  {
+    pointerArrayPushBack(&interface->pool, message);
+    ++message;
+  }
+
+  if ((res = setupSocket(interface, config)) != E_OK)
+  {
+    cleanup(interface, CLEANUP_FILTERS);
+    return res;
+  }
+
+  if (!setBusMode(interface, MODE_LISTENER))
+  {
+    cleanup(interface, CLEANUP_SOCKET);
+    return E_INTERFACE;
+  }
+
+  uv_poll_init_socket(uv_default_loop(), interface->listener,
+      interface->descriptor);
+  uv_handle_set_data((uv_handle_t *)interface->listener, interface);
+  uv_poll_start(interface->listener, UV_READABLE, onInterfaceCallback);
+
+  return E_OK;
+}
+/*----------------------------------------------------------------------------*/
+static void canDeinit(void *object)
+{
+  cleanup(object, CLEANUP_ALL);
+}
+/*----------------------------------------------------------------------------*/
+static void canSetCallback(void *object, void (*callback)(void *),
+    void *argument)
+{
+  struct PosixCan * const interface = object;
+
+  interface->callbackArgument = argument;
+  interface->callback = callback;
+}
+/*----------------------------------------------------------------------------*/
+static enum Result canGetParam(void *object, int parameter, void *data)
+{
+  struct PosixCan * const interface = object;
+
+  switch ((enum CANParameter)parameter)
+  {
+    case IF_CAN_RETRANSMISSION:
+      /* Retransmission is controlled by the network interface settings */
+      *(uint8_t *)data = 1;
+      return E_OK;
+
+    case IF_CAN_ERRORS:
+      *(uint32_t *)data = interface->errorCount;
+      return E_OK;
+
+    case IF_CAN_OVERRUNS:
+      pthread_mutex_lock(&interface->rxQueueLock);
+      *(uint32_t *)data =
+          interface->overrunCount + interface->kernelOverrunCount;
+      pthread_mutex_unlock(&interface->rxQueueLock);
+      return E_OK;
+
+    case IF_CAN_RX_COUNT:
+      *(uint32_t *)data = interface->rxCount;
+      return E_OK;
+
+    case IF_CAN_TX_COUNT:
+      *(uint32_t *)data = interface->txCount;
+      return E_OK;
+
+    default:
+      break;
+  }
+
+  switch ((enum IfParameter)parameter)
+  {
+    case IF_RX_AVAILABLE:
+      pthread_mutex_lock(&interface->rxQueueLock);
+      *(size_t *)data = pointerQueueSize(&interface->rxQueue);
+      pthread_mutex_unlock(&interface->rxQueueLock);
+      return E_OK;
+
+    case IF_RX_PENDING:
+      pthread_mutex_lock(&interface->rxQueueLock);
+      *(size_t *)data = pointerQueueCapacity(&interface->rxQueue)
+          - pointerQueueSize(&interface->rxQueue);
+      pthread_mutex_unlock(&interface->rxQueueLock);
+      return E_OK;
+
+    case IF_TX_AVAILABLE:
+      /* Frames are passed to the kernel immediately */
+      *(size_t *)data = BATCH_SIZE;
+      return E_OK;
+
+    case IF_TX_PENDING:
+      *(size_t *)data = 0;
+      return E_OK;
+
+    default:
+      return E_INVALID;
+  }
+}
+/*----------------------------------------------------------------------------*/
+static enum Result canSetParam(void *object, int parameter, const void *data)
+{
+  struct PosixCan * const interface = object;
+
+  switch ((enum CANParameter)parameter)
+  {
+    case IF_CAN_ACTIVE:
+      return setBusMode(interface, MODE_ACTIVE) ? E_OK : E_INTERFACE;
+
+    case IF_CAN_LISTENER:
+      return setBusMode(interface, MODE_LISTENER) ? E_OK : E_INTERFACE;
+
+    case IF_CAN_LOOPBACK:
+      return setBusMode(interface, MODE_LOOPBACK) ? E_OK : E_INTERFACE;
+
+    case IF_CAN_RETRANSMISSION:
+      return *(const uint8_t *)data ? E_OK : E_INVALID;
+
+    case IF_CAN_FILTER_ADD_STD:
+    case IF_CAN_FILTER_ADD_EXT:
+    case IF_CAN_FILTER_ADD_FD:
+      if (filterAdd(interface, data, (enum CANParameter)parameter))
+        return applyAcceptanceFilters(interface) ? E_OK : E_INTERFACE;
+      else
+        return E_FULL;
+
+    case IF_CAN_FILTER_REMOVE_STD:
+    case IF_CAN_FILTER_REMOVE_EXT:
+    case IF_CAN_FILTER_REMOVE_FD:
+      if (filterRemove(interface, data, (enum CANParameter)parameter))
+        return applyAcceptanceFilters(interface) ? E_OK : E_INTERFACE;
+      else
+        return E_VALUE;
+
+    default:
+      return E_INVALID;
+  }
+}
+/*----------------------------------------------------------------------------*/
+static size_t canRead(void *object, void *buffer, size_t length)
+{
+  struct PosixCan * const interface = object;
+  size_t position = 0;
+
+  pthread_mutex_lock(&interface->rxQueueLock);
+  while (!pointerQueueEmpty(&interface->rxQueue))
+  {
+    struct CANFlexibleDataMessage * const message =
+        pointerQueueFront(&interface->rxQueue);
+    const size_t size = (message->flags & CAN_FD) ?
+        sizeof(struct CANFlexibleDataMessage) :
+        sizeof(struct CANStandardMessage);
+
+    if (length - position < size)
+      break;
+
+    memcpy((uint8_t *)buffer + position, message, size);
+    position += size;
+
+    pointerQueuePopFront(&interface->rxQueue);
+    pointerArrayPushBack(&interface->pool, message);
+  }
+  pthread_mutex_unlock(&interface->rxQueueLock);
+
+  return position;
+}
+/*----------------------------------------------------------------------------*/
+static size_t canWrite(void *object, const void *buffer, size_t length)
+{
+  static_assert(offsetof(struct CANStandardMessage, data) ==
+      offsetof(struct CANFlexibleDataMessage, data), "Incorrect layout");
+
+  struct PosixCan * const interface = object;
+  const uint8_t *position = buffer;
+  size_t written = 0;
+
+  /* Transmission is disabled in listener mode */
+  if (interface->mode == MODE_LISTENER)
+    return 0;
+
+  while (written < length)
+  {
+    struct canfd_frame frames[BATCH_SIZE];
+    struct iovec vectors[BATCH_SIZE];
+    struct mmsghdr headers[BATCH_SIZE];
+    size_t sizes[BATCH_SIZE];
+    size_t count = 0;
+    size_t offset = written;
+
+    while (count < BATCH_SIZE && offset < length)
+    {
+      struct CANFlexibleDataMessage message;
+
+      /* Remaining part of the buffer should contain at least a header */
+      if (length - offset < sizeof(struct CANStandardMessage))
+        break;
+
+      const uint8_t flags =
+          position[offset + offsetof(struct CANMessage, flags)];
+      const bool fd = (flags & CAN_FD) != 0;
+      const size_t size = fd ?
+          sizeof(struct CANFlexibleDataMessage) :
+          sizeof(struct CANStandardMessage);
+
+      /* Stop on an incorrect frame */
+      if (fd && !interface->fd)
+        break;
+      if (length - offset < size)
+        break;
+
+      memcpy(&message, position + offset, size);
+
+      struct canfd_frame * const frame = &frames[count];
+
+      memset(frame, 0, sizeof(*frame));
+      if (message.flags & CAN_EXT_ID)
+        frame->can_id = (message.id & CAN_EFF_MASK) | CAN_EFF_FLAG;
+      else
+        frame->can_id = message.id & CAN_SFF_MASK;
+      if (message.flags & CAN_RTR)
+        frame->can_id |= CAN_RTR_FLAG;
+
+      frame->len = MIN(message.length, fd ? CANFD_MAX_DLEN : CAN_MAX_DLEN);
+      memcpy(frame->data, message.data, frame->len);
+
+      vectors[count].iov_base = frame;
+      vectors[count].iov_len = fd ? CANFD_MTU : CAN_MTU;
+
+      memset(&headers[count], 0, sizeof(headers[count]));
+      headers[count].msg_hdr.msg_iov = &vectors[count];
+      headers[count].msg_hdr.msg_iovlen = 1;
+
+      sizes[count++] = size;
+      offset += size;
+    }
+
+    if (!count)
+      break;
+
+    const int sent = sendmmsg(interface->descriptor, headers,
+        (unsigned int)count, MSG_DONTWAIT);
+
+    if (sent <= 0)
+      break;
+
+    for (int index = 0; index < sent; ++index)
+      written += sizes[index];
+    interface->txCount += (uint32_t)sent;
+
+    /* Kernel transmit queue is full */
+    if ((size_t)sent < count)
+      break;
+  }
+
+  return written;
+}
@@ -0,0 +1,1284 @@
+/*
+ * sd_card_emulator.c
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the MIT License
+ */
+
+#include <halm/generic/mmcsd_defs.h>
+#include <halm/generic/sdio_defs.h>
+#include <halm/platform/generic/sd_card_emulator.h>
+#include <xcore/crc/crc7_mmc.h>
+#include <assert.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+/*----------------------------------------------------------------------------*/
+#define BLOCK_SIZE          512
+#define CARD_ADDRESS        0xB368
+#define DEFAULT_RATE        25000000
+#define HIGH_SPEED_RATE     50000000
+#define SWITCH_STATUS_SIZE  64
+
+#define COMMAND_BITS        48
+#define LONG_RESPONSE_BITS  136
+
+#define STATUS_OUT_OF_RANGE       BIT(31)
+#define STATUS_ADDRESS_ERROR      BIT(30)
+#define STATUS_BLOCK_LEN_ERROR    BIT(29)
+#define STATUS_ERASE_SEQ_ERROR    BIT(28)
+#define STATUS_ERASE_PARAM        BIT(27)
+#define STATUS_ILLEGAL_COMMAND    BIT(22)
+#define STATUS_CURRENT_STATE(value) BIT_FIELD((value), 9)
+#define STATUS_READY_FOR_DATA     BIT(8)
+#define STATUS_APP_CMD            BIT(5)
+
+#define ERASE_START_SET           BIT(0)
+#define ERASE_END_SET             BIT(1)
+
+enum Cleanup
+{
+  CLEANUP_ALL,
+  CLEANUP_MAPPING,
+  CLEANUP_FILE,
+  CLEANUP_SEMAPHORE,
+  CLEANUP_CONDITION,
+  CLEANUP_MUTEX
+};
+
+struct SdCardEmulator
+{
+  struct Interface base;
+
+  void (*callback)(void *);
+  void *callbackArgument;
+
+  /* Worker thread for delayed completion of requests */
+  pthread_t thread;
+  /* Mutex for the request and card state */
+  pthread_mutex_t lock;
+  /* Condition variable for the worker thread */
+  pthread_cond_t condition;
+  /* Bus lock */
+  sem_t semaphore;
+
+  /* Timing profile */
+  struct SdCardEmulatorProfile profile;
+  /* Completion time of the last request in nanoseconds */
+  uint64_t deadline;
+
+  /* Memory-mapped card image */
+  uint8_t *data;
+  /* Size of the mapped region */
+  size_t size;
+  /* Image file descriptor */
+  int file;
+
+  /* Command argument */
+  uint32_t argument;
+  /* Command code and flags */
+  uint32_t command;
+  /* Response of the last command */
+  uint32_t response[4];
+  /* Bus rate selected by the host */
+  uint32_t rate;
+  /* Data block size selected by the host */
+  uint32_t blockSize;
+
+  struct
+  {
+    /* Card capacity in blocks */
+    uint32_t capacity;
+    /* Block count of the next multiple block transfer */
+    uint32_t count;
+    /* Number of blocks pre-erased before the next write */
+    uint32_t erased;
+    /* Error bits of the card status */
+    uint32_t status;
+    /* First block of the erase range */
+    uint32_t eraseStart;
+    /* Last block of the erase range */
+    uint32_t eraseEnd;
+    /* Blocks programmed since the last stall */
+    uint32_t programmed;
+    /* C_SIZE field of the CSD register */
+    uint32_t sizeField;
+    /* C_SIZE_MULT field of the CSD register */
+    uint8_t sizeMultField;
+    /* READ_BL_LEN field of the CSD register */
+    uint8_t blockLengthField;
+
+    /* Relative card address */
+    uint16_t address;
+    /* Erase range flags */
+    uint8_t erase;
+    /* Current card state */
+    uint8_t state;
+    /* Next command is an application-specific command */
+    bool application;
+    /* High capacity card with block addressing */
+    bool hc;
+    /* High-speed mode is enabled */
+    bool hs;
+    /* 4-bit data bus is selected */
+    bool wide;
+  } card;
+
+  /* Status of the current request */
+  enum Result status;
+  /* Result of the request being completed in the worker thread */
+  enum Result result;
+  /* Request is waiting for completion in the worker thread */
+  bool pending;
+  /* Timing emulation is enabled */
+  bool realtime;
+  /* Worker thread should be terminated */
+  bool stop;
+  /* 4-bit data bus is available */
+  bool wide;
+};
+/*----------------------------------------------------------------------------*/
+static uint64_t calcBusTime(const struct SdCardEmulator *, size_t, bool);
+static uint64_t calcCommandTime(const struct SdCardEmulator *);
+static uint64_t calcProgramTime(struct SdCardEmulator *, uint32_t);
+static void cleanup(struct SdCardEmulator *, enum Cleanup);
+static bool decodeAddress(struct SdCardEmulator *, uint32_t, uint32_t,
+    uint32_t *);
+static enum Result executeCommand(struct SdCardEmulator *, uint64_t *);
+static enum Result executeTransfer(struct SdCardEmulator *, uint8_t *,
+    size_t, uint64_t *);
+static void fillRegister(uint32_t *);
+static uint64_t getTime(void);
+static void makeCid(uint32_t *);
+static void makeCsd(const struct SdCardEmulator *, uint32_t *);
+static void makeScr(uint8_t *);
+static uint32_t makeStatus(struct SdCardEmulator *, bool);
+static void makeSwitchStatus(struct SdCardEmulator *, uint8_t *);
+static bool noResponse(const struct SdCardEmulator *);
+static void resetCard(struct SdCardEmulator *);
+static bool setupCapacity(struct SdCardEmulator *, uint64_t);
+static enum Result setupImage(struct SdCardEmulator *,
+    const struct SdCardEmulatorConfig *);
+static void setBits(uint32_t *, unsigned int, unsigned int, uint32_t);
+static size_t startTransfer(struct SdCardEmulator *, uint8_t *, size_t);
+static enum Result submitRequest(struct SdCardEmulator *, enum Result,
+    uint64_t);
+static void *workerThread(void *);
+/*----------------------------------------------------------------------------*/
+static enum Result sdInit(void *, const void *);
+static void sdDeinit(void *);
+static void sdSetCallback(void *, void (*)(void *), void *);
+static enum Result sdGetParam(void *, int, void *);
+static enum Result sdSetParam(void *, int, const void *);
+static size_t sdRead(void *, void *, size_t);
+static size_t sdWrite(void *, const void *, size_t);
+/*----------------------------------------------------------------------------*/
+const struct InterfaceClass * const SdCardEmulator =
+    &(const struct InterfaceClass){
+    .size = sizeof(struct SdCardEmulator),
+    .init = sdInit,
+    .deinit = sdDeinit,
+
+    .setCallback = sdSetCallback,
+    .getParam = sdGetParam,
+    .setParam = sdSetParam,
+    .read = sdRead,
+    .write = sdWrite
+};
+/*----------------------------------------------------------------------------*/
+static uint64_t calcBusTime(const struct SdCardEmulator *interface,
+    size_t bits, bool data)
+{
+  const uint32_t limit = interface->card.hs ? HIGH_SPEED_RATE : DEFAULT_RATE;
+  const uint64_t rate = MIN(interface->rate, limit);
+  const uint64_t lines = (data && interface->card.wide) ? 4 : 1;
+
+  return (uint64_t)bits * 1000000000ULL / (rate * lines);
+}
+/*----------------------------------------------------------------------------*/
+static uint64_t calcCommandTime(const struct SdCardEmulator *interface)
+{
+  size_t bits = COMMAND_BITS;
+
+  switch ((enum SDIOResponse)COMMAND_RESP_VALUE(interface->command))
+  {
+    case SDIO_RESPONSE_SHORT:
+      bits += COMMAND_BITS;
+      break;
+
+    case SDIO_RESPONSE_LONG:
+      bits += LONG_RESPONSE_BITS;
+      break;
+
+    default:
+      break;
+  }
+
+  return calcBusTime(interface, bits, false)
+      + (uint64_t)interface->profile.command * 1000;
+}
+/*----------------------------------------------------------------------------*/
+static uint64_t calcProgramTime(struct SdCardEmulator *interface,
+    uint32_t blocks)
+{
+  const struct SdCardEmulatorProfile * const profile = &interface->profile;
+  const uint32_t prepared = MIN(blocks, interface->card.erased);
+  const uint32_t erased = profile->erased ? profile->erased : profile->program;
+  uint64_t duration = (uint64_t)profile->program * (blocks - prepared)
+      + (uint64_t)erased * prepared;
+
+  /* Pre-erase request is valid for a single write command only */
+  interface->card.erased = 0;
+
+  if (profile->stallPeriod)
+  {
+    /* Long stalls emulate internal garbage collection */
+    interface->card.programmed += blocks - prepared;
+
+    while (interface->card.programmed >= profile->stallPeriod)
+    {
+      interface->card.programmed -= profile->stallPeriod;
+      duration += profile->stall;
+    }
+  }
+
+  return duration * 1000;
+}
+/*----------------------------------------------------------------------------*/
+static void cleanup(struct SdCardEmulator *interface, enum Cleanup step)
+{
+  switch (step)
+  {
+    case CLEANUP_ALL:
+      if (interface->realtime)
+      {
+        pthread_mutex_lock(&interface->lock);
+        interface->stop = true;
+        pthread_cond_signal(&interface->condition);
+        pthread_mutex_unlock(&interface->lock);
+
+        pthread_join(interface->thread, NULL);
+      }
+      [[fallthrough]];
+    case CLEANUP_MAPPING:
+      munmap(interface->data, interface->size);
+      [[fallthrough]];
+    case CLEANUP_FILE:
+      close(interface->file);
+      [[fallthrough]];
+    case CLEANUP_SEMAPHORE:
+      sem_destroy(&interface->semaphore);
+      [[fallthrough]];
+    case CLEANUP_CONDITION:
+      pthread_cond_destroy(&interface->condition);
+      [[fallthrough]];
+    case CLEANUP_MUTEX:
+      pthread_mutex_destroy(&interface->lock);
+      break;
+  }
+}
+/*----------------------------------------------------------------------------*/
+static bool decodeAddress(struct SdCardEmulator *interface, uint32_t argument,
+    uint32_t blocks, uint32_t *block)
+{
+  uint32_t position;
+
+  if (!interface->card.hc)
+  {
+    /* Standard capacity cards use byte addressing */
+    if (argument & (BLOCK_SIZE - 1))
+    {
+      interface->card.status |= STATUS_ADDRESS_ERROR;
+      return false;
+    }
+
+    position = argument / BLOCK_SIZE;
+  }
+  else
+    position = argument;
+
+  if (position >= interface->card.capacity
+      || blocks > interface->card.capacity - position)
+  {
+    interface->card.status |= STATUS_OUT_OF_RANGE;
+    return false;
+  }
+
+  *block = position;
+  return true;
+}
+/*----------------------------------------------------------------------------*/
+static enum Result executeCommand(struct SdCardEmulator *interface,
+    uint64_t *duration)
+{
+  const enum MMCSDCommand code = COMMAND_CODE_VALUE(interface->command);
+  const uint32_t argument = interface->argument;
+  const bool application = interface->card.application;
+  const uint16_t address = argument >> 16;
+  const enum CardState state = interface->card.state;
+
+  interface->card.application = false;
+  *duration = calcCommandTime(interface);
+
+  if (application)
+  {
+    switch (code)
+    {
+      case ACMD6_SET_BUS_WIDTH:
+        if (state != CARD_TRANSFER)
+          break;
+
+        if (argument == ACMD6_BUS_WIDTH_1BIT)
+          interface->card.wide = false;
+        else if (argument == ACMD6_BUS_WIDTH_4BIT)
+          interface->card.wide = true;
+        else
+          interface->card.status |= STATUS_ERASE_PARAM;
+
+        interface->response[0] = makeStatus(interface, true);
+        return E_OK;
+
+      case ACMD41_SD_SEND_OP_COND:
+      {
+        if (state != CARD_IDLE && state != CARD_READY)
+          break;
+
+        uint32_t ocr = OCR_VOLTAGE_MASK_2V7_3V6;
+
+        /* Inquiry command does not start the initialization */
+        if (argument & OCR_VOLTAGE_MASK_2V7_3V6)
+        {
+          /* High capacity cards are not ready without HCS bit */
+          if (!interface->card.hc || (argument & OCR_HCS))
+          {
+            interface->card.state = CARD_READY;
+            ocr |= OCR_BUSY;
+
+            if (interface->card.hc)
+              ocr |= OCR_SD_CCS;
+          }
+        }
+
+        interface->response[0] = ocr;
+        return E_OK;
+      }
+
+      case ACMD23_SET_WR_BLK_ERASE_COUNT:
+        if (state != CARD_TRANSFER)
+          break;
+
+        interface->card.erased = argument & ACMD23_BLOCK_COUNT_MASK;
+        interface->response[0] = makeStatus(interface, true);
+        return E_OK;
+
+      case ACMD51_SEND_SCR:
+        /* Data commands should be started with read or write functions */
+        return E_VALUE;
+
+      default:
+        /* Other commands are processed as regular commands */
+        break;
+    }
+
+    if (code == ACMD6_SET_BUS_WIDTH || code == ACMD23_SET_WR_BLK_ERASE_COUNT
+        || code == ACMD41_SD_SEND_OP_COND)
+    {
+      interface->card.status |= STATUS_ILLEGAL_COMMAND;
+      return E_TIMEOUT;
+    }
+  }
+
+  switch (code)
+  {
+    case CMD0_GO_IDLE_STATE:
+      resetCard(interface);
+      return noResponse(interface) ? E_OK : E_TIMEOUT;
+
+    case CMD2_ALL_SEND_CID:
+      if (state != CARD_READY)
+        break;
+
+      makeCid(interface->response);
+      interface->card.state = CARD_IDENT;
+      return E_OK;
+
+    case CMD3_SEND_RELATIVE_ADDR:
+    {
+      if (state != CARD_IDENT && state != CARD_STANDBY)
+        break;
+
+      /* Status bits 23, 22, 19 and 12:0 are packed into the lower half */
+      const uint32_t status = makeStatus(interface, false);
+
+      interface->card.address = CARD_ADDRESS;
+      interface->card.state = CARD_STANDBY;
+      interface->response[0] = ((uint32_t)interface->card.address << 16)
+          | ((status >> 8) & 0xC000) | ((status >> 6) & 0x2000)
+          | (status & 0x1FFF);
+      return E_OK;
+    }
+
+    case CMD7_SELECT_CARD:
+      if (address != interface->card.address || !address)
+      {
+        /* Card is deselected without a response */
+        if (state == CARD_TRANSFER)
+          interface->card.state = CARD_STANDBY;
+        return noResponse(interface) ? E_OK : E_TIMEOUT;
+      }
+      if (state != CARD_STANDBY && state != CARD_TRANSFER)
+        break;
+
+      interface->response[0] = makeStatus(interface, false);
+      interface->card.state = CARD_TRANSFER;
+      return E_OK;
+
+    case CMD8_SEND_IF_COND:
+      if (state != CARD_IDLE)
+        break;
+
+      /* Supply voltage should be in the range from 2.7V to 3.6V */
+      if ((argument & 0xF00) != 0x100)
+        return E_TIMEOUT;
+
+      interface->response[0] = argument & 0xFFF;
+      return E_OK;
+
+    case CMD9_SEND_CSD:
+    case CMD10_SEND_CID:
+      if (state != CARD_STANDBY || address != interface->card.address)
+        break;
+
+      if (code == CMD9_SEND_CSD)
+        makeCsd(interface, interface->response);
+      else
+        makeCid(interface->response);
+      return E_OK;
+
+    case CMD12_STOP_TRANSMISSION:
+      if (state != CARD_DATA && state != CARD_RECEIVE)
+        break;
+
+      /* Open-ended write is finished with the programming of buffered data */
+      if (state == CARD_RECEIVE)
+        *duration += (uint64_t)interface->profile.stop * 1000;
+
+      interface->response[0] = makeStatus(interface, false);
+      interface->card.state = CARD_TRANSFER;
+      return E_OK;
+
+    case CMD13_SEND_STATUS:
+      if (state < CARD_STANDBY || address != interface->card.address)
+        break;
+
+      interface->response[0] = makeStatus(interface, false);
+      return E_OK;
+
+    case CMD16_SET_BLOCKLEN:
+      if (state != CARD_TRANSFER)
+        break;
+
+      /* Only 512-byte blocks are supported */
+      if (argument != BLOCK_SIZE)
+        interface->card.status |= STATUS_BLOCK_LEN_ERROR;
+
+      interface->response[0] = makeStatus(interface, false);
+      return E_OK;
+
+    case CMD23_SET_BLOCK_COUNT:
+      if (state != CARD_TRANSFER)
+        break;
+
+      interface->card.count = argument;
+      interface->response[0] = makeStatus(interface, false);
+      return E_OK;
+
+    case CMD32_ERASE_WR_BLK_START:
+    case CMD33_ERASE_WR_BLK_END:
+    {
+      if (state != CARD_TRANSFER)
+        break;
+
+      uint32_t block;
+
+      if (decodeAddress(interface, argument, 1, &block))
+      {
+        if (code == CMD32_ERASE_WR_BLK_START)
+        {
+          interface->card.eraseStart = block;
+          interface->card.erase = ERASE_START_SET;
+        }
+        else if (interface->card.erase & ERASE_START_SET)
+        {
+          interface->card.eraseEnd = block;
+          interface->card.erase |= ERASE_END_SET;
+        }
+        else
+          interface->card.status |= STATUS_ERASE_SEQ_ERROR;
+      }
+
+      interface->response[0] = makeStatus(interface, false);
+      return E_OK;
+    }
+
+    case CMD38_ERASE:
+    {
+      if (state != CARD_TRANSFER)
+        break;
+
+      const uint32_t start = interface->card.eraseStart;
+      const uint32_t end = interface->card.eraseEnd;
+
+      if (interface->card.erase != (ERASE_START_SET | ERASE_END_SET))
+      {
+        interface->card.status |= STATUS_ERASE_SEQ_ERROR;
+      }
+      else if (start > end)
+      {
+        interface->card.status |= STATUS_ERASE_PARAM;
+      }
+      else
+      {
+        memset(interface->data + (size_t)start * BLOCK_SIZE, 0,
+            (size_t)(end - start + 1) * BLOCK_SIZE);
+        *duration += (uint64_t)interface->profile.erase * 1000;
+      }
+
+      interface->card.erase = 0;
+      interface->response[0] = makeStatus(interface, false);
+      return E_OK;
+    }
+
+    case CMD55_APP_CMD:
+      if (state != CARD_IDLE && address != interface->card.address)
+        break;
+
+      interface->card.application = true;
+      interface->response[0] = makeStatus(interface, true);
+      return E_OK;
+
+    case CMD6_SWITCH_FUNC:
+    case CMD17_READ_SINGLE_BLOCK:
+    case CMD18_READ_MULTIPLE_BLOCK:
+    case CMD24_WRITE_BLOCK:
+    case CMD25_WRITE_MULTIPLE_BLOCK:
+      /* Data commands should be started with read or write functions */
+      return E_VALUE;
+
+    default:
+      break;
+  }
+
+  /* Illegal commands are not answered and are reported in the next status */
+  interface->card.status |= STATUS_ILLEGAL_COMMAND;
+  return E_TIMEOUT;
+}
+/*----------------------------------------------------------------------------*/
+static enum Result executeTransfer(struct SdCardEmulator *interface,
+    uint8_t *buffer, size_t length, uint64_t *duration)
+{
+  const enum MMCSDCommand code = COMMAND_CODE_VALUE(interface->command);
+  const uint16_t flags = COMMAND_FLAG_VALUE(interface->command);
+  const bool application = interface->card.application;
+  const bool write = (flags & SDIO_WRITE_MODE) != 0;
+  const uint32_t count = interface->card.count;
+
+  /* Block count is valid for a single data command only */
+  interface->card.application = false;
+  interface->card.count = 0;
+  *duration = calcCommandTime(interface);
+
+  if (interface->card.state != CARD_TRANSFER)
+  {
+    interface->card.status |= STATUS_ILLEGAL_COMMAND;
+    return E_TIMEOUT;
+  }
+
+  if (application && code == ACMD51_SEND_SCR && !write)
+  {
+    if (length != SCR_SIZE || interface->blockSize != SCR_SIZE)
+      return E_VALUE;
+
+    interface->response[0] = makeStatus(interface, true);
+    makeScr(buffer);
+
+    *duration += (uint64_t)interface->profile.access * 1000
+        + calcBusTime(interface, length * 8, true);
+    return E_OK;
+  }
+
+  if (!application && code == CMD6_SWITCH_FUNC && !write)
+  {
+    if (length != SWITCH_STATUS_SIZE)
+      return E_VALUE;
+
+    interface->response[0] = makeStatus(interface, false);
+    makeSwitchStatus(interface, buffer);
+
+    *duration += (uint64_t)interface->profile.access * 1000
+        + calcBusTime(interface, length * 8, true);
+    return E_OK;
+  }
+
+  const bool multiple = code == CMD18_READ_MULTIPLE_BLOCK
+      || code == CMD25_WRITE_MULTIPLE_BLOCK;
+  const bool single = code == CMD17_READ_SINGLE_BLOCK
+      || code == CMD24_WRITE_BLOCK;
+  const bool matched = (code == CMD17_READ_SINGLE_BLOCK
+      || code == CMD18_READ_MULTIPLE_BLOCK) != write;
+
+  if (application || (!multiple && !single) || !matched)
+  {
+    interface->card.status |= STATUS_ILLEGAL_COMMAND;
+    return E_TIMEOUT;
+  }
+
+  if (interface->blockSize != BLOCK_SIZE || (length % BLOCK_SIZE) != 0
+      || (single && length != BLOCK_SIZE))
+  {
+    return E_VALUE;
+  }
+
+  const uint32_t blocks = (uint32_t)(length / BLOCK_SIZE);
+  uint32_t block;
+
+  if (!decodeAddress(interface, interface->argument, blocks, &block))
+  {
+    /* Card answers with an error and does not start the data transfer */
+    interface->response[0] = makeStatus(interface, false);
+    return E_TIMEOUT;
+  }
+
+  uint8_t * const position = interface->data + (size_t)block * BLOCK_SIZE;
+
+  interface->response[0] = makeStatus(interface, false);
+  *duration += calcBusTime(interface, length * 8, true);
+
+  /* Transfer with a pre-defined block count is finished by the card */
+  const bool open = multiple && count != blocks;
+
+  if (write)
+  {
+    memcpy(position, buffer, length);
+    *duration += calcProgramTime(interface, blocks);
+
+    if (open)
+    {
+      if (!(flags & SDIO_AUTO_STOP))
+        interface->card.state = CARD_RECEIVE;
+      else
+        *duration += (uint64_t)interface->profile.stop * 1000;
+    }
+  }
+  else
+  {
+    memcpy(buffer, position, length);
+    *duration += (uint64_t)interface->profile.access * 1000;
+
+    if (open && !(flags & SDIO_AUTO_STOP))
+      interface->card.state = CARD_DATA;
+  }
+
+  return E_OK;
+}
+/*----------------------------------------------------------------------------*/
+static void fillRegister(uint32_t *data)
+{
+  uint8_t buffer[15];
+
+  for (size_t index = 0; index < sizeof(buffer); ++index)
+  {
+    const unsigned int position = 120 - index * 8;
+    buffer[index] = (uint8_t)(data[position >> 5] >> (position & 0x1F));
+  }
+
+  /* Checksum and end bit occupy the lowest byte of the register */
+  setBits(data, 0, 7,
+      (crc7MMCUpdate(0x00, buffer, sizeof(buffer)) << 1) | 0x01);
+}
+/*----------------------------------------------------------------------------*/
+static uint64_t getTime(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+/*----------------------------------------------------------------------------*/
+static void makeCid(uint32_t *data)
+{
+  memset(data, 0, sizeof(uint32_t) * 4);
+
+  /* Manufacturer ID and OEM ID */
+  setBits(data, 120, 127, 0x00);
+  setBits(data, 104, 119, ('H' << 8) | 'L');
+  /* Product name "SDEMU" */
+  setBits(data, 96, 103, 'S');
+  setBits(data, 64, 95, ('D' << 24) | ('E' << 16) | ('M' << 8) | 'U');
+  /* Product revision 1.0 and serial number */
+  setBits(data, 56, 63, 0x10);
+  setBits(data, 24, 55, 0x00C0FFEE);
+  /* Manufacturing date: January 2026 */
+  setBits(data, 8, 19, (26 << 4) | 1);
+
+  fillRegister(data);
+}
+/*----------------------------------------------------------------------------*/
+static void makeCsd(const struct SdCardEmulator *interface, uint32_t *data)
+{
+  memset(data, 0, sizeof(uint32_t) * 4);
+
+  /* CSD structure version, 2.0 for high capacity cards */
+  setBits(data, 126, 127, interface->card.hc ? 1 : 0);
+  /* TAAC and NSAC */
+  setBits(data, 112, 119, 0x0E);
+  /* Maximum data transfer rate: 25 MHz or 50 MHz */
+  setBits(data, 96, 103, interface->card.hs ? 0x5A : 0x32);
+  /* Card command classes */
+  setBits(data, 84, 95, 0x5B5);
+  /* Maximum read data block length */
+  setBits(data, 80, 83, interface->card.blockLengthField);
+
+  if (interface->card.hc)
+  {
+    setBits(data, 48, 69, interface->card.sizeField);
+  }
+  else
+  {
+    setBits(data, 62, 73, interface->card.sizeField);
+    /* Maximum read and write currents */
+    setBits(data, 50, 61, 0xFFF);
+    setBits(data, 47, 49, interface->card.sizeMultField);
+  }
+
+  /* Erase of single blocks is enabled, sector size is 64 KiB */
+  setBits(data, 46, 46, 1);
+  setBits(data, 39, 45, 0x7F);
+  /* Write speed factor and maximum write data block length */
+  setBits(data, 26, 28, 2);
+  setBits(data, 22, 25, 9);
+
+  fillRegister(data);
+}
+/*----------------------------------------------------------------------------*/
+static void makeScr(uint8_t *buffer)
+{
+  memset(buffer, 0, SCR_SIZE);
+
+  /* SCR structure 1.0, physical layer specification 2.00 or later */
+  buffer[0] = 0x02;
+  /* Erased data is zero, 1-bit and 4-bit buses are supported */
+  buffer[1] = 0x05;
+  /* Physical layer specification 3.0 */
+  buffer[2] = 0x80;
+  /* Set Block Count command is supported */
+  buffer[3] = SCR_CMD23_SUPPORT;
+}
+/*----------------------------------------------------------------------------*/
+static uint32_t makeStatus(struct SdCardEmulator *interface, bool application)
+{
+  const enum CardState state = interface->card.state;
+  uint32_t status = interface->card.status | STATUS_CURRENT_STATE(state);
+
+  if (state != CARD_PROGRAMMING)
+    status |= STATUS_READY_FOR_DATA;
+  if (application)
+    status |= STATUS_APP_CMD;
+
+  /* Error bits are cleared after reading */
+  interface->card.status = 0;
+  return status;
+}
+/*----------------------------------------------------------------------------*/
+static void makeSwitchStatus(struct SdCardEmulator *interface,
+    uint8_t *buffer)
+{
+  const bool apply = (interface->argument & BIT(31)) != 0;
+  const unsigned int function = interface->argument & 0x0F;
+  unsigned int selected;
+
+  memset(buffer, 0, SWITCH_STATUS_SIZE);
+
+  /* Maximum current consumption is 100 mA */
+  buffer[1] = 100;
+
+  /* Only default functions are supported in groups 6 to 2 */
+  for (size_t index = 2; index < 12; index += 2)
+  {
+    buffer[index] = 0x80;
+    buffer[index + 1] = 0x01;
+  }
+
+  /* Default and High-Speed functions are supported in group 1 */
+  buffer[12] = 0x80;
+  buffer[13] = 0x03;
+
+  if (function == 0x0F)
+  {
+    /* Current function is not changed */
+    selected = interface->card.hs ? 1 : 0;
+  }
+  else if (function <= 1)
+  {
+    selected = function;
+
+    if (apply)
+      interface->card.hs = function == 1;
+  }
+  else
+    selected = 0x0F;
+
+  buffer[16] = (uint8_t)selected;
+}
+/*----------------------------------------------------------------------------*/
+static bool noResponse(const struct SdCardEmulator *interface)
+{
+  return COMMAND_RESP_VALUE(interface->command) == SDIO_RESPONSE_NONE;
+}
+/*----------------------------------------------------------------------------*/
+static void resetCard(struct SdCardEmulator *interface)
+{
+  interface->card.count = 0;
+  interface->card.erased = 0;
+  interface->card.status = 0;
+  interface->card.erase = 0;
+  interface->card.address = 0;
+  interface->card.state = CARD_IDLE;
+  interface->card.application = false;
+  interface->card.hs = false;
+  interface->card.wide = false;
+}
+/*----------------------------------------------------------------------------*/
+static bool setupCapacity(struct SdCardEmulator *interface, uint64_t size)
+{
+  if (interface->card.hc)
+  {
+    /* Capacity of high capacity cards is a multiple of 512 KiB */
+    const uint64_t units = MIN(size >> 19, 1ULL << 22);
+
+    if (!units)
+      return false;
+
+    interface->card.capacity = (uint32_t)(units << 10);
+    interface->card.sizeField = (uint32_t)(units - 1);
+    interface->card.blockLengthField = 9;
+  }
+  else
+  {
+    const uint64_t blocks = MIN(size, 1ULL << 31) / BLOCK_SIZE;
+    uint32_t capacity = 0;
+
+    /* Select the largest capacity that can be described by the CSD */
+    for (unsigned int length = 9; length <= 10; ++length)
+    {
+      for (unsigned int multiplier = 0; multiplier < 8; ++multiplier)
+      {
+        const unsigned int shift = multiplier + 2 + (length - 9);
+        const uint64_t units = MIN(blocks >> shift, 4096);
+
+        if (units && (units << shift) > capacity)
+        {
+          capacity = (uint32_t)(units << shift);
+          interface->card.sizeField = (uint32_t)(units - 1);
+          interface->card.sizeMultField = (uint8_t)multiplier;
+          interface->card.blockLengthField = (uint8_t)length;
+        }
+      }
+    }
+
+    if (!capacity)
+      return false;
+
+    interface->card.capacity = capacity;
+  }
+
+  return true;
+}
+/*----------------------------------------------------------------------------*/
+static enum Result setupImage(struct SdCardEmulator *interface,
+    const struct SdCardEmulatorConfig *config)
+{
+  struct stat info;
+
+  interface->file = open(config->path, config->capacity ?
+      (O_RDWR | O_CREAT) : O_RDWR, 0644);
+  if (interface->file < 0)
+    return E_ENTRY;
+
+  if (fstat(interface->file, &info) == -1)
+    goto error;
+
+  if (config->capacity > (uint64_t)info.st_size)
+  {
+    /* Extended part of the image is sparse */
+    if (ftruncate(interface->file, (off_t)config->capacity) == -1)
+      goto error;
+    info.st_size = (off_t)config->capacity;
+  }
+
+  if (!setupCapacity(interface,
+      config->capacity ? config->capacity : (uint64_t)info.st_size))
+  {
+    close(interface->file);
+    return E_VALUE;
+  }
+
+  interface->size = (size_t)interface->card.capacity * BLOCK_SIZE;
+  interface->data = mmap(NULL, interface->size, PROT_READ | PROT_WRITE,
+      MAP_SHARED, interface->file, 0);
+  if (interface->data == MAP_FAILED)
+    goto error;
+
+  return E_OK;
+
+error:
+  close(interface->file);
+  return E_INTERFACE;
+}
+/*----------------------------------------------------------------------------*/
+static void setBits(uint32_t *data, unsigned int start, unsigned int end,
+    uint32_t value)
+{
+  for (unsigned int position = start; position <= end; ++position)
+  {
+    const uint32_t mask = 1UL << (position & 0x1F);
+
+    if (value & (1UL << (position - start)))
+      data[position >> 5] |= mask;
+    else
+      data[position >> 5] &= ~mask;
+  }
+}
+/*----------------------------------------------------------------------------*/
+static size_t startTransfer(struct SdCardEmulator *interface, uint8_t *buffer,
+    size_t length)
+{
+  void (*callback)(void *) = NULL;
+  void *argument = NULL;
+  uint64_t duration;
+
+  pthread_mutex_lock(&interface->lock);
+
+  if (interface->pending)
+  {
+    pthread_mutex_unlock(&interface->lock);
+    return 0;
+  }
+
+  const enum Result status = executeTransfer(interface, buffer, length,
+      &duration);
+  const enum Result res = submitRequest(interface, status, duration);
+
+  if (res != E_BUSY)
+  {
+    /* Transfer is completed in the context of the caller */
+    callback = interface->callback;
+    argument = interface->callbackArgument;
+  }
+
+  pthread_mutex_unlock(&interface->lock);
+
+  if (callback != NULL)
+    callback(argument);
+
+  return length;
+}
+/*----------------------------------------------------------------------------*/
+static enum Result submitRequest(struct SdCardEmulator *interface,
+    enum Result result, uint64_t duration)
+{
+  if (!interface->realtime)
+  {
+    interface->status = result;
+    return result;
+  }
+
+  const uint64_t time = getTime();
+
+  interface->deadline = MAX(time, interface->deadline) + duration;
+  interface->result = result;
+  interface->status = E_BUSY;
+  interface->pending = true;
+  pthread_cond_signal(&interface->condition);
+
+  return E_BUSY;
+}
+/*----------------------------------------------------------------------------*/
+static void *workerThread(void *argument)
+{
+  struct SdCardEmulator * const interface = argument;
+
+  pthread_mutex_lock(&interface->lock);
+
+  while (!interface->stop)
+  {
+    if (!interface->pending)
+    {
+      pthread_cond_wait(&interface->condition, &interface->lock);
+      continue;
+    }
+
+    const struct timespec deadline = {
+        .tv_sec = (time_t)(interface->deadline / 1000000000ULL),
+        .tv_nsec = (long)(interface->deadline % 1000000000ULL)
+    };
+
+    pthread_mutex_unlock(&interface->lock);
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, NULL)
+        == EINTR);
+    pthread_mutex_lock(&interface->lock);
+
+    void (*callback)(void *) = interface->callback;
+    void * const callbackArgument = interface->callbackArgument;
+
+    interface->status = interface->result;
+    interface->pending = false;
+
+    /* Callback function may start the next request */
+    pthread_mutex_unlock(&interface->lock);
+    if (callback != NULL)
+      callback(callbackArgument);
+    pthread_mutex_lock(&interface->lock);
+  }
+
+  pthread_mutex_unlock(&interface->lock);
+  return NULL;
+}
+/*----------------------------------------------------------------------------*/
+static enum Result sdInit(void *object, const void *configBase)
+{
+  const struct SdCardEmulatorConfig * const config = configBase;
+  assert(config != NULL);
+
+  struct SdCardEmulator * const interface = object;
+  enum Result res;
+
+  if (config->path == NULL)
+    return E_VALUE;
+
+  interface->callback = NULL;
+  interface->callbackArgument = NULL;
+  interface->deadline = 0;
+  interface->argument = 0;
+  interface->command = 0;
+  interface->rate = config->rate ? config->rate : DEFAULT_RATE;
+  interface->blockSize = BLOCK_SIZE;
+  interface->status = E_OK;
+  interface->result = E_OK;
+  interface->pending = false;
+  interface->realtime = config->profile != NULL;
+  interface->stop = false;
+  interface->wide = config->wide;
+
+  memset(interface->response, 0, sizeof(interface->response));
+  memset(&interface->card, 0, sizeof(interface->card));
+  interface->card.hc = !config->sdsc;
+  resetCard(interface);
+
+  if (config->profile != NULL)
+    interface->profile = *config->profile;
+  else
+    memset(&interface->profile, 0, sizeof(interface->profile));
+
+  if (pthread_mutex_init(&interface->lock, NULL))
+    return E_ERROR;
+
+  if (pthread_cond_init(&interface->condition, NULL))
+  {
+    cleanup(interface, CLEANUP_MUTEX);
+    return E_ERROR;
+  }
+
+  if (sem_init(&interface->semaphore, 0, 1))
+  {
+    cleanup(interface, CLEANUP_CONDITION);
+    return E_ERROR;
+  }
+
+  if ((res = setupImage(interface, config)) != E_OK)
+  {
+    cleanup(interface, CLEANUP_SEMAPHORE);
+    return res;
+  }
+
+  if (interface->realtime)
+  {
+    if (pthread_create(&interface->thread, NULL, workerThread, interface))
+    {
+      cleanup(interface, CLEANUP_MAPPING);
+      return E_ERROR;
+    }
+  }
+
+  return E_OK;
+}
+/*----------------------------------------------------------------------------*/
+static void sdDeinit(void *object)
+{
+  cleanup(object, CLEANUP_ALL);
+}
+/*----------------------------------------------------------------------------*/
+static void sdSetCallback(void *object, void (*callback)(void *),
+    void *argument)
+{
+  struct SdCardEmulator * const interface = object;
+
+  pthread_mutex_lock(&interface->lock);
+  interface->callbackArgument = argument;
+  interface->callback = callback;
+  pthread_mutex_unlock(&interface->lock);
+}
+/*----------------------------------------------------------------------------*/
+static enum Result sdGetParam(void *object, int parameter, void *data)
+{
+  struct SdCardEmulator * const interface = object;
+  enum Result res = E_OK;
+
+  pthread_mutex_lock(&interface->lock);
+
+  switch ((enum SDIOParameter)parameter)
+  {
+    case IF_SDIO_MODE:
+      *(uint8_t *)data = interface->wide ? SDIO_4BIT : SDIO_1BIT;
+      goto exit;
+
+    case IF_SDIO_RESPONSE:
+    {
+      const enum SDIOResponse response =
+          COMMAND_RESP_VALUE(interface->command);
+
+      if (response == SDIO_RESPONSE_LONG)
+        memcpy(data, interface->response, sizeof(interface->response));
+      else if (response == SDIO_RESPONSE_SHORT)
+        *(uint32_t *)data = interface->response[0];
+      else
+        res = E_ERROR;
+      goto exit;
+    }
+
+    default:
+      break;
+  }
+
+  switch ((enum IfParameter)parameter)
+  {
+    case IF_RATE:
+      *(uint32_t *)data = interface->rate;
+      break;
+
+    case IF_STATUS:
+      res = interface->status;
+      break;
+
+    default:
+      res = E_INVALID;
+      break;
+  }
+
+exit:
+  pthread_mutex_unlock(&interface->lock);
+  return res;
+}
+/*----------------------------------------------------------------------------*/
+static enum Result sdSetParam(void *object, int parameter, const void *data)
+{
+  struct SdCardEmulator * const interface = object;
+
+  switch ((enum IfParameter)parameter)
+  {
+    case IF_ACQUIRE:
+      sem_wait(&interface->semaphore);
+      return E_OK;
+
+    case IF_RELEASE:
+      sem_post(&interface->semaphore);
+      return E_OK;
+
+    default:
+      break;
+  }
+
+  enum Result res = E_OK;
+
+  pthread_mutex_lock(&interface->lock);
+
+  switch ((enum SDIOParameter)parameter)
+  {
+    case IF_SDIO_EXECUTE:
+    {
+      if (!interface->pending)
+      {
+        uint64_t duration;
+        const enum Result status = executeCommand(interface, &duration);
+
+        res = submitRequest(interface, status, duration);
+      }
+      else
+        res = E_BUSY;
+      goto exit;
+    }
+
+    case IF_SDIO_ARGUMENT:
+      interface->argument = *(const uint32_t *)data;
+      goto exit;
+
+    case IF_SDIO_BLOCK_SIZE:
+    {
+      const uint32_t blockSize = *(const uint32_t *)data;
+
+      if (blockSize && blockSize <= BLOCK_SIZE)
+        interface->blockSize = blockSize;
+      else
+        res = E_VALUE;
+      goto exit;
+    }
+
+    case IF_SDIO_COMMAND:
+      interface->command = *(const uint32_t *)data;
+      goto exit;
+
+    default:
+      break;
+  }
+
+  switch ((enum IfParameter)parameter)
+  {
+    case IF_RATE:
+    {
+      const uint32_t rate = *(const uint32_t *)data;
+
+      if (rate)
+        interface->rate = rate;
+      else
+        res = E_VALUE;
+      break;
+    }
+
+    case IF_ZEROCOPY:
+      break;
+
+    default:
+      res = E_INVALID;
+      break;
+  }
+
+exit:
+  pthread_mutex_unlock(&interface->lock);
+  return res;
+}
+/*----------------------------------------------------------------------------*/
+static size_t sdRead(void *object, void *buffer, size_t length)
+{
+  return startTransfer(object, buffer, length);
+}
+/*----------------------------------------------------------------------------*/
+static size_t sdWrite(void *object, const void *buffer, size_t length)
+{
+  /* Buffer is not modified during write transfers */
+  return startTransfer(object, (uint8_t *)buffer, length);
+}
@@ -0,0 +1,1066 @@
+/*
+ * spim_emulator.c
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the MIT License
+ */
+
+#include <halm/platform/generic/spim_emulator.h>
+#include <xcore/bits.h>
+#include <xcore/memory.h>
+#include <assert.h>
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+/*----------------------------------------------------------------------------*/
+#define MANUFACTURER_ID     0xEF
+#define MEMORY_TYPE         0x40
+#define MAX_CAPACITY        (1UL << 28)
+#define MIN_CAPACITY        65536
+#define PROGRAM_PAGE_SIZE   256
+#define SFDP_BFPT_DWORDS    16
+#define SFDP_BFPT_OFFSET    16
+#define SFDP_SIZE           (SFDP_BFPT_OFFSET + SFDP_BFPT_DWORDS * 4)
+
+#define SR1_WIP             BIT(0)
+#define SR1_WEL             BIT(1)
+#define SR1_WRITABLE_MASK   0xFC
+#define SR2_QE              BIT(1)
+#define SR2_SUS             BIT(7)
+#define SR2_WRITABLE_MASK   SR2_QE
+
+/* Command is followed by an address */
+#define OP_ADDRESS          0x01
+/* Data is read from the memory */
+#define OP_IN               0x02
+/* Data is written to the memory */
+#define OP_OUT              0x04
+/* Command uses DTR clocking */
+#define OP_DTR              0x08
+/* Address length is fixed to 3 bytes */
+#define OP_SHORT            0x10
+/* Command is accepted when the memory is busy */
+#define OP_STATUS           0x20
+/* Command reads the memory array */
+#define OP_ARRAY            0x40
+/* Command suspends an erase operation and is accepted when busy */
+#define OP_SUSPEND          0x80
+
+struct Operation
+{
+  /* Operation flags */
+  uint8_t flags;
+  /* Operation code */
+  uint8_t code;
+  /* Number of lines used in the address phase */
+  uint8_t address;
+  /* Number of lines used in the data phase */
+  uint8_t data;
+  /* Number of mode and dummy clocks */
+  uint8_t clocks;
+};
+
+struct SpimEmulator
+{
+  struct Interface base;
+
+  void (*callback)(void *);
+  void *callbackArgument;
+
+  /* Timing profile */
+  struct SpimEmulatorProfile profile;
+  /* Completion time of the current operation in nanoseconds */
+  uint64_t deadline;
+  /* Remaining time of the suspended erase operation in nanoseconds */
+  uint64_t remaining;
+
+  /* Memory array */
+  uint8_t *data;
+  /* Memory capacity in bytes */
+  uint32_t capacity;
+
+  struct
+  {
+    /* Remaining commands of the sequence */
+    const struct SpimCommand *commands;
+    /* Number of remaining commands */
+    size_t count;
+  } sequence;
+
+  /* Current command */
+  struct SpimCommand command;
+  /* Command response */
+  uint8_t response;
+
+  /* Serial Flash Discoverable Parameters */
+  uint8_t sfdp[SFDP_SIZE];
+
+  struct
+  {
+    /* Status register 1 */
+    uint8_t sr1;
+    /* Status register 2 */
+    uint8_t sr2;
+    /* 4-byte address mode */
+    bool address4;
+    /* Erase operation is in progress */
+    bool erasing;
+    /* Deep power-down mode */
+    bool sleep;
+    /* Erase operation is suspended */
+    bool suspended;
+  } memory;
+
+  /* Status of the last command */
+  enum Result status;
+  /* Enables blocking mode instead of zero-copy mode */
+  bool blocking;
+  /* Enables DDR mode */
+  bool ddr;
+  /* Support of DTR read commands */
+  bool dtr;
+  /* Memory-mapping mode flag */
+  bool memmap;
+  /* Enable Quad I/O mode */
+  bool quad;
+  /* Timing emulation is enabled */
+  bool realtime;
+  /* IO2 and IO3 lines are connected */
+  bool wide;
+};
+/*----------------------------------------------------------------------------*/
+static bool checkCommand(const struct SpimEmulator *,
+    const struct SpimCommand *, const struct Operation *);
+static enum Result executeCommand(struct SpimEmulator *, void *, size_t, bool);
+static enum Result executeOperation(struct SpimEmulator *,
+    const struct Operation *, uint8_t *, size_t);
+static const struct Operation *findOperation(uint8_t);
+static uint64_t getTime(void);
+static bool isCommandValid(const struct SpimCommand *);
+static void makeSfdp(struct SpimEmulator *);
+static enum Result runSequence(struct SpimEmulator *);
+static void setBusy(struct SpimEmulator *, uint32_t);
+static void setErasing(struct SpimEmulator *, uint32_t);
+static void updateBusy(struct SpimEmulator *, bool);
+/*----------------------------------------------------------------------------*/
+static enum Result emuInit(void *, const void *);
+static void emuDeinit(void *);
+static void emuSetCallback(void *, void (*)(void *), void *);
+static enum Result emuGetParam(void *, int, void *);
+static enum Result emuSetParam(void *, int, const void *);
+static size_t emuRead(void *, void *, size_t);
+static size_t emuWrite(void *, const void *, size_t);
+/*----------------------------------------------------------------------------*/
+const struct InterfaceClass * const SpimEmulator =
+    &(const struct InterfaceClass){
+    .size = sizeof(struct SpimEmulator),
+    .init = emuInit,
+    .deinit = emuDeinit,
+
+    .setCallback = emuSetCallback,
+    .getParam = emuGetParam,
+    .setParam = emuSetParam,
+    .read = emuRead,
+    .write = emuWrite
+};
+/*----------------------------------------------------------------------------*/
+static const struct Operation operations[] = {
+    /* Write Status Register 1 and 2 */
+    {OP_OUT, 0x01, 0, 1, 0},
+    /* Page Program */
+    {OP_ADDRESS | OP_OUT, 0x02, 1, 1, 0},
+    /* Read Data */
+    {OP_ADDRESS | OP_IN | OP_ARRAY, 0x03, 1, 1, 0},
+    /* Write Disable */
+    {0, 0x04, 0, 0, 0},
+    /* Read Status Register 1 */
+    {OP_IN | OP_STATUS, 0x05, 0, 1, 0},
+    /* Write Enable */
+    {0, 0x06, 0, 0, 0},
+    /* Fast Read */
+    {OP_ADDRESS | OP_IN | OP_ARRAY, 0x0B, 1, 1, 8},
+    /* DTR Fast Read */
+    {OP_ADDRESS | OP_IN | OP_ARRAY | OP_DTR, 0x0D, 1, 1, 8},
+    /* Sector Erase */
+    {OP_ADDRESS, 0x20, 1, 0, 0},
+    /* Write Status Register 2 */
+    {OP_OUT, 0x31, 0, 1, 0},
+    /* Read Status Register 2 */
+    {OP_IN | OP_STATUS, 0x35, 0, 1, 0},
+    /* Fast Read Dual Output */
+    {OP_ADDRESS | OP_IN | OP_ARRAY, 0x3B, 1, 2, 8},
+    /* 32 KiB Block Erase */
+    {OP_ADDRESS, 0x52, 1, 0, 0},
+    /* Read SFDP */
+    {OP_ADDRESS | OP_IN | OP_SHORT, 0x5A, 1, 1, 8},
+    /* Chip Erase */
+    {0, 0x60, 0, 0, 0},
+    /* Fast Read Quad Output */
+    {OP_ADDRESS | OP_IN | OP_ARRAY, 0x6B, 1, 4, 8},
+    /* Erase Suspend */
+    {OP_SUSPEND, 0x75, 0, 0, 0},
+    /* Erase Resume */
+    {0, 0x7A, 0, 0, 0},
+    /* Release Power-down */
+    {0, 0xAB, 0, 0, 0},
+    /* Enter 4-Byte Address Mode */
+    {0, 0xB7, 0, 0, 0},
+    /* Power-down */
+    {0, 0xB9, 0, 0, 0},
+    /* Fast Read Dual I/O */
+    {OP_ADDRESS | OP_IN | OP_ARRAY, 0xBB, 2, 2, 4},
+    /* DTR Fast Read Dual I/O */
+    {OP_ADDRESS | OP_IN | OP_ARRAY | OP_DTR, 0xBD, 2, 2, 4},
+    /* Chip Erase */
+    {0, 0xC7, 0, 0, 0},
+    /* 64 KiB Block Erase */
+    {OP_ADDRESS, 0xD8, 1, 0, 0},
+    /* Exit 4-Byte Address Mode */
+    {0, 0xE9, 0, 0, 0},
+    /* Fast Read Quad I/O */
+    {OP_ADDRESS | OP_IN | OP_ARRAY, 0xEB, 4, 4, 6},
+    /* DTR Fast Read Quad I/O */
+    {OP_ADDRESS | OP_IN | OP_ARRAY | OP_DTR, 0xED, 4, 4, 6},
+    /* Read JEDEC ID */
+    {OP_IN, 0x9F, 0, 1, 0}
+};
+/*----------------------------------------------------------------------------*/
+static bool checkCommand(const struct SpimEmulator *interface,
+    const struct SpimCommand *command, const struct Operation *operation)
+{
+  const uint16_t flags = command->flags;
+  const uint8_t lanes = interface->quad ? 4 : 2;
+
+  /* Only commands with serial operation code phase are supported */
+  if (!(flags & SPIM_OPCODE) || (flags & SPIM_OPCODE_PARALLEL))
+    return false;
+
+  /* Address phase */
+  if (operation->flags & OP_ADDRESS)
+  {
+    const uint8_t width = (interface->memory.address4
+        && !(operation->flags & OP_SHORT)) ? 4 : 3;
+    const uint8_t actual = (flags & SPIM_ADDRESS_PARALLEL) ? lanes : 1;
+
+    if (command->width != width || actual != operation->address)
+      return false;
+  }
+  else if (command->width)
+    return false;
+
+  /* Mode and dummy clocks */
+  uint32_t clocks = 0;
+
+  if (flags & SPIM_POST)
+    clocks += 8 / ((flags & SPIM_POST_PARALLEL) ? lanes : 1);
+  if (command->delay)
+    clocks += command->delay * 8 / ((flags & SPIM_DELAY_PARALLEL) ? lanes : 1);
+  if (clocks != operation->clocks)
+    return false;
+
+  /* Data phase */
+  if (operation->flags & (OP_IN | OP_OUT))
+  {
+    const uint8_t actual = (flags & SPIM_DATA_PARALLEL) ? lanes : 1;
+
+    if (actual != operation->data)
+      return false;
+  }
+
+  /* Quad modes require IO2 and IO3 lines enabled by the QE bit */
+  if (operation->address == 4 || operation->data == 4)
+  {
+    if (!interface->wide || !(interface->memory.sr2 & SR2_QE))
+      return false;
+  }
+
+  /* Read commands of the memory array depend on the clocking mode */
+  if (operation->flags & OP_ARRAY)
+  {
+    const bool dtr = (operation->flags & OP_DTR) != 0;
+
+    if (dtr != interface->ddr || (dtr && !interface->dtr))
+      return false;
+  }
+
+  return true;
+}
+/*----------------------------------------------------------------------------*/
+static enum Result executeCommand(struct SpimEmulator *interface,
+    void *buffer, size_t length, bool out)
+{
+  const struct SpimCommand * const command = &interface->command;
+  const struct Operation * const operation = findOperation(command->code);
+
+  if (interface->memmap)
+    return E_BUSY;
+  if (operation == NULL || !checkCommand(interface, command, operation))
+    return E_INTERFACE;
+
+  if (command->flags & SPIM_POLL)
+  {
+    /* Poll mode is available for status registers only */
+    if (!(operation->flags & OP_STATUS) || length || out)
+      return E_INTERFACE;
+
+    const uint8_t mask = BIT(command->length);
+    uint8_t response;
+
+    do
+    {
+      updateBusy(interface, true);
+
+      if (executeOperation(interface, operation, &response, 1) != E_OK)
+        return E_INTERFACE;
+    }
+    while (response & mask);
+
+    interface->response = response;
+    return E_OK;
+  }
+
+  if (length != command->length)
+    return E_INTERFACE;
+  if (length && !(operation->flags & (out ? OP_OUT : OP_IN)))
+    return E_INTERFACE;
+
+  updateBusy(interface, false);
+  return executeOperation(interface, operation, buffer, length);
+}
+/*----------------------------------------------------------------------------*/
+static enum Result executeOperation(struct SpimEmulator *interface,
+    const struct Operation *operation, uint8_t *buffer, size_t length)
+{
+  const uint32_t mask = interface->capacity - 1;
+  const uint32_t address = interface->command.address;
+
+  if (interface->memory.sleep && operation->code != 0xAB)
+    return E_IDLE;
+  if ((interface->memory.sr1 & SR1_WIP)
+      && !(operation->flags & (OP_STATUS | OP_SUSPEND)))
+  {
+    return E_BUSY;
+  }
+
+  switch (operation->code)
+  {
+    case 0x01:
+    case 0x31:
+      if (!(interface->memory.sr1 & SR1_WEL) || !length || length > 2)
+        return E_ERROR;
+      if (interface->memory.suspended)
+        return E_ERROR;
+
+      if (operation->code == 0x01)
+      {
+        interface->memory.sr1 = (interface->memory.sr1 & ~SR1_WRITABLE_MASK)
+            | (buffer[0] & SR1_WRITABLE_MASK);
+        ++buffer;
+        --length;
+      }
+
+      if (length)
+      {
+        interface->memory.sr2 = (interface->memory.sr2 & ~SR2_WRITABLE_MASK)
+            | (buffer[0] & SR2_WRITABLE_MASK);
+      }
+
+      setBusy(interface, interface->profile.status);
+      return E_OK;
+
+    case 0x02:
+    {
+      if (!(interface->memory.sr1 & SR1_WEL))
+        return E_ERROR;
+
+      const uint32_t page = address & mask & ~(PROGRAM_PAGE_SIZE - 1);
+
+      /* Address wraps around within the page */
+      for (size_t index = 0; index < length; ++index)
+      {
+        const uint32_t offset = (address + index) & (PROGRAM_PAGE_SIZE - 1);
+        interface->data[page + offset] &= buffer[index];
+      }
+
+      setBusy(interface, interface->profile.program);
+      return E_OK;
+    }
+
+    case 0x03:
+    case 0x0B:
+    case 0x0D:
+    case 0x3B:
+    case 0x6B:
+    case 0xBB:
+    case 0xBD:
+    case 0xEB:
+    case 0xED:
+      for (size_t index = 0; index < length; ++index)
+        buffer[index] = interface->data[(address + index) & mask];
+      return E_OK;
+
+    case 0x04:
+      interface->memory.sr1 &= ~SR1_WEL;
+      return E_OK;
+
+    case 0x05:
+      if (length)
+        buffer[0] = interface->memory.sr1;
+      return E_OK;
+
+    case 0x06:
+      interface->memory.sr1 |= SR1_WEL;
+      return E_OK;
+
+    case 0x20:
+    case 0x52:
+    case 0xD8:
+    {
+      /* New erase operations are prohibited during erase suspend */
+      if (!(interface->memory.sr1 & SR1_WEL) || interface->memory.suspended)
+        return E_ERROR;
+
+      uint32_t size;
+      uint32_t time;
+
+      if (operation->code == 0x20)
+      {
+        size = 4096;
+        time = interface->profile.sector;
+      }
+      else
+      {
+        size = operation->code == 0x52 ? 32768 : 65536;
+        time = interface->profile.block;
+      }
+
+      memset(interface->data + (address & mask & ~(size - 1)), 0xFF, size);
+      setErasing(interface, time);
+      return E_OK;
+    }
+
+    case 0x35:
+      if (length)
+        buffer[0] = interface->memory.sr2;
+      return E_OK;
+
+    case 0x5A:
+      for (size_t index = 0; index < length; ++index)
+      {
+        const uint32_t offset = address + index;
+        buffer[index] = offset < SFDP_SIZE ? interface->sfdp[offset] : 0xFF;
+      }
+      return E_OK;
+
+    case 0x60:
+    case 0xC7:
+      if (!(interface->memory.sr1 & SR1_WEL) || interface->memory.suspended)
+        return E_ERROR;
+
+      memset(interface->data, 0xFF, interface->capacity);
+      setErasing(interface, interface->profile.chip);
+      return E_OK;
+
+    case 0x75:
+    {
+      /* Command is ignored when the erase operation is not running */
+      if (!interface->memory.erasing || interface->memory.suspended)
+        return E_OK;
+
+      const uint64_t time = getTime();
+      const uint64_t left = interface->deadline - time;
+
+      /* Erase does not progress during the resume overhead period */
+      interface->remaining = MIN(left, interface->remaining);
+      interface->memory.sr2 |= SR2_SUS;
+      interface->memory.suspended = true;
+
+      /* Memory stays busy until the end of the suspend latency period */
+      if (interface->profile.suspend)
+        interface->deadline = time + interface->profile.suspend * 1000ULL;
+      else
+        interface->memory.sr1 &= ~SR1_WIP;
+      return E_OK;
+    }
+
+    case 0x7A:
+      if (!interface->memory.suspended)
+        return E_OK;
+
+      interface->memory.sr1 |= SR1_WIP;
+      interface->memory.sr2 &= ~SR2_SUS;
+      interface->memory.suspended = false;
+      interface->deadline = getTime() + interface->remaining
+          + interface->profile.resume * 1000ULL;
+      return E_OK;
+
+    case 0x9F:
+    {
+      const uint8_t id[] = {
+          MANUFACTURER_ID,
+          MEMORY_TYPE,
+          (uint8_t)(31 - countLeadingZeros32(interface->capacity))
+      };
+
+      memcpy(buffer, id, MIN(length, sizeof(id)));
+      return E_OK;
+    }
+
+    case 0xAB:
+      interface->memory.sleep = false;
+      return E_OK;
+
+    case 0xB7:
+      interface->memory.address4 = true;
+      return E_OK;
+
+    case 0xB9:
+      interface->memory.sleep = true;
+      return E_OK;
+
+    case 0xE9:
+      interface->memory.address4 = false;
+      return E_OK;
+
+    default:
+      return E_INTERFACE;
+  }
+}
+/*----------------------------------------------------------------------------*/
+static const struct Operation *findOperation(uint8_t code)
+{
+  for (size_t index = 0; index < ARRAY_SIZE(operations); ++index)
+  {
+    if (operations[index].code == code)
+      return &operations[index];
+  }
+
+  return NULL;
+}
+/*----------------------------------------------------------------------------*/
+static uint64_t getTime(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+/*----------------------------------------------------------------------------*/
+static bool isCommandValid(const struct SpimCommand *command)
+{
+  if (command->width > 4)
+    return false;
+
+  if (command->flags & SPIM_POLL)
+  {
+    /* Poll mode must not be used with data write commands */
+    return command->length < 8 && !(command->flags & SPIM_WRITE);
+  }
+  else
+    return true;
+}
+/*----------------------------------------------------------------------------*/
+static void makeSfdp(struct SpimEmulator *interface)
+{
+  const bool large = interface->capacity > (1UL << 24);
+  uint32_t bfpt[SFDP_BFPT_DWORDS];
+
+  /* SFDP header, revision 1.6, one parameter header */
+  const uint8_t header[] = {
+      'S', 'F', 'D', 'P', 0x06, 0x01, 0x00, 0xFF,
+      0x00, 0x06, 0x01, SFDP_BFPT_DWORDS,
+      SFDP_BFPT_OFFSET, 0x00, 0x00, 0xFF
+  };
+  static_assert(sizeof(header) == SFDP_BFPT_OFFSET);
+
+  memset(bfpt, 0, sizeof(bfpt));
+
+  /* 4 KiB erase, 1-1-2 and 1-2-2 reads, optional DTR and quad reads */
+  bfpt[0] = 0xFF800000UL | 0x00012000UL | 0x00100000UL | 0x00000005UL;
+  if (large)
+    bfpt[0] |= 0x00020000UL;
+  if (interface->dtr)
+    bfpt[0] |= 0x00080000UL;
+  if (interface->wide)
+    bfpt[0] |= 0x00600000UL;
+
+  /* Memory density in bits */
+  bfpt[1] = interface->capacity * 8 - 1;
+
+  /* 1-4-4 read EBh with 2 mode and 4 dummy clocks, 1-1-4 read 6Bh */
+  if (interface->wide)
+    bfpt[2] = 0x6B08EB44UL;
+
+  /* 1-1-2 read 3Bh with 8 dummy clocks, 1-2-2 read BBh with 4 mode clocks */
+  bfpt[3] = 0xBB803B08UL;
+
+  /* 2-2-2 and 4-4-4 modes are not supported */
+  bfpt[4] = 0xFFFFFFEEUL;
+  bfpt[5] = 0x0000FFFFUL;
+  bfpt[6] = 0x0000FFFFUL;
+
+  /* Erase types: 4 KiB 20h, 32 KiB 52h, 64 KiB D8h */
+  bfpt[7] = 0x520F200CUL;
+  bfpt[8] = 0x0000D810UL;
+
+  /* 256 byte pages */
+  bfpt[10] = 0x00000080UL;
+
+  /* Erase suspend latency in microseconds and resume to suspend interval */
+  const uint32_t latency = MIN(MAX(interface->profile.suspend, 1), 32) - 1;
+  const uint32_t interval =
+      MIN(MAX((interface->profile.resume + 63) / 64, 1), 16) - 1;
+
+  bfpt[11] = 0x20000000UL | (latency << 24) | (interval << 20)
+      | 0x00040000UL | (latency << 13);
+
+  /* Suspend 75h and resume 7Ah commands for erase and program operations */
+  bfpt[12] = 0x757A757AUL;
+
+  /* Quad Enable is bit 1 of the Status Register 2 */
+  if (interface->wide)
+    bfpt[14] = 0x00400000UL;
+
+  /* 4-byte address mode is entered with B7h command */
+  if (large)
+    bfpt[15] = 0x01000000UL;
+
+  memcpy(interface->sfdp, header, sizeof(header));
+  for (size_t index = 0; index < ARRAY_SIZE(bfpt); ++index)
+  {
+    const uint32_t value = toLittleEndian32(bfpt[index]);
+    memcpy(interface->sfdp + SFDP_BFPT_OFFSET + index * 4, &value, 4);
+  }
+}
+/*----------------------------------------------------------------------------*/
+static enum Result runSequence(struct SpimEmulator *interface)
+{
+  while (interface->sequence.count)
+  {
+    const struct SpimCommand * const command = interface->sequence.commands++;
+    const size_t length = (command->flags & SPIM_POLL) ? 0 : command->length;
+    enum Result res;
+
+    --interface->sequence.count;
+
+    if (!(command->flags & SPIM_PREPARED) && !isCommandValid(command))
+      res = E_VALUE;
+    else
+    {
+      interface->command = *command;
+      res = executeCommand(interface, command->buffer, length,
+          (command->flags & SPIM_WRITE) != 0);
+    }
+
+    if (res != E_OK)
+    {
+      interface->sequence.count = 0;
+      return res;
+    }
+  }
+
+  return E_OK;
+}
+/*----------------------------------------------------------------------------*/
+static void setBusy(struct SpimEmulator *interface, uint32_t time)
+{
+  interface->memory.sr1 &= ~SR1_WEL;
+
+  if (interface->realtime && time)
+  {
+    interface->memory.sr1 |= SR1_WIP;
+    interface->deadline = getTime() + (uint64_t)time * 1000;
+  }
+}
+/*----------------------------------------------------------------------------*/
+static void setErasing(struct SpimEmulator *interface, uint32_t time)
+{
+  setBusy(interface, time);
+
+  if (interface->memory.sr1 & SR1_WIP)
+  {
+    interface->memory.erasing = true;
+    interface->remaining = (uint64_t)time * 1000;
+  }
+}
+/*----------------------------------------------------------------------------*/
+static void updateBusy(struct SpimEmulator *interface, bool wait)
+{
+  if (!(interface->memory.sr1 & SR1_WIP))
+    return;
+
+  if (wait)
+  {
+    const struct timespec deadline = {
+        .tv_sec = (time_t)(interface->deadline / 1000000000ULL),
+        .tv_nsec = (long)(interface->deadline % 1000000000ULL)
+    };
+
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, NULL)
+        == EINTR);
+  }
+
+  if (getTime() >= interface->deadline)
+  {
+    interface->memory.sr1 &= ~SR1_WIP;
+
+    if (!interface->memory.suspended)
+      interface->memory.erasing = false;
+  }
+}
+/*----------------------------------------------------------------------------*/
+static enum Result emuInit(void *object, const void *configBase)
+{
+  const struct SpimEmulatorConfig * const config = configBase;
+  assert(config != NULL);
+
+  struct SpimEmulator * const interface = object;
+
+  if (config->capacity < MIN_CAPACITY || config->capacity > MAX_CAPACITY
+      || (config->capacity & (config->capacity - 1)))
+  {
+    return E_VALUE;
+  }
+
+  interface->data = malloc(config->capacity);
+  if (interface->data == NULL)
+    return E_MEMORY;
+  memset(interface->data, 0xFF, config->capacity);
+
+  interface->callback = NULL;
+  interface->callbackArgument = NULL;
+  interface->deadline = 0;
+  interface->remaining = 0;
+  interface->capacity = config->capacity;
+  interface->sequence.commands = NULL;
+  interface->sequence.count = 0;
+  interface->command = (struct SpimCommand){0};
+  interface->response = 0;
+  interface->status = E_OK;
+  interface->blocking = true;
+  interface->ddr = false;
+  interface->dtr = config->dtr;
+  interface->memmap = false;
+  interface->quad = false;
+  interface->realtime = config->profile != NULL;
+  interface->wide = config->wide;
+
+  memset(&interface->memory, 0, sizeof(interface->memory));
+
+  if (config->profile != NULL)
+    interface->profile = *config->profile;
+  else
+    memset(&interface->profile, 0, sizeof(interface->profile));
+
+  makeSfdp(interface);
+  return E_OK;
+}
+/*----------------------------------------------------------------------------*/
+static void emuDeinit(void *object)
+{
+  struct SpimEmulator * const interface = object;
+  free(interface->data);
+}
+/*----------------------------------------------------------------------------*/
+static void emuSetCallback(void *object, void (*callback)(void *),
+    void *argument)
+{
+  struct SpimEmulator * const interface = object;
+
+  interface->callbackArgument = argument;
+  interface->callback = callback;
+}
+/*----------------------------------------------------------------------------*/
+static enum Result emuGetParam(void *object, int parameter, void *data)
+{
+  struct SpimEmulator * const interface = object;
+
+  switch ((enum SPIMParameter)parameter)
+  {
+    case IF_SPIM_MODE:
+      *(uint8_t *)data = 0;
+      return E_OK;
+
+    case IF_SPIM_MEMORY_MAPPED_ADDRESS:
+      *(uintptr_t *)data = (uintptr_t)interface->data;
+      return E_OK;
+
+    case IF_SPIM_RESPONSE:
+      *(uint32_t *)data = (uint32_t)interface->response;
+      return E_OK;
+
+    case IF_SPIM_PREPARE:
+    {
+      struct SpimCommand * const command = data;
+
+      if (!isCommandValid(command))
+        return E_VALUE;
+
+      command->prepared = 0;
+      command->flags |= SPIM_PREPARED;
+      return E_OK;
+    }
+
+    default:
+      break;
+  }
+
+  switch ((enum IfParameter)parameter)
+  {
+    case IF_SIZE:
+      *(uint32_t *)data = interface->capacity;
+      return E_OK;
+
+    case IF_STATUS:
+      return interface->memmap ? E_BUSY : interface->status;
+
+    default:
+      return E_INVALID;
+  }
+}
+/*----------------------------------------------------------------------------*/
+static enum Result emuSetParam(void *object, int parameter, const void *data)
+{
+  struct SpimEmulator * const interface = object;
+
+  /* Changes of command fields invalidate the prepared command */
+  if (parameter >= IF_SPIM_COMMAND && parameter <= IF_SPIM_DATA_SERIAL)
+    interface->command.flags &= ~SPIM_PREPARED;
+
+  switch ((enum SPIMParameter)parameter)
+  {
+    case IF_SPIM_MODE:
+    {
+      const uint8_t mode = *(const uint8_t *)data;
+      return mode == 0 || mode == 3 ? E_OK : E_VALUE;
+    }
+
+    case IF_SPIM_DUAL:
+      interface->quad = false;
+      return E_OK;
+
+    case IF_SPIM_QUAD:
+      if (interface->wide)
+      {
+        interface->quad = true;
+        return E_OK;
+      }
+      else
+        return E_VALUE;
+
+    case IF_SPIM_SDR:
+      interface->ddr = false;
+      return E_OK;
+
+    case IF_SPIM_DDR:
+      if (interface->dtr)
+      {
+        interface->ddr = true;
+        return E_OK;
+      }
+      else
+        return E_VALUE;
+
+    case IF_SPIM_INDIRECT:
+      interface->memmap = false;
+      return E_OK;
+
+    case IF_SPIM_MEMORY_MAPPED:
+    {
+      const struct Operation * const operation =
+          findOperation(interface->command.code);
+
+      /* Only read commands of the memory array can be memory-mapped */
+      if (operation == NULL || !(operation->flags & OP_ARRAY)
+          || !checkCommand(interface, &interface->command, operation))
+      {
+        return E_VALUE;
+      }
+
+      updateBusy(interface, true);
+      interface->memmap = true;
+      return E_OK;
+    }
+
+    case IF_SPIM_COMMAND:
+      interface->command.code = *(const uint8_t *)data;
+      interface->command.flags |= SPIM_OPCODE;
+      return E_OK;
+
+    case IF_SPIM_COMMAND_NONE:
+      interface->command.flags &= ~SPIM_OPCODE;
+      return E_OK;
+
+    case IF_SPIM_COMMAND_PARALLEL:
+      interface->command.flags |= SPIM_OPCODE_PARALLEL;
+      return E_OK;
+
+    case IF_SPIM_COMMAND_SERIAL:
+      interface->command.flags &= ~SPIM_OPCODE_PARALLEL;
+      return E_OK;
+
+    case IF_SPIM_DELAY_LENGTH:
+      interface->command.delay = *(const uint8_t *)data;
+      return E_OK;
+
+    case IF_SPIM_DELAY_NONE:
+      interface->command.delay = 0;
+      return E_OK;
+
+    case IF_SPIM_DELAY_PARALLEL:
+      interface->command.flags |= SPIM_DELAY_PARALLEL;
+      return E_OK;
+
+    case IF_SPIM_DELAY_SERIAL:
+      interface->command.flags &= ~SPIM_DELAY_PARALLEL;
+      return E_OK;
+
+    case IF_SPIM_ADDRESS_8:
+    case IF_SPIM_ADDRESS_16:
+      /* Unsupported operand type */
+      return E_VALUE;
+
+    case IF_SPIM_ADDRESS_24:
+      interface->command.address = *(const uint32_t *)data;
+      interface->command.width = 3;
+      return E_OK;
+
+    case IF_SPIM_ADDRESS_32:
+      interface->command.address = *(const uint32_t *)data;
+      interface->command.width = 4;
+      return E_OK;
+
+    case IF_SPIM_ADDRESS_NONE:
+      interface->command.width = 0;
+      return E_OK;
+
+    case IF_SPIM_ADDRESS_PARALLEL:
+      interface->command.flags |= SPIM_ADDRESS_PARALLEL;
+      return E_OK;
+
+    case IF_SPIM_ADDRESS_SERIAL:
+      interface->command.flags &= ~SPIM_ADDRESS_PARALLEL;
+      return E_OK;
+
+    case IF_SPIM_POST_ADDRESS_8:
+      interface->command.post = (uint8_t)*(const uint32_t *)data;
+      interface->command.flags |= SPIM_POST;
+      return E_OK;
+
+    case IF_SPIM_POST_ADDRESS_NONE:
+      interface->command.flags &= ~SPIM_POST;
+      return E_OK;
+
+    case IF_SPIM_POST_ADDRESS_PARALLEL:
+      interface->command.flags |= SPIM_POST_PARALLEL;
+      return E_OK;
+
+    case IF_SPIM_POST_ADDRESS_SERIAL:
+      interface->command.flags &= ~SPIM_POST_PARALLEL;
+      return E_OK;
+
+    case IF_SPIM_DATA_LENGTH:
+      interface->command.length = *(const uint32_t *)data;
+      return E_OK;
+
+    case IF_SPIM_DATA_NONE:
+      interface->command.length = 0;
+      return E_OK;
+
+    case IF_SPIM_DATA_POLL_BIT:
+    {
+      const uint8_t value = *(const uint8_t *)data;
+
+      if (value < 8)
+      {
+        interface->command.length = value;
+        interface->command.flags |= SPIM_POLL;
+        return E_OK;
+      }
+      else
+        return E_VALUE;
+    }
+
+    case IF_SPIM_DATA_PARALLEL:
+      interface->command.flags |= SPIM_DATA_PARALLEL;
+      return E_OK;
+
+    case IF_SPIM_DATA_SERIAL:
+      interface->command.flags &= ~SPIM_DATA_PARALLEL;
+      return E_OK;
+
+    case IF_SPIM_LOAD:
+    {
+      const struct SpimCommand * const command = data;
+
+      if (!(command->flags & SPIM_PREPARED) && !isCommandValid(command))
+        return E_VALUE;
+
+      interface->command = *command;
+      return E_OK;
+    }
+
+    case IF_SPIM_SEQUENCE:
+    {
+      const struct SpimSequence * const sequence = data;
+
+      if (!sequence->count)
+        return E_VALUE;
+
+      interface->sequence.commands = sequence->commands;
+      interface->sequence.count = sequence->count;
+      interface->status = runSequence(interface);
+
+      if (interface->blocking)
+        return interface->status == E_OK ? E_OK : E_INTERFACE;
+
+      /* Sequence is completed immediately, callback is called in place */
+      if (interface->callback != NULL)
+        interface->callback(interface->callbackArgument);
+      return E_BUSY;
+    }
+
+    default:
+      break;
+  }
+
+  switch ((enum IfParameter)parameter)
+  {
+    case IF_BLOCKING:
+      interface->blocking = true;
+      return E_OK;
+
+    case IF_ZEROCOPY:
+      interface->blocking = false;
+      return E_OK;
+
+    default:
+      return E_INVALID;
+  }
+}
+/*----------------------------------------------------------------------------*/
+static size_t emuRead(void *object, void *buffer, size_t length)
+{
+  struct SpimEmulator * const interface = object;
+
+  interface->status = executeCommand(interface, buffer, length, false);
+  interface->command.flags &= ~SPIM_POLL;
+
+  if (!interface->blocking && interface->callback != NULL)
+    interface->callback(interface->callbackArgument);
+
+  return interface->status == E_OK ? length : 0;
+}
+/*----------------------------------------------------------------------------*/
+static size_t emuWrite(void *object, const void *buffer, size_t length)
+{
+  struct SpimEmulator * const interface = object;
+
+  /* Buffer is not modified during write commands */
+  interface->status = executeCommand(interface, (void *)buffer, length, true);
+
+  if (!interface->blocking && interface->callback != NULL)
+    interface->callback(interface->callbackArgument);
+
+  return interface->status == E_OK ? length : 0;
+}
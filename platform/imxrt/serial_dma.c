@@ -14,6 +14,10 @@
 #include <xcore/containers/byte_queue.h>
 #include <malloc.h>
 #include <string.h>
+
+#ifdef CONFIG_GENERIC_MEMORY_REGION
+#  include <halm/generic/memory_region.h>
+#endif
 /*----------------------------------------------------------------------------*/
 #define MEM_ALIGNMENT CONFIG_CORE_CORTEX_CACHE_LINE
 /*----------------------------------------------------------------------------*/
@@ -45,6 +49,10 @@ struct SerialDma
 
   /* Queues are allocated in a static memory */
   bool preallocated;
+  /* Reception buffer does not require cache maintenance */
+  bool rxCoherent;
+  /* Output queue does not require cache maintenance */
+  bool txCoherent;
 
 #ifdef CONFIG_PLATFORM_IMXRT_LPUART_PM
   /* Desired baud rate */
@@ -62,6 +70,7 @@ struct SerialDma
 static bool dmaSetup(struct SerialDma *, uint8_t, uint8_t, enum EdmaPriority);
 static enum Result enqueueRxBuffer(struct SerialDma *);
 static enum Result enqueueTxBuffers(struct SerialDma *);
+static bool isCoherentMemory(const void *, size_t);
 static bool readResidue(struct SerialDma *);
 static void rxDmaHandler(void *);
 static void serialInterruptHandler(void *);
@@ -184,6 +193,18 @@ static enum Result enqueueTxBuffers(struct SerialDma *interface)
   return res;
 }
 /*----------------------------------------------------------------------------*/
+static bool isCoherentMemory(const void *address, size_t size)
+{
+#ifdef CONFIG_GENERIC_MEMORY_REGION
+  return (memoryRegionGetFlags(address, size) & MEMORY_COHERENT) != 0;
+#else
+  (void)address;
+  (void)size;
+
+  return false;
+#endif
+}
+/*----------------------------------------------------------------------------*/
 static bool readResidue(struct SerialDma *interface)
 {
   size_t residue;
@@ -208,7 +229,8 @@ static bool readResidue(struct SerialDma *interface)
   {
     const uint8_t * const address = interface->rxBuffer + interface->rxPosition;
 
-    dCacheInvalidate((uintptr_t)address, count);
+    if (!interface->rxCoherent)
+      dCacheInvalidate((uintptr_t)address, count);
     byteQueuePushArray(&interface->rxQueue, address, count);
     interface->rxPosition += count;
 
@@ -234,7 +256,8 @@ static void rxDmaHandler(void *object)
   {
     const uint8_t * const address = interface->rxBuffer + interface->rxPosition;
 
-    dCacheInvalidate((uintptr_t)address, count);
+    if (!interface->rxCoherent)
+      dCacheInvalidate((uintptr_t)address, count);
     byteQueuePushArray(&interface->rxQueue, address, count);
     updateRxWatermark(interface, byteQueueSize(&interface->rxQueue));
 
@@ -343,6 +366,7 @@ static enum Result serialInit(void *object, const void *configBase)
         arena + config->txLength);
 
     interface->preallocated = true;
+    interface->txCoherent = isCoherentMemory(arena, config->txLength);
   }
   else
   {
@@ -357,12 +381,20 @@ static enum Result serialInit(void *object, const void *configBase)
       return E_MEMORY;
 
     interface->preallocated = false;
+    interface->txCoherent = false;
   }
 
   /* Allocate aligned memory chunk for a circular input buffer */
+#ifdef CONFIG_GENERIC_MEMORY_REGION
+  interface->rxBuffer = memoryRegionAlloc(MEMORY_HINT_DMA, config->rxChunk,
+      MEM_ALIGNMENT);
+#else
   interface->rxBuffer = memalign(MEM_ALIGNMENT, config->rxChunk);
+#endif
   if (interface->rxBuffer == NULL)
     return E_MEMORY;
+  interface->rxCoherent = isCoherentMemory(interface->rxBuffer,
+      config->rxChunk);
 
   interface->base.handler = serialInterruptHandler;
   interface->callback = NULL;
@@ -448,7 +480,11 @@ static void serialDeinit(void *object)
   deinit(interface->rxDma);
 
   /* Free the reception buffer */
+#ifdef CONFIG_GENERIC_MEMORY_REGION
+  memoryRegionFree(interface->rxBuffer);
+#else
   free(interface->rxBuffer);
+#endif
 
   if (interface->preallocated)
   {
@@ -635,7 +671,8 @@ static size_t serialWrite(void *object, const void *buffer, size_t length)
 
     state = irqSave();
     byteQueueAdvance(&interface->txQueue, count);
-    dCacheClean((uintptr_t)address, count);
+    if (!interface->txCoherent)
+      dCacheClean((uintptr_t)address, count);
     irqRestore(state);
 
     position += count;
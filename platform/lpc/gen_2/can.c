@@ -5,6 +5,7 @@
  */
 
 #include <halm/generic/can.h>
+#include <halm/generic/can_filter.h>
 #include <halm/generic/pointer_array.h>
 #include <halm/generic/pointer_queue.h>
 #include <halm/platform/lpc/can.h>
@@ -36,18 +37,10 @@ enum Mode
   MODE_LOOPBACK
 };
 /*----------------------------------------------------------------------------*/
-typedef struct
-{
-  uint32_t id;
-  uint32_t mask;
-} CanFilterEntry;
-
 enum
 {
   CAN_FILTER_ENTRY_EXT = 1UL << 29
 };
-
-DEFINE_ARRAY(CanFilterEntry, Filter, filter)
 /*----------------------------------------------------------------------------*/
 struct Can
 {
@@ -71,8 +64,8 @@ struct Can
   uint32_t rate;
 
 #ifdef CONFIG_PLATFORM_LPC_CAN_FILTERS
-  /* Filter entries */
-  FilterArray filters;
+  /* Filter entries, also used for software filtering */
+  struct CanFilterEngine filters;
 #endif
 
 #ifdef CONFIG_PLATFORM_LPC_CAN_WATERMARK
@@ -94,6 +87,7 @@ struct Can
 #endif
 };
 /*----------------------------------------------------------------------------*/
+static bool acceptMessage(struct Can *, const struct CANStandardMessage *);
 static void buildAcceptanceFilters(struct Can *);
 static bool calcSegments(uint8_t, uint8_t *, uint8_t *);
 static bool calcTimings(const struct Can *, uint32_t, uint32_t *, uint32_t *);
@@ -144,22 +138,45 @@ const struct InterfaceClass * const Can = &(const struct InterfaceClass){
     .write = canWrite
 };
 /*----------------------------------------------------------------------------*/
+static bool acceptMessage(struct Can *interface,
+    const struct CANStandardMessage *message)
+{
+#ifdef CONFIG_PLATFORM_LPC_CAN_FILTERS
+  /* Message Objects accept all frames when there are too many rules */
+  if (canFilterEngineSize(&interface->filters) > RX_COUNT)
+  {
+    return canFilterEngineAccept(&interface->filters, message->id,
+        (message->flags & CAN_EXT_ID) != 0);
+  }
+#else
+  (void)interface;
+  (void)message;
+#endif
+
+  return true;
+}
+/*----------------------------------------------------------------------------*/
 static void buildAcceptanceFilters(struct Can *interface)
 {
 #ifdef CONFIG_PLATFORM_LPC_CAN_FILTERS
-  if (!filterArrayEmpty(&interface->filters))
+  const size_t rules = canFilterEngineSize(&interface->filters);
+
+  if (rules && rules <= RX_COUNT)
   {
-    const size_t width = RX_COUNT / filterArraySize(&interface->filters);
+    const size_t width = RX_COUNT / rules;
     size_t offset = RX_OBJECT;
 
-    for (size_t rule = 0; rule < filterArraySize(&interface->filters); ++rule)
+    for (size_t rule = 0; rule < rules; ++rule)
     {
-      const CanFilterEntry entry = *filterArrayAt(&interface->filters, rule);
+      const struct CanFilterRule * const entry =
+          canFilterEngineRule(&interface->filters, rule);
+      const uint32_t id = entry->id;
+      const uint32_t mask = entry->mask & ~CAN_FILTER_ENTRY_EXT;
 
       for (size_t index = 0; index < width; ++index)
       {
         invalidateMessageObject(interface, index + offset);
-        listenForMessage(interface, index + offset, entry.id, entry.mask);
+        listenForMessage(interface, index + offset, id, mask);
       }
 
       offset += width;
@@ -374,11 +391,15 @@ static void interruptHandler(void *object)
         {
           struct CANStandardMessage * const message =
               pointerArrayBack(&interface->pool);
-          pointerArrayPopBack(&interface->pool);
 
           readMessage(interface, message, id);
-          message->timestamp = timestamp;
-          pointerQueuePushBack(&interface->rxQueue, message);
+
+          if (acceptMessage(interface, message))
+          {
+            pointerArrayPopBack(&interface->pool);
+            message->timestamp = timestamp;
+            pointerQueuePushBack(&interface->rxQueue, message);
+          }
         }
         else
         {
@@ -736,24 +757,11 @@ static void writeMessage(struct Can *interface,
 static bool filterAdd(struct Can *interface, const struct CANFilter *filter,
     bool ext)
 {
-  if (filterArrayFull(&interface->filters))
-    return false;
-
-  CanFilterEntry entry;
-
-  if (ext)
-  {
-    entry.id = (filter->id & MASK(29)) | CAN_FILTER_ENTRY_EXT;
-    entry.mask = filter->mask & MASK(29);
-  }
-  else
-  {
-    entry.id = filter->id & MASK(11);
-    entry.mask = filter->mask & MASK(11);
-  }
+  irqDisable(interface->base.irq);
+  const bool added = canFilterEngineAdd(&interface->filters, filter, ext);
+  irqEnable(interface->base.irq);
 
-  filterArrayPushBack(&interface->filters, entry);
-  return true;
+  return added;
 }
 #endif
 /*----------------------------------------------------------------------------*/
@@ -761,34 +769,11 @@ static bool filterAdd(struct Can *interface, const struct CANFilter *filter,
 static bool filterRemove(struct Can *interface, const struct CANFilter *filter,
     bool ext)
 {
-  CanFilterEntry target;
-  bool matched = false;
-
-  if (ext)
-  {
-    target.id = (filter->id & MASK(29)) | CAN_FILTER_ENTRY_EXT;
-    target.mask = filter->mask & MASK(29);
-  }
-  else
-  {
-    target.id = filter->id & MASK(11);
-    target.mask = filter->mask & MASK(11);
-  }
-
-  for (size_t index = 0; index < filterArraySize(&interface->filters);)
-  {
-    const CanFilterEntry entry = *filterArrayAt(&interface->filters, index);
-
-    if (entry.id == target.id && entry.mask == target.mask)
-    {
-      filterArrayErase(&interface->filters, index);
-      matched = true;
-    }
-    else
-      ++index;
-  }
+  irqDisable(interface->base.irq);
+  const bool removed = canFilterEngineRemove(&interface->filters, filter, ext);
+  irqEnable(interface->base.irq);
 
-  return matched;
+  return removed;
 }
 #endif
 /*----------------------------------------------------------------------------*/
@@ -807,7 +792,6 @@ static enum Result canInit(void *object, const void *configBase)
 {
   const struct CanConfig * const config = configBase;
   assert(config != NULL);
-  assert(config->filters <= RX_COUNT);
 
   const struct CanBaseConfig baseConfig = {
       .rx = config->rx,
@@ -835,7 +819,7 @@ static enum Result canInit(void *object, const void *configBase)
     return E_MEMORY;
 
 #ifdef CONFIG_PLATFORM_LPC_CAN_FILTERS
-  if (!filterArrayInit(&interface->filters, config->filters))
+  if (!canFilterEngineInit(&interface->filters, config->filters))
     return E_MEMORY;
 #endif
 
@@ -916,7 +900,7 @@ static void canDeinit(void *object)
 #endif
 
 #ifdef CONFIG_PLATFORM_LPC_CAN_FILTERS
-  filterArrayDeinit(&interface->filters);
+  canFilterEngineDeinit(&interface->filters);
 #endif
 
   free(interface->arena);
@@ -964,6 +948,16 @@ static enum Result canGetParam(void *object, int parameter, void *data)
       break;
 #endif
 
+#ifdef CONFIG_PLATFORM_LPC_CAN_FILTERS
+    case IF_CAN_FILTER_HITS:
+      *(uint32_t *)data = interface->filters.hits;
+      return E_OK;
+
+    case IF_CAN_FILTER_DROPS:
+      *(uint32_t *)data = interface->filters.drops;
+      return E_OK;
+#endif
+
     default:
       break;
   }
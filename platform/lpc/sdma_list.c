@@ -35,6 +35,7 @@ static enum Result channelResidue(const void *, size_t *);
 static enum Result channelStatus(const void *);
 
 static void channelAppend(void *, void *, const void *, size_t);
+static void channelAppendVector(void *, const struct DmaVector *, size_t);
 static void channelClear(void *);
 static size_t channelQueued(const void *);
 /*----------------------------------------------------------------------------*/
@@ -52,6 +53,7 @@ const struct DmaClass * const SdmaList = &(const struct DmaClass){
     .status = channelStatus,
 
     .append = channelAppend,
+    .appendVector = channelAppendVector,
     .clear = channelClear,
     .queued = channelQueued
 };
@@ -160,6 +162,7 @@ static enum Result channelInit(void *object, const void *configBase)
   channel->capacity = config->number;
   channel->index = 0;
   channel->queued = 0;
+  channel->length = 0;
   channel->transferConfig = 0;
   channel->state = STATE_IDLE;
 
@@ -211,7 +214,7 @@ static enum Result channelEnable(void *object)
   const uint8_t number = channel->base.number;
   const uint32_t mask = 1UL << number;
 
-  assert(channel->state == STATE_READY);
+  assert(channel->state == STATE_READY || channel->state == STATE_DONE);
 
   if (!sdmaSetInstance(number, object))
   {
@@ -219,6 +222,15 @@ static enum Result channelEnable(void *object)
     return E_BUSY;
   }
 
+  /* Descriptors of the completed chain are left intact and can be reused */
+  if (channel->state == STATE_DONE)
+    channel->queued = channel->length;
+
+  size_t index = channel->index + channel->capacity - channel->queued;
+
+  if (index >= channel->capacity)
+    index -= channel->capacity;
+
   sdmaSetMux(&channel->base);
   channel->state = STATE_BUSY;
 
@@ -229,7 +241,7 @@ static enum Result channelEnable(void *object)
   LPC_SDMA->INTENSET = mask;
 
   /* Start the transfer */
-  startTransfer(channel, &channel->list[0]);
+  startTransfer(channel, &channel->list[index]);
 
   return E_OK;
 }
@@ -302,6 +314,13 @@ static enum Result channelStatus(const void *object)
 /*----------------------------------------------------------------------------*/
 static void channelAppend(void *object, void *destination, const void *source,
     size_t size)
+{
+  const struct DmaVector vector = {destination, source, size};
+  channelAppendVector(object, &vector, 1);
+}
+/*----------------------------------------------------------------------------*/
+static void channelAppendVector(void *object, const struct DmaVector *vector,
+    size_t count)
 {
   struct SdmaList * const channel = object;
 
@@ -311,47 +330,62 @@ static void channelAppend(void *object, void *destination, const void *source,
   const unsigned int srcStride =
       (1 << XFERCFG_SRCINC_VALUE(transferConfig)) >> 1;
   const unsigned int width = XFERCFG_WIDTH_VALUE(transferConfig);
-  const uint32_t count = (size >> width) - 1;
 
-  assert(destination != NULL && source != NULL);
-  assert(!((uintptr_t)destination % (1 << width)));
-  assert(!((uintptr_t)source % (1 << width)));
-  assert(count <= SDMA_MAX_TRANSFER_SIZE && ((count + 1) << width) == size);
-  assert(channel->queued < channel->capacity);
+  assert(count > 0);
 
   if (channel->state == STATE_DONE || channel->state == STATE_ERROR)
   {
     channel->index = 0;
     channel->queued = 0;
+    channel->length = 0;
   }
 
-  struct SdmaEntry * const entry = channel->list + channel->index;
+  assert(channel->queued + count <= channel->capacity);
+
   struct SdmaEntry *previous = NULL;
 
   if (channel->queued)
   {
     /* There are initialized entries in the list */
-    previous = channel->index ? entry : channel->list + channel->capacity;
-    --previous;
+    previous = channel->list
+        + (channel->index ? channel->index : channel->capacity) - 1;
   }
 
-  if (++channel->index >= channel->capacity)
-    channel->index = 0;
+  for (size_t position = 0; position < count; ++position)
+  {
+    const uintptr_t destination = (uintptr_t)vector[position].destination;
+    const uintptr_t source = (uintptr_t)vector[position].source;
+    const size_t size = vector[position].size;
+    const uint32_t number = (size >> width) - 1;
 
-  entry->source = (uintptr_t)source + (count << width) * srcStride;
-  entry->destination = (uintptr_t)destination + (count << width) * dstStride;
-  entry->config = transferConfig | XFERCFG_XFERCOUNT(count);
-  entry->next = 0;
+    assert(destination != 0 && source != 0);
+    assert(!(destination % (1 << width)));
+    assert(!(source % (1 << width)));
+    assert(number <= SDMA_MAX_TRANSFER_SIZE && ((number + 1) << width) == size);
 
-  if (previous != NULL)
-  {
-    /* Link previous descriptor with the new one */
-    previous->next = (uintptr_t)entry;
-    /* Enable descriptor reload */
-    previous->config |= XFERCFG_RELOAD;
+    struct SdmaEntry * const entry = channel->list + channel->index;
+
+    if (++channel->index >= channel->capacity)
+      channel->index = 0;
+
+    entry->source = source + (number << width) * srcStride;
+    entry->destination = destination + (number << width) * dstStride;
+    entry->config = transferConfig | XFERCFG_XFERCOUNT(number);
+    entry->next = 0;
+
+    if (previous != NULL)
+    {
+      /* Link previous descriptor with the new one */
+      previous->next = (uintptr_t)entry;
+      /* Enable descriptor reload */
+      previous->config |= XFERCFG_RELOAD;
+    }
+
+    previous = entry;
+    ++channel->queued;
   }
 
-  ++channel->queued;
+  channel->length = MIN(channel->length + count, channel->capacity);
 
   if (channel->state != STATE_BUSY)
     channel->state = STATE_READY;
@@ -363,6 +397,7 @@ static void channelClear(void *object)
 
   channel->index = 0;
   channel->queued = 0;
+  channel->length = 0;
   channel->state = STATE_IDLE;
 }
 /*----------------------------------------------------------------------------*/
@@ -18,13 +18,19 @@ enum
   STATUS_ERROR
 };
 /*----------------------------------------------------------------------------*/
+static bool continueSequence(struct Spifi *);
 static bool dmaSetup(struct Spifi *, uint8_t);
 static void enableIndirectMode(struct Spifi *);
 static void enableMemoryMappingMode(struct Spifi *);
 static void executeCommand(struct Spifi *, bool);
+static bool loadCommand(struct Spifi *, const struct SpimCommand *);
 static uint32_t makeCommand(const struct Spifi *);
+static bool makeFrame(const struct SpimCommand *, uint32_t *);
+static size_t readData(struct Spifi *, void *, size_t);
 static void resetContext(struct Spifi *);
 static void resetMode(struct Spifi *);
+static bool startNextCommand(struct Spifi *);
+static size_t writeData(struct Spifi *, const void *, size_t);
 static void dmaInterruptHandler(void *);
 static void spifiInterruptHandler(void *);
 /*----------------------------------------------------------------------------*/
@@ -48,6 +54,20 @@ const struct InterfaceClass * const Spifi = &(const struct InterfaceClass){
     .write = spifiWrite
 };
 /*----------------------------------------------------------------------------*/
+static bool continueSequence(struct Spifi *interface)
+{
+  if (interface->sequence.count && interface->status != STATUS_ERROR)
+  {
+    if (startNextCommand(interface))
+      return true;
+
+    interface->status = STATUS_ERROR;
+  }
+
+  interface->sequence.count = 0;
+  return false;
+}
+/*----------------------------------------------------------------------------*/
 static bool dmaSetup(struct Spifi *interface, uint8_t channel)
 {
   const struct GpDmaOneShotConfig dmaConfigs[] = {
@@ -149,14 +169,51 @@ static void executeCommand(struct Spifi *interface, bool out)
     command |= CMD_DOUT;
   }
 
-  if (interface->address.length)
-    reg->ADDR = interface->address.value;
-  if (interface->post.length)
-    reg->IDATA = interface->post.value;
+  if (interface->command.width)
+    reg->ADDR = interface->command.address;
+  if (interface->command.flags & SPIM_POST)
+    reg->IDATA = interface->command.post;
   reg->CMD = command;
 }
 /*----------------------------------------------------------------------------*/
+static bool loadCommand(struct Spifi *interface,
+    const struct SpimCommand *command)
+{
+  uint32_t frame = command->prepared;
+
+  if (!(command->flags & SPIM_PREPARED) && !makeFrame(command, &frame))
+    return false;
+
+  interface->command = *command;
+  interface->command.prepared = frame;
+  interface->command.flags |= SPIM_PREPARED;
+
+  return true;
+}
+/*----------------------------------------------------------------------------*/
 static uint32_t makeCommand(const struct Spifi *interface)
+{
+  const struct SpimCommand * const command = &interface->command;
+  uint32_t value;
+
+  if (command->flags & SPIM_PREPARED)
+  {
+    value = command->prepared;
+  }
+  else
+  {
+    [[maybe_unused]] const bool valid = makeFrame(command, &value);
+    assert(valid);
+  }
+
+  value |= CMD_DATALEN(command->length);
+  if (command->flags & SPIM_POLL)
+    value |= CMD_POLL;
+
+  return value;
+}
+/*----------------------------------------------------------------------------*/
+static bool makeFrame(const struct SpimCommand *command, uint32_t *frame)
 {
   enum FieldPacking
   {
@@ -173,7 +230,9 @@ static uint32_t makeCommand(const struct Spifi *interface)
       FRAMEFORM_OPCODE_ADDRESS_32
   };
 
-  const uint8_t delay = interface->delay.length + interface->post.length;
+  const uint16_t flags = command->flags;
+  const bool post = (flags & SPIM_POST) != 0;
+  const uint8_t delay = command->delay + (post ? 1 : 0);
   enum FieldPacking packCommand = PACK_DISABLED;
   enum FieldPacking packAddress = PACK_DISABLED;
   enum FieldPacking packPost = PACK_DISABLED;
@@ -181,55 +240,65 @@ static uint32_t makeCommand(const struct Spifi *interface)
   uint8_t fieldform;
   uint8_t frameform;
 
+  if (command->width > 4)
+    return false;
+
+  if (flags & SPIM_POLL)
+  {
+    /* Poll mode must not be used with data write commands */
+    if (command->length >= 8 || (flags & SPIM_WRITE))
+      return false;
+  }
+  else if (command->length > CMD_DATALEN_MAX)
+    return false;
+
   if (delay != 0)
   {
-    assert(delay <= CMD_INTLEN_MAX);
+    const bool postSerial = !(flags & SPIM_POST_PARALLEL);
+    const bool delaySerial = !(flags & SPIM_DELAY_PARALLEL);
 
-    if (interface->post.length != 0 && interface->delay.length != 0)
+    if (delay > CMD_INTLEN_MAX)
+      return false;
+
+    if (post && command->delay != 0)
     {
-      assert(interface->post.serial == interface->delay.serial);
-      packPost = interface->post.serial ? PACK_SERIAL : PACK_PARALLEL;
+      if (postSerial != delaySerial)
+        return false;
+
+      packPost = postSerial ? PACK_SERIAL : PACK_PARALLEL;
     }
     else
     {
-      const bool serial = interface->post.length != 0 ?
-          interface->post.serial : interface->delay.serial;
-
+      const bool serial = post ? postSerial : delaySerial;
       packPost = serial ? PACK_SERIAL : PACK_PARALLEL;
     }
   }
 
-  if (interface->command.length != 0)
+  if (flags & SPIM_OPCODE)
   {
-    frameform = frameformOpcodeMap[interface->address.length];
-    packCommand = interface->command.serial ? PACK_SERIAL : PACK_PARALLEL;
+    frameform = frameformOpcodeMap[command->width];
+    packCommand = (flags & SPIM_OPCODE_PARALLEL) ?
+        PACK_PARALLEL : PACK_SERIAL;
   }
   else
   {
-    assert(interface->address.length >= 3);
+    if (command->width < 3)
+      return false;
 
-    frameform = interface->address.length == 4 ?
+    frameform = command->width == 4 ?
         FRAMEFORM_ADDRESS_32 : FRAMEFORM_ADDRESS_24;
   }
 
-  if (interface->address.length != 0)
-    packAddress = interface->address.serial ? PACK_SERIAL : PACK_PARALLEL;
-  if (interface->data.length != 0 || interface->poll)
-    packData = interface->data.serial ? PACK_SERIAL : PACK_PARALLEL;
-
-  assert(
-      (
-          /* FIELDFORM_PARALLEL_ALL or FIELDFORM_SERIAL_OPCODE */
-          packAddress != PACK_SERIAL
-          && packPost != PACK_SERIAL
-          && packData != PACK_SERIAL
-      ) || (
-          /* FIELDFORM_PARALLEL_DATA or FIELDFORM_SERIAL_ALL */
-          packCommand != PACK_PARALLEL
-          && packAddress != PACK_PARALLEL
-          && packPost != PACK_PARALLEL
-      )
-  );
+  if (command->width != 0)
+  {
+    packAddress = (flags & SPIM_ADDRESS_PARALLEL) ?
+        PACK_PARALLEL : PACK_SERIAL;
+  }
+  if (command->length != 0 || (flags & SPIM_POLL))
+  {
+    packData = (flags & SPIM_DATA_PARALLEL) ?
+        PACK_PARALLEL : PACK_SERIAL;
+  }
 
   if (packAddress != PACK_SERIAL && packPost != PACK_SERIAL
       && packData != PACK_SERIAL)
@@ -239,47 +308,84 @@ static uint32_t makeCommand(const struct Spifi *interface)
     else
       fieldform = FIELDFORM_SERIAL_OPCODE;
   }
-  else
+  else if (packCommand != PACK_PARALLEL && packAddress != PACK_PARALLEL
+      && packPost != PACK_PARALLEL)
   {
     if (packData != PACK_SERIAL)
       fieldform = FIELDFORM_PARALLEL_DATA;
     else
       fieldform = FIELDFORM_SERIAL_ALL;
   }
+  else
+  {
+    /* Unsupported combination of serial and parallel fields */
+    return false;
+  }
 
-  uint32_t command = CMD_DATALEN(interface->data.length)
-      | CMD_FIELDFORM(fieldform) | CMD_FRAMEFORM(frameform);
+  uint32_t value = CMD_FIELDFORM(fieldform) | CMD_FRAMEFORM(frameform);
 
-  if (interface->poll)
-    command |= CMD_POLL;
-  if (interface->command.length)
-    command |= CMD_OPCODE(interface->command.value);
+  if (flags & SPIM_OPCODE)
+    value |= CMD_OPCODE(command->code);
   if (delay)
-    command |= CMD_INTLEN(delay);
+    value |= CMD_INTLEN(delay);
 
-  return command;
+  *frame = value;
+  return true;
 }
 /*----------------------------------------------------------------------------*/
-static void resetContext(struct Spifi *interface)
+static size_t readData(struct Spifi *interface, void *buffer, size_t length)
 {
-  interface->command.length = 0;
-  interface->command.serial = true;
-  interface->command.value = 0;
+  LPC_SPIFI_Type * const reg = interface->base.reg;
 
-  interface->address.length = 0;
-  interface->address.serial = true;
-  interface->address.value = 0;
+  if (!interface->blocking)
+  {
+    assert(length % 4 == 0);
+    interface->sync = length == 0;
+  }
 
-  interface->post.length = 0;
-  interface->post.serial = true;
-  interface->post.value = 0;
+  executeCommand(interface, false);
 
-  interface->delay.length = 0;
-  interface->delay.serial = true;
+  if (length)
+  {
+    /* Poll mode requires zero length read */
+    assert(!(interface->command.flags & SPIM_POLL));
+
+    if (interface->blocking)
+    {
+      uint8_t *position = buffer;
+      size_t left = length;
 
-  interface->data.length = 0;
-  interface->data.response = 0;
-  interface->data.serial = true;
+      while (left--)
+        *position++ = reg->DATA_B;
+    }
+    else
+    {
+      dmaAppend(interface->rxDma, buffer, (const void *)&reg->DATA, length);
+
+      interface->status = STATUS_RX_BUSY;
+      if (dmaEnable(interface->rxDma) != E_OK)
+      {
+        interface->status = STATUS_ERROR;
+        return 0;
+      }
+    }
+  }
+
+  if (interface->blocking)
+  {
+    while (reg->STAT & STAT_CMD);
+  }
+
+  return length;
+}
+/*----------------------------------------------------------------------------*/
+static void resetContext(struct Spifi *interface)
+{
+  interface->command = (struct SpimCommand){0};
+  interface->response = 0;
+
+  interface->sequence.commands = NULL;
+  interface->sequence.count = 0;
 }
 /*----------------------------------------------------------------------------*/
 static void resetMode(struct Spifi *interface)
@@ -293,6 +399,66 @@ static void resetMode(struct Spifi *interface)
   }
 }
 /*----------------------------------------------------------------------------*/
+static bool startNextCommand(struct Spifi *interface)
+{
+  const struct SpimCommand * const command = interface->sequence.commands++;
+  const size_t length = (command->flags & SPIM_POLL) ? 0 : command->length;
+
+  --interface->sequence.count;
+
+  if (!loadCommand(interface, command))
+    return false;
+
+  if (command->flags & SPIM_WRITE)
+    return writeData(interface, command->buffer, length) == length;
+  else
+    return readData(interface, command->buffer, length) == length;
+}
+/*----------------------------------------------------------------------------*/
+static size_t writeData(struct Spifi *interface, const void *buffer,
+    size_t length)
+{
+  LPC_SPIFI_Type * const reg = interface->base.reg;
+
+  if (!interface->blocking)
+  {
+    assert(length % 4 == 0);
+    interface->sync = length == 0;
+  }
+
+  executeCommand(interface, true);
+
+  if (length)
+  {
+    if (interface->blocking)
+    {
+      const uint8_t *position = buffer;
+      size_t left = length;
+
+      while (left--)
+        reg->DATA_B = *position++;
+    }
+    else
+    {
+      dmaAppend(interface->txDma, (void *)&reg->DATA, buffer, length);
+
+      interface->status = STATUS_TX_BUSY;
+      if (dmaEnable(interface->txDma) != E_OK)
+      {
+        interface->status = STATUS_ERROR;
+        return 0;
+      }
+    }
+  }
+
+  if (interface->blocking)
+  {
+    while (reg->STAT & STAT_CMD);
+  }
+
+  return length;
+}
+/*----------------------------------------------------------------------------*/
 static void dmaInterruptHandler(void *object)
 {
   struct Spifi * const interface = object;
@@ -319,6 +485,9 @@ static void dmaInterruptHandler(void *object)
     if (interface->status != STATUS_ERROR)
       interface->status = res == E_OK ? STATUS_OK : STATUS_ERROR;
 
+    if (continueSequence(interface))
+      return;
+
     if (interface->callback != NULL)
       interface->callback(interface->callbackArgument);
   }
@@ -351,12 +520,15 @@ static void spifiInterruptHandler(void *object)
     if (interface->status != STATUS_ERROR)
       interface->status = STATUS_OK;
 
-    if (interface->poll)
+    if (interface->command.flags & SPIM_POLL)
     {
-      interface->data.response = (uint32_t)reg->DATA_B;
-      interface->poll = false;
+      interface->response = reg->DATA_B;
+      interface->command.flags &= ~SPIM_POLL;
     }
 
+    if (continueSequence(interface))
+      return;
+
     if (interface->callback != NULL)
       interface->callback(interface->callbackArgument);
   }
@@ -401,7 +573,6 @@ static enum Result spifiInit(void *object, const void *configBase)
   interface->blocking = true;
   interface->large = config->large;
   interface->memmap = true;
-  interface->poll = false;
   resetContext(interface);
 
   LPC_SPIFI_Type * const reg = interface->base.reg;
@@ -474,9 +645,20 @@ static enum Result spifiGetParam(void *object, int parameter, void *data)
       return E_OK;
 
     case IF_SPIM_RESPONSE:
-      *(uint32_t *)data = (uint32_t)interface->data.response;
+      *(uint32_t *)data = (uint32_t)interface->response;
       return E_OK;
 
+    case IF_SPIM_PREPARE:
+    {
+      struct SpimCommand * const command = data;
+
+      if (!makeFrame(command, &command->prepared))
+        return E_VALUE;
+
+      command->flags |= SPIM_PREPARED;
+      return E_OK;
+    }
+
     default:
       break;
   }
@@ -516,6 +698,10 @@ static enum Result spifiSetParam(void *object, int parameter, const void *data)
   struct Spifi * const interface = object;
   LPC_SPIFI_Type * const reg = interface->base.reg;
 
+  /* Changes of command fields invalidate the prepared command */
+  if (parameter >= IF_SPIM_COMMAND && parameter <= IF_SPIM_DATA_SERIAL)
+    interface->command.flags &= ~SPIM_PREPARED;
+
   switch ((enum SPIMParameter)parameter)
   {
     case IF_SPIM_MODE:
@@ -557,20 +743,20 @@ static enum Result spifiSetParam(void *object, int parameter, const void *data)
       return E_OK;
 
     case IF_SPIM_COMMAND:
-      interface->command.length = 1;
-      interface->command.value = *(const uint8_t *)data;
+      interface->command.code = *(const uint8_t *)data;
+      interface->command.flags |= SPIM_OPCODE;
       return E_OK;
 
     case IF_SPIM_COMMAND_NONE:
-      interface->command.length = 0;
+      interface->command.flags &= ~SPIM_OPCODE;
       return E_OK;
 
     case IF_SPIM_COMMAND_PARALLEL:
-      interface->command.serial = false;
+      interface->command.flags |= SPIM_OPCODE_PARALLEL;
       return E_OK;
 
     case IF_SPIM_COMMAND_SERIAL:
-      interface->command.serial = true;
+      interface->command.flags &= ~SPIM_OPCODE_PARALLEL;
       return E_OK;
 
     case IF_SPIM_DELAY_LENGTH:
@@ -579,7 +765,7 @@ static enum Result spifiSetParam(void *object, int parameter, const void *data)
 
       if (value <= CMD_INTLEN_MAX)
       {
-        interface->delay.length = value;
+        interface->command.delay = value;
         return E_OK;
       }
       else
@@ -587,64 +773,64 @@ static enum Result spifiSetParam(void *object, int parameter, const void *data)
     }
 
     case IF_SPIM_DELAY_NONE:
-      interface->delay.length = 0;
+      interface->command.delay = 0;
       return E_OK;
 
     case IF_SPIM_DELAY_PARALLEL:
-      interface->delay.serial = false;
+      interface->command.flags |= SPIM_DELAY_PARALLEL;
       return E_OK;
 
     case IF_SPIM_DELAY_SERIAL:
-      interface->delay.serial = true;
+      interface->command.flags &= ~SPIM_DELAY_PARALLEL;
       return E_OK;
 
     case IF_SPIM_ADDRESS_8:
-      interface->address.length = 1;
-      interface->address.value = *(const uint32_t *)data;
+      interface->command.address = *(const uint32_t *)data;
+      interface->command.width = 1;
       return E_OK;
 
     case IF_SPIM_ADDRESS_16:
-      interface->address.length = 2;
-      interface->address.value = *(const uint32_t *)data;
+      interface->command.address = *(const uint32_t *)data;
+      interface->command.width = 2;
       return E_OK;
 
     case IF_SPIM_ADDRESS_24:
-      interface->address.length = 3;
-      interface->address.value = *(const uint32_t *)data;
+      interface->command.address = *(const uint32_t *)data;
+      interface->command.width = 3;
       return E_OK;
 
     case IF_SPIM_ADDRESS_32:
-      interface->address.length = 4;
-      interface->address.value = *(const uint32_t *)data;
+      interface->command.address = *(const uint32_t *)data;
+      interface->command.width = 4;
       return E_OK;
 
     case IF_SPIM_ADDRESS_NONE:
-      interface->address.length = 0;
+      interface->command.width = 0;
       return E_OK;
 
     case IF_SPIM_ADDRESS_PARALLEL:
-      interface->address.serial = false;
+      interface->command.flags |= SPIM_ADDRESS_PARALLEL;
       return E_OK;
 
     case IF_SPIM_ADDRESS_SERIAL:
-      interface->address.serial = true;
+      interface->command.flags &= ~SPIM_ADDRESS_PARALLEL;
       return E_OK;
 
     case IF_SPIM_POST_ADDRESS_8:
-      interface->post.length = 1;
-      interface->post.value = *(const uint32_t *)data;
+      interface->command.post = (uint8_t)*(const uint32_t *)data;
+      interface->command.flags |= SPIM_POST;
       return E_OK;
 
     case IF_SPIM_POST_ADDRESS_NONE:
-      interface->post.length = 0;
+      interface->command.flags &= ~SPIM_POST;
       return E_OK;
 
     case IF_SPIM_POST_ADDRESS_PARALLEL:
-      interface->post.serial = false;
+      interface->command.flags |= SPIM_POST_PARALLEL;
       return E_OK;
 
     case IF_SPIM_POST_ADDRESS_SERIAL:
-      interface->post.serial = true;
+      interface->command.flags &= ~SPIM_POST_PARALLEL;
       return E_OK;
 
     case IF_SPIM_DATA_LENGTH:
@@ -653,7 +839,7 @@ static enum Result spifiSetParam(void *object, int parameter, const void *data)
 
       if (value <= CMD_DATALEN_MAX)
       {
-        interface->data.length = value;
+        interface->command.length = value;
         return E_OK;
       }
       else
@@ -661,7 +847,7 @@ static enum Result spifiSetParam(void *object, int parameter, const void *data)
     }
 
     case IF_SPIM_DATA_NONE:
-      interface->data.length = 0;
+      interface->command.length = 0;
       return E_OK;
 
     case IF_SPIM_DATA_POLL_BIT:
@@ -670,8 +856,8 @@ static enum Result spifiSetParam(void *object, int parameter, const void *data)
 
       if (value < 8)
       {
-        interface->data.length = value;
-        interface->poll = true;
+        interface->command.length = value;
+        interface->command.flags |= SPIM_POLL;
         return E_OK;
       }
       else
@@ -679,13 +865,39 @@ static enum Result spifiSetParam(void *object, int parameter, const void *data)
     }
 
     case IF_SPIM_DATA_PARALLEL:
-      interface->data.serial = false;
+      interface->command.flags |= SPIM_DATA_PARALLEL;
       return E_OK;
 
     case IF_SPIM_DATA_SERIAL:
-      interface->data.serial = true;
+      interface->command.flags &= ~SPIM_DATA_PARALLEL;
       return E_OK;
 
+    case IF_SPIM_LOAD:
+      return loadCommand(interface, data) ? E_OK : E_VALUE;
+
+    case IF_SPIM_SEQUENCE:
+    {
+      const struct SpimSequence * const sequence = data;
+
+      if (!sequence->count)
+        return E_VALUE;
+
+      interface->sequence.commands = sequence->commands;
+      interface->sequence.count = sequence->count;
+
+      do
+      {
+        if (!startNextCommand(interface))
+        {
+          interface->sequence.count = 0;
+          return E_INTERFACE;
+        }
+      }
+      while (interface->blocking && interface->sequence.count);
+
+      return interface->blocking ? E_OK : E_BUSY;
+    }
+
     default:
       break;
   }
@@ -710,91 +922,10 @@ static enum Result spifiSetParam(void *object, int parameter, const void *data)
 /*----------------------------------------------------------------------------*/
 static size_t spifiRead(void *object, void *buffer, size_t length)
 {
-  struct Spifi * const interface = object;
-  LPC_SPIFI_Type * const reg = interface->base.reg;
-
-  if (!interface->blocking)
-  {
-    assert(length % 4 == 0);
-    interface->sync = length == 0;
-  }
-
-  executeCommand(interface, false);
-
-  if (length)
-  {
-    /* Poll mode requires zero length read */
-    assert(!interface->poll);
-
-    if (interface->blocking)
-    {
-      uint8_t *position = buffer;
-      size_t left = length;
-
-      while (left--)
-        *position++ = reg->DATA_B;
-    }
-    else
-    {
-      dmaAppend(interface->rxDma, buffer, (const void *)&reg->DATA, length);
-
-      interface->status = STATUS_RX_BUSY;
-      if (dmaEnable(interface->rxDma) != E_OK)
-      {
-        interface->status = STATUS_ERROR;
-        return 0;
-      }
-    }
-  }
-
-  if (interface->blocking)
-  {
-    while (reg->STAT & STAT_CMD);
-  }
-
-  return length;
+  return readData(object, buffer, length);
 }
 /*----------------------------------------------------------------------------*/
 static size_t spifiWrite(void *object, const void *buffer, size_t length)
 {
-  struct Spifi * const interface = object;
-  LPC_SPIFI_Type * const reg = interface->base.reg;
-
-  if (!interface->blocking)
-  {
-    assert(length % 4 == 0);
-    interface->sync = length == 0;
-  }
-
-  executeCommand(interface, true);
-
-  if (length)
-  {
-    if (interface->blocking)
-    {
-      const uint8_t *position = buffer;
-      size_t left = length;
-
-      while (left--)
-        reg->DATA_B = *position++;
-    }
-    else
-    {
-      dmaAppend(interface->txDma, (void *)&reg->DATA, buffer, length);
-
-      interface->status = STATUS_TX_BUSY;
-      if (dmaEnable(interface->txDma) != E_OK)
-      {
-        interface->status = STATUS_ERROR;
-        return 0;
-      }
-    }
-  }
-
-  if (interface->blocking)
-  {
-    while (reg->STAT & STAT_CMD);
-  }
-
-  return length;
+  return writeData(object, buffer, length);
 }
@@ -35,6 +35,7 @@ static enum Result channelResidue(const void *, size_t *);
 static enum Result channelStatus(const void *);
 
 static void channelAppend(void *, void *, const void *, size_t);
+static void channelAppendVector(void *, const struct DmaVector *, size_t);
 static void channelClear(void *);
 static size_t channelQueued(const void *);
 /*----------------------------------------------------------------------------*/
@@ -52,6 +53,7 @@ const struct DmaClass * const PdmaList = &(const struct DmaClass){
     .status = channelStatus,
 
     .append = channelAppend,
+    .appendVector = channelAppendVector,
     .clear = channelClear,
     .queued = channelQueued
 };
@@ -304,17 +306,18 @@ static enum Result channelStatus(const void *object)
 /*----------------------------------------------------------------------------*/
 static void channelAppend(void *object, void *destination, const void *source,
     size_t size)
+{
+  const struct DmaVector vector = {destination, source, size};
+  channelAppendVector(object, &vector, 1);
+}
+/*----------------------------------------------------------------------------*/
+static void channelAppendVector(void *object, const struct DmaVector *vector,
+    size_t count)
 {
   struct PdmaList * const channel = object;
   const uint32_t control = channel->base.control;
-  const uint32_t transfers = size >> DSCT_CTL_TXWIDTH_VALUE(control);
 
-  assert(destination != NULL && source != NULL);
-  assert(!((uintptr_t)destination % (1 << DSCT_CTL_TXWIDTH_VALUE(control))));
-  assert(!((uintptr_t)source % (1 << DSCT_CTL_TXWIDTH_VALUE(control))));
-  assert(!(size % (1 << DSCT_CTL_TXWIDTH_VALUE(control))));
-  assert(transfers > 0 && transfers <= PDMA_MAX_TRANSFER_SIZE);
-  assert(channel->queued < channel->capacity);
+  assert(count > 0);
 
   if (channel->state == STATE_DONE || channel->state == STATE_ERROR)
   {
@@ -322,36 +325,54 @@ static void channelAppend(void *object, void *destination, const void *source,
     channel->queued = 0;
   }
 
-  struct PdmaEntry * const current = channel->list + channel->index;
+  assert(channel->queued + count <= channel->capacity);
+
   struct PdmaEntry *previous = NULL;
 
   if (channel->queued)
   {
     /* There are initialized entries in the list */
-    previous = channel->index ? current : channel->list + channel->capacity;
-    --previous;
+    previous = channel->list
+        + (channel->index ? channel->index : channel->capacity) - 1;
   }
 
-  if (++channel->index >= channel->capacity)
-    channel->index = 0;
+  for (size_t position = 0; position < count; ++position)
+  {
+    const uintptr_t destination = (uintptr_t)vector[position].destination;
+    const uintptr_t source = (uintptr_t)vector[position].source;
+    const size_t size = vector[position].size;
+    const uint32_t transfers = size >> DSCT_CTL_TXWIDTH_VALUE(control);
 
-  current->source = (uintptr_t)source;
-  current->destination = (uintptr_t)destination;
-  current->control = control | DSCT_CTL_OPMODE(OPMODE_BASIC)
-      | DSCT_CTL_TXCNT(transfers - 1);
-  current->next = 0;
+    assert(destination != 0 && source != 0);
+    assert(!(destination % (1 << DSCT_CTL_TXWIDTH_VALUE(control))));
+    assert(!(source % (1 << DSCT_CTL_TXWIDTH_VALUE(control))));
+    assert(!(size % (1 << DSCT_CTL_TXWIDTH_VALUE(control))));
+    assert(transfers > 0 && transfers <= PDMA_MAX_TRANSFER_SIZE);
 
-  if (previous != NULL)
-  {
-    /* Change mode of the previous element from basic to scatter-gather */
-    previous->control &= ~DSCT_CTL_OPMODE_MASK;
-    previous->control |= DSCT_CTL_OPMODE(OPMODE_LIST);
+    struct PdmaEntry * const current = channel->list + channel->index;
 
-    /* Link previous element with the new one */
-    previous->next = DSCT_NEXT_NEXT((uintptr_t)current);
-  }
+    if (++channel->index >= channel->capacity)
+      channel->index = 0;
+
+    current->source = source;
+    current->destination = destination;
+    current->control = control | DSCT_CTL_OPMODE(OPMODE_BASIC)
+        | DSCT_CTL_TXCNT(transfers - 1);
+    current->next = 0;
+
+    if (previous != NULL)
+    {
+      /* Change mode of the previous element from basic to scatter-gather */
+      previous->control &= ~DSCT_CTL_OPMODE_MASK;
+      previous->control |= DSCT_CTL_OPMODE(OPMODE_LIST);
 
-  ++channel->queued;
+      /* Link previous element with the new one */
+      previous->next = DSCT_NEXT_NEXT((uintptr_t)current);
+    }
+
+    previous = current;
+    ++channel->queued;
+  }
 
   if (channel->state != STATE_BUSY)
     channel->state = STATE_READY;
@@ -22,10 +22,14 @@ enum
   STATUS_ERROR
 };
 /*----------------------------------------------------------------------------*/
+static bool continueSequence(struct Spim *);
 static void enableMemoryMappingMode(struct Spim *);
 static void enableNormalMode(struct Spim *);
 static void executeDirectCommand(struct Spim *, uintptr_t, bool);
 static void executeDmaCommand(struct Spim *, uintptr_t, bool);
+static bool isCommandValid(const struct SpimCommand *);
+static bool loadCommand(struct Spim *, const struct SpimCommand *);
+static size_t readData(struct Spim *, void *, size_t);
 static void readDataDirect(struct Spim *, void *, size_t);
 static bool readPollResponse(struct Spim *);
 static void resetContext(struct Spim *);
@@ -33,7 +37,9 @@ static void resetMode(struct Spim *);
 static uint32_t getSerialRate(const struct Spim *);
 static void setSerialRate(struct Spim *, uint32_t);
 static void spimInterruptHandler(void *);
+static bool startNextCommand(struct Spim *);
 static void timerInterruptHandler(void *);
+static size_t writeData(struct Spim *, const void *, size_t);
 static void writeDataDirect(struct Spim *, const void *, size_t);
 /*----------------------------------------------------------------------------*/
 static enum Result spimInit(void *, const void *);
@@ -56,6 +62,20 @@ const struct InterfaceClass * const Spim = &(const struct InterfaceClass){
     .write = spimWrite
 };
 /*----------------------------------------------------------------------------*/
+static bool continueSequence(struct Spim *interface)
+{
+  if (interface->sequence.count && interface->status != STATUS_ERROR)
+  {
+    if (startNextCommand(interface))
+      return true;
+
+    interface->status = STATUS_ERROR;
+  }
+
+  interface->sequence.count = 0;
+  return false;
+}
+/*----------------------------------------------------------------------------*/
 static void enableMemoryMappingMode(struct Spim *interface)
 {
   NM_SPIM_Type * const reg = interface->base.reg;
@@ -80,31 +100,35 @@ static void enableMemoryMappingMode(struct Spim *interface)
    */
   if (interface->ddr)
   {
-    const uint8_t cmd = interface->command.value;
+    const uint8_t cmd = interface->command.code;
+    const bool serial = !(interface->command.flags & SPIM_DATA_PARALLEL);
     (void)cmd;
+    (void)serial;
 
-    assert((interface->data.serial && cmd == 0x0D)
-        || (!interface->data.serial && interface->quad && cmd == 0xED)
-        || (!interface->data.serial && !interface->quad && cmd == 0xBD));
+    assert((serial && cmd == 0x0D)
+        || (!serial && interface->quad && cmd == 0xED)
+        || (!serial && !interface->quad && cmd == 0xBD));
   }
   else
   {
-    const uint8_t cmd = interface->command.value;
+    const uint8_t cmd = interface->command.code;
+    const bool serial = !(interface->command.flags & SPIM_DATA_PARALLEL);
     (void)cmd;
+    (void)serial;
 
-    assert((interface->data.serial
+    assert((serial
     				&& (cmd == 0x03 || cmd == 0x0B))
-        || (!interface->data.serial && interface->quad
+        || (!serial && interface->quad
             && (cmd == 0xE7 || cmd == 0xEB))
-        || (!interface->data.serial && !interface->quad
+        || (!serial && !interface->quad
             && (cmd == 0x3B || cmd == 0xBB)));
   }
 
   /* CTL0 */
   ctl0 &= ~(CTL0_OPMODE_MASK | CTL0_CMDCODE_MASK | CTL0_B4ADDREN);
-  if (interface->address.length == 4)
+  if (interface->command.width == 4)
     ctl0 |= CTL0_B4ADDREN;
-  ctl0 |= CTL0_CMDCODE(interface->command.value) | CTL0_OPMODE(OPMODE_DMM);
+  ctl0 |= CTL0_CMDCODE(interface->command.code) | CTL0_OPMODE(OPMODE_DMM);
 
   /* CTL2 and DMMCTL */
   ctl2 &= ~(CTL2_DTRMPOFF | CTL2_DCNUM_MASK);
@@ -117,34 +141,34 @@ static void enableMemoryMappingMode(struct Spim *interface)
   if (interface->quad)
     cycles >>= 1;
 
-  if (interface->post.length)
+  if (interface->command.flags & SPIM_POST)
   {
     /* Command 03h does not support mode phase */
-    assert(interface->command.value != 0x03);
+    assert(interface->command.code != 0x03);
 
-    if (interface->command.value == 0xBB)
-      cycles *= interface->delay.length + interface->post.length;
+    if (interface->command.code == 0xBB)
+      cycles *= interface->command.delay + 1;
     else
-      cycles *= interface->delay.length;
+      cycles *= interface->command.delay;
 
-    dmmctl |= DMMCTL_CRMDAT(interface->post.value);
+    dmmctl |= DMMCTL_CRMDAT(interface->command.post);
   }
   else
   {
-    if ((interface->command.value & 0x0F) == 0x0D)
+    if ((interface->command.code & 0x0F) == 0x0D)
     {
       /* Disable mode phase for DTR/DDR commands only */
       ctl2 |= CTL2_DTRMPOFF;
     }
 
-    cycles *= interface->delay.length;
+    cycles *= interface->command.delay;
   }
 
   assert(cycles <= CTL2_DCNUM_MAX);
   ctl2 |= CTL2_DCNUM(cycles);
 
   // TODO Burst mode in abstract SPIM interface
-  // if (interface->command.value == 0xEB || interface->command.value == 0xE7)
+  // if (interface->command.code == 0xEB || interface->command.code == 0xE7)
   //   dmmctl |= DMMCTL_BWEN;
 
   /* Clear cache */
@@ -175,6 +199,7 @@ static void executeDirectCommand(struct Spim *interface, uintptr_t buffer,
     bool out)
 {
   NM_SPIM_Type * const reg = interface->base.reg;
+  const bool poll = (interface->command.flags & SPIM_POLL) != 0;
   uint32_t ctl0 = reg->CTL0;
 
   ctl0 &= ~(CTL0_QDIODIR | CTL0_BITMODE_MASK | CTL0_OPMODE_MASK);
@@ -185,12 +210,12 @@ static void executeDirectCommand(struct Spim *interface, uintptr_t buffer,
   reg->CTL0 = ctl0;
   reg->CTL1 &= ~CTL1_SS;
 
-  if (interface->command.length)
+  if (interface->command.flags & SPIM_OPCODE)
   {
     uint32_t bitmode;
 
     /* Send command part */
-    if (interface->command.serial)
+    if (!(interface->command.flags & SPIM_OPCODE_PARALLEL))
       bitmode = CTL0_BITMODE(BITMODE_STANDARD);
     else if (!interface->quad)
       bitmode = CTL0_BITMODE(BITMODE_DUAL);
@@ -198,18 +223,18 @@ static void executeDirectCommand(struct Spim *interface, uintptr_t buffer,
       bitmode = CTL0_BITMODE(BITMODE_QUAD);
 
     reg->CTL0 = ctl0 | bitmode | CTL0_QDIODIR;
-    writeDataDirect(interface, &interface->command.value, 1);
+    writeDataDirect(interface, &interface->command.code, 1);
   }
 
-  if (interface->address.length)
+  if (interface->command.width)
   {
-    uint32_t address = toBigEndian32(interface->address.value);
+    uint32_t address = toBigEndian32(interface->command.address);
     uint32_t bitmode;
 
-    address >>= 32 - interface->address.length * 8;
+    address >>= 32 - interface->command.width * 8;
 
     /* Send address part */
-    if (interface->address.serial)
+    if (!(interface->command.flags & SPIM_ADDRESS_PARALLEL))
       bitmode = CTL0_BITMODE(BITMODE_STANDARD);
     else if (!interface->quad)
       bitmode = CTL0_BITMODE(BITMODE_DUAL);
@@ -217,15 +242,15 @@ static void executeDirectCommand(struct Spim *interface, uintptr_t buffer,
       bitmode = CTL0_BITMODE(BITMODE_QUAD);
 
     reg->CTL0 = ctl0 | bitmode | CTL0_QDIODIR;
-    writeDataDirect(interface, &address, interface->address.length);
+    writeDataDirect(interface, &address, interface->command.width);
   }
 
-  if (interface->post.length)
+  if (interface->command.flags & SPIM_POST)
   {
     uint32_t bitmode;
 
     /* Send post-address part */
-    if (interface->post.serial)
+    if (!(interface->command.flags & SPIM_POST_PARALLEL))
       bitmode = CTL0_BITMODE(BITMODE_STANDARD);
     else if (!interface->quad)
       bitmode = CTL0_BITMODE(BITMODE_DUAL);
@@ -233,16 +258,16 @@ static void executeDirectCommand(struct Spim *interface, uintptr_t buffer,
       bitmode = CTL0_BITMODE(BITMODE_QUAD);
 
     reg->CTL0 = ctl0 | bitmode | CTL0_QDIODIR;
-    writeDataDirect(interface, &interface->post.value, 1);
+    writeDataDirect(interface, &interface->command.post, 1);
   }
 
-  if (interface->delay.length)
+  if (interface->command.delay)
   {
     uint32_t bitmode;
     uint8_t pattern[CTL2_DCNUM_MAX];
 
     /* Send dummy bytes */
-    if (interface->delay.serial)
+    if (!(interface->command.flags & SPIM_DELAY_PARALLEL))
       bitmode = CTL0_BITMODE(BITMODE_STANDARD);
     else if (!interface->quad)
       bitmode = CTL0_BITMODE(BITMODE_DUAL);
@@ -251,13 +276,13 @@ static void executeDirectCommand(struct Spim *interface, uintptr_t buffer,
     memset(pattern, 0xFF, sizeof(pattern));
 
     reg->CTL0 = ctl0 | bitmode | CTL0_QDIODIR;
-    writeDataDirect(interface, pattern, interface->delay.length);
+    writeDataDirect(interface, pattern, interface->command.delay);
   }
 
-  if (interface->data.length || interface->poll)
+  if (interface->command.length || poll)
   {
     /* Send or receive data bytes */
-    if (interface->data.serial)
+    if (!(interface->command.flags & SPIM_DATA_PARALLEL))
       ctl0 |= CTL0_BITMODE(BITMODE_STANDARD);
     else if (!interface->quad)
       ctl0 |= CTL0_BITMODE(BITMODE_DUAL);
@@ -269,37 +294,38 @@ static void executeDirectCommand(struct Spim *interface, uintptr_t buffer,
 
     reg->CTL0 = ctl0;
 
-    if (interface->data.length)
+    if (!poll && interface->command.length)
     {
       if (out)
       {
         writeDataDirect(interface, (const void *)buffer,
-            interface->data.length);
+            interface->command.length);
       }
       else
       {
         readDataDirect(interface, (void *)buffer,
-            interface->data.length);
+            interface->command.length);
       }
     }
   }
 
-  const bool invoke = !interface->blocking && interface->callback != NULL;
-
-  if (!interface->poll)
+  if (!poll)
   {
     /* Deactivate Slave Select in all modes except for polling mode */
     reg->CTL1 |= CTL1_SS;
   }
-  else if (!invoke)
+  else if (interface->blocking)
   {
     /* Read first poll response immediately in case of blocking mode */
     readPollResponse(interface);
   }
 
-  if (invoke)
+  if (!interface->blocking)
   {
-    /* Call user callback from interrupt handler */
+    /*
+     * Advance the command sequence and call user callback from interrupt
+     * handler, the callback is optional.
+     */
     irqSetPending(interface->base.irq);
   }
 }
@@ -333,40 +359,44 @@ static void executeDmaCommand(struct Spim *interface, uintptr_t buffer,
    */
   if (interface->ddr)
   {
-    const uint8_t cmd = interface->command.value;
+    const uint8_t cmd = interface->command.code;
+    const bool serial = !(interface->command.flags & SPIM_DATA_PARALLEL);
     (void)cmd;
+    (void)serial;
 
-    assert((interface->data.serial && cmd == 0x0D)
-        || (!interface->data.serial && interface->quad && cmd == 0xED)
-        || (!interface->data.serial && !interface->quad && cmd == 0xBD));
+    assert((serial && cmd == 0x0D)
+        || (!serial && interface->quad && cmd == 0xED)
+        || (!serial && !interface->quad && cmd == 0xBD));
   }
   else
   {
-    const uint8_t cmd = interface->command.value;
+    const uint8_t cmd = interface->command.code;
+    const bool serial = !(interface->command.flags & SPIM_DATA_PARALLEL);
     (void)cmd;
+    (void)serial;
 
     /* Check read commands */
     assert(out
-        || (interface->data.serial
+        || (serial
     				&& (cmd == 0x03 || cmd == 0x0B))
-        || (!interface->data.serial && interface->quad
+        || (!serial && interface->quad
             && (cmd == 0xE7 || cmd == 0xEB))
-        || (!interface->data.serial && !interface->quad
+        || (!serial && !interface->quad
             && (cmd == 0x3B || cmd == 0xBB)));
 
     /* Check write commands */
     assert(!out
-        || (interface->data.serial
+        || (serial
             && (cmd == 0x02))
-        || (!interface->data.serial && interface->quad
+        || (!serial && interface->quad
             && (cmd == 0x32 || cmd == 0x38 || cmd == 0x40)));
   }
 
   /* CTL0 */
   ctl0 &= ~(CTL0_B4ADDREN | CTL0_OPMODE_MASK | CTL0_CMDCODE_MASK);
-  ctl0 |= CTL0_CMDCODE(interface->command.value);
+  ctl0 |= CTL0_CMDCODE(interface->command.code);
   ctl0 |= out ? CTL0_OPMODE(OPMODE_DMA_WRITE) : CTL0_OPMODE(OPMODE_DMA_READ);
-  if (interface->address.length == 4)
+  if (interface->command.width == 4)
     ctl0 |= CTL0_B4ADDREN;
 
   /* CTL2 */
@@ -377,14 +407,14 @@ static void executeDmaCommand(struct Spim *interface, uintptr_t buffer,
     uint32_t cycles = 4;
 
     /* Continuous Read mode is not supported in non-memory-mapped mode */
-    assert((interface->post.length == 1 && interface->post.value == 0xFF)
-        || interface->post.length == 0);
+    assert(!(interface->command.flags & SPIM_POST)
+        || interface->command.post == 0xFF);
 
     if (interface->ddr)
       cycles >>= 1;
     if (interface->quad)
       cycles >>= 1;
-    cycles *= interface->delay.length;
+    cycles *= interface->command.delay;
 
     if (interface->ddr)
       ctl2 |= CTL2_DTRMPOFF;
@@ -394,9 +424,9 @@ static void executeDmaCommand(struct Spim *interface, uintptr_t buffer,
   }
 
   /* Prepare DMA mode and activate Slave Select */
-  reg->FADDR = interface->address.value;
+  reg->FADDR = interface->command.address;
   reg->SRAMADDR = (uint32_t)buffer;
-  reg->DMACNT = interface->data.length;
+  reg->DMACNT = interface->command.length;
   reg->DMMCTL &= ~(DMMCTL_CRMDAT_MASK | DMMCTL_CREN);
   reg->CTL0 = ctl0;
   reg->CTL2 = ctl2;
@@ -420,6 +450,94 @@ static void executeDmaCommand(struct Spim *interface, uintptr_t buffer,
   }
 }
 /*----------------------------------------------------------------------------*/
+static bool isCommandValid(const struct SpimCommand *command)
+{
+  /* Only 24-bit and 32-bit addresses are supported */
+  if (command->width != 0 && command->width != 3 && command->width != 4)
+    return false;
+  if (command->delay >= CTL2_DCNUM_MAX)
+    return false;
+
+  if (command->flags & SPIM_POLL)
+  {
+    /* Poll mode must not be used with data write commands */
+    return command->length < 8 && !(command->flags & SPIM_WRITE);
+  }
+  else
+    return command->length <= SPIM_MAX_TRANSFER_SIZE;
+}
+/*----------------------------------------------------------------------------*/
+static bool loadCommand(struct Spim *interface,
+    const struct SpimCommand *command)
+{
+  if (!(command->flags & SPIM_PREPARED) && !isCommandValid(command))
+    return false;
+
+  interface->command = *command;
+  return true;
+}
+/*----------------------------------------------------------------------------*/
+static size_t readData(struct Spim *interface, void *buffer, size_t length)
+{
+  if (interface->command.flags & SPIM_POLL)
+  {
+    /* Poll mode requires zero length read */
+    assert(!length);
+
+    executeDirectCommand(interface, (uintptr_t)NULL, false);
+
+    if (interface->blocking)
+    {
+      while (interface->command.flags & SPIM_POLL)
+        barrier();
+    }
+  }
+  else
+  {
+    const uint8_t cmd = interface->command.code;
+    const bool serial = !(interface->command.flags & SPIM_DATA_PARALLEL);
+    bool dma = false;
+
+    if (interface->ddr)
+    {
+      assert((serial && cmd == 0x0D)
+          || (!serial && interface->quad && cmd == 0xED)
+          || (!serial && !interface->quad && cmd == 0xBD));
+
+      dma = true;
+    }
+    else if (serial)
+    {
+      /* Check for Standard Read and Fast Read commands */
+      dma = cmd == 0x03 || cmd == 0x0B;
+    }
+    else if (interface->quad)
+    {
+      /* Check for Fast Read Quad I/O commands */
+      dma = cmd == 0xEB || cmd == 0xE7;
+    }
+    else
+    {
+      /* Check for Fast Read Dual Output and Dual I/O commands */
+      dma = cmd == 0x3B || cmd == 0xBB;
+    }
+
+    assert(length % 4 == 0 || !dma);
+    assert(length == interface->command.length);
+
+    if (dma)
+    {
+      executeDmaCommand(interface, (uintptr_t)buffer, false);
+    }
+    else
+    {
+      executeDirectCommand(interface, (uintptr_t)buffer, false);
+    }
+  }
+
+  return length;
+}
+/*----------------------------------------------------------------------------*/
 static void readDataDirect(struct Spim *interface, void *buffer, size_t length)
 {
   NM_SPIM_Type * const reg = interface->base.reg;
@@ -474,15 +592,15 @@ static bool readPollResponse(struct Spim *interface)
 
   readDataDirect(interface, &response, sizeof(response));
 
-  if ((response & BIT(interface->data.length)) == 0)
+  if ((response & BIT(interface->command.length)) == 0)
   {
     NM_SPIM_Type * const reg = interface->base.reg;
 
     /* Deactivate Slave Select */
     reg->CTL1 |= CTL1_SS;
 
-    interface->data.response = response;
-    interface->poll = false;
+    interface->response = response;
+    interface->command.flags &= ~SPIM_POLL;
 
     return true;
   }
@@ -497,24 +615,11 @@ static bool readPollResponse(struct Spim *interface)
 /*----------------------------------------------------------------------------*/
 static void resetContext(struct Spim *interface)
 {
-  interface->command.length = 0;
-  interface->command.serial = true;
-  interface->command.value = 0;
-
-  interface->address.length = 0;
-  interface->address.serial = true;
-  interface->address.value = 0;
-
-  interface->post.length = 0;
-  interface->post.serial = true;
-  interface->post.value = 0;
+  interface->command = (struct SpimCommand){0};
+  interface->response = 0;
 
-  interface->delay.length = 0;
-  interface->delay.serial = true;
-
-  interface->data.length = 0;
-  interface->data.response = 0;
-  interface->data.serial = true;
+  interface->sequence.commands = NULL;
+  interface->sequence.count = 0;
 }
 /*----------------------------------------------------------------------------*/
 static void resetMode(struct Spim *interface)
@@ -570,21 +675,39 @@ static void spimInterruptHandler(void *object)
     reg->CTL1 |= CTL1_SS;
   }
 
-  if (interface->poll)
+  if (interface->command.flags & SPIM_POLL)
     event = readPollResponse(interface);
   else
 	  event = true;
 
-  if (event && interface->callback != NULL)
+  if (event && !continueSequence(interface) && interface->callback != NULL)
     interface->callback(interface->callbackArgument);
 }
 /*----------------------------------------------------------------------------*/
+static bool startNextCommand(struct Spim *interface)
+{
+  const struct SpimCommand * const command = interface->sequence.commands++;
+  const size_t length = (command->flags & SPIM_POLL) ? 0 : command->length;
+
+  --interface->sequence.count;
+
+  if (!loadCommand(interface, command))
+    return false;
+
+  if (command->flags & SPIM_WRITE)
+    writeData(interface, command->buffer, length);
+  else
+    readData(interface, command->buffer, length);
+
+  return true;
+}
+/*----------------------------------------------------------------------------*/
 static void timerInterruptHandler(void *object)
 {
   struct Spim * const interface = object;
   const bool event = readPollResponse(interface);
 
-  if (event && interface->callback != NULL)
+  if (event && !continueSequence(interface) && interface->callback != NULL)
     interface->callback(interface->callbackArgument);
 }
 /*----------------------------------------------------------------------------*/
@@ -634,6 +757,28 @@ static void writeDataDirect(struct Spim *interface, const void *buffer,
   reg->CTL0 |= CTL0_IF;
 }
 /*----------------------------------------------------------------------------*/
+static size_t writeData(struct Spim *interface, const void *buffer,
+    size_t length)
+{
+  const uint8_t cmd = interface->command.code;
+  const bool dma = cmd == 0x02 || cmd == 0x32 || cmd == 0x38 || cmd == 0x40;
+
+  assert(!(interface->command.flags & SPIM_POLL));
+  assert(length % 4 == 0 || !dma);
+  assert(length == interface->command.length);
+
+  if (dma)
+  {
+    executeDmaCommand(interface, (uintptr_t)buffer, true);
+  }
+  else
+  {
+    executeDirectCommand(interface, (uintptr_t)buffer, true);
+  }
+
+  return length;
+}
+/*----------------------------------------------------------------------------*/
 static enum Result spimInit(void *object, const void *configBase)
 {
   const struct SpimConfig * const config = configBase;
@@ -667,7 +812,6 @@ static enum Result spimInit(void *object, const void *configBase)
   interface->blocking = true;
   interface->ddr = false;
   interface->memmap = false;
-  interface->poll = false;
   interface->quad = false;
   interface->uncached = config->uncached;
   resetContext(interface);
@@ -752,8 +896,21 @@ static enum Result spimGetParam(void *object, int parameter, void *data)
       return E_OK;
 
     case IF_SPIM_RESPONSE:
-      *(uint32_t *)data = (uint32_t)interface->data.response;
+      *(uint32_t *)data = (uint32_t)interface->response;
+      return E_OK;
+
+    case IF_SPIM_PREPARE:
+    {
+      struct SpimCommand * const command = data;
+
+      if (!isCommandValid(command))
+        return E_VALUE;
+
+      /* Register values depend on DDR and Quad modes, validation only */
+      command->prepared = 0;
+      command->flags |= SPIM_PREPARED;
       return E_OK;
+    }
 
     default:
       break;
@@ -797,6 +954,10 @@ static enum Result spimSetParam(void *object, int parameter, const void *data)
 {
   struct Spim * const interface = object;
 
+  /* Changes of command fields invalidate the prepared command */
+  if (parameter >= IF_SPIM_COMMAND && parameter <= IF_SPIM_DATA_SERIAL)
+    interface->command.flags &= ~SPIM_PREPARED;
+
   switch ((enum SPIMParameter)parameter)
   {
     case IF_SPIM_MODE:
@@ -834,20 +995,20 @@ static enum Result spimSetParam(void *object, int parameter, const void *data)
       return E_OK;
 
     case IF_SPIM_COMMAND:
-      interface->command.value = *(const uint8_t *)data;
-      interface->command.length = 1;
+      interface->command.code = *(const uint8_t *)data;
+      interface->command.flags |= SPIM_OPCODE;
       return E_OK;
 
     case IF_SPIM_COMMAND_NONE:
-      interface->command.length = 0;
+      interface->command.flags &= ~SPIM_OPCODE;
       return E_OK;
 
     case IF_SPIM_COMMAND_PARALLEL:
-      interface->command.serial = false;
+      interface->command.flags |= SPIM_OPCODE_PARALLEL;
       return E_OK;
 
     case IF_SPIM_COMMAND_SERIAL:
-      interface->command.serial = true;
+      interface->command.flags &= ~SPIM_OPCODE_PARALLEL;
       return E_OK;
 
     case IF_SPIM_DELAY_LENGTH:
@@ -856,7 +1017,7 @@ static enum Result spimSetParam(void *object, int parameter, const void *data)
 
       if (value < CTL2_DCNUM_MAX)
       {
-        interface->delay.length = value;
+        interface->command.delay = value;
         return E_OK;
       }
       else
@@ -864,15 +1025,15 @@ static enum Result spimSetParam(void *object, int parameter, const void *data)
     }
 
     case IF_SPIM_DELAY_NONE:
-      interface->delay.length = 0;
+      interface->command.delay = 0;
       return E_OK;
 
     case IF_SPIM_DELAY_PARALLEL:
-      interface->delay.serial = false;
+      interface->command.flags |= SPIM_DELAY_PARALLEL;
       return E_OK;
 
     case IF_SPIM_DELAY_SERIAL:
-      interface->delay.serial = true;
+      interface->command.flags &= ~SPIM_DELAY_PARALLEL;
       return E_OK;
 
     case IF_SPIM_ADDRESS_8:
@@ -881,42 +1042,42 @@ static enum Result spimSetParam(void *object, int parameter, const void *data)
       return E_VALUE;
 
     case IF_SPIM_ADDRESS_24:
-      interface->address.length = 3;
-      interface->address.value = *(const uint32_t *)data;
+      interface->command.address = *(const uint32_t *)data;
+      interface->command.width = 3;
       return E_OK;
 
     case IF_SPIM_ADDRESS_32:
-      interface->address.length = 4;
-      interface->address.value = *(const uint32_t *)data;
+      interface->command.address = *(const uint32_t *)data;
+      interface->command.width = 4;
       return E_OK;
 
     case IF_SPIM_ADDRESS_NONE:
-      interface->address.length = 0;
+      interface->command.width = 0;
       return E_OK;
 
     case IF_SPIM_ADDRESS_PARALLEL:
-      interface->address.serial = false;
+      interface->command.flags |= SPIM_ADDRESS_PARALLEL;
       return E_OK;
 
     case IF_SPIM_ADDRESS_SERIAL:
-      interface->address.serial = true;
+      interface->command.flags &= ~SPIM_ADDRESS_PARALLEL;
       return E_OK;
 
     case IF_SPIM_POST_ADDRESS_8:
-      interface->post.length = 1;
-      interface->post.value = *(const uint32_t *)data;
+      interface->command.post = (uint8_t)*(const uint32_t *)data;
+      interface->command.flags |= SPIM_POST;
       return E_OK;
 
     case IF_SPIM_POST_ADDRESS_NONE:
-      interface->post.length = 0;
+      interface->command.flags &= ~SPIM_POST;
       return E_OK;
 
     case IF_SPIM_POST_ADDRESS_PARALLEL:
-      interface->post.serial = false;
+      interface->command.flags |= SPIM_POST_PARALLEL;
       return E_OK;
 
     case IF_SPIM_POST_ADDRESS_SERIAL:
-      interface->post.serial = true;
+      interface->command.flags &= ~SPIM_POST_PARALLEL;
       return E_OK;
 
     case IF_SPIM_DATA_LENGTH:
@@ -925,7 +1086,7 @@ static enum Result spimSetParam(void *object, int parameter, const void *data)
 
       if (value <= SPIM_MAX_TRANSFER_SIZE)
       {
-        interface->data.length = value;
+        interface->command.length = value;
         return E_OK;
       }
       else
@@ -933,7 +1094,7 @@ static enum Result spimSetParam(void *object, int parameter, const void *data)
     }
 
     case IF_SPIM_DATA_NONE:
-      interface->data.length = 0;
+      interface->command.length = 0;
       return E_OK;
 
     case IF_SPIM_DATA_POLL_BIT:
@@ -942,8 +1103,8 @@ static enum Result spimSetParam(void *object, int parameter, const void *data)
 
       if (value < 8)
       {
-        interface->data.length = value;
-        interface->poll = true;
+        interface->command.length = value;
+        interface->command.flags |= SPIM_POLL;
         return E_OK;
       }
       else
@@ -951,13 +1112,39 @@ static enum Result spimSetParam(void *object, int parameter, const void *data)
     }
 
     case IF_SPIM_DATA_PARALLEL:
-      interface->data.serial = false;
+      interface->command.flags |= SPIM_DATA_PARALLEL;
       return E_OK;
 
     case IF_SPIM_DATA_SERIAL:
-      interface->data.serial = true;
+      interface->command.flags &= ~SPIM_DATA_PARALLEL;
       return E_OK;
 
+    case IF_SPIM_LOAD:
+      return loadCommand(interface, data) ? E_OK : E_VALUE;
+
+    case IF_SPIM_SEQUENCE:
+    {
+      const struct SpimSequence * const sequence = data;
+
+      if (!sequence->count)
+        return E_VALUE;
+
+      interface->sequence.commands = sequence->commands;
+      interface->sequence.count = sequence->count;
+
+      do
+      {
+        if (!startNextCommand(interface))
+        {
+          interface->sequence.count = 0;
+          return E_INTERFACE;
+        }
+      }
+      while (interface->blocking && interface->sequence.count);
+
+      return interface->blocking ? E_OK : E_BUSY;
+    }
+
     default:
       break;
   }
@@ -983,84 +1170,10 @@ static enum Result spimSetParam(void *object, int parameter, const void *data)
 /*----------------------------------------------------------------------------*/
 static size_t spimRead(void *object, void *buffer, size_t length)
 {
-  struct Spim * const interface = object;
-
-  if (interface->poll)
-  {
-    /* Poll mode requires zero length read */
-    assert(!length && !interface->data.length);
-
-    executeDirectCommand(interface, (uintptr_t)NULL, false);
-
-    if (interface->blocking)
-    {
-      while (interface->poll)
-        barrier();
-    }
-  }
-  else
-  {
-    const uint8_t cmd = interface->command.value;
-    bool dma = false;
-
-    if (interface->ddr)
-    {
-      assert((interface->data.serial && cmd == 0x0D)
-          || (!interface->data.serial && interface->quad && cmd == 0xED)
-          || (!interface->data.serial && !interface->quad && cmd == 0xBD));
-
-      dma = true;
-    }
-    else if (interface->data.serial)
-    {
-      /* Check for Standard Read and Fast Read commands */
-      dma = cmd == 0x03 || cmd == 0x0B;
-    }
-    else if (interface->quad)
-    {
-      /* Check for Fast Read Quad I/O commands */
-      dma = cmd == 0xEB || cmd == 0xE7;
-    }
-    else
-    {
-      /* Check for Fast Read Dual Output and Dual I/O commands */
-      dma = cmd == 0x3B || cmd == 0xBB;
-    }
-
-    assert(length % 4 == 0 || !dma);
-    assert(length == interface->data.length);
-
-    if (dma)
-    {
-      executeDmaCommand(interface, (uintptr_t)buffer, false);
-    }
-    else
-    {
-      executeDirectCommand(interface, (uintptr_t)buffer, false);
-    }
-  }
-
-  return length;
+  return readData(object, buffer, length);
 }
 /*----------------------------------------------------------------------------*/
 static size_t spimWrite(void *object, const void *buffer, size_t length)
 {
-  struct Spim * const interface = object;
-  const uint8_t cmd = interface->command.value;
-  const bool dma = cmd == 0x02 || cmd == 0x32 || cmd == 0x38 || cmd == 0x40;
-
-  assert(!interface->poll);
-  assert(length % 4 == 0 || !dma);
-  assert(length == interface->data.length);
-
-  if (dma)
-  {
-    executeDmaCommand(interface, (uintptr_t)buffer, true);
-  }
-  else
-  {
-    executeDirectCommand(interface, (uintptr_t)buffer, true);
-  }
-
-  return length;
+  return writeData(object, buffer, length);
 }
@@ -160,7 +160,7 @@ static enum Result streamEnable(void *object)
 {
   struct BdmaCircular * const stream = object;
 
-  assert(stream->state == STATE_READY);
+  assert(stream->state == STATE_READY || stream->state == STATE_DONE);
 
   if (bdmaSetInstance(stream->base.number, object))
   {
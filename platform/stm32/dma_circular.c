@@ -206,7 +206,7 @@ static enum Result streamEnable(void *object)
 {
   struct DmaCircular * const stream = object;
 
-  assert(stream->state == STATE_READY);
+  assert(stream->state == STATE_READY || stream->state == STATE_DONE);
 
   if (dmaSetInstance(stream->base.number, object))
   {
@@ -34,6 +34,7 @@ static enum Result streamResidue(const void *, size_t *);
 static enum Result streamStatus(const void *);
 
 static void streamAppend(void *, void *, const void *, size_t);
+static void streamAppendVector(void *, const struct DmaVector *, size_t);
 static void streamClear(void *);
 static size_t streamQueued(const void *);
 /*----------------------------------------------------------------------------*/
@@ -51,6 +52,7 @@ const struct DmaClass * const DmaList = &(const struct DmaClass){
     .status = streamStatus,
 
     .append = streamAppend,
+    .appendVector = streamAppendVector,
     .clear = streamClear,
     .queued = streamQueued
 };
@@ -343,14 +345,19 @@ static enum Result streamStatus(const void *object)
 /*----------------------------------------------------------------------------*/
 static void streamAppend(void *object, void *destination, const void *source,
     size_t size)
+{
+  const struct DmaVector vector = {destination, source, size};
+  streamAppendVector(object, &vector, 1);
+}
+/*----------------------------------------------------------------------------*/
+static void streamAppendVector(void *object, const struct DmaVector *vector,
+    size_t count)
 {
   struct DmaList * const stream = object;
   const uint32_t config = stream->base.config;
+  const bool m2p = SCR_DIR_VALUE(config) == DMA_TYPE_M2P;
 
-  assert(destination != NULL && source != NULL);
-  assert(!(size % (1 << SCR_PSIZE_VALUE(config))));
-  assert(!(size % (1 << SCR_MSIZE_VALUE(config))));
-  assert(stream->queued < stream->capacity);
+  assert(count > 0);
 
   if (stream->state == STATE_DONE || stream->state == STATE_ERROR)
   {
@@ -358,45 +365,58 @@ static void streamAppend(void *object, void *destination, const void *source,
     stream->queued = 0;
   }
 
-  struct DmaListEntry * const entry = stream->list + stream->index;
-  uintptr_t periphAddress;
-  uint32_t transferNumber;
-
-  if (++stream->index >= stream->capacity)
-    stream->index = 0;
+  assert(stream->queued + count <= stream->capacity);
 
-  if (SCR_DIR_VALUE(config) == DMA_TYPE_M2P)
-  {
-    /* Direction is from memory to peripheral */
-    entry->memoryAddress = (uintptr_t)source;
-    periphAddress = (uintptr_t)destination;
-    transferNumber = size >> SCR_PSIZE_VALUE(config);
-  }
-  else
+  for (size_t position = 0; position < count; ++position)
   {
-    /* Direction is from peripheral to memory */
-    entry->memoryAddress = (uintptr_t)destination;
-    periphAddress = (uintptr_t)source;
-    transferNumber = size >> SCR_MSIZE_VALUE(config);
-  }
+    const size_t size = vector[position].size;
+    struct DmaListEntry * const entry = stream->list + stream->index;
+    uintptr_t periphAddress;
+    uint32_t transferNumber;
+
+    assert(vector[position].destination != NULL);
+    assert(vector[position].source != NULL);
+    assert(!(size % (1 << SCR_PSIZE_VALUE(config))));
+    assert(!(size % (1 << SCR_MSIZE_VALUE(config))));
+
+    if (++stream->index >= stream->capacity)
+      stream->index = 0;
+
+    if (m2p)
+    {
+      /* Direction is from memory to peripheral */
+      entry->memoryAddress = (uintptr_t)vector[position].source;
+      periphAddress = (uintptr_t)vector[position].destination;
+      transferNumber = size >> SCR_PSIZE_VALUE(config);
+    }
+    else
+    {
+      /* Direction is from peripheral to memory */
+      entry->memoryAddress = (uintptr_t)vector[position].destination;
+      periphAddress = (uintptr_t)vector[position].source;
+      transferNumber = size >> SCR_MSIZE_VALUE(config);
+    }
 
-  assert(!(entry->memoryAddress % (1 << SCR_MSIZE_VALUE(config))));
-  assert(!(periphAddress % (1 << SCR_PSIZE_VALUE(config))));
-  assert(transferNumber && transferNumber <= DMA_MAX_TRANSFER);
+    assert(!(entry->memoryAddress % (1 << SCR_MSIZE_VALUE(config))));
+    assert(!(periphAddress % (1 << SCR_PSIZE_VALUE(config))));
+    assert(transferNumber && transferNumber <= DMA_MAX_TRANSFER);
+
+    if (stream->state != STATE_BUSY)
+    {
+      stream->periphAddress = periphAddress;
+      stream->transferNumber = (uint16_t)transferNumber;
+    }
+    else
+    {
+      assert(periphAddress == stream->periphAddress);
+      assert(transferNumber == stream->transferNumber);
+    }
 
-  ++stream->queued;
+    ++stream->queued;
+  }
 
   if (stream->state != STATE_BUSY)
-  {
-    stream->periphAddress = periphAddress;
-    stream->transferNumber = (uint16_t)transferNumber;
     stream->state = STATE_READY;
-  }
-  else
-  {
-    assert(periphAddress == stream->periphAddress);
-    assert(transferNumber == stream->transferNumber);
-  }
 }
 /*----------------------------------------------------------------------------*/
 static void streamClear(void *object)
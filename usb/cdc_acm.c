@@ -18,6 +18,10 @@
 #include <malloc.h>
 #include <stdlib.h>
 #include <string.h>
+
+#ifdef CONFIG_GENERIC_BLOCK_POOL
+#  include <halm/generic/block_pool.h>
+#endif
 /*----------------------------------------------------------------------------*/
 #ifdef CONFIG_PLATFORM_USB_DEVICE_BUFFER_ALIGNMENT
 #  define MEM_ALIGNMENT CONFIG_PLATFORM_USB_DEVICE_BUFFER_ALIGNMENT
@@ -39,6 +43,8 @@ struct CdcAcm
   PointerArray txRequestPool;
   /* Pointer to the beginning of the request pool */
   void *requests;
+  /* Block pool for request memory */
+  void *pool;
   /* Number of available bytes */
   size_t queuedRxBytes;
   /* Number of pending bytes */
@@ -61,7 +67,8 @@ struct CdcAcm
 #endif
 };
 /*----------------------------------------------------------------------------*/
-static void *allocBufferMemory(size_t, size_t, size_t *);
+static void *allocBufferMemory(struct CdcAcm *, size_t, size_t, size_t *);
+static void freeBufferMemory(struct CdcAcm *);
 static void cdcDataReceived(void *, struct UsbRequest *, enum UsbRequestStatus);
 static void cdcDataSent(void *, struct UsbRequest *, enum UsbRequestStatus);
 static inline size_t getMaxBufferSize(void);
@@ -98,8 +105,8 @@ const struct InterfaceClass * const CdcAcm = &(const struct InterfaceClass){
     .write = interfaceWrite
 };
 /*----------------------------------------------------------------------------*/
-static void *allocBufferMemory(size_t requestCount, size_t bufferCount,
-    size_t *padding)
+static void *allocBufferMemory(struct CdcAcm *interface, size_t requestCount,
+    size_t bufferCount, size_t *padding)
 {
   const size_t bufferSize = getMaxBufferSize();
   const size_t dataMemorySize = bufferCount * bufferSize;
@@ -108,19 +115,47 @@ static void *allocBufferMemory(size_t requestCount, size_t bufferCount,
 #ifdef MEM_ALIGNMENT
   headerMemorySize += MEM_ALIGNMENT - 1;
   headerMemorySize -= headerMemorySize % MEM_ALIGNMENT;
+#endif
 
   if (padding != NULL)
     *padding = headerMemorySize;
 
-  return memalign(MEM_ALIGNMENT, headerMemorySize + dataMemorySize);
+#ifdef CONFIG_GENERIC_BLOCK_POOL
+  /* Alignment of blocks is determined by the pool configuration */
+  if (interface->pool != NULL)
+  {
+    void * const memory = blockPoolAlloc(interface->pool,
+        headerMemorySize + dataMemorySize);
+
+#  ifdef MEM_ALIGNMENT
+    assert((uintptr_t)memory % MEM_ALIGNMENT == 0);
+#  endif
+    return memory;
+  }
 #else
-  if (padding != NULL)
-    *padding = headerMemorySize;
+  assert(interface->pool == NULL);
+#endif
 
+#ifdef MEM_ALIGNMENT
+  return memalign(MEM_ALIGNMENT, headerMemorySize + dataMemorySize);
+#else
   return malloc(headerMemorySize + dataMemorySize);
 #endif
 }
 /*----------------------------------------------------------------------------*/
+static void freeBufferMemory(struct CdcAcm *interface)
+{
+#ifdef CONFIG_GENERIC_BLOCK_POOL
+  if (interface->pool != NULL)
+  {
+    blockPoolFree(interface->pool, interface->requests);
+    return;
+  }
+#endif
+
+  free(interface->requests);
+}
+/*----------------------------------------------------------------------------*/
 static void cdcDataReceived(void *argument, struct UsbRequest *request,
     enum UsbRequestStatus status)
 {
@@ -383,6 +418,7 @@ static enum Result interfaceInit(void *object, const void *configBase)
 
   interface->callback = NULL;
   interface->callbackArgument = NULL;
+  interface->pool = config->pool;
   interface->queuedRxBytes = 0;
   interface->queuedTxBytes = 0;
   interface->suspended = true;
@@ -414,7 +450,7 @@ static enum Result interfaceInit(void *object, const void *configBase)
   /* Allocate requests */
   if (config->arena != NULL)
   {
-    interface->requests = allocBufferMemory(count, 0, NULL);
+    interface->requests = allocBufferMemory(interface, count, 0, NULL);
     if (interface->requests == NULL)
       return E_MEMORY;
 
@@ -424,7 +460,8 @@ static enum Result interfaceInit(void *object, const void *configBase)
   {
     size_t padding;
 
-    interface->requests = allocBufferMemory(count, count, &padding);
+    interface->requests = allocBufferMemory(interface, count, count,
+        &padding);
     if (interface->requests == NULL)
       return E_MEMORY;
 
@@ -475,7 +512,7 @@ static void interfaceDeinit(void *object)
   assert(pointerQueueFull(&interface->rxRequestQueue));
 
   /* Free memory allocated for request buffers */
-  free(interface->requests);
+  freeBufferMemory(interface);
 
   /* Delete endpoints */
   deinit(interface->txDataEp);